@@ -4,10 +4,12 @@
 #include <QStyleFactory>
 #include <QPalette>
 #include <QStyle>
-#include <QFile>
-#include <QDir>
-#include <QDateTime>
-#include <QTextStream>
+
+#include "AsyncFileLogger.h"
+#include "EventTrace.h"
+#include "FlightRecorder.h"
+#include "LogCategories.h"
+#include "MonoClock.h"
 
 
 #pragma comment(linker, "/entry::WinMainCRTStartup /subsystem:console")
@@ -60,51 +62,40 @@ static void applyLightPalette() {
     qApp->setStyleSheet("");
 }
 
-void LogToFile(QtMsgType type, const QMessageLogContext &context, const QString &msg)
-{
-
-    const QString logDirPath = QStringLiteral("C:/Work/multiRobotController/tmp");
-    QDir().mkpath(logDirPath);   // 없으면 생성
-
-    const QString logFilePath = logDirPath + "/log_"+ QDate::currentDate().toString("yyMMdd") + ".txt";
-
-    QFile file(logFilePath);
-    if(!file.open(QIODevice::Append | QIODevice::Text)) {
-        return;
-    }
-    QTextStream out(&file);
-
-    QString curtime = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    //context.file, context.line, context.function
-    switch (type) {
-    case QtDebugMsg:
-        out << "[Debug]" << curtime <<": "<< msg << "\n";
-        break;
-    case QtInfoMsg:
-        out << "[Info]" << curtime <<": " << msg << "\n";
-        break;
-    case QtWarningMsg:
-        out << "[Warning]" << curtime <<": " << msg << "\n";
-        break;
-    case QtCriticalMsg:
-        out << "[Critical]" << curtime <<": " << msg << context.function << context.line << "\n";
-        break;
-    case QtFatalMsg:
-        out << "[Fatal]" << curtime <<": " << msg << "\n";
-        abort();
-    }
-    file.close();
-}
-
-
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
     applyLightPalette(); // 기본 라이트 모드 적용
-    qInstallMessageHandler(LogToFile);
 
-    MainWindow w;
-    w.show();
-    return a.exec();
+    // 세션 벽시계 앵커: 이후 모든 시각은 단조 시계, 표시할 때만 이 앵커로 변환
+    MonoClock::anchor();
+
+    // 파일 로그: 호출 스레드는 링에 넣기만, 기록은 전용 스레드 (경로: MRC_LOG_DIR 또는 기본값)
+    AsyncFileLogger::instance().start();
+    LogCategories::applyRules();    // logging.rules / MRC_LOG_RULES (기본: debug 꺼짐)
+    qInstallMessageHandler(AsyncFileLogger::messageHandler);
+
+    // 플라이트 레코더: 기본 켜짐 (MRC_FLIGHT=0 으로 끔). 에러/운영자 요청 시 최근 N 초를 덤프
+    FlightRecorder::configureFromEnv();
+    if (FlightRecorder::enabled())
+        qInfo("[TRACE] flight recorder on (%ds window, dumps to %s)",
+              FlightRecorder::windowSec(), qPrintable(FlightRecorder::dumpDir()));
+
+    // 바이너리 이벤트 트레이스 (MRC_TRACE_DIR 이 있을 때만, 재생: mrc_trace_replay)
+    const QString tracePath = EventTrace::openFromEnv();
+    if (!tracePath.isEmpty())
+        qInfo("[TRACE] recording to %s", qPrintable(tracePath));
+
+    int rc = 0;
+    {
+        MainWindow w;
+        w.show();
+        rc = a.exec();
+    }   // 창 소멸자에서 나오는 로그까지 기록한 뒤 종료
+
+    EventTrace::close();
+    qInstallMessageHandler(nullptr);
+    AsyncFileLogger::instance().stop();
+    return rc;
 }
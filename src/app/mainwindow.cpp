@@ -3,9 +3,12 @@
 
 #include "RobotManager.h"
 #include "GentryManager.h"
+#include "RobotCommandRouter.h"
+#include "AddressMapBuiltin.h"
 
 #include <QFile>
 #include <QDir>
+#include <QCoreApplication>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -15,12 +18,12 @@
 #include <QStatusBar>
 #include <QLabel>
 #include <QFrame>
-#include <QCheckBox>
 #include <QDebug>
-#include <QDateTime>
 
 #include "widgets/RobotPanel.h"
 #include "widgets/MotorPanel.h"
+#include "widgets/LogView.h"
+#include "LogModel.h"
 
 #include <QSplitter>
 
@@ -31,25 +34,29 @@ MainWindow::MainWindow(QWidget *parent)
     ui->setupUi(this);
 
     setWindowTitle("BinPicking Modbus Controller");
+
+    // 로그창: 모델 하나를 전체 창과 로봇 패널이 공유 (패널은 자기 로봇만 필터)
+    m_logModel = new LogModel(this);
+    m_logView  = new LogView(this);
+    m_logView->setLogModel(m_logModel);
+    ui->verticalLayout->addWidget(m_logView);
+
     initVisionClient();
 
     m_mgr = new RobotManager(this);
     m_mgr->setVisionClient(m_visionClient);
-    connect(m_mgr, &RobotManager::log, this,
-            [this](const QString& line, Common::LogLevel level){
-                QString prefix;
-                switch(level) {
-                case Common::LogLevel::Debug: prefix = "[DBG] "; break;
-                case Common::LogLevel::Info:  prefix = ""; break;
-                case Common::LogLevel::Warn:  prefix = "[WARN] "; break;
-                case Common::LogLevel::Error: prefix = "[ERR] "; break;
-                }
-                onLog(prefix + line, level);
+    connect(m_mgr, &RobotManager::log,
+            this, qOverload<const QString&, Common::LogLevel>(&MainWindow::onLog));
+    connect(m_mgr, &RobotManager::logByRobot, this,
+            [this](const QString& rid, const QString& line, Common::LogLevel level){
+                m_logModel->append(level, rid, line);
             });
+    m_mgr->loadRecipes();   // 실행 파일 옆 recipes.json → :/config/recipes.json
+    m_mgr->loadPulseActions(); // 실행 파일 옆 pulse_actions.json → :/config/pulse_actions.json
 
     connect(m_mgr, &RobotManager::reqGentryPalce, this, [this]{
         // TODO Gentry Place 동작 시작
-        qDebug()<<QDateTime::currentDateTime()<<"MainWindow::reqGentryPlace";
+        qDebug()<<"MainWindow::reqGentryPlace";
         m_gentryMgr->startGantryMove();
         int offset_mm = (m_sortingOffset>30)? (m_sortingOffset-30+10) : 0;
         m_gentryMgr->doGentryPlace(37, offset_mm);
@@ -57,7 +64,7 @@ MainWindow::MainWindow(QWidget *parent)
 
     connect(m_mgr, &RobotManager::reqGentryReady, this, [this]{
         // TODO Gentry Place 동작 시작
-        qDebug()<<QDateTime::currentDateTime()<<"MainWindow::reqGentryReady";
+        qDebug()<<"MainWindow::reqGentryReady";
         m_sortingPlacePorcessActive=false;
         m_gentryMgr->doGentryReady();
     });
@@ -76,7 +83,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_gentryMgr, &GentryManager::gantryCommandFinished, this,
             [this](bool ok, GantryPose pose){
                 Q_UNUSED(ok)
-                qDebug()<<QString("Gentry gantry command finished: %1").arg(ok?"OK":"FAIL");
+                qInfo()<<QString("Gentry gantry command finished: %1").arg(ok?"OK":"FAIL");
                 bool flip   = m_sortingFlip;
                 int  offset = m_sortingOffset;
                 int  thick  = m_sortingThick;
@@ -96,7 +103,7 @@ MainWindow::MainWindow(QWidget *parent)
                     }
                     else if(flip&& pose==GantryPose::Place){
                         // 겐트리 Tool Off
-                        qDebug()<<QDateTime::currentDateTime()<<"Gentry place pose"<<gantryPoseToString(pose)<<ok;
+                        qDebug()<<"Gentry place pose"<<gantryPoseToString(pose)<<ok;
                         m_mgr->cmdSort_GentryTool(false);
 
                         m_sortingPlacePorcessActive=false;
@@ -117,7 +124,7 @@ MainWindow::MainWindow(QWidget *parent)
                 Q_UNUSED(ok)
 
                 onLog(QString("Conveyor command finished: %1").arg(ok?"OK":"FAIL"));
-                qInfo()<<QDateTime::currentDateTime()<<"KJW"<<QString("Conveyor command finished: %1").arg(ok?"OK":"FAIL");
+                qInfo()<<"KJW"<<QString("Conveyor command finished: %1").arg(ok?"OK":"FAIL");
         /*
                 QTimer::singleShot(100, this, [this]() {
                     m_visionClient->sendWorkComplete("a", "conveyor", "forward", 0);
@@ -125,11 +132,15 @@ MainWindow::MainWindow(QWidget *parent)
         */
             });
 
+    initCommandRouter();
+
     m_split  = new QSplitter(Qt::Horizontal, this);
     m_panelA = new RobotPanel(this);
     m_panelB = new RobotPanel(this);
     m_motorPanel = new MotorPanel(this);
 
+    m_panelA->setLogModel(m_logModel);
+    m_panelB->setLogModel(m_logModel);
     m_panelA->setManager(m_mgr);
     m_panelB->setManager(m_mgr);
     m_motorPanel->setManager(m_gentryMgr);
@@ -158,6 +169,8 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    if (m_visionClient)
+        m_visionClient->saveCommandStats(QDir(QCoreApplication::applicationDirPath()).filePath("command_latency.json"));
     delete ui;
 }
 
@@ -181,7 +194,7 @@ void MainWindow::initVisionClient()
     // 로그 메시지 처리
     connect(m_visionClient, &VisionClient::lineReceived, this, [this](const QString& line){
         onLog(QString("[VC] Line received: %1").arg(line));
-        qDebug()<<QDateTime::currentDateTime()<<"VisionClient line received:"<<line;
+        qInfo()<<"VisionClient line received:"<<line;
     });
     connect(m_visionClient, &VisionClient::commandReceived, this, &MainWindow::onRobotCommand);
 
@@ -189,34 +202,13 @@ void MainWindow::initVisionClient()
 
 void MainWindow::onLog(const QString& line)
 {
-    QString html = QString("<span style='color:blue;font-weight:bold;'>[MODBUS] %1</span>").arg(line);
-    ui->plainLog->appendHtml(html);
+    onLog(line, Common::LogLevel::Info);
 }
 
 void MainWindow::onLog(const QString& line, Common::LogLevel level)
 {
-    // Debug 레벨 필터링
-    if (level == Common::LogLevel::Debug && !m_showDebugLogs)
-        return;
-
-    // QPlainTextEdit은 색상을 못 넣으니, 단순 접두어로 레벨 표기
-    QString html;
-    switch (level) {
-    case Common::LogLevel::Debug:
-        html = QString("<span style='color:gray;font-style:italic;'>[DBG] %1</span>").arg(line);
-        break;
-    case Common::LogLevel::Info:
-        html = QString("<span style='color:black;'>%1</span>").arg(line);
-        break;
-    case Common::LogLevel::Warn:
-        html = QString("<span style='color:orange;font-weight:bold;'>[WARN] %1</span>").arg(line);
-        break;
-    case Common::LogLevel::Error:
-        html = QString("<span style='color:red;font-weight:bold;text-decoration:underline;'>[ERR] %1</span>").arg(line);
-        break;
-    }
-
-    ui->plainLog->appendHtml(html);
+    // 모델 대기열에 넣기만 한다. 화면 반영은 프레임당 한 번 (LogModel)
+    m_logModel->append(level, QString(), line);
 }
 
 void MainWindow::setFsmLedColor(const QString& name)
@@ -248,6 +240,19 @@ void MainWindow::loadRobotsFromConfig()
         return;
 
     qDebug()<<"robots.json parsed";
+
+    // 비전 링크 옵션: 서버가 지원할 때만 켠다 (없으면 기존 동작 그대로, 하트비트/hello 없음)
+    const auto vision = doc.object().value("vision").toObject();
+    if (!vision.isEmpty()) {
+        m_visionClient->setHeartbeat(vision.value("heartbeat_ms").toInt(0),
+                                     vision.value("peer_timeout_ms").toInt(0));
+        m_visionClient->setBinaryProtocol(vision.value("offer_binary").toBool(false));
+        onLog(QString("[OK] Vision link: heartbeat %1 ms, peer timeout %2 ms, binary offer %3")
+                  .arg(vision.value("heartbeat_ms").toInt(0))
+                  .arg(vision.value("peer_timeout_ms").toInt(0))
+                  .arg(vision.value("offer_binary").toBool(false) ? "on" : "off"));
+    }
+
     const auto arr = doc.object().value("robots").toArray();
     for (const auto& v : arr) {
         const auto o = v.toObject();
@@ -255,10 +260,16 @@ void MainWindow::loadRobotsFromConfig()
         const QString host = o.value("host").toString();
         const int     port = o.value("port").toInt();
         const QString addr_map  = o.value("addr_map").toString();
+        if (o.contains("vision_history"))
+            m_mgr->setVisionHistory(id, o.value("vision_history").toInt());
 
         QVariantMap addr;
         QFile mf(addr_map);
-        if (mf.open(QIODevice::ReadOnly)) {
+        if (AddressMapBuiltin::lookup(addr_map, &addr)) {
+            // 출하 맵: 빌드 시 생성된 constexpr 테이블 사용 (JSON 파싱 생략)
+            qDebug()<<"Address map (built-in) for"<<addr_map;
+        }
+        else if (mf.open(QIODevice::ReadOnly)) {
             auto d = QJsonDocument::fromJson(mf.readAll());
             if (d.isObject())
             {
@@ -279,284 +290,74 @@ void MainWindow::loadRobotsFromConfig()
 
 void MainWindow::onRobotCommand(const RobotCommand& cmd)
 {
-    // dir 필터가 필요하면 여기서
-    if (cmd.dir != 1)
-        return;
-
-    switch (cmd.robot) {
-    case RobotId::A: handleRobotA(cmd); break;
-    case RobotId::B: handleRobotB(cmd); break;
-    default:
-        onLog("Unknown robot command");
-        break;
-    }
+    if (m_router)
+        m_router->route(cmd);
 }
 
-void MainWindow::handleRobotA(const RobotCommand& cmd)
+// ─────────────────────────────────────────────────────────────
+// 갠트리 훅: 명령 라우팅(ack + RobotManager)은 RobotCommandRouter 가,
+// 갠트리 상태(m_sorting* / lastPose)와 RS-485 동작은 여기서 맡는다
+// ─────────────────────────────────────────────────────────────
+void MainWindow::initCommandRouter()
 {
-    if(cmd.type == CmdType::Tool) {
-        if(cmd.kind == CmdKind::Tool_Mount) {
-            if(cmd.toolCmd.toolName=="bulk") {
-                onLog("로봇 A 벌크 툴 마운트 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "Tool Mount Bulk command received");
-                m_mgr->cmdBulk_AttachTool();
-            }
-            else if(cmd.toolCmd.toolName=="sorting") {
-                onLog("로봇 A 소팅 툴 마운트 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "Tool Mount Sorting command received");
-                m_mgr->cmdSort_AttachTool();
-            }
+    m_router = new RobotCommandRouter(m_mgr, m_visionClient, this);
+    connect(m_router, &RobotCommandRouter::log,
+            this, qOverload<const QString&, Common::LogLevel>(&MainWindow::onLog));
+
+    RobotCommandRouter::GantryHooks hooks;
+    hooks.sortPick = [this](const RobotCommand& cmd) {
+        if (cmd.flip) {
+            m_gentryMgr->startGantryMove();
+            m_gentryMgr->setFalgs(false, false, true, false, false);
+            m_gentryMgr->gentry_motion();
+            m_gantryPickupState = true;
         }
-        else if(cmd.kind == CmdKind::Tool_UnMount) {
-            if(cmd.toolCmd.toolName=="bulk") {
-                onLog("로봇 A 벌크 툴 언마운트 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "Tool UnMount Bulk command received");
-                m_mgr->cmdBulk_DettachTool();
-            }
-            else if(cmd.toolCmd.toolName=="sorting") {
-                onLog("로봇 A 소팅 툴 언마운트 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "Tool UnMount Sorting command received");
-                m_mgr->cmdSort_DettachTool();
-            }
-        }
-        else if(cmd.kind == CmdKind::Tool_Change) {
-            if(cmd.toolCmd.toolFrom=="bulk" && cmd.toolCmd.toolTo=="sorting") {
-                onLog("로봇 A 벌크→소팅 툴 체인지 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "Tool Change Bulk to Sorting command received");
-                QTimer::singleShot(100, this, [this]() {
-                    m_mgr->cmdBulk_ChangeTool();
-                });
-
-            }
-            else if(cmd.toolCmd.toolFrom=="sorting" && cmd.toolCmd.toolTo=="bulk") {
-                onLog("로봇 A 소팅→벌크 툴 체인지 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "Tool Change Sorting to Bulk command received");
-                QTimer::singleShot(100, this, [this]() {
-                    m_mgr->cmdSort_ChangeTool();
-                });
-            }
+        else if (!m_gantryPickupState) {
+            m_gentryMgr->startGantryMove();
+            m_gentryMgr->setFalgs(false, true, false, false, false);
+            m_gentryMgr->gentry_motion();
         }
-    }
-    else if(cmd.type == CmdType::Bulk) {
-        switch (cmd.kind) {
-        case CmdKind::Pick:
-            if(cmd.hasPick)
-            {
-                onLog("Robot A 벌크 픽 처리 필요, pose:"
-                       + QString("[%1,%2,%3] [%4,%5,%6]")
-                         .arg(cmd.pick.x).arg(cmd.pick.y).arg(cmd.pick.z)
-                         .arg(cmd.pick.rx).arg(cmd.pick.ry).arg(cmd.pick.rz));
-                m_visionClient->sendAck(cmd.seq, "ok", "bulk Pick command received");
-                const int mode = (cmd.mode=="single")? 2 : 0;
-
-                m_mgr->cmdBulk_DoPickup(cmd.pick, mode);
-            }
-
-            break;
-        case CmdKind::Place:
-            if(cmd.hasPlace)
-            {
-                onLog("Robot A 벌크 플레이스 처리 필요, pose:"
-                       + QString("[%1,%2,%3] [%4,%5,%6]")
-                         .arg(cmd.place.x).arg(cmd.place.y).arg(cmd.place.z)
-                         .arg(cmd.place.rx).arg(cmd.place.ry).arg(cmd.place.rz));
-                m_visionClient->sendAck(cmd.seq, "ok", "bulk Place command received");
-                const int mode = (cmd.mode=="single")? 2 : 0;
-
-                m_mgr->cmdBulk_DoPlace(cmd.place, mode);
-            }
-
-            break;
-        default:
-            break;
+        m_sortingFlip   = cmd.flip;
+        m_sortingOffset = cmd.sortOffset.height;
+        m_sortingThick  = cmd.sortOffset.thickness;
+    };
+    hooks.sortPlace = [this](const RobotCommand& cmd) {
+        m_sortingPlacePorcessActive = true;
+        m_sortingFlip   = cmd.flip;
+        m_sortingOffset = cmd.sortOffset.height;
+        m_sortingThick  = cmd.sortOffset.thickness;
+
+        if (cmd.flip) {
+            // offset: 로봇 후퇴거리/미사용
+            m_gentryMgr->startGantryMove();
+            int offset_mm = (m_sortingOffset>30)? (m_sortingOffset-30+10) : 0;
+            m_sortingShfit = m_sortingThick;
+            m_gentryMgr->doGentryPlace(m_sortingShfit, offset_mm);
         }
-    }
-    else if (cmd.type == CmdType::Sorting) {
-        switch (cmd.kind) {
-
-        case CmdKind::Ready:
-            onLog("로봇 A 소팅 레디 처리 필요\r\n");
-            m_visionClient->sendAck(cmd.seq, "ok", "sorting Ready command received");
-            m_mgr->cmdSort_MoveToPickupReady();
-            break;
-        case CmdKind::Pick:
-            if (cmd.hasPick && cmd.isOffset) {
-                // cmd.pick 사용
-                onLog(QString("로봇 A 소팅 픽 처리 필요, pose: [%1,%2,%3] [%4,%5,%6]\r\n")
-                               .arg(cmd.pick.x).arg(cmd.pick.y).arg(cmd.pick.z).arg(cmd.pick.rx).arg(cmd.pick.ry).arg(cmd.pick.rz));
-
-                if(cmd.flip) {
-                    m_gentryMgr->startGantryMove();
-                    m_gentryMgr->setFalgs(false, false, true, false, false);
-                    m_gentryMgr->gentry_motion();
-                    m_gantryPickupState = true;
-                }
-                else {
-                    if(!m_gantryPickupState)
-                    {
-                        m_gentryMgr->startGantryMove();
-                        m_gentryMgr->setFalgs(false, true, false, false, false);
-                        m_gentryMgr->gentry_motion();
-                    }
-                }
-                m_visionClient->sendAck(cmd.seq, "ok", "sorting Pick command received");
-                m_sortingFlip = cmd.flip;
-                m_sortingOffset = cmd.sortOffset.height;
-                m_sortingThick= cmd.sortOffset.thickness;
-//                m_sortingShfit = cmd.sortOffset.shift;
-
-//                Pose6D pick_pose =  cmd.pick;
-                m_mgr->cmdSort_DoPickup(cmd.pick,m_sortingFlip, m_sortingOffset, m_sortingThick);
-            }
-            break;
-        case CmdKind::Place:
-            if (cmd.flip) {
-                // offset: 로봇 후퇴거리/미사용
-                onLog("로봇 A 소팅 플립 처리 필요\r\n");
-                m_visionClient->sendAck(cmd.seq, "ok", "sorting Place Flip command received");
-////////////////////////////////////////////////////////////////
-                m_sortingPlacePorcessActive = true;
-                m_sortingFlip = true;
-                m_sortingOffset=cmd.sortOffset.height; //cmd.offset;
-                m_sortingThick=cmd.sortOffset.thickness;
-//                m_sortingShfit = cmd.sortOffset.shift;
-
-                m_gentryMgr->startGantryMove();
-                int offset_mm = (m_sortingOffset>30)? (m_sortingOffset-30+10) : 0;
-                m_sortingShfit=m_sortingThick;
-
-                m_gentryMgr->doGentryPlace(m_sortingShfit, offset_mm);
-////////////////////////////////////////////////////////////////
-            } else {
-                // offset: 겐트리와 컨베어간의 높이차이 -> Z축 환산필요
-                onLog(QString("로봇 A 소팅 논플립 처리 필요, offset: %1\r\n")
-                               .arg(cmd.offset));
-                m_visionClient->sendAck(cmd.seq, "ok", "sorting Place Non-Flip command received");
-//                m_mgr->cmdSort_DoPlace(cmd.flip, cmd.offset);
-////////////////////////////////////////////////////////////////
-                m_sortingPlacePorcessActive = true;
-                m_sortingFlip =false;
-                m_sortingOffset=cmd.sortOffset.height;//cmd.offset;
-                m_sortingThick=cmd.sortOffset.thickness;
-//                m_sortingShfit = cmd.sortOffset.shift;
-                if(lastPose==GantryPose::Standby)
-                {
-                    //TODO robot->place
-                    qDebug()<<"Robot place without flip"<<gantryPoseToString(lastPose);
-                    m_mgr->cmdSort_DoPlace(false, m_sortingOffset, m_sortingThick);
-                }
-                else
-                {
-                    m_gentryMgr->startGantryMove();
-                    m_gentryMgr->setFalgs(false, true, false, false, false);
-                    m_gentryMgr->gentry_motion();
-
-                    QTimer::singleShot(500, this, [this]() {
-                        m_gentryMgr->requestGentryPose();
-                    });
-                }
-////////////////////////////////////////////////////////////////
-            }
-            break;
-
-        case CmdKind::Arrange: {
-            if(cmd.isArrange)
-            {
-/*
-                onLog("로봇 A 소팅 어레인지 처리 필요, poseOrig:"
-                       + QString("[%1,%2,%3] [%4,%5,%6]")
-                         .arg(cmd.arrangeCmd.poseOrig.x).arg(cmd.arrangeCmd.poseOrig.y).arg(cmd.arrangeCmd.poseOrig.z)
-                         .arg(cmd.arrangeCmd.poseOrig.rx).arg(cmd.arrangeCmd.poseOrig.ry).arg(cmd.arrangeCmd.poseOrig.rz)
-                       + QString(" -> poseDest:")
-                       + QString("[%1,%2,%3] [%4,%5,%6]")
-                         .arg(cmd.arrangeCmd.poseDest.x).arg(cmd.arrangeCmd.poseDest.y).arg(cmd.arrangeCmd.poseDest.z)
-                         .arg(cmd.arrangeCmd.poseDest.rx).arg(cmd.arrangeCmd.poseDest.ry).arg(cmd.arrangeCmd.poseDest.rz));
-                m_visionClient->sendAck(cmd.seq, "ok", "sorting Arrange command received");
-*/
-                m_mgr->cmdSort_Arrange(cmd.arrangeCmd.poseOrig, cmd.arrangeCmd.poseDest);
-
-            }
-        } break;
-        default:
-            break;
+        else if (lastPose == GantryPose::Standby) {
+            // offset: 겐트리와 컨베어간의 높이차이 -> Z축 환산필요
+            qDebug()<<"Robot place without flip"<<gantryPoseToString(lastPose);
+            m_mgr->cmdSort_DoPlace(false, m_sortingOffset, m_sortingThick);
         }
-    } else if (cmd.type == CmdType::Conveyor) {
-        if (cmd.kind == CmdKind::Forward) {
-            onLog("로봇 A 컨베이어 포워드 처리 필요\r\n");
-            qInfo()<<QDateTime::currentDateTime()<<"KJW"<<"Robot A Conveyor Forward command received";
-
-            m_visionClient->sendAck(cmd.seq, "ok", "conveyor Forward command received");
-            QTimer::singleShot(1000, this, [this]{
-                m_gentryMgr->startConveyorMove();
-                m_gentryMgr->doConveyorForwardOneStep();
-//                m_gentryMgr->setFalgs(true, false, false, false, false);
-//                m_gentryMgr->gentry_motion();
+        else {
+            // 대기 위치로 보낸 뒤 gantryCommandFinished(Standby) 에서 로봇 플레이스
+            m_gentryMgr->startGantryMove();
+            m_gentryMgr->setFalgs(false, true, false, false, false);
+            m_gentryMgr->gentry_motion();
+
+            QTimer::singleShot(500, this, [this]() {
+                m_gentryMgr->requestGentryPose();
             });
         }
-    }
-}
-
-void MainWindow::handleRobotB(const RobotCommand& cmd)
-{
-    if (cmd.type != CmdType::Align)
-        return;
-
-    switch (cmd.kind) {
-    case CmdKind::Init:  // TODO: 초기화 명령 처리
-        onLog("로봇 B 얼라인 이닛 처리 필요\r\n");
-        m_visionClient->sendAck(cmd.seq, "ok", "align Init command received");
-        m_mgr->cmdAlign_Initialize();
-
-        break;
-    case CmdKind::Assy:  // TODO: 어셈블리 명령 처리
-        onLog("로봇 B 얼라인 어셈블리 처리 필요\r\n");
-        m_visionClient->sendAck(cmd.seq, "ok", "align Assy command received");
-        m_mgr->cmdAlign_MoveToAssyReady();
-        break;
-    case CmdKind::Ready: // TODO: 레디 명령 처리
-        onLog("로봇 B 얼라인 레디 처리 필요\r\n");
-        m_visionClient->sendAck(cmd.seq, "ok", "align Ready command received");
-        m_mgr->cmdAlign_MoveToPickupReady();
-        break;
-    case CmdKind::Pick:  // TODO: 픽 명령 처리
-        if (cmd.hasPick) {
-            // cmd.pick 사용
-            onLog(QString("로봇 B 얼라인 픽 처리 필요, pose: [%1,%2,%3] [%4,%5,%6]\r\n")
-                           .arg(cmd.pick.x).arg(cmd.pick.y).arg(cmd.pick.z).arg(cmd.pick.rx).arg(cmd.pick.ry).arg(cmd.pick.rz));
-            m_visionClient->sendAck(cmd.seq, "ok", "align Pick command received");
-            m_mgr->cmdAlign_DoPickup(cmd.pick);
-        }
-        break;
-    case CmdKind::Place: // TODO: 플레이스 명령 처리
-        if (cmd.hasPlace) {
-            // cmd.place 사용
-            onLog(QString("로봇 B 얼라인 플레이스 처리 필요, pose: [%1,%2,%3] [%4,%5,%6]\r\n")
-                           .arg(cmd.place.x).arg(cmd.place.y).arg(cmd.place.z).arg(cmd.place.rx).arg(cmd.place.ry).arg(cmd.place.rz));
-            int sequenceType = cmd.clampSequenceMode;
-            m_visionClient->sendAck(cmd.seq, "ok", "align Place command received");
-            m_mgr->cmdAlign_DoPlace(cmd.place,sequenceType);
-        }
-        break;
-    case CmdKind::Clamp: // 2025-12-11: desperate!
-        if (cmd.clamp == "open") {
-            onLog("로봇 B 클램프 오픈 처리 필요\r\n");
-            qDebug()<<"25-11-24: Robot B Clamp Open command received";
-            m_visionClient->sendAck(cmd.seq, "ok", "align Clamp Open command received");
-            m_mgr->cmdAlign_Clamp(false);
-        } else if (cmd.clamp == "close") {
-            onLog("로봇 B 클램프 클로즈 처리 필요\r\n");
-            m_visionClient->sendAck(cmd.seq, "ok", "align Clamp Close command received");
-            m_mgr->cmdAlign_Clamp(true);
-        }
-        break;
-    case CmdKind::Scrap: // 2025-12-11: desperate!
-        onLog("로봇 B 스크랩 처리 필요\r\n");
-        m_visionClient->sendAck(cmd.seq, "ok", "align Scrap command received");
-        m_mgr->cmdAlign_Scrap();
-        break;
-    default:
-        break;
-    }
+    };
+    hooks.conveyorForward = [this] {
+        qInfo()<<"KJW"<<"Robot A Conveyor Forward command received";
+        QTimer::singleShot(1000, this, [this]{
+            m_gentryMgr->startConveyorMove();
+            m_gentryMgr->doConveyorForwardOneStep();
+        });
+    };
+    m_router->setGantryHooks(hooks);
 }
 
 void MainWindow::on_btnConnect_clicked()
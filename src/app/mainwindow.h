@@ -9,10 +9,12 @@
 
 class RobotManager;
 class GentryManager;
+class RobotCommandRouter;
 class QLabel;
 class QFrame;
-class QCheckBox;
 class RobotPanel;
+class LogModel;
+class LogView;
 class MotorPanel;
 class QSplitter;
 
@@ -33,9 +35,7 @@ public:
     void initVisionClient();
 
 private:
-    void handleRobotA(const RobotCommand& cmd);
-    void handleRobotB(const RobotCommand& cmd);
-
+    void initCommandRouter();
 
 private slots:
     void onLog(const QString& line);
@@ -75,12 +75,13 @@ private:
     QLabel* m_fsmLabel{nullptr};
     QFrame* m_fsmLed{nullptr};
 
-    QCheckBox* m_chkShowDebug{nullptr};
-    bool m_showDebugLogs{false};
+    LogModel* m_logModel{nullptr};   // 전체/패널 로그창이 공유하는 링 버퍼
+    LogView*  m_logView{nullptr};
 
     void setFsmLedColor(const QString& name);
 
     VisionClient* m_visionClient{nullptr};
+    RobotCommandRouter* m_router{nullptr};   // 비전 명령 → RobotManager (갠트리는 훅)
 
     bool m_sortingPlacePorcessActive{false};
     bool m_sortingFlip{false};
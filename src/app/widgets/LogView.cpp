@@ -0,0 +1,164 @@
+#include "LogView.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QListView>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
+#include <QFontDatabase>
+#include <algorithm>
+
+LogView::LogView(QWidget* parent) : QWidget(parent)
+{
+    m_filter = new LogFilterModel(this);
+
+    m_list = new QListView(this);
+    m_list->setModel(m_filter);
+    m_list->setUniformItemSizes(true);      // 행 높이 계산 생략 → 보이는 행만 그림
+    m_list->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_list->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_list->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    m_list->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    m_cmbLevel = new QComboBox(this);
+    m_cmbLevel->addItem("Debug", int(Common::LogLevel::Debug));
+    m_cmbLevel->addItem("Info",  int(Common::LogLevel::Info));
+    m_cmbLevel->addItem("Warn",  int(Common::LogLevel::Warn));
+    m_cmbLevel->addItem("Error", int(Common::LogLevel::Error));
+    m_cmbLevel->setCurrentIndex(1);
+
+    m_cmbSource = new QComboBox(this);
+    m_cmbSource->addItem("All", -1);
+    m_cmbSource->addItem("System", 0);
+
+    m_chkFollow = new QCheckBox("Follow", this);
+    m_chkFollow->setChecked(true);
+    m_btnClear  = new QPushButton("Clear", this);
+    m_lblCount  = new QLabel(this);
+
+    auto* row = new QHBoxLayout;
+    row->addWidget(new QLabel("Level:", this));
+    row->addWidget(m_cmbLevel);
+    row->addWidget(m_cmbSource);
+    row->addWidget(m_chkFollow);
+    row->addWidget(m_btnClear);
+    row->addStretch();
+    row->addWidget(m_lblCount);
+
+    auto* lay = new QVBoxLayout(this);
+    lay->setContentsMargins(0, 0, 0, 0);
+    lay->addLayout(row);
+    lay->addWidget(m_list);
+    setLayout(lay);
+
+    auto* copy = new QAction(this);
+    copy->setShortcut(QKeySequence::Copy);
+    copy->setShortcutContext(Qt::WidgetShortcut);
+    m_list->addAction(copy);
+    connect(copy, &QAction::triggered, this, &LogView::copySelection);
+
+    connect(m_cmbLevel, qOverload<int>(&QComboBox::currentIndexChanged), this, [this](int){
+        m_filter->setMinLevel(Common::LogLevel(m_cmbLevel->currentData().toInt()));
+        updateCount();
+    });
+    connect(m_cmbSource, qOverload<int>(&QComboBox::currentIndexChanged), this, [this](int){
+        if (m_fixedSource.isEmpty())
+            m_filter->setSource(m_cmbSource->currentData().toInt());
+        updateCount();
+    });
+    connect(m_chkFollow, &QCheckBox::toggled, this, [this](bool on){
+        if (on) m_list->scrollToBottom();
+    });
+    connect(m_btnClear, &QPushButton::clicked, this, [this]{
+        m_filter->clearView();
+        updateCount();
+    });
+
+    // 모델은 프레임당 한 번만 행을 넣으므로 스크롤/카운트 갱신도 프레임당 한 번
+    connect(m_filter, &QAbstractItemModel::rowsInserted, this, &LogView::onRowsInserted);
+    connect(m_filter, &QAbstractItemModel::rowsRemoved,  this, &LogView::updateCount);
+    connect(m_filter, &QAbstractItemModel::modelReset,   this, &LogView::updateCount);
+    updateCount();
+}
+
+void LogView::setLogModel(LogModel* model)
+{
+    if (m_model == model) return;
+    if (m_model) disconnect(m_model, nullptr, this, nullptr);
+    m_model = model;
+    m_filter->setLogModel(model);
+    if (!m_model) return;
+
+    connect(m_model, &LogModel::sourcesChanged, this, &LogView::onSourcesChanged);
+    connect(m_model, &LogModel::droppedChanged, this, &LogView::updateCount);
+    if (!m_fixedSource.isEmpty())
+        m_filter->setSource(m_model->sourceIndex(m_fixedSource));
+    onSourcesChanged();
+    updateCount();
+}
+
+void LogView::setFixedSource(const QString& source)
+{
+    m_fixedSource = source;
+    m_cmbSource->setVisible(source.isEmpty());
+    if (!m_model) return;
+    m_filter->setSource(source.isEmpty() ? m_cmbSource->currentData().toInt()
+                                         : m_model->sourceIndex(source));
+    updateCount();
+}
+
+void LogView::setMinLevel(Common::LogLevel level)
+{
+    const int i = m_cmbLevel->findData(int(level));
+    if (i >= 0) m_cmbLevel->setCurrentIndex(i);
+}
+
+void LogView::onRowsInserted()
+{
+    if (m_chkFollow->isChecked())
+        m_list->scrollToBottom();
+    updateCount();
+}
+
+void LogView::onSourcesChanged()
+{
+    if (!m_model) return;
+    const int current = m_cmbSource->currentData().toInt();
+    const QStringList& src = m_model->sources();
+
+    QSignalBlocker block(m_cmbSource);
+    while (m_cmbSource->count() > 2)
+        m_cmbSource->removeItem(2);
+    for (int i = 1; i < src.size(); ++i)
+        m_cmbSource->addItem(src.at(i), i);
+    const int idx = m_cmbSource->findData(current);
+    m_cmbSource->setCurrentIndex(idx >= 0 ? idx : 0);
+}
+
+void LogView::updateCount()
+{
+    QString text = QString("%1 lines").arg(m_filter->rowCount());
+    if (m_model && m_model->dropped() > 0)
+        text += QString(" (%1 dropped)").arg(m_model->dropped());
+    m_lblCount->setText(text);
+}
+
+void LogView::copySelection()
+{
+    if (!m_model) return;
+    QList<int> rows;
+    const QModelIndexList sel = m_list->selectionModel()->selectedIndexes();
+    for (const QModelIndex& i : sel)
+        rows << m_filter->mapToSource(i).row();
+    std::sort(rows.begin(), rows.end());
+
+    QStringList lines;
+    for (int r : rows)
+        if (r >= 0) lines << m_model->lineText(r);
+    if (!lines.isEmpty())
+        QApplication::clipboard()->setText(lines.join('\n'));
+}
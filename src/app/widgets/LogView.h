@@ -0,0 +1,44 @@
+#pragma once
+#include <QWidget>
+#include <QPointer>
+#include "LogModel.h"
+
+class QListView;
+class QComboBox;
+class QCheckBox;
+class QPushButton;
+class QLabel;
+
+// ─────────────────────────────────────────────────────────────
+// 로그 뷰: LogModel(공유 링 버퍼) 위에 뷰별 필터를 얹은 가상 리스트
+//  - 보이는 행만 그린다 (uniformItemSizes). 줄 수와 무관하게 그리기 비용 일정.
+//  - 레벨/출처 필터, Follow(맨 아래 따라가기), Clear(이 뷰에서만 지움), Ctrl+C 복사.
+//  - setFixedSource(): 로봇 패널처럼 출처 하나만 보는 뷰 (출처 콤보 숨김)
+// ─────────────────────────────────────────────────────────────
+class LogView : public QWidget {
+    Q_OBJECT
+public:
+    explicit LogView(QWidget* parent=nullptr);
+
+    void setLogModel(LogModel* model);
+    void setFixedSource(const QString& source);     // "" 이면 고정 해제
+    void setMinLevel(Common::LogLevel level);
+
+private slots:
+    void onRowsInserted();
+    void onSourcesChanged();
+    void updateCount();
+    void copySelection();
+
+private:
+    QPointer<LogModel> m_model;
+    LogFilterModel* m_filter = nullptr;
+    QString m_fixedSource;
+
+    QListView*   m_list = nullptr;
+    QComboBox*   m_cmbLevel = nullptr;
+    QComboBox*   m_cmbSource = nullptr;
+    QCheckBox*   m_chkFollow = nullptr;
+    QPushButton* m_btnClear = nullptr;
+    QLabel*      m_lblCount = nullptr;
+};
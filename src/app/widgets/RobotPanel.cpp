@@ -7,10 +7,10 @@
 #include <QLabel>
 #include <QAbstractItemView>
 #include <QHeaderView>
-#include <QPlainTextEdit>
 #include <QFileDialog>
 
 #include "RobotManager.h"
+#include "LogView.h"
 
 static QLabel* makeLed(QWidget* parent) {
     auto* led = new QLabel(parent);
@@ -32,18 +32,19 @@ RobotPanel::RobotPanel(QWidget* parent) : QWidget(parent)
     m_btnStop       = new QPushButton("Stop", this);
     m_btnLoadCsv    = new QPushButton("Load CSV", this);
     m_btnClear      = new QPushButton("Clear", this);
+    m_btnDump       = new QPushButton("Dump", this);
+    m_btnDump->setToolTip("Save the last seconds of bus/DI/FSM/vision events to a .mrct file");
     m_chkRepeat     = new QCheckBox("Repeat targets", this);
     m_led           = makeLed(this);
     m_chkVisionMode = new QCheckBox("Vision", this);
 
-    m_logView = new QPlainTextEdit(this);   // ★
-    m_logView->setReadOnly(true);
-    m_logView->setMaximumBlockCount(2000);  // 메모리 제한 (필요시)
+    m_logView = new LogView(this);          // ★ 줄 수 제한은 공유 LogModel 이 한다
 
     auto* row1 = new QHBoxLayout;
     row1->addWidget(m_btnConnect);
     row1->addWidget(m_btnDisconnect);
     row1->addStretch();
+    row1->addWidget(m_btnDump);
     row1->addWidget(new QLabel("Conn:", this));
     row1->addWidget(m_led);
 
@@ -73,6 +74,7 @@ RobotPanel::RobotPanel(QWidget* parent) : QWidget(parent)
 
     connect(m_btnLoadCsv,    &QPushButton::clicked, this, &RobotPanel::onLoadCsv); // ★
     connect(m_btnClear,      &QPushButton::clicked, this, &RobotPanel::onClear);   // ★
+    connect(m_btnDump,       &QPushButton::clicked, this, &RobotPanel::onDumpFlight);
 
     // ✅ 비전 모드 토글 → 매니저로 반영
     connect(m_chkVisionMode, &QCheckBox::toggled, this, [this](bool on){
@@ -93,6 +95,12 @@ void RobotPanel::setManager(RobotManager* mgr)
             [this](const QString& rid, bool ok){
                 if (rid == m_id) onHeartbeat(ok);
             });
+    connect(m_mgr, &RobotManager::csvLoaded, this,
+            [this](const QString& rid, bool ok, int /*rows*/, const QString& msg){
+                if (rid != m_id) return;
+                appendLog(ok ? QString("CSV loaded: %1").arg(msg) : QString("CSV load failed: %1").arg(msg),
+                          ok ? Common::LogLevel::Info : Common::LogLevel::Error);
+            });
 #if false
     connect(m_mgr, &RobotManager::currentRowChanged, this,
             [this](const QString& /*id*/, int row){
@@ -114,21 +122,24 @@ void RobotPanel::setManager(RobotManager* mgr)
                 if (rid == m_id) onHeartbeat(up);
             });
 
-    connect(m_mgr, &RobotManager::logByRobot, this,
-            [this](const QString& rid, const QString& line, Common::LogLevel lv){
-                if (rid == m_id) appendLog(line, lv);
-            });
-
     if (!m_id.isEmpty())
         onHeartbeat(m_mgr->isConnected(m_id));
 
     bindModel();
 }
 
+void RobotPanel::setLogModel(LogModel* model)
+{
+    m_logModel = model;
+    m_logView->setLogModel(model);
+    m_logView->setFixedSource(m_id);
+}
+
 void RobotPanel::setRobotId(const QString& id)
 {
     if (m_id == id) return;
     m_id = id;
+    m_logView->setFixedSource(m_id);
     bindModel();
     if (m_mgr)
         onHeartbeat(m_mgr->isConnected(m_id));  // 즉시 LED 동기화
@@ -153,18 +164,8 @@ void RobotPanel::bindModel()
 
 void RobotPanel::appendLog(const QString& line, Common::LogLevel lv)
 {
-    QString prefix;
-    switch (lv) {
-    case Common::LogLevel::Warn:  prefix = "[WARN] ";
-        break;
-    case Common::LogLevel::Error: prefix = "[ERR] ";
-        break;
-    case Common::LogLevel::Debug: prefix = "[DBG] ";
-        break;
-    default:
-        break;
-    }
-    m_logView->appendPlainText(prefix + line);
+    // logByRobot 는 MainWindow 가 모델에 넣는다. 여기선 패널 자체 메시지만
+    if (m_logModel) m_logModel->append(lv, m_id, line);
 }
 
 void RobotPanel::onConnect()
@@ -216,12 +217,12 @@ void RobotPanel::onHeartbeat(bool ok)
 void RobotPanel::onLoadCsv()
 {
     if (!m_mgr || m_id.isEmpty()) return;
-    QString path = QFileDialog::getOpenFileName(this, "Load pose CSV", QString(),
-                                                "CSV/TXT (*.csv *.txt);;All (*.*)");
+    QString path = QFileDialog::getOpenFileName(this, "Load pose file", QString(),
+                                                "Poses (*.csv *.txt *.mrcp);;Binary (*.mrcp);;All (*.*)");
     if (path.isEmpty()) return;
-    QString err;
-    if (!m_mgr->loadCsvToModel(m_id, path, &err)) {
-        appendLog(QString("CSV load failed: %1").arg(err), Common::LogLevel::Error);
+    // .mrcp 는 mmap 으로 바로 연결, CSV 는 UI 를 막지 않도록 비동기 로드 (행은 파싱되는 대로 추가됨)
+    if (!m_mgr->loadPoseFile(m_id, path)) {
+        appendLog("CSV load already running", Common::LogLevel::Warn);
         return;
     }
     bindModel(); // 새 모델 데이터 반영
@@ -232,3 +233,9 @@ void RobotPanel::onClear()
     if (!m_mgr || m_id.isEmpty()) return;
     m_mgr->clearPoseList(m_id);
 }
+
+void RobotPanel::onDumpFlight()
+{
+    if (!m_mgr || m_id.isEmpty()) return;
+    m_mgr->dumpFlightRecorder(m_id, "operator");   // 결과는 logByRobot 으로 이 패널에 표시
+}
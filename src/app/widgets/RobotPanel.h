@@ -7,7 +7,8 @@ class QTableView;
 class QPushButton;
 class QCheckBox;
 class QLabel;
-class QPlainTextEdit;
+class LogView;
+class LogModel;
 class RobotManager;
 
 class RobotPanel : public QWidget {
@@ -16,6 +17,7 @@ public:
     explicit RobotPanel(QWidget* parent=nullptr);
 
     void setManager(RobotManager* mgr);
+    void setLogModel(LogModel* model);    // 전체 로그와 공유, 이 패널 로봇만 표시
     void setRobotId(const QString& id);   // "A" / "B" 등
     void setEndpoint(const QString& host, int port, const QVariantMap& addr);
 
@@ -29,6 +31,7 @@ private slots:
 
     void onLoadCsv();      // ★ CSV 로드
     void onClear();        // ★ 리스트 지우기
+    void onDumpFlight();   // 플라이트 레코더 덤프 (운영자 요청)
 
 private:
     void bindModel(); // RobotManager의 모델을 TableView에 바인딩
@@ -47,13 +50,15 @@ private:
 
     QPushButton* m_btnLoadCsv = nullptr;
     QPushButton* m_btnClear   = nullptr;
+    QPushButton* m_btnDump    = nullptr;
 
     QPushButton* m_btnDisconnect = nullptr;
     QPushButton* m_btnStart = nullptr;
     QPushButton* m_btnStop = nullptr;
     QCheckBox*   m_chkRepeat = nullptr;
     QLabel*      m_led = nullptr;   // 연결 상태 LED
-    QPlainTextEdit* m_logView = nullptr;   // ★ 패널용 로그창
+    LogView*     m_logView = nullptr;   // ★ 패널용 로그창 (출처 = m_id)
+    QPointer<LogModel> m_logModel;
 
     QCheckBox*   m_chkVisionMode = nullptr;
 };
@@ -4,6 +4,9 @@
 //#include <QModbusRtuSerialMaster>
 #include <QModbusRtuSerialClient>
 #include <QDebug>
+
+#include "common/LogCategories.h"
+#include "common/MonoClock.h"
 namespace Com
 {
     Modbus::Modbus(QObject *parent)
@@ -14,12 +17,12 @@ namespace Com
         modbusDevice_ = new QModbusRtuSerialClient(this);
         if (!modbusDevice_)
         {
-            qDebug()<<QString("Could not create Modbus master.");
+            qCWarning(lcModbus)<<QString("Could not create Modbus master.");
         }
         else
         {
-            qDebug()<<QString("Create Modbus master.");
-            qDebug()<<"state: "<<modbusDevice_->state();
+            qCDebug(lcModbus)<<QString("Create Modbus master.");
+            qCDebug(lcModbus)<<"state: "<<modbusDevice_->state();
 
 
             connect(modbusDevice_, &QModbusClient::errorOccurred, this, &Modbus::onModbusErrorOccurred);
@@ -51,11 +54,11 @@ namespace Com
 
         if (!modbusDevice_->connectDevice())
         {
-            qDebug()<<"connect: fail!!";
+            qCWarning(lcModbus)<<"connect: fail!!";
         }
         else
         {
-            qDebug()<<"connect: succed!!";
+            qCDebug(lcModbus)<<"connect: succed!!";
         }
     }
 
@@ -80,11 +83,11 @@ namespace Com
                 connect(reply, &QModbusReply::finished, this, [this, reply]() {
                     if (reply->error() == QModbusDevice::ProtocolError)
                     {
-                        qDebug()<<(tr("Write response error: %1 (Mobus exception: 0x%2)").arg(reply->errorString()).arg(reply->rawResult().exceptionCode(), -1, 16));
+                        qCWarning(lcModbus)<<(tr("Write response error: %1 (Mobus exception: 0x%2)").arg(reply->errorString()).arg(reply->rawResult().exceptionCode(), -1, 16));
                     }
                     else if (reply->error() != QModbusDevice::NoError)
                     {
-                        qDebug()<<(tr("Write response error: %1 (code: 0x%2)").arg(reply->errorString()).arg(reply->error(), -1, 16));
+                        qCWarning(lcModbus)<<(tr("Write response error: %1 (code: 0x%2)").arg(reply->errorString()).arg(reply->error(), -1, 16));
                     }
                     reply->deleteLater();
                 });
@@ -95,7 +98,7 @@ namespace Com
                 reply->deleteLater();
             }
         } else {
-            qDebug()<<(QString("Write error: ")+ modbusDevice_->errorString());
+            qCWarning(lcModbus)<<(QString("Write error: ")+ modbusDevice_->errorString());
         }
 #else
         enqueueWrite(writeUnit, serverAddress);
@@ -119,7 +122,7 @@ namespace Com
             }
         } else
         {
-            qDebug() << "읽기 요청 실패:" << modbusDevice_->errorString();
+            qCWarning(lcModbus) << "읽기 요청 실패:" << modbusDevice_->errorString();
         }
 #else
         enqueueRead(readUnit, serverAddress);
@@ -160,7 +163,7 @@ namespace Com
         QModbusReply* reply = nullptr;
 
         // ✅ RTT 측정 시작
-        rttTimer_.restart();
+        rttT0Ns_ = MonoClock::nowNs();
 
         if (currentReq_.type == ReqType::Read) {
             reply = modbusDevice_->sendReadRequest(currentReq_.unit, currentReq_.serverAddress);
@@ -169,7 +172,7 @@ namespace Com
         }
 
         if (!reply) {
-            qDebug() << "Modbus request failed:" << modbusDevice_->errorString();
+            qCWarning(lcModbus) << "Modbus request failed:" << modbusDevice_->errorString();
             // 실패해도 다음 요청 진행
             inflight_ = false;
             kick();
@@ -193,18 +196,18 @@ namespace Com
         // sender()가 nullptr인 경우(즉시 종료) 대비
         if (!reply) reply = currentReply_.data();
 
-        const qint64 rttMs = rttTimer_.elapsed();
+        const qint64 rttMs = (MonoClock::nowNs() - rttT0Ns_) / 1000000;
         if (reply) {
             if (reply->error() == QModbusDevice::NoError) {
                 // ✅ RTT 로그
 #if false
-                qDebug().noquote()
+                qCDebug(lcModbus).noquote()
                     << QString("[RTT] %1 addr=0x%2 id=%3 rtt=%4 ms")
                            .arg(currentReq_.type == ReqType::Read ? "READ " : "WRITE")
                            .arg(currentReq_.unit.startAddress(), 4, 16, QLatin1Char('0'))
                            .arg(currentReq_.serverAddress)
                            .arg(rttMs);
-                qDebug()<<queue_.size()<<"requests pending.";
+                qCDebug(lcModbus)<<queue_.size()<<"requests pending.";
 #endif
                 // Read면 result()가 의미 있고, Write도 unit 정보는 currentReq_로 알 수 있음
                 if (currentReq_.type == ReqType::Read) {
@@ -212,10 +215,10 @@ namespace Com
                     emit readData(currentReq_.serverAddress, unit.startAddress(), unit.values());
                 }
             } else if (reply->error() == QModbusDevice::ProtocolError) {
-                qDebug() << "Modbus ProtocolError:" << reply->errorString()
+                qCWarning(lcModbus) << "Modbus ProtocolError:" << reply->errorString()
                 << " exception:" << Qt::hex << reply->rawResult().exceptionCode();
             } else {
-                qDebug() << "Modbus error:" << reply->error() << reply->errorString();
+                qCWarning(lcModbus) << "Modbus error:" << reply->error() << reply->errorString();
             }
 
             reply->deleteLater();
@@ -242,7 +245,7 @@ namespace Com
         QModbusDevice::UnknownError         8	An unknown error occurred.
         **/
 
-        qDebug()<<modbusDevice_->errorString();
+        qCWarning(lcModbus)<<modbusDevice_->errorString();
         emit errorState(error);
 #if false
         switch(error)
@@ -278,7 +281,7 @@ namespace Com
         QModbusDevice::ClosingState	    3	The device is being closed.
         **/
         isConnect = (state != QModbusDevice::UnconnectedState);
-        qDebug()<<"comState: "<<state;
+        qCDebug(lcModbus)<<"comState: "<<state;
 
         // 연결이 끊기면 큐/인플라이트 정리
         if (state == QModbusDevice::UnconnectedState || state == QModbusDevice::ClosingState) {
@@ -306,11 +309,11 @@ namespace Com
         }
         else if (reply->error() == QModbusDevice::ProtocolError)
         {
-            qDebug()<<(tr("Read response error: %1 (Mobus exception: 0x%2)").arg(reply->errorString()).arg(reply->rawResult().exceptionCode(), -1, 16));
+            qCWarning(lcModbus)<<(tr("Read response error: %1 (Mobus exception: 0x%2)").arg(reply->errorString()).arg(reply->rawResult().exceptionCode(), -1, 16));
         }
         else
         {
-            qDebug()<<(tr("Read response error: %1 (code: 0x%2)").arg(reply->errorString()).arg(reply->error(), -1, 16));
+            qCWarning(lcModbus)<<(tr("Read response error: %1 (code: 0x%2)").arg(reply->errorString()).arg(reply->error(), -1, 16));
         }
         reply->deleteLater();
     }
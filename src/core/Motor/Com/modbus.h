@@ -6,7 +6,6 @@
 #include <QModbusDataUnit>
 #include <QQueue>
 #include <QPointer>
-#include <QElapsedTimer>
 #include "serialport.h"
 
 QT_BEGIN_NAMESPACE
@@ -72,7 +71,7 @@ namespace Com {
         pendingRequest currentReq_;
         QQueue<pendingRequest> queue_;
 
-        QElapsedTimer rttTimer_;
+        qint64 rttT0Ns_ = 0;           // MonoClock::nowNs() at send
     };
 }
 
@@ -8,6 +8,7 @@
 #include "modbus.h"
 #include "serialport.h"
 #include "common/convert.h"
+#include "common/LogCategories.h"
 
 namespace Leadshine
 {
@@ -264,7 +265,7 @@ namespace Leadshine
 
     void Eld2Conveyor::reqWriteLimit(const int &id, const int &dir)
     {
-        qDebug()<<id<<dir;
+        qCDebug(lcGantry)<<id<<dir;
 //        QModbusDataUnit limitData(QModbusDataUnit::HoldingRegisters, 0x0405, 1);
     }
 
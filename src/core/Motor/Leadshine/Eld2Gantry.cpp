@@ -9,6 +9,8 @@
 #include "modbus.h"
 #include "serialport.h"
 #include "common/convert.h"
+#include "common/LogCategories.h"
+#include "common/EventTrace.h"
 
 namespace Leadshine
 {
@@ -228,6 +230,7 @@ namespace Leadshine
         // 1) runtime에 목표 입력 + moving 플래그 ON
         runtime_[id].targetPos = pos;
         runtime_[id].moving    = true;
+        if (EventTrace::enabled()) EventTrace::gantryMove(id, pos, false);
 
         QModbusDataUnit posData(QModbusDataUnit::HoldingRegisters, 0x6200, 8);
         posData.setValues(QVector<uint16_t>(send_buffer,send_buffer+8));
@@ -256,6 +259,7 @@ namespace Leadshine
 
         runtime_[id].targetPos = runtime_[id].lastPos+pos;
         runtime_[id].moving    = true;
+        if (EventTrace::enabled()) EventTrace::gantryMove(id, pos, true);
 
         QModbusDataUnit posData(QModbusDataUnit::HoldingRegisters, 0x6200, 8);
         posData.setValues(QVector<uint16_t>(send_buffer,send_buffer+8));
@@ -264,7 +268,7 @@ namespace Leadshine
 
     void Eld2Gantry::reqWriteLimit(const int &id, const int &dir)
     {
-        qDebug()<<id<<dir;
+        qCDebug(lcGantry)<<id<<dir;
 //        QModbusDataUnit limitData(QModbusDataUnit::HoldingRegisters, 0x0405, 1);
     }
 /*
@@ -342,8 +346,9 @@ namespace Leadshine
             if(inPosition)
             {
                 if (isMotionDone(id)) {
-                    qDebug()<<QDateTime::currentDateTime()<<QString("%1번 모터 이동 완료: 목표 %2 pulse").arg(id).arg(runtime_[id].targetPos);
+                    qCInfo(lcGantry) <<QString("%1번 모터 이동 완료: 목표 %2 pulse").arg(id).arg(runtime_[id].targetPos);
                     runtime_[id].moving = false;
+                    if (EventTrace::enabled()) EventTrace::gantryDone(id, runtime_[id].targetPos);
                     emit motionFinished(id, runtime_[id].targetPos);   // 새 signal
                 }
             }
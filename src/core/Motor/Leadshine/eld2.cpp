@@ -8,6 +8,7 @@
 #include "modbus.h"
 #include "serialport.h"
 #include "common/convert.h"
+#include "common/LogCategories.h"
 
 namespace Leadshine
 {
@@ -365,7 +366,7 @@ namespace Leadshine
 
     void ELD2::reqWriteLimit(const int &id, const int &dir)
     {
-        qDebug()<<id<<dir;
+        qCDebug(lcGantry)<<id<<dir;
 //        QModbusDataUnit limitData(QModbusDataUnit::HoldingRegisters, 0x0405, 1);
     }
 /*
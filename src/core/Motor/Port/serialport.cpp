@@ -1,6 +1,8 @@
 #include "serialport.h"
 
 #include <QDebug>
+
+#include "common/LogCategories.h"
 #define port_debug false
 namespace Serial
 {
@@ -44,7 +46,7 @@ namespace Serial
         for (const QSerialPortInfo &portInfo : serialPortInfos)
         {
 
-            qDebug() << "\n"
+            qCDebug(lcModbus) << "\n"
                      << "Port:" << portInfo.portName() << "\n"
                      << "Location:" << portInfo.systemLocation() << "\n"
                      << "Description:" << portInfo.description() << "\n"
@@ -0,0 +1,32 @@
+#include "AddressMapBuiltin.h"
+
+#include "AddressMapGenerated.h"
+
+namespace {
+
+QVariantMap toSpaceMap(const AddressMapGen::Entry* e, int n)
+{
+    QVariantMap m;
+    for (int i = 0; i < n; ++i)
+        m.insert(QString::fromLatin1(e[i].name), e[i].addr);
+    return m;
+}
+
+} // namespace
+
+bool AddressMapBuiltin::lookup(const QString& path, QVariantMap* out)
+{
+    for (const auto& r : AddressMapGen::kRobots) {
+        if (path != QLatin1String(r.resource))
+            continue;
+        if (out) {
+            out->clear();
+            out->insert("coils",           toSpaceMap(r.coils,           r.coilsCount));
+            out->insert("discrete_inputs", toSpaceMap(r.discrete_inputs, r.discrete_inputsCount));
+            out->insert("holding",         toSpaceMap(r.holding,         r.holdingCount));
+            out->insert("input_registers", toSpaceMap(r.input_registers, r.input_registersCount));
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,17 @@
+#ifndef ADDRESSMAPBUILTIN_H
+#define ADDRESSMAPBUILTIN_H
+
+#include <QString>
+#include <QVariantMap>
+
+// 빌드 시 AddressMap_*.json 으로부터 생성된 constexpr 테이블(AddressMapGenerated.h)을
+// 런타임 QVariantMap 형태로 제공. 출하 맵은 JSON 파싱 없이 바로 적용된다.
+namespace AddressMapBuiltin {
+
+// path: robots.json 의 addr_map 값 (예: ":/map/AddressMap_A.json")
+// 내장 맵이 있으면 out 을 채우고 true
+bool lookup(const QString& path, QVariantMap* out);
+
+} // namespace AddressMapBuiltin
+
+#endif // ADDRESSMAPBUILTIN_H
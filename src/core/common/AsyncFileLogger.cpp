@@ -0,0 +1,314 @@
+#include "AsyncFileLogger.h"
+#include "MonoClock.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+constexpr int kBatchBytes = 1 << 20;            // 한 번에 모아 쓸 최대 크기
+constexpr auto kIdleWait = std::chrono::milliseconds(50);
+constexpr auto kFlushWait = std::chrono::seconds(2);
+
+const char* typeTag(QtMsgType t)
+{
+    switch (t) {
+    case QtDebugMsg:    return "[Debug]";
+    case QtInfoMsg:     return "[Info]";
+    case QtWarningMsg:  return "[Warning]";
+    case QtCriticalMsg: return "[Critical]";
+    case QtFatalMsg:    return "[Fatal]";
+    }
+    return "[Debug]";
+}
+
+bool sameDay(qint64 a, qint64 b)
+{
+    return QDateTime::fromMSecsSinceEpoch(a).date() == QDateTime::fromMSecsSinceEpoch(b).date();
+}
+
+} // namespace
+
+AsyncFileLogger& AsyncFileLogger::instance()
+{
+    static AsyncFileLogger lg;
+    return lg;
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    stop();
+}
+
+QString AsyncFileLogger::defaultDir()
+{
+    const QString env = qEnvironmentVariable("MRC_LOG_DIR");
+    if (!env.isEmpty())
+        return env;
+#ifdef Q_OS_WIN
+    return QStringLiteral("C:/Work/multiRobotController/tmp");
+#else
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QStringLiteral("/log");
+#endif
+}
+
+bool AsyncFileLogger::start(const Options& opt)
+{
+    if (isRunning()) return true;
+
+    m_opt = opt;
+    if (m_opt.dir.isEmpty()) m_opt.dir = defaultDir();
+    if (!QDir().mkpath(m_opt.dir)) {
+        std::fprintf(stderr, "[LOG] cannot create %s\n", qPrintable(m_opt.dir));
+        return false;
+    }
+
+    quint64 cap = 64;
+    while (cap < quint64(qMax(64, m_opt.capacity))) cap <<= 1;
+    m_ring.reset(new Slot[cap]);
+    for (quint64 i = 0; i < cap; ++i)
+        m_ring[i].seq.store(i, std::memory_order_relaxed);
+    m_mask = cap - 1;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail = 0;
+    m_written.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+
+    m_quit.store(false);
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread([this]{ run(); });
+    return true;
+}
+
+void AsyncFileLogger::stop()
+{
+    if (!m_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lk(m_wakeMx);
+        m_quit.store(true);
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    m_running.store(false, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lk(m_fileMx);
+    if (m_file.isOpen()) m_file.close();
+}
+
+bool AsyncFileLogger::push(QtMsgType type, const QString& msg)
+{
+    if (!isRunning()) return false;
+
+    quint64 pos = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& s = m_ring[pos & m_mask];
+        const qint64 diff = qint64(s.seq.load(std::memory_order_acquire)) - qint64(pos);
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);   // 가득 참: 기다리지 않음
+            return false;
+        } else {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    Slot& s = m_ring[pos & m_mask];
+    s.ms = MonoClock::wallNowMs();            // 앵커 + 단조 경과: 세션 안에서 되돌아가지 않음
+    s.type = type;
+    s.msg = msg;                                // 참조 카운트만 (복사 없음)
+    s.seq.store(pos + 1, std::memory_order_release);
+
+    // 기록 스레드가 자고 있을 때만 깨운다 (놓쳐도 kIdleWait 안에 깨어남)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed))
+        m_wake.notify_one();
+    return true;
+}
+
+void AsyncFileLogger::flush()
+{
+    if (!isRunning()) return;
+    const quint64 target = m_head.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lk(m_wakeMx);
+    m_wake.notify_one();
+    m_flushed.wait_for(lk, kFlushWait, [&]{
+        return m_written.load(std::memory_order_acquire) >= target || m_quit.load();
+    });
+}
+
+QString AsyncFileLogger::currentFile() const
+{
+    std::lock_guard<std::mutex> lk(m_fileMx);
+    return m_file.fileName();
+}
+
+void AsyncFileLogger::run()
+{
+    QByteArray buf;
+    quint64 reportedDrops = 0;
+    for (;;) {
+        int n = 0;
+        {
+            std::lock_guard<std::mutex> lk(m_fileMx);
+            buf.clear();
+            qint64 batchMs = 0;
+            n = drain(buf, &batchMs);
+
+            const quint64 drops = m_dropped.load(std::memory_order_relaxed);
+            if (drops != reportedDrops) {
+                const qint64 now = MonoClock::wallNowMs();
+                if (n == 0) {
+                    batchMs = now;
+                } else if (!sameDay(now, batchMs)) {    // 알림은 자기 날짜 파일로
+                    write(buf, batchMs);
+                    buf.clear();
+                    batchMs = now;
+                }
+                format(buf, now, QtWarningMsg,
+                       QString("[LOG] %1 messages dropped (ring full)").arg(drops - reportedDrops));
+                reportedDrops = drops;
+            }
+            if (!buf.isEmpty())
+                write(buf, batchMs);
+            m_written.store(m_tail, std::memory_order_release);
+        }
+        {
+            std::lock_guard<std::mutex> lk(m_wakeMx);
+        }
+        m_flushed.notify_all();
+
+        if (n > 0) continue;
+        if (m_quit.load()) break;
+
+        std::unique_lock<std::mutex> lk(m_wakeMx);
+        m_sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // push() 의 fence 와 짝
+        m_wake.wait_for(lk, kIdleWait, [&]{
+            return m_quit.load()
+                || m_ring[m_tail & m_mask].seq.load(std::memory_order_acquire) == m_tail + 1;
+        });
+        m_sleeping.store(false);
+    }
+}
+
+// 기록 스레드(또는 m_fileMx 를 잡은 fatal 경로)에서만 호출.
+// 날짜가 바뀌는 줄 앞에서 멈춘다: 꺼낸 묶음은 모두 *firstMs 와 같은 날짜 (파일 하나)
+int AsyncFileLogger::drain(QByteArray& out, qint64* firstMs)
+{
+    int n = 0;
+    while (out.size() < kBatchBytes) {
+        Slot& s = m_ring[m_tail & m_mask];
+        if (s.seq.load(std::memory_order_acquire) != m_tail + 1)
+            break;
+        const qint64 ms = s.ms;
+        if (n == 0)
+            *firstMs = ms;
+        else if (ms / 1000 != m_lastSec && !sameDay(ms, *firstMs))   // 초가 바뀔 때만 날짜 비교
+            break;
+        const QString msg = std::move(s.msg);
+        const QtMsgType type = s.type;
+        s.seq.store(m_tail + m_mask + 1, std::memory_order_release);
+        ++m_tail;
+
+        format(out, ms, type, msg);
+        ++n;
+    }
+    return n;
+}
+
+// "[Debug]yyyy-MM-dd hh:mm:ss.zzz: msg\n" — LogToFile 형식에 ms 세 자리를 붙인 것
+void AsyncFileLogger::format(QByteArray& out, qint64 ms, QtMsgType type, const QString& msg)
+{
+    const qint64 sec = ms / 1000;
+    if (sec != m_lastSec) {
+        m_lastSec = sec;
+        m_stamp = QDateTime::fromMSecsSinceEpoch(sec * 1000).toString("yyyy-MM-dd hh:mm:ss").toLatin1();
+    }
+    const int frac = int(ms - sec * 1000);
+    const char msBuf[5] = {'.', char('0' + frac / 100), char('0' + frac / 10 % 10), char('0' + frac % 10), ':'};
+    out.append(typeTag(type));
+    out.append(m_stamp);
+    out.append(msBuf, 5);
+    out.append(" ", 1);
+    out.append(msg.toUtf8());
+    out.append('\n');
+}
+
+void AsyncFileLogger::write(const QByteArray& bytes, qint64 ms)
+{
+    if (!openFor(ms)) return;
+    // 날짜가 같은 동안 크기 한도를 넘으면 다음 조각 파일로
+    if (m_file.size() > 0 && m_file.size() + bytes.size() > m_opt.maxFileBytes) {
+        m_file.close();
+        ++m_part;
+        if (!openFor(ms)) return;
+    }
+    m_file.write(bytes);
+    m_file.flush();
+}
+
+bool AsyncFileLogger::openFor(qint64 ms)
+{
+    const QString day = QDateTime::fromMSecsSinceEpoch(ms).toString("yyMMdd");
+    if (m_file.isOpen() && day == m_day)
+        return true;
+
+    if (m_file.isOpen()) m_file.close();
+    if (day != m_day) {
+        m_day = day;
+        m_part = 0;
+    }
+    for (;;) {
+        const QString name = m_part == 0
+            ? QString("%1/%2%3.txt").arg(m_opt.dir, m_opt.prefix, m_day)
+            : QString("%1/%2%3_%4.txt").arg(m_opt.dir, m_opt.prefix, m_day).arg(m_part);
+        m_file.setFileName(name);
+        // 재시작 시 이미 가득 찬 조각은 건너뜀
+        if (m_file.exists() && m_file.size() >= m_opt.maxFileBytes) {
+            ++m_part;
+            continue;
+        }
+        if (m_file.open(QIODevice::Append | QIODevice::Text))
+            return true;
+        std::fprintf(stderr, "[LOG] cannot open %s\n", qPrintable(name));
+        return false;
+    }
+}
+
+void AsyncFileLogger::messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+    AsyncFileLogger& lg = instance();
+
+    QString text = msg;
+    if (type == QtCriticalMsg && context.function)
+        text += QString(" (%1:%2)").arg(QLatin1String(context.function)).arg(context.line);
+
+    if (type == QtFatalMsg) {
+        // 링에 남은 것과 함께 이 스레드에서 바로 기록
+        if (lg.isRunning()) {
+            std::lock_guard<std::mutex> lk(lg.m_fileMx);
+            QByteArray buf;
+            qint64 batchMs = 0;
+            while (lg.drain(buf, &batchMs) > 0) {
+                lg.write(buf, batchMs);
+                buf.clear();
+            }
+            const qint64 now = MonoClock::wallNowMs();
+            lg.format(buf, now, type, text);
+            lg.write(buf, now);
+        } else {
+            std::fprintf(stderr, "[Fatal] %s\n", qUtf8Printable(text));
+        }
+        std::abort();
+    }
+
+    if (!lg.push(type, text) && !lg.isRunning())
+        std::fprintf(stderr, "%s %s\n", typeTag(type), qUtf8Printable(text));
+}
@@ -0,0 +1,102 @@
+#ifndef ASYNCFILELOGGER_H
+#define ASYNCFILELOGGER_H
+
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// ─────────────────────────────────────────────────────────────
+// 비동기 파일 로거 (qInstallMessageHandler 용)
+//
+//  - 호출 스레드: 시각(MonoClock::wallNowMs) + 종류 + QString(암시적 공유, 참조 카운트만)을 고정 크기 링 슬롯에 넣고 끝.
+//    잠금 없는 MPSC 링 (슬롯별 시퀀스 번호). 링이 가득 차면 기다리지 않고 버리고 센다.
+//  - 기록 스레드: 쌓인 것을 한 번에 꺼내 UTF-8/시각 문자열로 만들고 열어 둔 파일에 한 번 write.
+//    시각 문자열은 초가 바뀔 때만 다시 만들고 ms 세 자리만 붙인다.
+//  - 파일: <dir>/log_yyMMdd.txt, 줄: "[Debug]yyyy-MM-dd hh:mm:ss.zzz: msg"
+//    (기존 LogToFile 과 같은 이름, 줄 형식은 ms 만 추가).
+//    날짜가 바뀌거나 maxFileBytes 를 넘으면 새 파일 (log_yyMMdd_1.txt, _2 ...).
+//    한 번에 꺼내는 묶음은 날짜 경계에서 끊는다 (자정 전 줄이 다음 날 파일에 섞이지 않도록).
+//  - 디렉터리: Options::dir → 환경변수 MRC_LOG_DIR → 플랫폼 기본값 (defaultDir()).
+//  - QtFatalMsg: 링을 거치지 않고 지금까지 쌓인 것과 함께 바로 기록한 뒤 핸들러 안에서 std::abort().
+// ─────────────────────────────────────────────────────────────
+class AsyncFileLogger
+{
+public:
+    struct Options {
+        QString dir;                            // 비어 있으면 defaultDir()
+        QString prefix = QStringLiteral("log_");
+        qint64  maxFileBytes = 32 * 1024 * 1024;
+        int     capacity = 16384;               // 링 슬롯 수 (2의 거듭제곱으로 올림)
+    };
+
+    static AsyncFileLogger& instance();
+
+    // MRC_LOG_DIR, 없으면 Windows: C:/Work/multiRobotController/tmp, 그 외: <AppLocalData>/log
+    static QString defaultDir();
+
+    bool start(const Options& opt = Options());
+    void stop();                                // 남은 것 모두 기록 후 스레드 종료
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // 호출 스레드 비용: 시계 읽기 + 슬롯 CAS + QString 참조 복사. 가득 차면 false (버림)
+    bool push(QtMsgType type, const QString& msg);
+    // 지금까지 push 된 것이 파일에 쓰일 때까지 대기
+    void flush();
+
+    quint64 dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    QString currentFile() const;
+
+    // qInstallMessageHandler(AsyncFileLogger::messageHandler)
+    static void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg);
+
+private:
+    AsyncFileLogger() = default;
+    ~AsyncFileLogger();
+    AsyncFileLogger(const AsyncFileLogger&) = delete;
+    AsyncFileLogger& operator=(const AsyncFileLogger&) = delete;
+
+    struct Slot {
+        std::atomic<quint64> seq{0};
+        qint64 ms = 0;
+        QtMsgType type = QtDebugMsg;
+        QString msg;
+    };
+
+    void run();
+    int  drain(QByteArray& out, qint64* firstMs); // 링 → 텍스트 (날짜 하나까지), 꺼낸 건수
+    void format(QByteArray& out, qint64 ms, QtMsgType type, const QString& msg);
+    void write(const QByteArray& bytes, qint64 ms);
+    bool openFor(qint64 ms);
+
+    Options m_opt;
+    std::unique_ptr<Slot[]> m_ring;
+    quint64 m_mask = 0;
+    alignas(64) std::atomic<quint64> m_head{0};     // 생산자들
+    alignas(64) quint64 m_tail = 0;                 // 기록 스레드만
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_written{0};              // 기록 완료된 슬롯 위치 (flush 대기용)
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_quit{false};
+    std::atomic<bool> m_sleeping{false};
+    std::mutex m_wakeMx;
+    std::condition_variable m_wake;                 // 기록 스레드 깨움
+    std::condition_variable m_flushed;              // flush() 대기자 깨움
+
+    // 기록 스레드 상태 (m_fileMx 로 보호: fatal 경로가 직접 쓸 때)
+    mutable std::mutex m_fileMx;
+    QFile m_file;
+    QString m_day;                                  // 현재 파일 날짜 (yyMMdd)
+    int m_part = 0;
+    qint64 m_lastSec = -1;
+    QByteArray m_stamp;                             // "yyyy-MM-dd hh:mm:ss" (m_lastSec 기준)
+};
+
+#endif // ASYNCFILELOGGER_H
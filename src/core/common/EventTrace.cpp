@@ -0,0 +1,420 @@
+#include "EventTrace.h"
+#include "FlightRecorder.h"
+#include "MonoClock.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QVarLengthArray>
+
+#include <cstring>
+#include <thread>
+
+namespace EventTrace {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+std::atomic<bool> g_fileOpen{false};
+
+void updateEnabled()
+{
+    g_enabled.store(g_fileOpen.load(std::memory_order_acquire) || FlightRecorder::enabled(),
+                    std::memory_order_release);
+}
+} // namespace detail
+
+namespace {
+
+constexpr char kMagic[8] = {'M','R','C','T','R','C','0','1'};
+constexpr quint32 kVersion = 1;
+
+// 기록 상태. open()/close() 는 메인 스레드, 기록은 아무 스레드에서나.
+struct Writer {
+    QFile file;
+    uchar* base = nullptr;
+    FileHeader* header = nullptr;
+    Record* records = nullptr;
+    quint64 capacity = 0;
+    qint64 t0Ns = 0;                            // open() 시점 nowNs() → 파일 레코드는 이 기준
+
+    alignas(64) std::atomic<quint64> next{0};   // 다음 슬롯 (capacity 를 넘을 수 있음)
+    std::atomic<quint64> dropped{0};
+    std::atomic<int> inflight{0};               // 기록 중인 스레드 수 (close 가 기다림)
+};
+
+Writer& w()
+{
+    static Writer s;
+    return s;
+}
+
+// 연속 n 개 슬롯 예약. 실패하면 nullptr (버린 수는 센다). 성공 시 호출 측이 release().
+Record* reserve(int n)
+{
+    Writer& s = w();
+    s.inflight.fetch_add(1, std::memory_order_acquire);
+    if (!detail::g_fileOpen.load(std::memory_order_acquire)) {
+        s.inflight.fetch_sub(1, std::memory_order_release);
+        return nullptr;
+    }
+    const quint64 i = s.next.fetch_add(quint64(n), std::memory_order_relaxed);
+    if (i + quint64(n) > s.capacity) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        s.inflight.fetch_sub(1, std::memory_order_release);
+        return nullptr;
+    }
+    return s.records + i;
+}
+
+void release()
+{
+    w().inflight.fetch_sub(1, std::memory_order_release);
+}
+
+// event 바이트를 마지막에 써서 레코드를 "완성" 표시
+void commit(Record* r, Event e)
+{
+    std::atomic_thread_fence(std::memory_order_release);
+    reinterpret_cast<volatile quint8&>(r->event) = quint8(e);
+}
+
+Record* begin(Record* r, int robot, quint32 seq, quint16 arg)
+{
+    r->tNs = nowNs();
+    r->seq = seq;
+    r->event = 0;
+    r->robot = qint8(robot);
+    r->arg = arg;
+    return r;
+}
+
+// 한 이벤트(연속 레코드 n 개, recs[0] 이 주 레코드)를 파일과 플라이트 레코더에 전달.
+// 파일에는 시각을 open() 기준으로 옮겨 쓰고, 주 레코드의 event 를 마지막에 쓴다.
+void deliver(Record* recs, const Event* events, int n)
+{
+    if (detail::g_fileOpen.load(std::memory_order_relaxed)) {
+        if (Record* f = reserve(n)) {
+            const qint64 t0 = w().t0Ns;
+            for (int i = n - 1; i >= 0; --i) {
+                std::memcpy(&f[i], &recs[i], sizeof(Record));
+                f[i].tNs -= t0;
+                commit(&f[i], events[i]);
+            }
+            release();
+        }
+    }
+    if (FlightRecorder::enabled()) {
+        for (int i = 0; i < n; ++i) recs[i].event = quint8(events[i]);
+        FlightRecorder::record(recs, n);
+    }
+}
+
+void single(Event e, int robot, quint32 seq, quint16 arg, const void* payload, int size)
+{
+    Record r;
+    begin(&r, robot, seq, arg);
+    if (size > 0) std::memcpy(r.payload, payload, size_t(size));
+    if (size < kPayloadBytes) std::memset(r.payload + size, 0, size_t(kPayloadBytes - size));
+    deliver(&r, &e, 1);
+}
+
+void toFloats(float* out, const Pose6D& p)
+{
+    out[0] = float(p.x);  out[1] = float(p.y);  out[2] = float(p.z);
+    out[3] = float(p.rx); out[4] = float(p.ry); out[5] = float(p.rz);
+}
+
+} // namespace
+
+qint64 nowNs()
+{
+    return MonoClock::nowNs();
+}
+
+void initHeader(FileHeader& h, qint64 wallMs)
+{
+    std::memset(&h, 0, sizeof(FileHeader));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.recordSize = sizeof(Record);
+    h.wallMs = wallMs;
+}
+
+bool open(const QString& path, qint64 maxBytes)
+{
+    close();
+    Writer& s = w();
+
+    const qint64 records = (maxBytes - qint64(sizeof(FileHeader))) / qint64(sizeof(Record));
+    if (records <= 0) return false;
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    s.file.setFileName(path);
+    if (!s.file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qWarning("[TRACE] cannot open %s: %s", qPrintable(path), qPrintable(s.file.errorString()));
+        return false;
+    }
+    const qint64 total = qint64(sizeof(FileHeader)) + records * qint64(sizeof(Record));
+    if (!s.file.resize(total)) {
+        qWarning("[TRACE] cannot size %s to %lld bytes", qPrintable(path), total);
+        s.file.close();
+        return false;
+    }
+    s.base = s.file.map(0, total);
+    if (!s.base) {
+        qWarning("[TRACE] cannot map %s", qPrintable(path));
+        s.file.close();
+        return false;
+    }
+
+    s.header = reinterpret_cast<FileHeader*>(s.base);
+    s.records = reinterpret_cast<Record*>(s.base + sizeof(FileHeader));
+    s.capacity = quint64(records);
+    s.t0Ns = nowNs();
+    initHeader(*s.header, MonoClock::toWallMs(s.t0Ns / 1000000));
+
+    s.next.store(0, std::memory_order_relaxed);
+    s.dropped.store(0, std::memory_order_relaxed);
+    detail::g_fileOpen.store(true, std::memory_order_release);
+    detail::updateEnabled();
+    return true;
+}
+
+QString openFromEnv()
+{
+    const QString dir = qEnvironmentVariable("MRC_TRACE_DIR");
+    if (dir.isEmpty()) return QString();
+
+    bool ok = false;
+    const qint64 mb = qEnvironmentVariableIntValue("MRC_TRACE_MB", &ok);
+    const QString path = QString("%1/trace_%2.mrct")
+        .arg(dir, MonoClock::toString(MonoClock::nowMs(), "yyMMdd_hhmmss"));
+    if (!open(path, ok && mb > 0 ? mb * 1024 * 1024 : 256LL * 1024 * 1024))
+        return QString();
+    return path;
+}
+
+void close()
+{
+    Writer& s = w();
+    if (!s.base) return;
+
+    detail::g_fileOpen.store(false, std::memory_order_release);
+    detail::updateEnabled();
+    while (s.inflight.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+
+    const quint64 n = qMin(s.next.load(std::memory_order_relaxed), s.capacity);
+    s.header->count = n;
+    s.header->dropped = s.dropped.load(std::memory_order_relaxed);
+
+    s.file.unmap(s.base);
+    s.base = nullptr;
+    s.header = nullptr;
+    s.records = nullptr;
+    s.file.resize(qint64(sizeof(FileHeader)) + qint64(n) * qint64(sizeof(Record)));
+    s.file.close();
+    s.capacity = 0;
+}
+
+quint64 recorded()
+{
+    return qMin(w().next.load(std::memory_order_relaxed), w().capacity);
+}
+
+quint64 dropped()
+{
+    return w().dropped.load(std::memory_order_relaxed);
+}
+
+void busRequest(int robot, quint32 seq, bool write, Table table, int start, int count,
+                const quint16* values, int n)
+{
+    BusPayload p{};
+    p.table = quint8(table);
+    p.count = quint16(count);
+    n = qMin(n, kBusValues);
+    if (values && n > 0) std::memcpy(p.values, values, size_t(n) * sizeof(quint16));
+    single(write ? Event::BusWrite : Event::BusRead, robot, seq, quint16(start), &p, sizeof(p));
+}
+
+void busReply(int robot, quint32 seq, Table table, int start, bool ok, qint64 rttNs,
+              const quint16* values, int n)
+{
+    BusPayload p{};
+    p.table = quint8(table);
+    p.ok = ok ? 1 : 0;
+    p.count = quint16(n);
+    p.rttUs = quint32(qBound<qint64>(0, rttNs / 1000, 0xFFFFFFFFLL));
+    n = qMin(n, kBusValues);
+    if (values && n > 0) std::memcpy(p.values, values, size_t(n) * sizeof(quint16));
+    single(Event::BusReply, robot, seq, quint16(start), &p, sizeof(p));
+}
+
+void diEdge(int robot, int pulseIndex)
+{
+    single(Event::DiEdge, robot, 0, quint16(pulseIndex), nullptr, 0);
+}
+
+void visionRx(const RobotCommand& cmd, const char* line, int size)
+{
+    size = qBound(0, size, 0xFFFF);
+    const int chunks = (size + kPayloadBytes - 1) / kPayloadBytes;
+    const int robot = robotIndex(cmd.robot);
+
+    QVarLengthArray<Record, 16> recs(1 + chunks);
+    QVarLengthArray<Event, 16> events(1 + chunks);
+
+    VisionPayload p{};
+    p.type = quint8(cmd.type);
+    p.kind = quint8(cmd.kind);
+    p.dir = qint8(cmd.dir);
+    p.flags = (cmd.hasPick ? 1 : 0) | (cmd.hasPlace ? 2 : 0) | (cmd.flip ? 4 : 0) | (cmd.isTool ? 8 : 0);
+    p.textLen = quint16(size);
+    toFloats(p.pick, cmd.pick);
+    toFloats(p.place, cmd.place);
+
+    begin(&recs[0], robot, cmd.seq, quint16(chunks));
+    std::memset(recs[0].payload, 0, kPayloadBytes);
+    std::memcpy(recs[0].payload, &p, sizeof(p));
+    events[0] = Event::VisionRx;
+    for (int c = 0; c < chunks; ++c) {
+        Record* t = &recs[1 + c];
+        begin(t, robot, cmd.seq, quint16(c));
+        const int off = c * kPayloadBytes;
+        const int len = qMin(kPayloadBytes, size - off);
+        std::memcpy(t->payload, line + off, size_t(len));
+        if (len < kPayloadBytes) std::memset(t->payload + len, 0, size_t(kPayloadBytes - len));
+        events[1 + c] = Event::VisionText;
+    }
+    deliver(recs.data(), events.data(), recs.size());
+}
+
+void visionTx(int robot, quint32 seq, TxKind kind, CmdType type, CmdKind cmdKind)
+{
+    VisionPayload p{};
+    p.type = quint8(type);
+    p.kind = quint8(cmdKind);
+    p.dir = 11;
+    single(Event::VisionTx, robot, seq, quint16(kind), &p, 8);
+}
+
+void gantryMove(int axis, qint32 target, bool relative)
+{
+    const GantryPayload p{target, relative ? 1 : 0};
+    single(Event::GantryMove, -1, 0, quint16(axis), &p, sizeof(p));
+}
+
+void gantryDone(int axis, qint32 target)
+{
+    const GantryPayload p{target, 0};
+    single(Event::GantryDone, -1, 0, quint16(axis), &p, sizeof(p));
+}
+
+void mark(quint16 value)
+{
+    single(Event::Mark, -1, 0, value, nullptr, 0);
+}
+
+void fsmState(int robot, int state)
+{
+    single(Event::FsmState, robot, 0, quint16(state), nullptr, 0);
+}
+
+void fault(int robot, const QString& reason, int code1, int code2)
+{
+    const QByteArray text = reason.toUtf8().left(kPayloadBytes);
+    single(Event::Fault, robot, quint32(code2), quint16(code1), text.constData(), text.size());
+}
+
+const char* eventName(Event e)
+{
+    switch (e) {
+    case Event::None:       return "none";
+    case Event::BusRead:    return "bus_read";
+    case Event::BusWrite:   return "bus_write";
+    case Event::BusReply:   return "bus_reply";
+    case Event::DiEdge:     return "di_edge";
+    case Event::VisionRx:   return "vision_rx";
+    case Event::VisionText: return "vision_text";
+    case Event::VisionTx:   return "vision_tx";
+    case Event::GantryMove: return "gantry_move";
+    case Event::GantryDone: return "gantry_done";
+    case Event::Mark:       return "mark";
+    case Event::FsmState:   return "fsm_state";
+    case Event::Fault:      return "fault";
+    case Event::Count:      break;
+    }
+    return "?";
+}
+
+// ── Reader ───────────────────────────────────────────────────
+struct Reader::Impl {
+    QFile file;
+    uchar* base = nullptr;
+};
+
+Reader::~Reader()
+{
+    if (m_impl) {
+        if (m_impl->base) m_impl->file.unmap(m_impl->base);
+        delete m_impl;
+    }
+}
+
+bool Reader::open(const QString& path, QString* error)
+{
+    auto fail = [&](const QString& msg) {
+        if (error) *error = msg;
+        return false;
+    };
+
+    if (!m_impl) m_impl = new Impl;
+    m_impl->file.setFileName(path);
+    if (!m_impl->file.open(QIODevice::ReadOnly))
+        return fail(m_impl->file.errorString());
+
+    const qint64 size = m_impl->file.size();
+    if (size < qint64(sizeof(FileHeader)))
+        return fail(QStringLiteral("file too short"));
+    m_impl->base = m_impl->file.map(0, size);
+    if (!m_impl->base)
+        return fail(QStringLiteral("cannot map file"));
+
+    m_header = reinterpret_cast<const FileHeader*>(m_impl->base);
+    if (std::memcmp(m_header->magic, kMagic, sizeof(kMagic)) != 0)
+        return fail(QStringLiteral("not a trace file"));
+    if (m_header->recordSize != sizeof(Record))
+        return fail(QString("record size %1 (expected %2)").arg(m_header->recordSize).arg(sizeof(Record)));
+
+    m_records = reinterpret_cast<const Record*>(m_impl->base + sizeof(FileHeader));
+    const qint64 slots = (size - qint64(sizeof(FileHeader))) / qint64(sizeof(Record));
+    if (m_header->count > 0) {
+        m_count = qMin<qint64>(qint64(m_header->count), slots);
+    } else {
+        // 비정상 종료: 완성된 레코드(event!=0)가 끊기는 곳까지
+        m_count = 0;
+        while (m_count < slots && m_records[m_count].event != 0) ++m_count;
+    }
+    return true;
+}
+
+QByteArray Reader::visionText(qint64 i) const
+{
+    const Record& r = at(i);
+    if (Event(r.event) != Event::VisionRx) return QByteArray();
+    VisionPayload p;
+    std::memcpy(&p, r.payload, sizeof(p));
+
+    QByteArray out;
+    out.reserve(p.textLen);
+    for (int c = 0; c < r.arg && i + 1 + c < m_count; ++c) {
+        const Record& t = at(i + 1 + c);
+        if (Event(t.event) != Event::VisionText) break;
+        out.append(reinterpret_cast<const char*>(t.payload),
+                   qMin(kPayloadBytes, int(p.textLen) - out.size()));
+    }
+    return out;
+}
+
+} // namespace EventTrace
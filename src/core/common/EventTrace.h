@@ -0,0 +1,163 @@
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+
+#include "RobotCommand.h"
+
+// ─────────────────────────────────────────────────────────────
+// 바이너리 이벤트 트레이스 (재생/벤치마크용)
+//
+// 파일: [FileHeader 64B][Record 96B]...  (리틀 엔디언, 고정 크기 레코드)
+//  - 파일을 최대 크기로 미리 늘리고 통째로 mmap. 기록 = 슬롯 번호 fetch_add + memcpy.
+//    event 바이트는 마지막에 쓴다 → 비정상 종료 후에도 event==0 인 슬롯에서 끝난 것으로 읽는다.
+//  - 가득 차면 이후 이벤트는 버리고 센다 (재매핑 없음). close() 가 실제 길이로 자르고 count 기록.
+//  - 시각: steady_clock ns (open() 시점 기준). 헤더에 open 시점의 벽시계 ms 를 같이 둔다.
+//  - 같은 레코드를 FlightRecorder(로봇별 메모리 링, 에러 시 덤프)에도 넘긴다.
+//    enabled() = 파일이 열려 있거나 플라이트 레코더가 켜져 있음.
+//  - 꺼져 있을 때 호출 비용은 enabled() 분기 하나. 호출 측은 if (EventTrace::enabled()) 로 감싼다.
+//
+// 이벤트별 필드:
+//   BusRead/BusWrite  robot, seq=버스 op 번호, arg=시작 주소, BusPayload (쓰기는 값 포함)
+//   BusReply          robot, seq=같은 op 번호, arg=시작 주소, BusPayload (ok, rtt, 읽은 값)
+//   DiEdge            robot, arg=펄스 인덱스
+//   VisionRx          robot, seq, arg=뒤따르는 VisionText 레코드 수, VisionPayload
+//   VisionText        원본 JSON 줄 조각 (payload 80B 씩, 재생 시 그대로 송신)
+//   VisionTx          robot, seq, arg=TxKind, VisionPayload(type/kind 만)
+//   GantryMove        arg=축 id, GantryPayload(target, relative)
+//   GantryDone        arg=축 id, GantryPayload(target)
+//   Mark              arg=사용자 값 (구간 표시)
+//   FsmState          robot, arg=Orchestrator 상태 번호
+//   Fault             robot, arg=code1, seq=code2, payload=사유 문자열 (UTF-8, 최대 80B)
+// ─────────────────────────────────────────────────────────────
+namespace EventTrace {
+
+enum class Event : quint8 {
+    None = 0,
+    BusRead, BusWrite, BusReply,
+    DiEdge,
+    VisionRx, VisionText, VisionTx,
+    GantryMove, GantryDone,
+    Mark,
+    FsmState, Fault,
+    Count
+};
+
+enum class Table : quint8 { Coils, DiscreteInputs, InputRegisters, HoldingRegisters };
+enum class TxKind : quint16 { Ack = 1, WorkComplete, ToolComplete, Error, Feedback };
+
+constexpr int kPayloadBytes = 80;
+constexpr int kBusValues = 36;
+
+struct Record {
+    qint64  tNs;            // open() 기준 단조 시각
+    quint32 seq;
+    quint8  event;          // Event (0: 비어 있음)
+    qint8   robot;          // 조밀 인덱스, -1: 해당 없음
+    quint16 arg;
+    uchar   payload[kPayloadBytes];
+};
+static_assert(sizeof(Record) == 96, "trace record must stay 96 bytes");
+
+struct BusPayload {
+    quint8  table;          // Table
+    quint8  ok;
+    quint16 count;          // 요청 개수 (values 는 앞쪽 kBusValues 개까지만)
+    quint32 rttUs;          // BusReply 만
+    quint16 values[kBusValues];
+};
+static_assert(sizeof(BusPayload) == kPayloadBytes, "bus payload size");
+
+struct VisionPayload {
+    quint8  type;           // CmdType
+    quint8  kind;           // CmdKind
+    qint8   dir;
+    quint8  flags;          // bit0 hasPick, bit1 hasPlace, bit2 flip, bit3 isTool
+    quint16 textLen;        // 원본 줄 길이 (VisionText 로 이어짐)
+    quint16 reserved;
+    float   pick[6];
+    float   place[6];
+};
+static_assert(sizeof(VisionPayload) <= kPayloadBytes, "vision payload size");
+
+struct GantryPayload {
+    qint32 target;
+    qint32 relative;
+};
+
+struct FileHeader {
+    char    magic[8];       // "MRCTRC01"
+    quint32 version;
+    quint32 recordSize;
+    qint64  wallMs;         // open() 시점 벽시계 (ms since epoch)
+    quint64 count;          // close() 시 기록 (0: 비정상 종료 → event==0 까지 읽기)
+    quint64 dropped;
+    char    note[24];       // 플라이트 레코더 덤프: 덤프 사유 (NUL 종료). 일반 트레이스는 비어 있음
+};
+static_assert(sizeof(FileHeader) == 64, "trace header must stay 64 bytes");
+
+namespace detail {
+extern std::atomic<bool> g_enabled;
+void updateEnabled();       // 싱크(파일/플라이트 레코더)가 켜지거나 꺼질 때
+}
+
+inline bool enabled() { return detail::g_enabled.load(std::memory_order_relaxed); }
+
+// 매직/버전/레코드 크기를 채운 헤더 (count/dropped/note 는 0)
+void initHeader(FileHeader& h, qint64 wallMs);
+
+// maxBytes 크기로 파일을 만들고 매핑. 이미 열려 있으면 닫고 새로 연다.
+bool open(const QString& path, qint64 maxBytes = 256LL * 1024 * 1024);
+// MRC_TRACE_DIR 이 있으면 <dir>/trace_yyMMdd_hhmmss.mrct 를 연다. 연 경로 (없으면 빈 문자열)
+QString openFromEnv();
+void close();
+quint64 recorded();
+quint64 dropped();
+
+qint64 nowNs();             // = MonoClock::nowNs() (기록/RTT 계산용)
+
+void busRequest(int robot, quint32 seq, bool write, Table table, int start, int count,
+                const quint16* values = nullptr, int n = 0);
+void busReply(int robot, quint32 seq, Table table, int start, bool ok, qint64 rttNs,
+              const quint16* values = nullptr, int n = 0);
+void diEdge(int robot, int pulseIndex);
+void visionRx(const RobotCommand& cmd, const char* line, int size);
+void visionTx(int robot, quint32 seq, TxKind kind, CmdType type, CmdKind cmdKind);
+void gantryMove(int axis, qint32 target, bool relative);
+void gantryDone(int axis, qint32 target);
+void mark(quint16 value);
+void fsmState(int robot, int state);
+void fault(int robot, const QString& reason, int code1 = 0, int code2 = 0);
+
+const char* eventName(Event e);
+
+// ── 읽기 (재생/분석 도구용). 파일을 매핑해 레코드를 그대로 가리킨다.
+class Reader
+{
+public:
+    Reader() = default;
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    bool open(const QString& path, QString* error = nullptr);
+    const FileHeader& header() const { return *m_header; }
+    qint64 size() const { return m_count; }
+    const Record& at(qint64 i) const { return m_records[i]; }
+    // VisionRx 레코드 i 뒤의 VisionText 를 이어 붙인 원본 줄
+    QByteArray visionText(qint64 i) const;
+
+private:
+    struct Impl;
+    Impl* m_impl = nullptr;
+    const FileHeader* m_header = nullptr;
+    const Record* m_records = nullptr;
+    qint64 m_count = 0;
+};
+
+} // namespace EventTrace
+
+#endif // EVENTTRACE_H
@@ -0,0 +1,182 @@
+#include "FlightRecorder.h"
+#include "AsyncFileLogger.h"
+#include "MonoClock.h"
+
+#include <QDir>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace FlightRecorder {
+
+namespace detail { std::atomic<bool> g_enabled{false}; }
+
+namespace {
+
+using EventTrace::Record;
+
+constexpr int kRings = kMaxRobots + 1;          // 마지막 = 공용
+constexpr quint64 kMask = kRecordsPerRing - 1;
+static_assert((kRecordsPerRing & kMask) == 0, "ring size must be a power of two");
+
+// stamp: 2*pos+1 = 쓰는 중, 2*pos+2 = pos 번째 레코드 완료. 읽는 쪽은 앞뒤 스탬프가 같을 때만 채택.
+struct Slot {
+    std::atomic<quint64> stamp{0};
+    Record rec{};
+};
+
+struct Ring {
+    alignas(64) std::atomic<quint64> head{0};   // 다음 위치 (누적)
+    Slot slots[kRecordsPerRing];
+};
+
+Ring g_rings[kRings];
+std::atomic<int> g_windowSec{kDefaultWindowSec};
+
+std::mutex g_dumpMutex;                         // 덤프 설정/간격 (기록 경로에서는 안 씀)
+QString g_dir;
+qint64 g_lastDumpMs[kRings] = {};
+
+int ringOf(int robot)
+{
+    return robot >= 0 && robot < kMaxRobots ? robot : kMaxRobots;
+}
+
+void collect(const Ring& ring, qint64 sinceNs, std::vector<Record>& out, quint64& skipped)
+{
+    const quint64 head = ring.head.load(std::memory_order_acquire);
+    const quint64 from = head > quint64(kRecordsPerRing) ? head - kRecordsPerRing : 0;
+    for (quint64 pos = from; pos < head; ++pos) {
+        const Slot& s = ring.slots[pos & kMask];
+        const quint64 want = 2 * pos + 2;
+        if (s.stamp.load(std::memory_order_acquire) != want) { ++skipped; continue; }
+        Record r;
+        std::memcpy(&r, &s.rec, sizeof(Record));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.stamp.load(std::memory_order_relaxed) != want) { ++skipped; continue; }
+        if (r.tNs >= sinceNs) out.push_back(r);
+    }
+}
+
+QString sanitize(const QString& reason)
+{
+    QString out;
+    for (QChar c : reason.left(32))
+        out += (c.isLetterOrNumber() && c.unicode() < 128) ? c : QChar('-');
+    return out.isEmpty() ? QStringLiteral("manual") : out;
+}
+
+} // namespace
+
+void setEnabled(bool on)
+{
+    detail::g_enabled.store(on, std::memory_order_release);
+    EventTrace::detail::updateEnabled();
+}
+
+void configureFromEnv()
+{
+    bool ok = false;
+    const int sec = qEnvironmentVariableIntValue("MRC_FLIGHT_SEC", &ok);
+    if (ok && sec > 0) setWindowSec(sec);
+    const QString dir = qEnvironmentVariable("MRC_FLIGHT_DIR");
+    if (!dir.isEmpty()) setDumpDir(dir);
+    setEnabled(qEnvironmentVariable("MRC_FLIGHT") != QLatin1String("0"));
+}
+
+void setWindowSec(int sec)
+{
+    g_windowSec.store(qMax(1, sec), std::memory_order_relaxed);
+}
+
+int windowSec()
+{
+    return g_windowSec.load(std::memory_order_relaxed);
+}
+
+void setDumpDir(const QString& dir)
+{
+    std::lock_guard<std::mutex> lk(g_dumpMutex);
+    g_dir = dir;
+}
+
+QString dumpDir()
+{
+    std::lock_guard<std::mutex> lk(g_dumpMutex);
+    return g_dir.isEmpty() ? AsyncFileLogger::defaultDir() + QStringLiteral("/flight") : g_dir;
+}
+
+void record(const Record* recs, int n)
+{
+    if (n <= 0) return;
+    Ring& ring = g_rings[ringOf(recs[0].robot)];
+    const quint64 pos = ring.head.fetch_add(quint64(n), std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i) {
+        Slot& s = ring.slots[(pos + quint64(i)) & kMask];
+        s.stamp.store(2 * (pos + quint64(i)) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&s.rec, &recs[i], sizeof(Record));
+        s.stamp.store(2 * (pos + quint64(i)) + 2, std::memory_order_release);
+    }
+}
+
+QString dump(int robot, const QString& reason, bool force, QString* error)
+{
+    auto fail = [&](const QString& msg) {
+        if (error) *error = msg;
+        return QString();
+    };
+
+    const int ri = ringOf(robot);
+    const qint64 nowMs = MonoClock::nowMs();
+    if (!force) {   // 운영자 덤프는 간격 계산에 넣지 않는다 (직후 에러 덤프를 막지 않도록)
+        std::lock_guard<std::mutex> lk(g_dumpMutex);
+        if (g_lastDumpMs[ri] && nowMs - g_lastDumpMs[ri] < kAutoDumpHoldoffMs)
+            return fail(QStringLiteral("holdoff"));
+        g_lastDumpMs[ri] = nowMs;
+    }
+
+    const qint64 now = EventTrace::nowNs();
+    const qint64 since = now - qint64(windowSec()) * 1000000000LL;
+    std::vector<Record> recs;
+    recs.reserve(kRecordsPerRing);
+    quint64 skipped = 0;
+    collect(g_rings[ri], since, recs, skipped);
+    if (ri != kMaxRobots) collect(g_rings[kMaxRobots], since, recs, skipped);
+    if (recs.empty()) return fail(QStringLiteral("no records"));
+
+    // 링 안에서는 위치순이지만 여러 스레드가 섞이면 시각이 조금 어긋날 수 있다.
+    // VisionRx 뒤의 VisionText 는 같은 시각이므로 stable_sort 로 순서를 유지한다.
+    std::stable_sort(recs.begin(), recs.end(),
+                     [](const Record& a, const Record& b) { return a.tNs < b.tNs; });
+    const qint64 t0 = recs.front().tNs;
+    for (Record& r : recs) r.tNs -= t0;
+
+    EventTrace::FileHeader h;
+    EventTrace::initHeader(h, MonoClock::toWallMs(t0 / 1000000));
+    h.count = recs.size();
+    h.dropped = skipped;
+    const QByteArray note = reason.toUtf8().left(int(sizeof(h.note)) - 1);
+    std::memcpy(h.note, note.constData(), size_t(note.size()));
+
+    const QString dir = dumpDir();
+    QDir().mkpath(dir);
+    const QString path = QString("%1/flight_%2_%3_%4.mrct")
+        .arg(dir)
+        .arg(robot >= 0 && robot < kMaxRobots ? QString(QChar('a' + robot)) : QStringLiteral("x"))
+        .arg(MonoClock::toString(nowMs, "yyMMdd_hhmmss_zzz"), sanitize(reason));
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return fail(f.errorString());
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    f.write(reinterpret_cast<const char*>(recs.data()), qint64(recs.size() * sizeof(Record)));
+    if (!f.commit())
+        return fail(f.errorString());
+    return path;
+}
+
+} // namespace FlightRecorder
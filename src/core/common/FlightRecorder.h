@@ -0,0 +1,47 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <QString>
+
+#include "EventTrace.h"
+
+// ─────────────────────────────────────────────────────────────
+// 플라이트 레코더: 로봇별 메모리 링에 최근 EventTrace 레코드를 계속 담아 두고,
+// 에러 에지/시퀀스 실패/운영자 요청 시 최근 N 초를 .mrct 파일로 덤프한다.
+//
+//  - 링: 로봇 인덱스(0..kMaxRobots-1)마다 하나 + 공용(robot -1: 갠트리/마크) 하나.
+//    기록 = 위치 fetch_add + 슬롯 스탬프(seqlock) + memcpy. 락/할당 없음, 아무 스레드에서나.
+//  - 덤프: 해당 로봇 링과 공용 링에서 창(window) 안의 레코드를 모아 시각순 정렬,
+//    첫 레코드를 t=0 으로 맞춰 QSaveFile 로 원자적 저장. 헤더 note 에 사유.
+//    덤프 중에도 기록은 계속된다 (덮어쓰인 슬롯은 건너뛰고 dropped 로 셈).
+//  - 파일: mrc_trace_replay dump/stats 로 그대로 읽힌다.
+//  - 환경 변수: MRC_FLIGHT=0 끄기, MRC_FLIGHT_SEC 창 길이(기본 30), MRC_FLIGHT_DIR 덤프 경로
+//    (기본 <로그 경로>/flight)
+// ─────────────────────────────────────────────────────────────
+namespace FlightRecorder {
+
+constexpr int kRecordsPerRing = 1 << 14;    // 로봇당 16384 레코드 (약 1.6MB, 기록한 만큼만 페이지가 잡힘)
+constexpr int kDefaultWindowSec = 30;
+constexpr int kAutoDumpHoldoffMs = 2000;    // 같은 로봇의 자동 덤프 최소 간격
+
+namespace detail { extern std::atomic<bool> g_enabled; }
+
+inline bool enabled() { return detail::g_enabled.load(std::memory_order_relaxed); }
+
+void setEnabled(bool on);
+void configureFromEnv();
+void setWindowSec(int sec);
+int windowSec();
+void setDumpDir(const QString& dir);
+QString dumpDir();
+
+// EventTrace 가 호출. recs[0] 의 robot 으로 링을 고른다 (n 개를 같은 링에)
+void record(const EventTrace::Record* recs, int n);
+
+// robot: 조밀 인덱스 (-1: 공용 링만). force=false 면 kAutoDumpHoldoffMs 안의 반복 덤프는 건너뜀.
+// 저장한 경로, 건너뛰었거나 실패하면 빈 문자열 (error 에 사유)
+QString dump(int robot, const QString& reason, bool force = false, QString* error = nullptr);
+
+} // namespace FlightRecorder
+
+#endif // FLIGHTRECORDER_H
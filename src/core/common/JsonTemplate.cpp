@@ -0,0 +1,329 @@
+#include "JsonTemplate.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr char kHex[] = "0123456789abcdef";
+
+// 이스케이프가 필요한 ASCII
+inline bool needsEscape(uchar c)
+{
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+void appendEscaped(QByteArray& out, uchar c)
+{
+    switch (c) {
+    case '"':  out.append("\\\"", 2); break;
+    case '\\': out.append("\\\\", 2); break;
+    case '\b': out.append("\\b", 2); break;
+    case '\f': out.append("\\f", 2); break;
+    case '\n': out.append("\\n", 2); break;
+    case '\r': out.append("\\r", 2); break;
+    case '\t': out.append("\\t", 2); break;
+    default: {
+        const char u[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+        out.append(u, 6);
+        break;
+    }
+    }
+}
+
+void appendUtf8Escaped(QByteArray& out, const char* p, qsizetype n)
+{
+    qsizetype run = 0;      // 이스케이프 없는 구간은 한 번에 복사
+    for (qsizetype i = 0; i < n; ++i) {
+        const uchar c = uchar(p[i]);
+        if (!needsEscape(c)) continue;
+        out.append(p + run, i - run);
+        appendEscaped(out, c);
+        run = i + 1;
+    }
+    out.append(p + run, n - run);
+}
+
+void appendBigEndian(QByteArray& out, quint64 v, int bytes)
+{
+    for (int s = (bytes - 1) * 8; s >= 0; s -= 8)
+        out.append(char((v >> s) & 0xFF));
+}
+
+// 패턴 값 자리를 "\u0000<번호>" 문자열로 바꿔 파싱한 객체를 CBOR 로 쓰면서, 표시를 만날 때마다 조각을 끊는다
+struct CborCompiler
+{
+    QVector<QByteArray>& lits;
+    QByteArray cur;
+    int next = 0;
+    bool ok = true;
+
+    void value(const QJsonValue& v)
+    {
+        switch (v.type()) {
+        case QJsonValue::Null:
+        case QJsonValue::Undefined:
+            cur.append(char(0xF6));
+            break;
+        case QJsonValue::Bool:
+            CborText::appendBool(cur, v.toBool());
+            break;
+        case QJsonValue::Double:
+            CborText::appendDouble(cur, v.toDouble());
+            break;
+        case QJsonValue::String: {
+            const QString s = v.toString();
+            if (s.startsWith(QChar(0))) {
+                ok &= s.mid(1).toInt() == next++;   // 키 순서와 자리 순서가 다르면 인자 순서가 어긋남
+                lits.push_back(cur);
+                cur.clear();
+            } else {
+                CborText::appendString(cur, s);
+            }
+            break;
+        }
+        case QJsonValue::Array: {
+            const QJsonArray a = v.toArray();
+            CborText::appendHead(cur, 4, quint64(a.size()));
+            for (const auto& e : a) value(e);
+            break;
+        }
+        case QJsonValue::Object:
+            object(v.toObject());
+            break;
+        }
+    }
+
+    void object(const QJsonObject& o)
+    {
+        CborText::appendMap(cur, int(o.size()));
+        for (auto it = o.constBegin(); it != o.constEnd(); ++it) {
+            CborText::appendString(cur, it.key());
+            value(it.value());
+        }
+    }
+};
+
+} // namespace
+
+namespace JsonText {
+
+void appendString(QByteArray& out, const QString& s)
+{
+    out.append('"');
+    const QChar* u = s.constData();
+    const qsizetype n = s.size();
+    qsizetype i = 0;
+    while (i < n && u[i].unicode() < 0x80) ++i;
+    if (i == n) {
+        // ASCII: UTF-16 → 바이트 직접 (toUtf8 임시 버퍼 없음)
+        const qsizetype base = out.size();
+        out.resize(base + n);
+        char* d = out.data() + base;
+        bool esc = false;
+        for (qsizetype k = 0; k < n; ++k) {
+            const char c = char(u[k].unicode());
+            d[k] = c;
+            esc |= needsEscape(uchar(c));
+        }
+        if (esc) {
+            const QByteArray tmp(d, n);
+            out.resize(base);
+            appendUtf8Escaped(out, tmp.constData(), tmp.size());
+        }
+    } else {
+        const QByteArray utf8 = s.toUtf8();
+        appendUtf8Escaped(out, utf8.constData(), utf8.size());
+    }
+    out.append('"');
+}
+
+void appendLatin1(QByteArray& out, const char* s)
+{
+    out.append('"');
+    appendUtf8Escaped(out, s, qsizetype(std::strlen(s)));
+    out.append('"');
+}
+
+void appendInt(QByteArray& out, qint64 v)
+{
+    char buf[24];
+    const auto r = std::to_chars(buf, buf + sizeof buf, v);
+    out.append(buf, int(r.ptr - buf));
+}
+
+void appendDouble(QByteArray& out, double d)
+{
+    if (!std::isfinite(d)) {
+        out.append("null", 4);
+        return;
+    }
+    // QJsonDocument 는 2^53 이하 정수값을 정수 표기로 쓴다 (-0 도 0)
+    constexpr double kMaxExactInt = 9007199254740992.0;
+    if (std::fabs(d) <= kMaxExactInt && std::floor(d) == d) {
+        appendInt(out, qint64(d));
+        return;
+    }
+    // 최단 왕복 유효숫자는 지수 표기로 받고, 고정 표기가 더 짧거나 같으면 그쪽으로 다시 쓴다.
+    // (std::to_chars 의 고정 표기는 큰 수를 정확한 정수 자릿수로 쓰므로 Qt 와 다르다 — 직접 조립)
+    char sci[32];
+    const auto r = std::to_chars(sci, sci + sizeof sci, d, std::chars_format::scientific);
+    const int sciLen = int(r.ptr - sci);
+
+    const char* p = sci;
+    const bool neg = (*p == '-');
+    if (neg) ++p;
+    char digits[20];
+    int nd = 0;
+    for (; *p != 'e'; ++p)
+        if (*p != '.') digits[nd++] = *p;
+    int exp10 = 0;
+    std::from_chars(p + 1 + (p[1] == '+'), r.ptr, exp10);
+    const int decpt = exp10 + 1;    // 소수점 앞 자릿수
+
+    const int fixedLen = decpt <= 0 ? 2 - decpt + nd : (decpt < nd ? nd + 1 : decpt);
+    if (fixedLen > sciLen - int(neg)) {
+        out.append(sci, sciLen);
+        return;
+    }
+    if (neg) out.append('-');
+    if (decpt <= 0) {
+        out.append("0.", 2);
+        out.append(-decpt, '0');
+        out.append(digits, nd);
+    } else if (decpt < nd) {
+        out.append(digits, decpt);
+        out.append('.');
+        out.append(digits + decpt, nd - decpt);
+    } else {
+        out.append(digits, nd);
+        out.append(decpt - nd, '0');
+    }
+}
+
+} // namespace JsonText
+
+namespace CborText {
+
+void appendHead(QByteArray& out, int major, quint64 v)
+{
+    const char mt = char(major << 5);
+    if (v < 24) {
+        out.append(char(mt | char(v)));
+    } else if (v <= 0xFF) {
+        out.append(char(mt | 24));
+        appendBigEndian(out, v, 1);
+    } else if (v <= 0xFFFF) {
+        out.append(char(mt | 25));
+        appendBigEndian(out, v, 2);
+    } else if (v <= 0xFFFFFFFFu) {
+        out.append(char(mt | 26));
+        appendBigEndian(out, v, 4);
+    } else {
+        out.append(char(mt | 27));
+        appendBigEndian(out, v, 8);
+    }
+}
+
+void appendString(QByteArray& out, const QString& s)
+{
+    const QChar* u = s.constData();
+    const qsizetype n = s.size();
+    qsizetype i = 0;
+    while (i < n && u[i].unicode() < 0x80) ++i;
+    if (i == n) {
+        // ASCII: UTF-8 길이 = 글자 수 (toUtf8 임시 버퍼 없음)
+        appendHead(out, 3, quint64(n));
+        const qsizetype base = out.size();
+        out.resize(base + n);
+        char* d = out.data() + base;
+        for (qsizetype k = 0; k < n; ++k)
+            d[k] = char(u[k].unicode());
+    } else {
+        const QByteArray utf8 = s.toUtf8();
+        appendHead(out, 3, quint64(utf8.size()));
+        out.append(utf8);
+    }
+}
+
+void appendLatin1(QByteArray& out, const char* s)
+{
+    const qsizetype n = qsizetype(std::strlen(s));
+    appendHead(out, 3, quint64(n));
+    out.append(s, n);
+}
+
+void appendInt(QByteArray& out, qint64 v)
+{
+    if (v >= 0) appendHead(out, 0, quint64(v));
+    else        appendHead(out, 1, quint64(-1 - v));
+}
+
+void appendDouble(QByteArray& out, double d)
+{
+    // WireFormat::encode 와 같은 축약: 정수값 → 정수, float32 로 손실 없음 → float32, 그 외 float64
+    if (std::floor(d) == d && std::fabs(d) < 9.0e15) {
+        appendInt(out, qint64(d));
+        return;
+    }
+    const float f = float(d);
+    if (double(f) == d) {
+        quint32 bits;
+        std::memcpy(&bits, &f, sizeof bits);
+        out.append(char(0xFA));
+        appendBigEndian(out, bits, 4);
+        return;
+    }
+    quint64 bits;
+    std::memcpy(&bits, &d, sizeof bits);
+    out.append(char(0xFB));
+    appendBigEndian(out, bits, 8);
+}
+
+} // namespace CborText
+
+JsonTemplate::JsonTemplate(const char* pattern)
+{
+    QByteArray cur;
+    for (const char* p = pattern; *p; ++p) {
+        if (p[0] == '%' && p[1] && std::strchr("sdfbr", p[1])) {
+            m_lits.push_back(cur);
+            m_holes.push_back(p[1]);
+            cur.clear();
+            ++p;
+        } else {
+            cur.append(*p);
+        }
+    }
+    m_lits.push_back(cur);
+    compileCbor();
+}
+
+void JsonTemplate::compileCbor()
+{
+    QByteArray marked = m_lits.first();
+    for (int i = 0; i < m_holes.size(); ++i) {
+        marked.append("\"\\u0000");
+        marked.append(QByteArray::number(i));
+        marked.append('"');
+        marked.append(m_lits[i + 1]);
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson(marked);
+    if (!doc.isObject())
+        return;     // 조각 패턴 ("dir":%d,... 처럼 객체가 아님)
+
+    QVector<QByteArray> lits;
+    CborCompiler c{lits};
+    c.object(doc.object());
+    if (!c.ok || c.next != m_holes.size()) {
+        Q_ASSERT_X(false, "JsonTemplate", "pattern keys must be in sorted order");
+        return;
+    }
+    lits.push_back(c.cur);
+    m_cborLits = std::move(lits);
+}
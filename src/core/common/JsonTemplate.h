@@ -0,0 +1,120 @@
+#ifndef JSONTEMPLATE_H
+#define JSONTEMPLATE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// ─────────────────────────────────────────────────────────────
+// 고정 형태 JSON 한 줄을 바이트 버퍼에 바로 쓰기
+//
+// QJsonObject → QJsonDocument::toJson(Compact) 와 바이트 단위로 같은 출력을 낸다:
+//  - 키 순서는 QJsonObject 와 같게 사전순으로 패턴에 적는다.
+//  - 문자열: " \ \b \f \n \r \t 와 0x20 미만(\u00xx)만 이스케이프, 나머지는 UTF-8 그대로.
+//  - 정수: std::to_chars.
+//  - 실수: |d| ≤ 2^53 인 정수값은 정수로, 그 외는 최단 왕복 표기
+//          (고정/지수 중 짧은 쪽, 같으면 고정. 지수는 최소 두 자리) — Qt 'g' shortest 와 같음.
+//          NaN/Inf 는 null.
+//
+// 패턴: 값 자리에 %s(문자열) %d(정수) %f(실수) %b(bool) %r(이미 만든 JSON 조각).
+// 생성 시 한 번 리터럴 조각으로 나눠 두고 render() 는 조각 복사 + 값 변환만 한다.
+//
+//   static const JsonTemplate t(R"({"dir":11,"robot":%s,"seq":%d})");
+//   t.render(buf, robot, int(seq));
+//
+// renderCbor(): 같은 인자로 같은 객체를 CBOR 데이터 항목 하나로 쓴다 (cbor1 피어용, JSON 텍스트 거치지 않음).
+//  - 패턴이 완전한 객체일 때만 쓸 수 있다 (조각 패턴은 hasCbor()=false).
+//  - 출력은 WireFormat::encode(obj, Cbor) 의 본문과 바이트 단위로 같다 (정수/float32 축약 규칙 포함).
+//  - %r 자리에는 CBOR 조각을 넣는다 (다른 템플릿의 renderCbor 결과 등).
+// ─────────────────────────────────────────────────────────────
+namespace JsonText {
+
+void appendString(QByteArray& out, const QString& s);
+void appendLatin1(QByteArray& out, const char* s);     // ASCII 상수 문자열 (이스케이프 포함)
+void appendInt(QByteArray& out, qint64 v);
+void appendDouble(QByteArray& out, double d);
+inline void appendBool(QByteArray& out, bool b) { out.append(b ? "true" : "false"); }
+
+} // namespace JsonText
+
+// CBOR 데이터 항목 직접 쓰기 (RFC 8949 최소 길이 헤더)
+namespace CborText {
+
+void appendHead(QByteArray& out, int major, quint64 v);
+inline void appendMap(QByteArray& out, int pairs) { appendHead(out, 5, quint64(pairs)); }
+void appendString(QByteArray& out, const QString& s);
+void appendLatin1(QByteArray& out, const char* s);
+void appendInt(QByteArray& out, qint64 v);
+void appendDouble(QByteArray& out, double d);       // 정수값 → 정수, float32 로 손실 없으면 float32
+inline void appendBool(QByteArray& out, bool b) { out.append(char(b ? 0xF5 : 0xF4)); }
+
+} // namespace CborText
+
+class JsonTemplate
+{
+public:
+    // %r 자리에 넣을 완성된 JSON 조각 (renderCbor 에서는 CBOR 조각)
+    struct Raw { const QByteArray& bytes; };
+
+    explicit JsonTemplate(const char* pattern);
+
+    int holes() const { return m_holes.size(); }
+    bool hasCbor() const { return !m_cborLits.isEmpty(); }
+
+    // 인자 개수/종류는 패턴의 자리와 같아야 한다 (디버그 빌드에서 확인)
+    template <typename... Args>
+    void render(QByteArray& out, const Args&... args) const
+    {
+        Q_ASSERT(int(sizeof...(Args)) == m_holes.size());
+        int i = 0;
+        (put(out, i++, args), ...);
+        out.append(m_lits.last());
+    }
+
+    template <typename... Args>
+    void renderCbor(QByteArray& out, const Args&... args) const
+    {
+        Q_ASSERT(hasCbor());
+        Q_ASSERT(int(sizeof...(Args)) == m_holes.size());
+        int i = 0;
+        (putCbor(out, i++, args), ...);
+        out.append(m_cborLits.last());
+    }
+
+private:
+    void lit(QByteArray& out, int i, char kind) const
+    {
+        Q_ASSERT(m_holes[i] == kind);
+        Q_UNUSED(kind);
+        out.append(m_lits[i]);
+    }
+    void put(QByteArray& out, int i, const QString& v) const  { lit(out, i, 's'); JsonText::appendString(out, v); }
+    void put(QByteArray& out, int i, const char* v) const     { lit(out, i, 's'); JsonText::appendLatin1(out, v); }
+    void put(QByteArray& out, int i, int v) const             { lit(out, i, 'd'); JsonText::appendInt(out, v); }
+    void put(QByteArray& out, int i, qint64 v) const          { lit(out, i, 'd'); JsonText::appendInt(out, v); }
+    void put(QByteArray& out, int i, double v) const          { lit(out, i, 'f'); JsonText::appendDouble(out, v); }
+    void put(QByteArray& out, int i, bool v) const            { lit(out, i, 'b'); JsonText::appendBool(out, v); }
+    void put(QByteArray& out, int i, const Raw& v) const      { lit(out, i, 'r'); out.append(v.bytes); }
+
+    void cborLit(QByteArray& out, int i, char kind) const
+    {
+        Q_ASSERT(m_holes[i] == kind);
+        Q_UNUSED(kind);
+        out.append(m_cborLits[i]);
+    }
+    void putCbor(QByteArray& out, int i, const QString& v) const { cborLit(out, i, 's'); CborText::appendString(out, v); }
+    void putCbor(QByteArray& out, int i, const char* v) const    { cborLit(out, i, 's'); CborText::appendLatin1(out, v); }
+    void putCbor(QByteArray& out, int i, int v) const            { cborLit(out, i, 'd'); CborText::appendInt(out, v); }
+    void putCbor(QByteArray& out, int i, qint64 v) const         { cborLit(out, i, 'd'); CborText::appendInt(out, v); }
+    void putCbor(QByteArray& out, int i, double v) const         { cborLit(out, i, 'f'); CborText::appendDouble(out, v); }
+    void putCbor(QByteArray& out, int i, bool v) const           { cborLit(out, i, 'b'); CborText::appendBool(out, v); }
+    void putCbor(QByteArray& out, int i, const Raw& v) const     { cborLit(out, i, 'r'); out.append(v.bytes); }
+
+    void compileCbor();
+
+    QVector<QByteArray> m_lits;    // holes()+1 개
+    QVector<QByteArray> m_cborLits; // 같은 자리의 CBOR 조각 (조각 패턴이면 비어 있음)
+    QVector<char> m_holes;
+};
+
+#endif // JSONTEMPLATE_H
@@ -0,0 +1,36 @@
+#include "LogCategories.h"
+
+#include <QCoreApplication>
+#include <QFile>
+
+Q_LOGGING_CATEGORY(lcModbus, "mrc.modbus", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcOrch,   "mrc.orch",   QtInfoMsg)
+Q_LOGGING_CATEGORY(lcVision, "mrc.vision", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcGantry, "mrc.gantry", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcTf,     "mrc.tf",     QtInfoMsg)
+
+namespace LogCategories {
+
+QString applyRules(const QString& rulesFile)
+{
+    QString rules;
+
+    const QString path = rulesFile.isEmpty()
+        ? QCoreApplication::applicationDirPath() + QStringLiteral("/logging.rules")
+        : rulesFile;
+    QFile f(path);
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text))
+        rules = QString::fromUtf8(f.readAll());
+
+    const QString env = qEnvironmentVariable("MRC_LOG_RULES");
+    if (!env.isEmpty()) {
+        if (!rules.isEmpty() && !rules.endsWith('\n')) rules += '\n';
+        rules += QString(env).replace(';', '\n');
+    }
+
+    if (!rules.isEmpty())
+        QLoggingCategory::setFilterRules(rules);
+    return rules;
+}
+
+} // namespace LogCategories
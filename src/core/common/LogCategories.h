@@ -0,0 +1,33 @@
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+
+#include <QLoggingCategory>
+
+// ─────────────────────────────────────────────────────────────
+// 서브시스템별 로그 카테고리
+//
+//   qCDebug(lcVision) << "..." << x;
+//
+//  - qCDebug/qCInfo 는 카테고리가 꺼져 있으면 << 뒤의 인자를 평가하지 않는다 (분기 하나).
+//    문자열 조립(QString::arg, toString)은 반드시 << 뒤에 둔다.
+//  - 기본: 모든 카테고리 debug 꺼짐, info 이상 켜짐.
+//  - 실행 중 규칙: QT_LOGGING_RULES 형식 ("mrc.vision.debug=true", "mrc.*.debug=true")
+//      1) 실행 파일 옆 logging.rules
+//      2) 환경변수 MRC_LOG_RULES (';' 구분, 파일보다 나중에 적용)
+//  - 빌드 옵션 MRC_NO_DEBUG_LOG=ON 이면 QT_NO_DEBUG_OUTPUT 으로 debug 문장 자체를 컴파일에서 뺀다.
+// ─────────────────────────────────────────────────────────────
+Q_DECLARE_LOGGING_CATEGORY(lcModbus)    // "mrc.modbus"  로봇/모터 모드버스
+Q_DECLARE_LOGGING_CATEGORY(lcOrch)      // "mrc.orch"    Orchestrator, RobotManager, 모델
+Q_DECLARE_LOGGING_CATEGORY(lcVision)    // "mrc.vision"  비전 클라이언트/서버
+Q_DECLARE_LOGGING_CATEGORY(lcGantry)    // "mrc.gantry"  갠트리/컨베이어 모터
+Q_DECLARE_LOGGING_CATEGORY(lcTf)        // "mrc.tf"      좌표/오일러 변환
+
+namespace LogCategories {
+
+// logging.rules + MRC_LOG_RULES 를 읽어 QLoggingCategory::setFilterRules 에 적용.
+// 적용한 규칙 문자열을 반환 (없으면 빈 문자열)
+QString applyRules(const QString& rulesFile = QString());
+
+} // namespace LogCategories
+
+#endif // LOGCATEGORIES_H
@@ -0,0 +1,32 @@
+#include "MonoClock.h"
+
+namespace MonoClock {
+
+const Anchor& anchor()
+{
+    static const Anchor a{QDateTime::currentMSecsSinceEpoch(), nowNs()};
+    return a;
+}
+
+qint64 toWallMs(qint64 monoMs)
+{
+    const Anchor& a = anchor();
+    return a.wallMs + (monoMs - a.monoNs / 1000000);
+}
+
+qint64 wallNowMs()
+{
+    return toWallMs(nowMs());
+}
+
+QDateTime toDateTime(qint64 monoMs)
+{
+    return QDateTime::fromMSecsSinceEpoch(toWallMs(monoMs));
+}
+
+QString toString(qint64 monoMs, const QString& format)
+{
+    return toDateTime(monoMs).toString(format);
+}
+
+} // namespace MonoClock
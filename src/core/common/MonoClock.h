@@ -0,0 +1,45 @@
+#ifndef MONOCLOCK_H
+#define MONOCLOCK_H
+
+#include <QDateTime>
+#include <QString>
+#include <QtGlobal>
+
+#include <chrono>
+
+// ─────────────────────────────────────────────────────────────
+// 단조 시계 (제어 경로 공용 시간 기준)
+//
+//  - nowNs/nowUs/nowMs: steady_clock (Linux CLOCK_MONOTONIC, Windows QPC). NTP/수동 시계 변경에
+//    영향 없고 시간대 변환도 없다. 지연 측정, 디바운스, 타임아웃, 모듈 간 시각 비교는 모두 이것으로.
+//    값의 원점은 의미 없음 (부팅 기준 등) → 차이만 쓴다.
+//  - 벽시계는 세션 시작 때 한 번만 읽어 앵커로 둔다 (anchor()). 표시/파일 이름/로그 줄 시각은
+//    toWallMs()/toDateTime()/toString() 으로 변환해서 쓴다. 세션 중 벽시계가 바뀌어도 반영하지 않는다.
+// ─────────────────────────────────────────────────────────────
+namespace MonoClock {
+
+inline qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline qint64 nowUs() { return nowNs() / 1000; }
+inline qint64 nowMs() { return nowNs() / 1000000; }
+
+struct Anchor {
+    qint64 wallMs;      // 앵커 시점 벽시계 (ms since epoch)
+    qint64 monoNs;      // 같은 시점 nowNs()
+};
+
+// 처음 호출될 때 한 번 잡는다 (main 에서 미리 호출해 둘 것)
+const Anchor& anchor();
+
+// ── 표시용 변환 (단조 ms/ns → 벽시계)
+qint64 toWallMs(qint64 monoMs);
+qint64 wallNowMs();                 // = toWallMs(nowMs()), 세션 안에서 되돌아가지 않음
+QDateTime toDateTime(qint64 monoMs);
+QString toString(qint64 monoMs, const QString& format = QStringLiteral("hh:mm:ss.zzz"));
+
+} // namespace MonoClock
+
+#endif // MONOCLOCK_H
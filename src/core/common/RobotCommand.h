@@ -8,9 +8,32 @@
 enum class RobotId {
     A,
     B,
+    C,
+    D,
+    E,
+    F,
+    G,
+    H,
     Unknown
 };
 
+// 프로토콜의 로봇 id 는 한 글자("a".."h") → 조밀 인덱스 0..kMaxRobots-1.
+// 셀을 더 늘리려면 여기에 글자를 추가한다 (로봇별 고정 배열은 모두 kMaxRobots 로 잡혀 있음)
+constexpr int kMaxRobots = int(RobotId::Unknown);
+
+inline int robotIndex(RobotId r)
+{
+    return r == RobotId::Unknown ? -1 : int(r);
+}
+
+// 문자열 비교 없이 첫 글자로 판별 (대소문자 무시)
+inline int robotIndex(const QString& s)
+{
+    if (s.size() != 1) return -1;
+    const int i = s.at(0).toLower().unicode() - 'a';
+    return (i >= 0 && i < kMaxRobots) ? i : -1;
+}
+
 enum class CmdType {
     Tool,
     Bulk,
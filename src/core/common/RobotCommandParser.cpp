@@ -1,38 +1,64 @@
 #include "RobotCommandParser.h"
 
+#include <QJsonDocument>
+
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
 static RobotId parseRobotId(const QString& s)
 {
-    const auto lower = s.toLower();
-    if (lower == "a") return RobotId::A;
-    if (lower == "b") return RobotId::B;
-    return RobotId::Unknown;
+    const int i = robotIndex(s);
+    return i < 0 ? RobotId::Unknown : RobotId(i);
 }
 
+namespace {
+
+struct TypeName { const char* name; CmdType type; };
+struct KindName { const char* name; CmdKind kind; };
+
+constexpr TypeName kTypeNames[] = {
+    {"bulk",     CmdType::Bulk},
+    {"sorting",  CmdType::Sorting},
+    {"conveyor", CmdType::Conveyor},
+    {"align",    CmdType::Align},
+    {"tool",     CmdType::Tool},
+};
+
+constexpr KindName kKindNames[] = {
+    //{"ready",  CmdKind::Ready},
+    {"standby", CmdKind::Ready},
+    {"pick",    CmdKind::Pick},
+    {"place",   CmdKind::Place},
+    {"clamp",   CmdKind::Clamp},
+    {"init",    CmdKind::Init},
+    {"assy",    CmdKind::Assy},
+    {"forward", CmdKind::Forward},
+    {"scrap",   CmdKind::Scrap},
+    {"mount",   CmdKind::Tool_Mount},
+    {"unmount", CmdKind::Tool_UnMount},
+    {"change",  CmdKind::Tool_Change},
+    {"arrange", CmdKind::Arrange},
+};
+
+std::atomic<int> g_captureRaw{-1};   // -1: 아직 환경변수 확인 전
+
+} // namespace
+
 static CmdType parseCmdType(const QString& s)
 {
-    if (s == "bulk")   return CmdType::Bulk;
-    if (s == "sorting")   return CmdType::Sorting;
-    if (s == "conveyor")  return CmdType::Conveyor;
-    if (s == "align")     return CmdType::Align;
-    if (s == "tool")     return CmdType::Tool;
+    for (const auto& t : kTypeNames)
+        if (s == QLatin1String(t.name)) return t.type;
     return CmdType::Unknown;
 }
 
 static CmdKind parseCmdKind(const QString& s)
 {
-    //if (s == "ready")   return CmdKind::Ready;
-    if (s == "standby")   return CmdKind::Ready;
-    if (s == "pick")    return CmdKind::Pick;
-    if (s == "place")   return CmdKind::Place;
-    if (s == "clamp")   return CmdKind::Clamp;
-    if (s == "init")    return CmdKind::Init;
-    if (s == "assy")    return CmdKind::Assy;
-    if (s == "forward") return CmdKind::Forward;
-    if (s == "scrap") return CmdKind::Scrap;
-    if (s == "mount") return CmdKind::Tool_Mount;
-    if (s == "unmount") return CmdKind::Tool_UnMount;
-    if (s == "change") return CmdKind::Tool_Change;
-    if (s == "arrange") return CmdKind::Arrange;
+    for (const auto& k : kKindNames)
+        if (s == QLatin1String(k.name)) return k.kind;
     return CmdKind::Unknown;
 }
 
@@ -158,8 +184,442 @@ bool RobotCommandParser::parse(const QJsonObject& obj, RobotCommand& out)
     if (obj.contains("place") && obj["place"].isObject()) {
         out.hasPlace = parsePoseObj(obj["place"].toObject(), out.place);
     }
-    out.raw = obj;
+    if (captureRaw()) out.raw = obj;
 
     // dir!=1 은 상위에서 거를 수 있도록 그대로 반환하거나, 여기서 false 처리할지 선택
     return true;
 }
+
+CmdType RobotCommandParser::typeFromName(const QString& s)
+{
+    return parseCmdType(s);
+}
+
+CmdKind RobotCommandParser::kindFromName(const QString& s)
+{
+    return parseCmdKind(s);
+}
+
+const char* RobotCommandParser::typeName(CmdType t)
+{
+    for (const auto& e : kTypeNames)
+        if (e.type == t) return e.name;
+    return "";
+}
+
+const char* RobotCommandParser::kindName(CmdKind k)
+{
+    for (const auto& e : kKindNames)
+        if (e.kind == k) return e.name;
+    return "";
+}
+
+bool RobotCommandParser::captureRaw()
+{
+    int v = g_captureRaw.load(std::memory_order_relaxed);
+    if (v < 0) {
+        v = qEnvironmentVariableIntValue("MRC_CMD_RAW") != 0 ? 1 : 0;
+        g_captureRaw.store(v, std::memory_order_relaxed);
+    }
+    return v != 0;
+}
+
+void RobotCommandParser::setCaptureRaw(bool on)
+{
+    g_captureRaw.store(on ? 1 : 0, std::memory_order_relaxed);
+}
+
+// ─────────────────────────────────────────────────────────────
+// 단일 패스 디코더
+// - 알려진 키만 해석하고 나머지 값은 문법만 확인하며 건너뛴다.
+// - 알려진 키의 값은 DOM 경로의 toString()/toInt()/toDouble() 과 같은 규칙으로 채운다
+//   (타입이 다르면 기본값).
+// - 이스케이프가 있는 키/문자열 값, 너무 깊은 중첩, 문법 오류는 false → DOM 경로로.
+// - 비ASCII 바이트(UTF-8 검증은 DOM 파서 몫)와 알려진 키의 중복도 false → DOM 경로로.
+// ─────────────────────────────────────────────────────────────
+namespace {
+
+struct Span {
+    const char* p = nullptr;
+    int n = 0;
+    bool present = false;
+
+    template <int N>
+    bool is(const char (&lit)[N]) const { return n == N - 1 && std::memcmp(p, lit, N - 1) == 0; }
+    QString str() const { return QString::fromUtf8(p, n); }
+};
+
+struct PoseField {
+    Pose6D pose{};
+    bool ok = false;      // 6개 키가 모두 있음 (parsePoseObj 와 동일)
+};
+
+constexpr int kMaxDepth = 32;
+
+class Reader
+{
+public:
+    Reader(const char* b, const char* e) : m_p(b), m_e(e) {}
+
+    void ws() { while (m_p < m_e && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n')) ++m_p; }
+    bool atEnd() { ws(); return m_p == m_e; }
+    char peek() { ws(); return m_p < m_e ? *m_p : '\0'; }
+    bool eat(char c) { if (peek() != c) return false; ++m_p; return true; }
+
+    // 이스케이프/비ASCII 없는 문자열만 (있으면 false → DOM 경로)
+    bool string(Span& out)
+    {
+        if (!eat('"')) return false;
+        const char* b = m_p;
+        while (m_p < m_e && *m_p != '"') {
+            if (*m_p == '\\' || uchar(*m_p) < 0x20 || uchar(*m_p) >= 0x80) return false;
+            ++m_p;
+        }
+        if (m_p == m_e) return false;
+        out.p = b;
+        out.n = int(m_p - b);
+        out.present = true;
+        ++m_p;
+        return true;
+    }
+
+    bool number(double& v)
+    {
+        ws();
+        const char* b = m_p;
+        const char* p = m_p;
+        if (p < m_e && *p == '-') ++p;
+        if (p == m_e) return false;
+        if (*p == '0') ++p;
+        else if (*p >= '1' && *p <= '9') { while (p < m_e && isDigit(*p)) ++p; }
+        else return false;
+        if (p < m_e && *p == '.') {
+            ++p;
+            if (p == m_e || !isDigit(*p)) return false;
+            while (p < m_e && isDigit(*p)) ++p;
+        }
+        if (p < m_e && (*p == 'e' || *p == 'E')) {
+            ++p;
+            if (p < m_e && (*p == '+' || *p == '-')) ++p;
+            if (p == m_e || !isDigit(*p)) return false;
+            while (p < m_e && isDigit(*p)) ++p;
+        }
+        const auto r = std::from_chars(b, p, v);
+        if (r.ec != std::errc() || r.ptr != p) return false;
+        m_p = p;
+        return true;
+    }
+
+    bool literal(const char* lit, int n)
+    {
+        ws();
+        if (m_e - m_p < n || std::memcmp(m_p, lit, size_t(n)) != 0) return false;
+        m_p += n;
+        return true;
+    }
+
+    // 값 하나를 문법 검사만 하며 건너뛴다 (문자열 이스케이프 허용)
+    bool skip(int depth = 0)
+    {
+        if (depth > kMaxDepth) return false;
+        switch (peek()) {
+        case '"': {
+            ++m_p;
+            while (m_p < m_e && *m_p != '"') {
+                if (uchar(*m_p) < 0x20 || uchar(*m_p) >= 0x80) return false;
+                if (*m_p == '\\') { if (++m_p == m_e) return false; }
+                ++m_p;
+            }
+            if (m_p == m_e) return false;
+            ++m_p;
+            return true;
+        }
+        case '{':
+            return object(depth + 1, [this, depth](const Span&) { return skip(depth + 1); });
+        case '[': {
+            ++m_p;
+            if (eat(']')) return true;
+            do { if (!skip(depth + 1)) return false; } while (eat(','));
+            return eat(']');
+        }
+        case 't': return literal("true", 4);
+        case 'f': return literal("false", 5);
+        case 'n': return literal("null", 4);
+        default: { double d; return number(d); }
+        }
+    }
+
+    // {"key": value, ...}  onKey(key) 가 값을 소비한다
+    template <typename OnKey>
+    bool object(int depth, OnKey&& onKey)
+    {
+        if (depth > kMaxDepth || !eat('{')) return false;
+        if (eat('}')) return true;
+        do {
+            Span key;
+            if (!string(key) || !eat(':') || !onKey(key)) return false;
+        } while (eat(','));
+        return eat('}');
+    }
+
+    // 값 종류별 읽기: 타입이 다르면 DOM 의 기본값 규칙대로 (값은 건너뜀)
+    bool toInt(int& out, int def = 0)
+    {
+        if (!isNumberStart(peek())) { out = def; return skip(); }
+        double d;
+        if (!number(d)) return false;
+        out = (std::floor(d) == d && d >= std::numeric_limits<int>::min() && d <= std::numeric_limits<int>::max())
+                  ? int(d) : def;
+        return true;
+    }
+
+    bool toDouble(double& out)
+    {
+        if (!isNumberStart(peek())) { out = 0.0; return skip(); }
+        return number(out);
+    }
+
+    bool toBool(bool& out)
+    {
+        const char c = peek();
+        if (c == 't') { out = true;  return literal("true", 4); }
+        if (c == 'f') { out = false; return literal("false", 5); }
+        out = false;
+        return skip();
+    }
+
+    // 문자열이 아니면 present=false (→ 호출 측 기본값)
+    bool toSpan(Span& out)
+    {
+        if (peek() != '"') { out = Span{}; return skip(); }
+        return string(out);
+    }
+
+    bool pose(int depth, PoseField& out)
+    {
+        if (peek() != '{') return skip();   // 객체가 아니면 DOM 경로도 무시
+        unsigned seen = 0;
+        double v[6] = {0, 0, 0, 0, 0, 0};
+        const bool ok = object(depth + 1, [&](const Span& k) {
+            int i = -1;
+            if      (k.is("x"))  i = 0;
+            else if (k.is("y"))  i = 1;
+            else if (k.is("z"))  i = 2;
+            else if (k.is("rx")) i = 3;
+            else if (k.is("ry")) i = 4;
+            else if (k.is("rz")) i = 5;
+            if (i < 0) return skip(depth + 1);
+            if (seen & (1u << i)) return false;   // 중복 키
+            seen |= 1u << i;
+            return toDouble(v[i]);
+        });
+        if (!ok) return false;
+        out.ok = (seen == 0x3F);
+        if (out.ok) out.pose = Pose6D{v[0], v[1], v[2], v[3], v[4], v[5]};
+        return true;
+    }
+
+private:
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static bool isNumberStart(char c) { return c == '-' || isDigit(c); }
+
+    const char* m_p;
+    const char* m_e;
+};
+
+bool sameName(const Span& s, const char* name)
+{
+    const size_t n = std::strlen(name);
+    return size_t(s.n) == n && std::memcmp(s.p, name, n) == 0;
+}
+
+CmdType cmdTypeOf(const Span& s)
+{
+    for (const auto& t : kTypeNames)
+        if (sameName(s, t.name)) return t.type;
+    return CmdType::Unknown;
+}
+
+CmdKind cmdKindOf(const Span& s)
+{
+    for (const auto& k : kKindNames)
+        if (sameName(s, k.name)) return k.kind;
+    return CmdKind::Unknown;
+}
+
+} // namespace
+
+bool RobotCommandParser::decode(const char* data, int size, RobotCommand& out, Extras* extras)
+{
+    Reader rd(data, data + size);
+
+    Span robot, type, kind, clamp, mode, status, message, proto;
+    int seq = 0, dir = 0, offset = 0, clampMode = 0;
+    bool flip = false;
+    PoseField pose, pick, place, arrStart, arrDest;
+    bool hasPoseObj = false, hasPickObj = false, hasPlaceObj = false;
+    bool hasTool = false, hasOffsetObj = false, hasArrange = false;
+    bool arrHasStart = false, arrHasDest = false;
+    Span toolName, toolFrom, toolTo;
+    bool toolHasName = false, toolHasFrom = false, toolHasTo = false;
+    int offHeight = 0, offThickness = 0;
+    bool offHasHeight = false, offHasThickness = false;
+
+    // 알려진 키가 두 번 나오면 DOM 경로로 (중복 키 처리는 QJsonDocument 규칙에 맡김)
+    quint32 seenKeys = 0;
+    auto once = [&](const Span& k) -> bool {
+        static constexpr const char* kKnown[] = {
+            "robot", "type", "kind", "seq", "dir", "flip", "clamp", "mode", "clamp_mode",
+            "status", "message", "proto", "pose", "pick", "place", "offset", "tool", "arrange",
+        };
+        for (int i = 0; i < int(std::size(kKnown)); ++i) {
+            if (!sameName(k, kKnown[i])) continue;
+            if (seenKeys & (1u << i)) return false;
+            seenKeys |= 1u << i;
+            return true;
+        }
+        return true;   // 모르는 키는 건너뛰므로 중복이어도 무관
+    };
+
+    const bool ok = rd.object(0, [&](const Span& k) -> bool {
+        if (!once(k))           return false;
+        if (k.is("robot"))      return rd.toSpan(robot);
+        if (k.is("type"))       return rd.toSpan(type);
+        if (k.is("kind"))       return rd.toSpan(kind);
+        if (k.is("seq"))        return rd.toInt(seq);
+        if (k.is("dir"))        return rd.toInt(dir);
+        if (k.is("flip"))       return rd.toBool(flip);
+        if (k.is("clamp"))      return rd.toSpan(clamp);
+        if (k.is("mode"))       return rd.toSpan(mode);
+        if (k.is("clamp_mode")) return rd.toInt(clampMode);
+        if (k.is("status"))     return rd.toSpan(status);
+        if (k.is("message"))    return rd.toSpan(message);
+        if (k.is("proto"))      return rd.toSpan(proto);
+        if (k.is("pose"))  { hasPoseObj  = rd.peek() == '{'; return rd.pose(1, pose); }
+        if (k.is("pick"))  { hasPickObj  = rd.peek() == '{'; return rd.pose(1, pick); }
+        if (k.is("place")) { hasPlaceObj = rd.peek() == '{'; return rd.pose(1, place); }
+        if (k.is("offset")) {
+            if (rd.peek() != '{') { hasOffsetObj = false; return rd.toInt(offset); }
+            hasOffsetObj = true;
+            offset = 0;   // 객체면 toInt() 는 기본값
+            offHasHeight = offHasThickness = false;
+            return rd.object(2, [&](const Span& fk) -> bool {
+                if (fk.is("height"))    { if (offHasHeight) return false;    offHasHeight = true;    return rd.toInt(offHeight); }
+                if (fk.is("thickness")) { if (offHasThickness) return false; offHasThickness = true; return rd.toInt(offThickness); }
+                return rd.skip(2);
+            });
+        }
+        if (k.is("tool")) {
+            hasTool = rd.peek() == '{';
+            if (!hasTool) return rd.skip();
+            toolHasName = toolHasFrom = toolHasTo = false;
+            return rd.object(2, [&](const Span& tk) -> bool {
+                if (tk.is("name")) { if (toolHasName) return false; toolHasName = true; return rd.toSpan(toolName); }
+                if (tk.is("from")) { if (toolHasFrom) return false; toolHasFrom = true; return rd.toSpan(toolFrom); }
+                if (tk.is("to"))   { if (toolHasTo)   return false; toolHasTo   = true; return rd.toSpan(toolTo); }
+                return rd.skip(2);
+            });
+        }
+        if (k.is("arrange")) {
+            hasArrange = rd.peek() == '{';
+            if (!hasArrange) return rd.skip();
+            arrHasStart = arrHasDest = false;
+            return rd.object(2, [&](const Span& ak) -> bool {
+                if (ak.is("start")) { if (arrHasStart) return false; arrHasStart = true; return rd.pose(3, arrStart); }
+                if (ak.is("dest"))  { if (arrHasDest)  return false; arrHasDest  = true; return rd.pose(3, arrDest); }
+                return rd.skip(2);
+            });
+        }
+        return rd.skip();
+    });
+    if (!ok || !rd.atEnd())
+        return false;   // 문법 오류/이스케이프/깊은 중첩 → DOM 경로에서 판정
+    if (type.is("subscribe") || type.is("unsubscribe"))
+        return false;   // 스트림 구독 요청 (드묾) → DOM 경로
+
+    // ── parse(const QJsonObject&) 와 같은 순서/규칙으로 채운다
+    const bool robotB = !robot.present || robot.is("b") || robot.is("B");   // 기본값 "B"
+    if (!robot.present) out.robot = RobotId::B;
+    else {
+        const int i = (robot.n == 1) ? ((robot.p[0] | 0x20) - 'a') : -1;
+        out.robot = (i >= 0 && i < kMaxRobots) ? RobotId(i) : RobotId::Unknown;
+    }
+    out.type  = type.present ? cmdTypeOf(type) : CmdType::Unknown;
+    out.kind  = kind.present ? cmdKindOf(kind) : CmdKind::Unknown;
+    out.seq   = quint32(seq);
+    out.dir   = dir;
+    out.flip  = flip;
+    out.offset = offset;
+    out.clamp = clamp.present ? clamp.str() : QString();
+    out.mode  = mode.present ? mode.str() : QStringLiteral("dual");
+
+    if (hasPoseObj) {
+        switch (out.kind) {
+        case CmdKind::Pick:
+            out.hasPick = pose.ok;
+            if (pose.ok) out.pick = pose.pose;
+            break;
+        case CmdKind::Place:
+            out.hasPlace = pose.ok;
+            if (pose.ok) out.place = pose.pose;
+            if (robotB && type.is("align") && kind.is("place"))
+                out.clampSequenceMode = clampMode;
+            break;
+        default:
+            out.hasPick = pose.ok;
+            if (pose.ok) out.pick = pose.pose;
+            break;
+        }
+    }
+    if (hasTool) {
+        const bool needName = out.kind == CmdKind::Tool_Mount || out.kind == CmdKind::Tool_UnMount;
+        const bool needFromTo = out.kind == CmdKind::Tool_Change;
+        if ((needName && !toolHasName) || (needFromTo && (!toolHasFrom || !toolHasTo))) {
+            out.isTool = false;
+        } else {
+            out.toolCmd.toolName = toolName.present ? toolName.str() : QString();
+            out.toolCmd.toolFrom = toolFrom.present ? toolFrom.str() : QString();
+            out.toolCmd.toolTo   = toolTo.present   ? toolTo.str()   : QString();
+            out.isTool = true;
+        }
+    }
+    if (hasOffsetObj) {
+        out.isOffset = offHasHeight && offHasThickness;
+        if (out.isOffset) {
+            out.sortOffset.height = offHeight;
+            out.sortOffset.thickness = offThickness;
+        }
+    }
+    if (hasArrange) {
+        out.isArrange = false;
+        if (arrHasStart && arrHasDest && arrStart.ok) {
+            out.arrangeCmd.poseOrig = arrStart.pose;
+            if (arrDest.ok) {
+                out.arrangeCmd.poseDest = arrDest.pose;
+                out.isArrange = true;
+            }
+        }
+    }
+    if (hasPickObj) {
+        out.hasPick = pick.ok;
+        if (pick.ok) out.pick = pick.pose;
+    }
+    if (hasPlaceObj) {
+        out.hasPlace = place.ok;
+        if (place.ok) out.place = place.pose;
+    }
+
+    if (extras) {
+        extras->isAck = type.is("ack");
+        if (extras->isAck) {
+            extras->status  = status.present  ? status.str()  : QString();
+            extras->message = message.present ? message.str() : QString();
+        }
+        extras->isHello = type.is("hello");
+        if (extras->isHello)
+            extras->proto = proto.present ? proto.str() : QString();
+    }
+    if (captureRaw())
+        out.raw = QJsonDocument::fromJson(QByteArray::fromRawData(data, size)).object();
+    return true;
+}
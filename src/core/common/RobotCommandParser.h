@@ -8,6 +8,30 @@ class RobotCommandParser
 {
 public:
     static bool parse(const QJsonObject& obj, RobotCommand& out);
+
+    // 명령 외에 수신 측이 쓰는 필드 (ack / hello)
+    struct Extras {
+        bool isAck = false;     // "type":"ack"
+        QString status;         // isAck 일 때만 채움
+        QString message;
+        bool isHello = false;   // "type":"hello" (프로토콜 협상 응답)
+        QString proto;          // isHello 일 때만 채움
+    };
+
+    // 한 줄 JSON → RobotCommand 직접 디코딩 (DOM/QJsonObject 생성 없음, 숫자 필드 할당 없음).
+    // 결과는 parse(QJsonDocument::fromJson(line).object()) 와 같다.
+    // 이스케이프 문자열, 깊은 중첩, 문법 오류, subscribe/unsubscribe 요청은 false → 호출 측이 DOM 경로(parse)로 처리.
+    static bool decode(const char* data, int size, RobotCommand& out, Extras* extras = nullptr);
+
+    // 프로토콜 문자열 ↔ 열거형 ("bulk", "standby" 등). 모르면 Unknown / ""
+    static CmdType typeFromName(const QString& s);
+    static CmdKind kindFromName(const QString& s);
+    static const char* typeName(CmdType t);
+    static const char* kindName(CmdKind k);
+
+    // RobotCommand::raw 채우기 (디버깅용). 기본 꺼짐, 환경변수 MRC_CMD_RAW=1 로 켬
+    static bool captureRaw();
+    static void setCaptureRaw(bool on);
 };
 
 #endif // ROBOTCOMMANDPARSER_H
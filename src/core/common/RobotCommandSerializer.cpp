@@ -1,15 +1,22 @@
 #include "RobotCommandSerializer.h"
+#include "JsonTemplate.h"
 
-static QString robotIdToString(RobotId id)
+static const char* robotIdToString(RobotId id)
 {
     switch (id) {
     case RobotId::A: return "a";
     case RobotId::B: return "b";
+    case RobotId::C: return "c";
+    case RobotId::D: return "d";
+    case RobotId::E: return "e";
+    case RobotId::F: return "f";
+    case RobotId::G: return "g";
+    case RobotId::H: return "h";
     default: return "";
     }
 }
 
-static QString cmdTypeToString(CmdType t)
+static const char* cmdTypeToString(CmdType t)
 {
     switch (t) {
     case CmdType::Tool:  return "tool";
@@ -21,7 +28,7 @@ static QString cmdTypeToString(CmdType t)
     }
 }
 
-static QString cmdKindToString(CmdKind k)
+static const char* cmdKindToString(CmdKind k)
 {
     switch (k) {
     case CmdKind::Ready:        return "standby";
@@ -75,3 +82,42 @@ QJsonObject RobotCommandSerializer::toJson(const RobotCommand& cmd)
 
     return o;
 }
+
+// toJson() 과 같은 키(사전순)·값 규칙으로 바로 쓴다: QJsonDocument(toJson(cmd)).toJson(Compact) 과 같은 바이트
+void RobotCommandSerializer::appendJson(const RobotCommand& cmd, QByteArray& out)
+{
+    static const JsonTemplate kPose(R"({"rx":%f,"ry":%f,"rz":%f,"x":%f,"y":%f,"z":%f})");
+    static const JsonTemplate kHead(R"("dir":%d,"flip":%b,"kind":%s)");
+    static const JsonTemplate kTail(R"("robot":%s,"seq":%d,"type":%s})");
+
+    auto pose = [&out](const char* key, const Pose6D& p) {
+        out.append(key);
+        kPose.render(out, p.rx, p.ry, p.rz, p.x, p.y, p.z);
+        out.append(',');
+    };
+
+    out.append('{');
+    if (cmd.kind == CmdKind::Clamp) {
+        out.append("\"clamp\":");
+        JsonText::appendString(out, cmd.clamp);
+        out.append(',');
+    }
+    kHead.render(out, cmd.dir, cmd.flip, cmdKindToString(cmd.kind));
+    out.append(',');
+    if (cmd.offset != 0) {
+        out.append("\"offset\":");
+        JsonText::appendInt(out, cmd.offset);
+        out.append(',');
+    }
+    if (cmd.hasPick)  pose("\"pick\":", cmd.pick);
+    if (cmd.hasPlace) pose("\"place\":", cmd.place);
+    kTail.render(out, robotIdToString(cmd.robot), int(cmd.seq), cmdTypeToString(cmd.type));
+}
+
+QByteArray RobotCommandSerializer::toJsonLine(const RobotCommand& cmd)
+{
+    QByteArray out;
+    out.reserve(256);
+    appendJson(cmd, out);
+    return out;
+}
@@ -8,6 +8,10 @@ class RobotCommandSerializer
 {
 public:
     static QJsonObject toJson(const RobotCommand& cmd);
+
+    // toJson() 을 Compact 로 직렬화한 것과 같은 바이트를 DOM 없이 out 뒤에 덧붙임 ('\n' 없음)
+    static void appendJson(const RobotCommand& cmd, QByteArray& out);
+    static QByteArray toJsonLine(const RobotCommand& cmd);
 };
 
 #endif // ROBOTCOMMANDSERIALIZER_H
@@ -0,0 +1,282 @@
+// AddressMapGenerated.h
+// 자동 생성 파일 - 직접 수정하지 마세요.
+// generator: tools/gen_address_map_header.py
+// sources  : AddressMap_A.json, AddressMap_B.json
+#ifndef ADDRESSMAPGENERATED_H
+#define ADDRESSMAPGENERATED_H
+
+#include <array>
+
+namespace AddressMapGen {
+
+// words == 0 : 주소가 아닌 값 (예: TARGET_QUEUE_STRIDE)
+struct Entry     { const char* name; int addr; int words; };
+// DOn_PULSE → processPulse(idx = n), idx 오름차순
+struct Pulse     { int idx; int addr; };
+
+namespace A {
+constexpr const char kId[] = "A";
+constexpr const char kResource[] = ":/map/AddressMap_A.json";
+
+namespace coils {
+constexpr int PUBLISH_PICK = 100;
+constexpr int PUBLISH_PLACE = 101;
+constexpr int DI2 = 102;
+constexpr int DI3 = 103;
+constexpr int DI4 = 104;
+constexpr int DI5 = 105;
+constexpr int DI6 = 106;
+constexpr int DI7 = 107;
+constexpr int DI8 = 108;
+constexpr int DI9 = 109;
+constexpr int DI10 = 110;
+constexpr int DI11 = 111;
+} // namespace coils
+namespace discrete_inputs {
+constexpr int ROBOT_READY = 100;
+constexpr int PICK_DONE = 101;
+constexpr int ROBOT_BUSY = 102;
+constexpr int DO3_PULSE = 103;
+constexpr int DO4_PULSE = 104;
+constexpr int DO5_PULSE = 105;
+constexpr int DO6_PULSE = 106;
+constexpr int DO7_PULSE = 107;
+constexpr int DO8_PULSE = 108;
+constexpr int DO9_PULSE = 109;
+constexpr int DO10_PULSE = 110;
+constexpr int DO11_PULSE = 111;
+constexpr int DO12_PULSE = 112;
+constexpr int DO13_PULSE = 113;
+constexpr int DO14_PULSE = 114;
+} // namespace discrete_inputs
+namespace holding {
+constexpr int TARGET_POSE_BASE = 132;
+constexpr int TARGET_POSE_PICK = 132;
+constexpr int TARGET_POSE_PLACE = 144;
+constexpr int SPEED_PCT = 146;
+constexpr int TARGET_POSE_STAGING_2_BASE = 164;
+constexpr int TARGET_QUEUE_BASE = 176;
+constexpr int TARGET_QUEUE_STRIDE = 12;
+} // namespace holding
+namespace input_registers {
+constexpr int CURR_POSE_BASE = 132;
+constexpr int ROBOT_STATUS_CODE = 144;
+constexpr int ERROR_CODE = 145;
+constexpr int ERROR_FLAGS = 146;
+constexpr int ROBOT_MODE = 147;
+constexpr int SEQ_ID_ECHO = 148;
+constexpr int MAP_SCHEMA_VER = 149;
+constexpr int FEATURE_FLAGS = 150;
+constexpr int MAGIC_0x1234 = 151;
+constexpr int HB_ROBOT = 152;
+constexpr int CYCLE_COUNT = 153;
+constexpr int LAST_DONE_TICK_BASE = 154;
+constexpr int LAST_ERROR_TICK_BASE = 156;
+constexpr int ACTIVE_POSE_ECHO_BASE = 158;
+constexpr int LATCH_POSE_BASE = 170;
+constexpr int CUR_JOINT_BASE = 340;
+constexpr int CUR_TCP_BASE = 388;
+} // namespace input_registers
+
+namespace meta {
+constexpr int schema_version = 3;
+constexpr bool word_order_hi_lo = true;
+constexpr int pose_axes = 6;
+constexpr int float32_words_per_axis = 2;
+constexpr int pose_words = 12;
+} // namespace meta
+
+constexpr std::array<Entry, 12> kCoils{{
+    Entry{ "PUBLISH_PICK", 100, 1 },
+    Entry{ "PUBLISH_PLACE", 101, 1 },
+    Entry{ "DI2", 102, 1 },
+    Entry{ "DI3", 103, 1 },
+    Entry{ "DI4", 104, 1 },
+    Entry{ "DI5", 105, 1 },
+    Entry{ "DI6", 106, 1 },
+    Entry{ "DI7", 107, 1 },
+    Entry{ "DI8", 108, 1 },
+    Entry{ "DI9", 109, 1 },
+    Entry{ "DI10", 110, 1 },
+    Entry{ "DI11", 111, 1 },
+}};
+constexpr std::array<Entry, 15> kDiscreteInputs{{
+    Entry{ "ROBOT_READY", 100, 1 },
+    Entry{ "PICK_DONE", 101, 1 },
+    Entry{ "ROBOT_BUSY", 102, 1 },
+    Entry{ "DO3_PULSE", 103, 1 },
+    Entry{ "DO4_PULSE", 104, 1 },
+    Entry{ "DO5_PULSE", 105, 1 },
+    Entry{ "DO6_PULSE", 106, 1 },
+    Entry{ "DO7_PULSE", 107, 1 },
+    Entry{ "DO8_PULSE", 108, 1 },
+    Entry{ "DO9_PULSE", 109, 1 },
+    Entry{ "DO10_PULSE", 110, 1 },
+    Entry{ "DO11_PULSE", 111, 1 },
+    Entry{ "DO12_PULSE", 112, 1 },
+    Entry{ "DO13_PULSE", 113, 1 },
+    Entry{ "DO14_PULSE", 114, 1 },
+}};
+constexpr std::array<Entry, 7> kHolding{{
+    Entry{ "TARGET_POSE_BASE", 132, 12 },
+    Entry{ "TARGET_POSE_PICK", 132, 12 },
+    Entry{ "TARGET_POSE_PLACE", 144, 12 },
+    Entry{ "SPEED_PCT", 146, 1 },
+    Entry{ "TARGET_POSE_STAGING_2_BASE", 164, 12 },
+    Entry{ "TARGET_QUEUE_BASE", 176, 192 },
+    Entry{ "TARGET_QUEUE_STRIDE", 12, 0 },
+}};
+constexpr std::array<Entry, 17> kInputRegisters{{
+    Entry{ "CURR_POSE_BASE", 132, 12 },
+    Entry{ "ROBOT_STATUS_CODE", 144, 1 },
+    Entry{ "ERROR_CODE", 145, 1 },
+    Entry{ "ERROR_FLAGS", 146, 1 },
+    Entry{ "ROBOT_MODE", 147, 1 },
+    Entry{ "SEQ_ID_ECHO", 148, 1 },
+    Entry{ "MAP_SCHEMA_VER", 149, 1 },
+    Entry{ "FEATURE_FLAGS", 150, 1 },
+    Entry{ "MAGIC_0x1234", 151, 1 },
+    Entry{ "HB_ROBOT", 152, 1 },
+    Entry{ "CYCLE_COUNT", 153, 1 },
+    Entry{ "LAST_DONE_TICK_BASE", 154, 2 },
+    Entry{ "LAST_ERROR_TICK_BASE", 156, 2 },
+    Entry{ "ACTIVE_POSE_ECHO_BASE", 158, 12 },
+    Entry{ "LATCH_POSE_BASE", 170, 12 },
+    Entry{ "CUR_JOINT_BASE", 340, 12 },
+    Entry{ "CUR_TCP_BASE", 388, 12 },
+}};
+constexpr std::array<Pulse, 12> kPulses{{
+    Pulse{ 3, 103 },
+    Pulse{ 4, 104 },
+    Pulse{ 5, 105 },
+    Pulse{ 6, 106 },
+    Pulse{ 7, 107 },
+    Pulse{ 8, 108 },
+    Pulse{ 9, 109 },
+    Pulse{ 10, 110 },
+    Pulse{ 11, 111 },
+    Pulse{ 12, 112 },
+    Pulse{ 13, 113 },
+    Pulse{ 14, 114 },
+}};
+} // namespace A
+
+namespace B {
+constexpr const char kId[] = "B";
+constexpr const char kResource[] = ":/map/AddressMap_B.json";
+
+namespace coils {
+constexpr int PUBLISH_PICK = 100;
+constexpr int PUBLISH_PLACE = 101;
+constexpr int DI2 = 102;
+constexpr int DI3 = 103;
+constexpr int DI4 = 104;
+constexpr int DI5 = 105;
+constexpr int DI6 = 106;
+constexpr int DI7 = 107;
+constexpr int DI8 = 108;
+constexpr int DI9 = 109;
+constexpr int DI10 = 110;
+constexpr int DI11 = 111;
+} // namespace coils
+namespace discrete_inputs {
+constexpr int ROBOT_READY = 100;
+constexpr int PICK_DONE = 101;
+constexpr int ROBOT_BUSY = 102;
+constexpr int DO3_PULSE = 103;
+constexpr int DO4_PULSE = 104;
+constexpr int DO5_PULSE = 105;
+constexpr int DO6_PULSE = 106;
+constexpr int DO7_PULSE = 107;
+constexpr int DO8_PULSE = 108;
+constexpr int DO9_PULSE = 109;
+} // namespace discrete_inputs
+namespace holding {
+constexpr int TARGET_POSE_BASE = 132;
+constexpr int TARGET_POSE_PICK = 132;
+constexpr int TARGET_POSE_PLACE = 144;
+constexpr int SPEED_PCT = 146;
+constexpr int TARGET_POSE_STAGING_2_BASE = 164;
+constexpr int TARGET_QUEUE_BASE = 176;
+constexpr int TARGET_QUEUE_STRIDE = 12;
+} // namespace holding
+namespace input_registers {
+constexpr int CUR_JOINT_BASE = 340;
+constexpr int CUR_TCP_BASE = 388;
+} // namespace input_registers
+
+namespace meta {
+constexpr int schema_version = 3;
+constexpr bool word_order_hi_lo = true;
+constexpr int pose_axes = 6;
+constexpr int float32_words_per_axis = 2;
+constexpr int pose_words = 12;
+} // namespace meta
+
+constexpr std::array<Entry, 12> kCoils{{
+    Entry{ "PUBLISH_PICK", 100, 1 },
+    Entry{ "PUBLISH_PLACE", 101, 1 },
+    Entry{ "DI2", 102, 1 },
+    Entry{ "DI3", 103, 1 },
+    Entry{ "DI4", 104, 1 },
+    Entry{ "DI5", 105, 1 },
+    Entry{ "DI6", 106, 1 },
+    Entry{ "DI7", 107, 1 },
+    Entry{ "DI8", 108, 1 },
+    Entry{ "DI9", 109, 1 },
+    Entry{ "DI10", 110, 1 },
+    Entry{ "DI11", 111, 1 },
+}};
+constexpr std::array<Entry, 10> kDiscreteInputs{{
+    Entry{ "ROBOT_READY", 100, 1 },
+    Entry{ "PICK_DONE", 101, 1 },
+    Entry{ "ROBOT_BUSY", 102, 1 },
+    Entry{ "DO3_PULSE", 103, 1 },
+    Entry{ "DO4_PULSE", 104, 1 },
+    Entry{ "DO5_PULSE", 105, 1 },
+    Entry{ "DO6_PULSE", 106, 1 },
+    Entry{ "DO7_PULSE", 107, 1 },
+    Entry{ "DO8_PULSE", 108, 1 },
+    Entry{ "DO9_PULSE", 109, 1 },
+}};
+constexpr std::array<Entry, 7> kHolding{{
+    Entry{ "TARGET_POSE_BASE", 132, 12 },
+    Entry{ "TARGET_POSE_PICK", 132, 12 },
+    Entry{ "TARGET_POSE_PLACE", 144, 12 },
+    Entry{ "SPEED_PCT", 146, 1 },
+    Entry{ "TARGET_POSE_STAGING_2_BASE", 164, 12 },
+    Entry{ "TARGET_QUEUE_BASE", 176, 192 },
+    Entry{ "TARGET_QUEUE_STRIDE", 12, 0 },
+}};
+constexpr std::array<Entry, 2> kInputRegisters{{
+    Entry{ "CUR_JOINT_BASE", 340, 12 },
+    Entry{ "CUR_TCP_BASE", 388, 12 },
+}};
+constexpr std::array<Pulse, 7> kPulses{{
+    Pulse{ 3, 103 },
+    Pulse{ 4, 104 },
+    Pulse{ 5, 105 },
+    Pulse{ 6, 106 },
+    Pulse{ 7, 107 },
+    Pulse{ 8, 108 },
+    Pulse{ 9, 109 },
+}};
+} // namespace B
+
+struct Robot {
+    const char* id;
+    const char* resource;
+    const Entry* coils; int coilsCount;
+    const Entry* discrete_inputs; int discrete_inputsCount;
+    const Entry* holding; int holdingCount;
+    const Entry* input_registers; int input_registersCount;
+};
+
+constexpr std::array<Robot, 2> kRobots{{
+    Robot{ A::kId, A::kResource, A::kCoils.data(), int(A::kCoils.size()), A::kDiscreteInputs.data(), int(A::kDiscreteInputs.size()), A::kHolding.data(), int(A::kHolding.size()), A::kInputRegisters.data(), int(A::kInputRegisters.size()) },
+    Robot{ B::kId, B::kResource, B::kCoils.data(), int(B::kCoils.size()), B::kDiscreteInputs.data(), int(B::kDiscreteInputs.size()), B::kHolding.data(), int(B::kHolding.size()), B::kInputRegisters.data(), int(B::kInputRegisters.size()) },
+}};
+
+} // namespace AddressMapGen
+
+#endif // ADDRESSMAPGENERATED_H
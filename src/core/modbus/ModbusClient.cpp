@@ -5,6 +5,24 @@
 #include <QVariant>
 #include <QModbusDataUnit>
 
+#include "EventTrace.h"
+
+namespace {
+
+EventTrace::Table traceTable(MbOp::Kind k)
+{
+    switch (k) {
+    case MbOp::Kind::ReadCoils:
+    case MbOp::Kind::WriteCoil:
+    case MbOp::Kind::WriteCoilBlock:     return EventTrace::Table::Coils;
+    case MbOp::Kind::ReadDiscreteInputs: return EventTrace::Table::DiscreteInputs;
+    case MbOp::Kind::ReadInputs:         return EventTrace::Table::InputRegisters;
+    default:                             return EventTrace::Table::HoldingRegisters;
+    }
+}
+
+} // namespace
+
 ModbusClient::ModbusClient(QObject *parent)
     : QObject{parent}
     , m_client(new QModbusTcpClient(this))
@@ -288,9 +306,9 @@ bool ModbusClient::isConnected() const {
 }
 
 //////////////////////////////////////////////////////
-void ModbusClient::enqueue(const MbOp& in)
+QUuid ModbusClient::enqueue(const MbOp& in)
 {
-    if (!isConnected()) return;
+    if (!isConnected()) return QUuid();
 
     MbOp op = in;
     op.id = op.id.isNull() ? QUuid::createUuid() : op.id;
@@ -299,7 +317,7 @@ void ModbusClient::enqueue(const MbOp& in)
     if (!op.key.isEmpty()) {
         if (m_pendingByKey.contains(op.key)) {
             emit opDropped(op.key, "coalesced");
-            return;
+            return QUuid();
         }
         m_pendingByKey.insert(op.key, 1);
     }
@@ -308,12 +326,93 @@ void ModbusClient::enqueue(const MbOp& in)
     if (m_q.size() >= m_maxQueue) {
         if (!op.key.isEmpty()) m_pendingByKey.remove(op.key);
         emit opDropped(op.key, "queue overflow");
-        return;
+        return QUuid();
     }
 
     m_q.enqueue(op);
     if (!m_inFlight && !m_pumpTimer.isActive())
         m_pumpTimer.start(0);
+    return op.id;
+}
+
+QUuid ModbusClient::submit(const MbOp& in, OpCallback cb)
+{
+    MbOp op = in;
+    if (op.id.isNull()) op.id = QUuid::createUuid();
+    // enqueue 안에서 완료될 일은 없으므로(pump는 다음 틱) 먼저 등록해도 안전
+    if (cb) m_callbacks.insert(op.id, std::move(cb));
+    const QUuid id = enqueue(op);
+    if (id.isNull()) m_callbacks.remove(op.id);
+    return id;
+}
+
+QUuid ModbusClient::submitGroup(const QVector<MbOp>& in, OpCallback cb)
+{
+    if (in.isEmpty()) return QUuid();
+    QVector<MbOp> ops = in;
+    for (MbOp& op : ops)
+        if (op.id.isNull()) op.id = QUuid::createUuid();
+
+    // 마지막 op 에 걸어 두면: 정상 종료 시 마지막 완료, 중간 실패 시 abortGroup 이 마지막까지 종료시킨다
+    const QUuid last = ops.last().id;
+    if (cb) m_callbacks.insert(last, std::move(cb));
+    const QUuid group = enqueueGroup(ops);
+    if (group.isNull()) m_callbacks.remove(last);
+    return group;
+}
+
+void ModbusClient::finishOp(const QUuid& id, bool ok, const QString& err)
+{
+    emit opFinished(id, ok, err);
+    if (m_callbacks.isEmpty()) return;
+    auto it = m_callbacks.find(id);
+    if (it == m_callbacks.end()) return;
+    const OpCallback cb = std::move(it.value());
+    m_callbacks.erase(it);
+    cb(ok, err);
+}
+
+QUuid ModbusClient::enqueueGroup(const QVector<MbOp>& ops)
+{
+    if (!isConnected() || ops.isEmpty()) return QUuid();
+
+    // 전부 들어갈 자리가 없으면 통째로 거절 (부분 투입 금지)
+    if (m_q.size() + ops.size() > m_maxQueue) {
+        emit opDropped(QString("group:%1").arg(ops.size()), "queue overflow");
+        return QUuid();
+    }
+
+    const QUuid group = QUuid::createUuid();
+    for (MbOp op : ops) {
+        if (op.id.isNull()) op.id = QUuid::createUuid();
+        op.group = group;
+        op.key.clear();          // 그룹 op는 coalescing 대상 아님
+        m_q.enqueue(op);
+    }
+    if (!m_inFlight && !m_pumpTimer.isActive())
+        m_pumpTimer.start(0);
+    return group;
+}
+
+void ModbusClient::abortGroup(const QUuid& group, const QString& reason)
+{
+    if (m_parkedGroup == group) m_parkedGroup = QUuid();
+
+    QVector<QUuid> aborted;
+    for (int i = m_q.size() - 1; i >= 0; --i) {
+        if (m_q[i].group == group) {
+            aborted.prepend(m_q[i].id);
+            m_q.removeAt(i);
+        }
+    }
+    for (const QUuid& id : aborted)
+        finishOp(id, false, reason);
+}
+
+static bool isReadKind(MbOp::Kind k)
+{
+    return k == MbOp::Kind::ReadCoils || k == MbOp::Kind::ReadHolding
+        || k == MbOp::Kind::ReadInputs || k == MbOp::Kind::ReadDiscreteInputs;
 }
 
 void ModbusClient::pump()
@@ -321,7 +420,17 @@ void ModbusClient::pump()
     if (m_inFlight) return;
     if (m_q.isEmpty()) return;
 
-    const MbOp op = m_q.dequeue();
+    int idx = 0;
+    if (!m_parkedGroup.isNull()) {
+        // 그룹 딜레이 중: 단독 읽기(폴링)만 끼워넣고, 쓰기/다른 그룹은 대기
+        idx = -1;
+        for (int i = 0; i < m_q.size(); ++i) {
+            if (m_q[i].group.isNull() && isReadKind(m_q[i].kind)) { idx = i; break; }
+        }
+        if (idx < 0) return;
+    }
+
+    const MbOp op = m_q.takeAt(idx);
     m_inFlight = true;
     startOp(op);
 }
@@ -333,12 +442,27 @@ void ModbusClient::startOp(const MbOp& op)
     };
 
     if (op.kind == MbOp::Kind::DelayMs) {
-        QTimer::singleShot(qMax(0, op.delayMs), this, [this, op, clearKey](){
-            clearKey();
+        // 그룹 딜레이는 버스를 잡지 않는다(park): 그 사이 폴링 읽기는 계속 돈다
+        const bool park = !op.group.isNull();
+        if (park) {
+            m_parkedGroup = op.group;
             m_inFlight = false;
-            emit opFinished(op.id, true, "");
+        }
+        QTimer::singleShot(qMax(0, op.delayMs), Qt::PreciseTimer, this, [this, op, park, clearKey](){
+            clearKey();
+            if (park) {
+                if (m_parkedGroup != op.group) {     // abort 됨
+                    finishOp(op.id, false, "group aborted");
+                    return;
+                }
+                m_parkedGroup = QUuid();
+            } else {
+                m_inFlight = false;
+            }
+            finishOp(op.id, true, "");
             if (!m_pumpTimer.isActive()) m_pumpTimer.start(0);
         });
+        if (park && !m_pumpTimer.isActive()) m_pumpTimer.start(0);
         return;
     }
 
@@ -398,15 +522,37 @@ void ModbusClient::startOp(const MbOp& op)
     if (!reply) {
         clearKey();
         m_inFlight = false;
-        emit opFinished(op.id, false, "sendRequest failed");
+        finishOp(op.id, false, "sendRequest failed");
+        if (!op.group.isNull()) abortGroup(op.group, "group aborted");
         if (!m_pumpTimer.isActive()) m_pumpTimer.start(0);
         return;
     }
 
-    connect(reply, &QModbusReply::finished, this, [this, reply, op, clearKey](){
+    // 트레이스: 요청 시점에 기록, 응답에서 같은 번호로 RTT/읽은 값 기록
+    quint32 traceSeq = 0;
+    qint64 traceT0 = 0;
+    if (EventTrace::enabled()) {
+        traceSeq = ++m_traceSeq;
+        traceT0 = EventTrace::nowNs();
+        const bool write = !isReadKind(op.kind);
+        const quint16 one = op.kind == MbOp::Kind::WriteCoil ? quint16(op.coilValue) : op.holdingValue;
+        const bool block = op.kind == MbOp::Kind::WriteCoilBlock || op.kind == MbOp::Kind::WriteHoldingBlock;
+        EventTrace::busRequest(m_traceRobot, traceSeq, write, traceTable(op.kind), op.start,
+                               block ? op.blockValues.size() : write ? 1 : op.count,
+                               block ? op.blockValues.constData() : &one,
+                               block ? op.blockValues.size() : write ? 1 : 0);
+    }
+
+    connect(reply, &QModbusReply::finished, this, [this, reply, op, clearKey, traceSeq, traceT0](){
         const bool ok = (reply->error() == QModbusDevice::NoError);
         const QString err = ok ? "" : reply->errorString();
 
+        if (traceSeq && EventTrace::enabled()) {
+            const QVector<quint16> v = ok && isReadKind(op.kind) ? reply->result().values() : QVector<quint16>();
+            EventTrace::busReply(m_traceRobot, traceSeq, traceTable(op.kind), op.start, ok,
+                                 EventTrace::nowNs() - traceT0, v.constData(), v.size());
+        }
+
         if (ok) {
             const auto u = reply->result();
             if (op.kind == MbOp::Kind::ReadCoils) {
@@ -433,7 +579,8 @@ void ModbusClient::startOp(const MbOp& op)
         clearKey();
 
         m_inFlight = false;
-        emit opFinished(op.id, ok, err);
+        finishOp(op.id, ok, err);
+        if (!ok && !op.group.isNull()) abortGroup(op.group, "group aborted");
 
         if (!m_pumpTimer.isActive())
             m_pumpTimer.start(0);
@@ -8,6 +8,8 @@
 #include <QTimer>
 #include <QHash>
 
+#include <functional>
+
 #include "LogLevel.h"
 
 class QModbusClient;
@@ -34,6 +36,9 @@ struct MbOp {
     // coalescing 키(폴링 중복 제거용)
     int delayMs = 0; // DelayMs용
     QString key; // 예: "poll:DI:310:32"
+
+    // enqueueGroup()으로 들어온 op 묶음 id (null이면 단독 op)
+    QUuid group;
 };
 
 class ModbusClient : public QObject
@@ -59,6 +64,9 @@ public:
 
     bool isConnected() const;
 
+    // EventTrace 레코드에 붙일 로봇 인덱스 (-1: 로봇 버스 아님)
+    void setTraceRobot(int index) { m_traceRobot = index; }
+
 signals:
     void connected();
     void disconnected();
@@ -81,8 +89,22 @@ private:
     QTimer* m_ping;
 
 public:
+    // op 완료 콜백 (opFinished 와 같은 시점, 해당 op 하나에만 호출)
+    using OpCallback = std::function<void(bool ok, const QString& err)>;
+
     // 기존 API는 유지하되, 내부에서 enqueue로 보내도록 변경 권장
-    void enqueue(const MbOp& op);
+    // 반환: 투입된 op id (미연결/coalesced/큐 초과로 버려지면 null)
+    QUuid enqueue(const MbOp& op);
+    // op 묶음을 하나의 원자 그룹으로 투입: 전부 들어가거나 전부 거절(null 반환).
+    // 그룹 사이에 다른 쓰기가 끼어들지 않고, 그룹 내 DelayMs 동안에는 폴링 읽기만 허용.
+    // 그룹 op 하나가 실패하면 남은 op는 "group aborted"로 종료된다.
+    QUuid enqueueGroup(const QVector<MbOp>& ops);
+
+    // 콜백 버전: 완료는 op id 해시로 바로 라우팅된다 (opFinished 전체 구독 불필요).
+    // 투입이 거절되면 콜백은 호출되지 않고 null 을 반환한다.
+    QUuid submit(const MbOp& op, OpCallback cb);
+    // 그룹 콜백은 마지막 op 완료(성공) 또는 그룹 abort(실패) 시 한 번 호출된다.
+    QUuid submitGroup(const QVector<MbOp>& ops, OpCallback cb);
 
 signals:
     void opFinished(QUuid id, bool ok, QString err);
@@ -91,6 +113,8 @@ signals:
 private:
     void pump();
     void startOp(const MbOp& op);
+    void abortGroup(const QUuid& group, const QString& reason);
+    void finishOp(const QUuid& id, bool ok, const QString& err);
 
     QQueue<MbOp> m_q;
     bool m_inFlight = false;
@@ -99,6 +123,13 @@ private:
     // 폴링 중복 제거(선택)
     QHash<QString, int> m_pendingByKey; // key->count 같은 용도(간단하게만)
     int m_maxQueue = 200;
+
+    QUuid m_parkedGroup; // DelayMs 대기 중인 그룹 (이 동안 폴링 읽기만 pump)
+
+    QHash<QUuid, OpCallback> m_callbacks; // op id → 완료 콜백 (submit/submitGroup)
+
+    int m_traceRobot = -1;
+    quint32 m_traceSeq = 0;               // 요청/응답 짝 맞춤 번호
 };
 
 #endif // MODBUSCLIENT_H
@@ -0,0 +1,92 @@
+#include "ModbusEmulator.h"
+
+#include <QModbusTcpServer>
+#include <QModbusDataUnit>
+#include <QTimer>
+#include <QVariant>
+
+namespace {
+
+QModbusDataUnit::RegisterType registerType(ModbusEmulator::Table t)
+{
+    switch (t) {
+    case ModbusEmulator::Table::Coils:            return QModbusDataUnit::Coils;
+    case ModbusEmulator::Table::DiscreteInputs:   return QModbusDataUnit::DiscreteInputs;
+    case ModbusEmulator::Table::InputRegisters:   return QModbusDataUnit::InputRegisters;
+    case ModbusEmulator::Table::HoldingRegisters: return QModbusDataUnit::HoldingRegisters;
+    }
+    return QModbusDataUnit::Invalid;
+}
+
+} // namespace
+
+ModbusEmulator::ModbusEmulator(QObject* parent)
+    : QObject(parent)
+    , m_server(new QModbusTcpServer(this))
+{
+    QModbusDataUnitMap map;
+    map.insert(QModbusDataUnit::Coils,            {QModbusDataUnit::Coils, 0, 0xFFFF});
+    map.insert(QModbusDataUnit::DiscreteInputs,   {QModbusDataUnit::DiscreteInputs, 0, 0xFFFF});
+    map.insert(QModbusDataUnit::InputRegisters,   {QModbusDataUnit::InputRegisters, 0, 0xFFFF});
+    map.insert(QModbusDataUnit::HoldingRegisters, {QModbusDataUnit::HoldingRegisters, 0, 0xFFFF});
+    m_server->setMap(map);
+    m_server->setServerAddress(1);
+
+    connect(m_server, &QModbusServer::dataWritten, this,
+            [this](QModbusDataUnit::RegisterType table, int address, int size) {
+        if (m_selfWrite) return;
+        ++m_writes;
+        emit written(table == QModbusDataUnit::Coils ? Table::Coils : Table::HoldingRegisters, address, size);
+    });
+}
+
+bool ModbusEmulator::listen(quint16 port, const QString& address, QString* error)
+{
+    close();
+    m_server->setConnectionParameter(QModbusDevice::NetworkAddressParameter, address);
+    m_server->setConnectionParameter(QModbusDevice::NetworkPortParameter, port);
+    if (!m_server->connectDevice()) {
+        if (error) *error = m_server->errorString();
+        return false;
+    }
+    m_port = port;
+    return true;
+}
+
+void ModbusEmulator::close()
+{
+    if (m_server->state() != QModbusDevice::UnconnectedState)
+        m_server->disconnectDevice();
+    m_port = 0;
+}
+
+bool ModbusEmulator::set(Table table, int addr, quint16 value)
+{
+    m_selfWrite = true;
+    const bool ok = m_server->setData(registerType(table), quint16(addr), value);
+    m_selfWrite = false;
+    return ok;
+}
+
+bool ModbusEmulator::set(Table table, int start, const QVector<quint16>& values)
+{
+    m_selfWrite = true;
+    const bool ok = m_server->setData(QModbusDataUnit(registerType(table), start, values));
+    m_selfWrite = false;
+    return ok;
+}
+
+quint16 ModbusEmulator::value(Table table, int addr) const
+{
+    quint16 v = 0;
+    m_server->data(registerType(table), quint16(addr), &v);
+    return v;
+}
+
+void ModbusEmulator::pulse(int diAddr, int widthMs)
+{
+    setDiscreteInput(diAddr, true);
+    QTimer::singleShot(qMax(1, widthMs), Qt::PreciseTimer, this, [this, diAddr] {
+        setDiscreteInput(diAddr, false);
+    });
+}
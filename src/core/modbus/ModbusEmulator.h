@@ -0,0 +1,50 @@
+#ifndef MODBUSEMULATOR_H
+#define MODBUSEMULATOR_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class QModbusTcpServer;
+
+// ─────────────────────────────────────────────────────────────
+// 로봇 Modbus TCP 에뮬레이터 (trace 재생/벤치마크용, 실제 로봇 없이 코어 라이브러리 구동)
+//
+//  - 4개 테이블 전 범위(0..0xFFFF)를 가진 QModbusTcpServer 하나 = 로봇 하나.
+//  - 로봇 쪽 값(DI/IR)과 앱 쪽 값(코일/홀딩)을 모두 직접 설정할 수 있다.
+//  - pulse(): DI 를 켰다가 widthMs 후 끈다 (로봇 DOn_PULSE 흉내).
+//  - 앱(ModbusClient)이 쓴 코일/홀딩만 written 으로 알린다 (setXxx 로 바꾼 값은 제외).
+// ─────────────────────────────────────────────────────────────
+class ModbusEmulator : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Table { Coils, DiscreteInputs, InputRegisters, HoldingRegisters };
+    Q_ENUM(Table)
+
+    explicit ModbusEmulator(QObject* parent = nullptr);
+
+    bool listen(quint16 port, const QString& address = QStringLiteral("127.0.0.1"), QString* error = nullptr);
+    void close();
+    quint16 port() const { return m_port; }
+
+    bool set(Table table, int addr, quint16 value);
+    bool set(Table table, int start, const QVector<quint16>& values);
+    quint16 value(Table table, int addr) const;
+
+    void setDiscreteInput(int addr, bool on) { set(Table::DiscreteInputs, addr, on ? 1 : 0); }
+    void pulse(int diAddr, int widthMs);
+
+    quint64 writes() const { return m_writes; }
+
+signals:
+    void written(ModbusEmulator::Table table, int start, int count);
+
+private:
+    QModbusTcpServer* m_server;
+    quint16 m_port = 0;
+    bool m_selfWrite = false;
+    quint64 m_writes = 0;
+};
+
+#endif // MODBUSEMULATOR_H
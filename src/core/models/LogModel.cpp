@@ -0,0 +1,237 @@
+#include "LogModel.h"
+#include "MonoClock.h"
+
+#include <QBrush>
+#include <QColor>
+#include <QFont>
+
+namespace {
+
+const char* levelTag(Common::LogLevel lv)
+{
+    switch (lv) {
+    case Common::LogLevel::Debug: return "[DBG] ";
+    case Common::LogLevel::Info:  return "";
+    case Common::LogLevel::Warn:  return "[WARN] ";
+    case Common::LogLevel::Error: return "[ERR] ";
+    }
+    return "";
+}
+
+} // namespace
+
+LogModel::LogModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+    m_sources << QString();
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogModel::flushPending);
+}
+
+int LogModel::sourceIndex(const QString& source)
+{
+    const int i = m_sources.indexOf(source);
+    if (i >= 0) return i;
+    if (m_sources.size() > 255) return 0;       // Line::source 는 8비트
+    m_sources << source;
+    emit sourcesChanged();
+    return m_sources.size() - 1;
+}
+
+void LogModel::append(Common::LogLevel level, const QString& source, const QString& text)
+{
+    Line l;
+    l.ms = MonoClock::nowMs();
+    l.seq = ++m_seq;
+    l.level = quint8(level);
+    l.source = quint8(source.isEmpty() ? 0 : sourceIndex(source));
+    l.text = text;
+    m_pending.push_back(std::move(l));
+
+    // 한 프레임에 capacity 보다 많이 들어오면 앞쪽은 화면에 나오기 전에 버린다
+    const int over = m_pending.size() - m_capacity;
+    if (over > 0) {
+        m_pending.remove(0, over);
+        m_dropped += quint64(over);
+    }
+    if (!m_flushTimer.isActive()) m_flushTimer.start();
+}
+
+void LogModel::flushPending()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) return;
+    if (m_ring.size() != m_capacity) m_ring.resize(m_capacity);
+
+    QVector<Line> batch;
+    batch.swap(m_pending);
+
+    const int n = batch.size();                 // append 에서 capacity 이하로 잘림
+    const int evict = qMax(0, m_count + n - m_capacity);
+    if (evict > 0) {
+        beginRemoveRows(QModelIndex(), 0, evict - 1);
+        for (int i = 0; i < evict; ++i)
+            m_ring[(m_head + i) % m_capacity].text = QString();     // 문자열 메모리 바로 반납
+        m_head = (m_head + evict) % m_capacity;
+        m_count -= evict;
+        m_dropped += quint64(evict);
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count + n - 1);
+    for (Line& l : batch) {
+        m_ring[(m_head + m_count) % m_capacity] = std::move(l);
+        ++m_count;
+    }
+    endInsertRows();
+
+    if (m_dropped != m_droppedNotified) {
+        m_droppedNotified = m_dropped;
+        emit droppedChanged(m_dropped);
+    }
+}
+
+void LogModel::setCapacity(int capacity)
+{
+    capacity = qMax(100, capacity);
+    if (capacity == m_capacity) return;
+
+    flushPending();
+    beginResetModel();
+    const int keep = qMin(m_count, capacity);
+    QVector<Line> ring(capacity);
+    for (int i = 0; i < keep; ++i)
+        ring[i] = std::move(m_ring[(m_head + m_count - keep + i) % m_capacity]);
+    m_dropped += quint64(m_count - keep);
+    m_ring.swap(ring);
+    m_capacity = capacity;
+    m_head = 0;
+    m_count = keep;
+    endResetModel();
+}
+
+void LogModel::clear()
+{
+    m_flushTimer.stop();
+    beginResetModel();
+    m_pending.clear();
+    m_ring.clear();
+    m_head = 0;
+    m_count = 0;
+    endResetModel();
+}
+
+QString LogModel::lineText(int row) const
+{
+    const Line& l = at(row);
+    QString out = MonoClock::toString(l.ms);
+    out += QLatin1Char(' ');
+    out += QLatin1String(levelTag(Common::LogLevel(l.level)));
+    if (l.source) out += m_sources.at(l.source) + QLatin1String(" | ");
+    out += l.text;
+    return out;
+}
+
+int LogModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant LogModel::data(const QModelIndex& idx, int role) const
+{
+    if (!idx.isValid() || idx.row() < 0 || idx.row() >= m_count)
+        return QVariant();
+
+    const Line& l = at(idx.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return lineText(idx.row());
+    case Qt::ForegroundRole:
+        switch (Common::LogLevel(l.level)) {
+        case Common::LogLevel::Debug: return QBrush(QColor(128, 128, 128));
+        case Common::LogLevel::Warn:  return QBrush(QColor(230, 140, 0));
+        case Common::LogLevel::Error: return QBrush(QColor(220, 0, 0));
+        default: break;
+        }
+        return QVariant();
+    case Qt::FontRole:
+        if (Common::LogLevel(l.level) >= Common::LogLevel::Warn) {
+            QFont f;
+            f.setBold(true);
+            return f;
+        }
+        return QVariant();
+    case LevelRole:
+        return int(l.level);
+    case SourceRole:
+        return int(l.source);
+    case SeqRole:
+        return qulonglong(l.seq);
+    default:
+        return QVariant();
+    }
+}
+
+// ── LogFilterModel ───────────────────────────────────────────
+LogFilterModel::LogFilterModel(QObject* parent)
+    : QSortFilterProxyModel(parent)
+{
+    setDynamicSortFilter(false);    // 정렬 없음: 삽입/삭제만 따라간다
+}
+
+void LogFilterModel::setLogModel(LogModel* model)
+{
+    m_log = model;
+    setSourceModel(model);
+}
+
+void LogFilterModel::setMinLevel(Common::LogLevel level)
+{
+    if (level == m_minLevel) return;
+    beginRefilter();
+    m_minLevel = level;
+    endRefilter();
+}
+
+void LogFilterModel::setSource(int source)
+{
+    if (source == m_source) return;
+    beginRefilter();
+    m_source = source;
+    endRefilter();
+}
+
+void LogFilterModel::clearView()
+{
+    if (!m_log) return;
+    m_log->flushPending();
+    const int n = m_log->rowCount();
+    beginRefilter();
+    m_since = n > 0 ? m_log->seqAt(n - 1) : m_since;
+    endRefilter();
+}
+
+void LogFilterModel::beginRefilter()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 10, 0)
+    beginFilterChange();
+#endif
+}
+
+void LogFilterModel::endRefilter()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 10, 0)
+    endFilterChange(QSortFilterProxyModel::Direction::Rows);    // 열은 거르지 않음
+#else
+    invalidateFilter();
+#endif
+}
+
+bool LogFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex&) const
+{
+    if (!m_log) return true;
+    if (m_log->seqAt(sourceRow) <= m_since) return false;
+    if (m_log->levelAt(sourceRow) < m_minLevel) return false;
+    return m_source < 0 || m_log->sourceAt(sourceRow) == m_source;
+}
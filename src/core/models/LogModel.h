@@ -0,0 +1,116 @@
+#ifndef LOGMODEL_H
+#define LOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include "LogLevel.h"
+
+// ─────────────────────────────────────────────────────────────
+// GUI 로그 모델 (링 버퍼 + 프레임 단위 일괄 반영)
+//
+//  - append(): 시각/레벨/출처 번호/QString(참조 복사)만 대기열에 넣고 끝. 문자열 조립 없음.
+//  - 대기열은 프레임(16ms)마다 한 번 링에 반영 (행 삽입/삭제 시그널 각 1회).
+//    capacity 를 넘으면 가장 오래된 줄부터 밀어낸다. 한 프레임에 capacity 보다 많이 오면
+//    화면에 나오기 전에 버린다 (dropped 로 셈).
+//  - 표시 문자열("hh:mm:ss.zzz [WARN] A | text")은 data() 에서 보이는 행만 만든다.
+//  - 출처: "" = 시스템, 그 외 로봇 id 등. 처음 보는 출처는 번호를 새로 받는다 (sourcesChanged).
+//  - GUI 스레드 전용.
+// ─────────────────────────────────────────────────────────────
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Role {
+        LevelRole = Qt::UserRole + 1,   // int(Common::LogLevel)
+        SourceRole,                     // 출처 번호 (sources() 인덱스)
+        SeqRole,                        // 누적 줄 번호 (qulonglong)
+    };
+
+    static constexpr int kDefaultCapacity = 20000;
+
+    explicit LogModel(QObject* parent = nullptr);
+
+    void append(Common::LogLevel level, const QString& source, const QString& text);
+
+    void setCapacity(int capacity);
+    int capacity() const { return m_capacity; }
+    void clear();
+    void flushPending();                    // 대기 중인 줄을 즉시 반영
+
+    const QStringList& sources() const { return m_sources; }
+    int sourceIndex(const QString& source); // 없으면 추가
+
+    quint64 dropped() const { return m_dropped; }   // 밀려나거나 버려진 누적 줄 수
+
+    // 필터용 빠른 조회 (QVariant 없이)
+    Common::LogLevel levelAt(int row) const { return Common::LogLevel(at(row).level); }
+    int sourceAt(int row) const { return at(row).source; }
+    quint64 seqAt(int row) const { return at(row).seq; }
+    QString lineText(int row) const;        // 복사용 전체 줄
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& idx, int role) const override;
+
+signals:
+    void sourcesChanged();
+    void droppedChanged(quint64 total);
+
+private:
+    static constexpr int kFlushIntervalMs = 16;
+
+    struct Line {
+        qint64  ms = 0;         // MonoClock ms (표시할 때만 벽시계로)
+        quint64 seq = 0;
+        quint8  level = 0;
+        quint8  source = 0;
+        QString text;
+    };
+
+    const Line& at(int row) const { return m_ring[(m_head + row) % m_ring.size()]; }
+
+    QVector<Line> m_ring;       // 크기 = m_capacity
+    int m_capacity = kDefaultCapacity;
+    int m_head = 0;             // 가장 오래된 줄 위치
+    int m_count = 0;
+    QVector<Line> m_pending;    // 다음 프레임에 반영할 줄
+    QTimer m_flushTimer;
+
+    QStringList m_sources;      // 0 = "" (시스템)
+    quint64 m_seq = 0;
+    quint64 m_dropped = 0;
+    quint64 m_droppedNotified = 0;
+};
+
+// 레벨/출처/지우기 기준선 필터. 뷰마다 하나씩 (모델은 공유)
+class LogFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+public:
+    explicit LogFilterModel(QObject* parent = nullptr);
+
+    void setLogModel(LogModel* model);
+    LogModel* logModel() const { return m_log; }
+
+    void setMinLevel(Common::LogLevel level);
+    void setSource(int source);             // -1: 전체
+    void clearView();                       // 지금까지의 줄을 이 뷰에서만 숨김
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    // 필터 조건 변경 구간. Qt 6.10+: beginFilterChange/endFilterChange, 이전: invalidateFilter
+    void beginRefilter();
+    void endRefilter();
+
+    LogModel* m_log = nullptr;
+    Common::LogLevel m_minLevel = Common::LogLevel::Info;
+    int m_source = -1;
+    quint64 m_since = 0;
+};
+
+#endif // LOGMODEL_H
@@ -1,7 +1,10 @@
 #include "PickListModel.h"
+#include "PoseBinary.h"
+#include "LogCategories.h"
 #include <QVariant>
 #include <QBrush>
 #include <QColor>// for QColor
+#include <algorithm>
 
 PickListModel::PickListModel(QObject *parent)
     : QAbstractTableModel(parent)
@@ -19,16 +22,174 @@ PickListModel::PickListModel(QObject *parent)
     , m_data()
 #endif
 {
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &PickListModel::flushPending);
+}
+
+int PickListModel::size() const
+{
+    if (m_view) return m_view->count();
+    return ringMode() ? m_count : m_data.size();
+}
+
+Pose6D PickListModel::poseAt(int r) const
+{
+    if (m_view) return m_view->pose(r);
+    return ringMode() ? m_ring[(m_head + r) % m_capacity] : m_data[r];
+}
+
+QVector<Pose6D> PickListModel::rows() const
+{
+    if (!m_view && !ringMode()) return m_data;
+    QVector<Pose6D> out;
+    out.reserve(size());
+    for (int i = 0; i < size(); ++i)
+        out.push_back(poseAt(i));
+    return out;
+}
+
+void PickListModel::storeRows(const QVector<Pose6D>& list)
+{
+    m_view.reset();
+    if (!ringMode()) {
+        m_data = list;
+        return;
+    }
+    m_data.clear();
+    m_data.squeeze();
+    const int skip = qMax(0, list.size() - m_capacity);
+    m_evicted += quint64(skip);
+    m_ring.resize(m_capacity);
+    m_head = 0;
+    m_count = list.size() - skip;
+    std::copy(list.cbegin() + skip, list.cend(), m_ring.begin());
+}
+
+// 뷰 → 메모리 복사 (편집이 필요한 순간에만, 모델 리셋 없이 내용 동일)
+// 링 모드에서는 뷰를 붙이지 않으므로 여기까지 오지 않는다.
+void PickListModel::detachView()
+{
+    if (!m_view) return;
+    m_data = rows();
+    m_view.reset();
+}
 
+bool PickListModel::attachBinary(const QString& path, QString* err)
+{
+    auto view = std::make_shared<PoseBinView>();
+    if (!view->open(path, err)) return false;
+
+    beginResetModel();
+    m_flushTimer.stop();
+    m_pending.clear();
+    if (ringMode()) {
+        // 링은 최근 capacity 행만 보관 → 뷰 대신 복사
+        PoseBinView& v = *view;
+        QVector<Pose6D> list;
+        const int first = qMax(0, v.count() - m_capacity);
+        m_evicted += quint64(first);
+        list.reserve(v.count() - first);
+        for (int i = first; i < v.count(); ++i)
+            list.push_back(v.pose(i));
+        storeRows(list);
+    } else {
+        m_data.clear();
+        m_data.squeeze();
+        m_view = std::move(view);
+    }
+    m_activeRow = -1;
+    endResetModel();
+    notifyEvicted();
+    return true;
+}
+
+void PickListModel::setCapacity(int capacity)
+{
+    capacity = qMax(0, capacity);
+    if (capacity == m_capacity) return;
+
+    flushPending();
+    const QVector<Pose6D> current = rows();
+
+    beginResetModel();
+    m_capacity = capacity;
+    m_ring.clear();
+    m_ring.squeeze();
+    m_head = m_count = 0;
+    storeRows(current);
+    m_activeRow = -1;
+    endResetModel();
+    notifyEvicted();
+}
+
+void PickListModel::queueRows(const Pose6D* p, int n)
+{
+    for (int i = 0; i < n; ++i) m_pending.push_back(p[i]);
+    // 한 프레임에 capacity 보다 많이 들어오면 앞쪽은 화면에 나오기 전에 버린다
+    const int over = m_pending.size() - m_capacity;
+    if (over > 0) {
+        m_pending.remove(0, over);
+        m_evicted += quint64(over);
+    }
+    if (!m_flushTimer.isActive()) m_flushTimer.start();
+}
+
+void PickListModel::notifyEvicted()
+{
+    if (m_evicted == m_evictedNotified) return;
+    m_evictedNotified = m_evicted;
+    emit evictedChanged(m_evicted);
+}
+
+void PickListModel::flushPending()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) return;
+
+    QVector<Pose6D> batch;
+    batch.swap(m_pending);
+    if (!ringMode()) {          // 대기 중에 링 모드가 꺼진 경우
+        append(batch);
+        return;
+    }
+    if (m_ring.size() != m_capacity) m_ring.resize(m_capacity);
+
+    const int n = batch.size();                  // queueRows 에서 capacity 이하로 잘림
+    const int evict = qMax(0, m_count + n - m_capacity);
+    if (evict > 0) {
+        beginRemoveRows(QModelIndex(), 0, evict - 1);
+        m_head = (m_head + evict) % m_capacity;
+        m_count -= evict;
+        m_evicted += quint64(evict);
+        if (m_activeRow >= 0) m_activeRow = (m_activeRow >= evict) ? m_activeRow - evict : -1;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count + n - 1);
+    for (const Pose6D& p : batch) {
+        m_ring[(m_head + m_count) % m_capacity] = p;
+        ++m_count;
+    }
+    endInsertRows();
+
+    notifyEvicted();
 }
 
 bool PickListModel::removeRow(int r)
 {
-    if (r < 0 || r >= m_data.size())
+    if (r < 0 || r >= size())
         return false;
+    detachView();
 
     beginRemoveRows(QModelIndex(), r, r);
-    m_data.removeAt(r);
+    if (ringMode()) {
+        for (int i = r; i < m_count - 1; ++i)
+            ringAt(i) = ringAt(i + 1);
+        --m_count;
+    } else {
+        m_data.removeAt(r);
+    }
 
     if (m_activeRow == r)
         m_activeRow = -1;
@@ -40,7 +201,7 @@ bool PickListModel::removeRow(int r)
 
 int PickListModel::rowCount(const QModelIndex& parent) const {
     Q_UNUSED(parent);
-    return m_data.size();
+    return size();
 }
 
 int PickListModel::columnCount(const QModelIndex& parent) const {
@@ -50,7 +211,7 @@ int PickListModel::columnCount(const QModelIndex& parent) const {
 
 QVariant PickListModel::extracted() const { return QBrush(QColor(0xFFF4CE)); }
 QVariant PickListModel::data(const QModelIndex &idx, int role) const {
-    if (!idx.isValid() || idx.row() < 0 || idx.row() >= m_data.size())
+    if (!idx.isValid() || idx.row() < 0 || idx.row() >= size())
         return {};
 
     if (role == Qt::BackgroundRole && idx.row() == m_activeRow) {
@@ -58,7 +219,7 @@ QVariant PickListModel::data(const QModelIndex &idx, int role) const {
     }
 
     if (role == Qt::DisplayRole) {
-        const auto &p = m_data[idx.row()];
+        const Pose6D p = poseAt(idx.row());
         switch (idx.column()) {
         case 0:
             return p.x;
@@ -93,6 +254,8 @@ QVariant PickListModel::headerData(int section, Qt::Orientation orientation, int
 }
 
 void PickListModel::add(const Pose6D &p) {
+    if (ringMode()) { queueRows(&p, 1); return; }
+    detachView();
     const int row = m_data.size();
     beginInsertRows(QModelIndex(), row, row);
     m_data.push_back(p);
@@ -101,35 +264,51 @@ void PickListModel::add(const Pose6D &p) {
 
 void PickListModel::clear() {
     beginResetModel();
+    m_flushTimer.stop();
+    m_pending.clear();
     m_data.clear();
+    m_view.reset();
+    m_head = m_count = 0;
     m_activeRow = -1;
     endResetModel();
 }
 
 void PickListModel::setAll(const QVector<Pose6D>& list) {
     beginResetModel();
-    m_data = list;
+    m_flushTimer.stop();
+    m_pending.clear();
+    storeRows(list);
     m_activeRow = -1;
     endResetModel();
+    notifyEvicted();
+}
+
+void PickListModel::append(const QVector<Pose6D>& list) {
+    if (list.isEmpty()) return;
+    if (ringMode()) { queueRows(list.constData(), list.size()); return; }
+    detachView();
+    const int first = m_data.size();
+    beginInsertRows(QModelIndex(), first, first + list.size() - 1);
+    m_data += list;
+    endInsertRows();
 }
 
 Pose6D PickListModel::getRow(int r) const {
-    if (r < 0 || r >= m_data.size()) {
-        qWarning() << "[PickListModel] getRow invalid row" << r
-                   << "size=" << m_data.size();
+    if (r < 0 || r >= size()) {
+        qCWarning(lcOrch) << "[PickListModel] getRow invalid row" << r
+                   << "size=" << size();
         return Pose6D{0,0,0,0,0,0};
     }
-    qDebug()<<"[PickListModel] getRow"<<r<<m_data[r].x<<m_data[r].y<<m_data[r].z;
-    return m_data[r];
+    return poseAt(r);
 }
 
 void PickListModel::setActiveRow(int r) {
     int old = m_activeRow;
     m_activeRow = r;
-    if(old >= 0 && old < m_data.size()) {
+    if(old >= 0 && old < size()) {
         emit dataChanged(index(old,0), index(old, columnCount()-1), {Qt::BackgroundRole});
     }
-    if(m_activeRow >= 0 && m_activeRow < m_data.size()) {
+    if(m_activeRow >= 0 && m_activeRow < size()) {
         emit dataChanged(index(m_activeRow,0), index(m_activeRow, columnCount()-1), {Qt::BackgroundRole});
     }
 }
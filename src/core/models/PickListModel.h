@@ -2,8 +2,12 @@
 #define PICKLISTMODEL_H
 
 #include <QAbstractTableModel>
+#include <QTimer>
+#include <memory>
 #include "Pose6D.h"
 
+class PoseBinView;
+
 class PickListModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -20,16 +24,56 @@ public:
     void add(const Pose6D& p);
     void clear();
     void setAll(const QVector<Pose6D>& list);  // ★ 전체 교체
+    void append(const QVector<Pose6D>& list);  // 끝에 묶음 추가 (행 삽입 1회)
+
+    // 바이너리 레시피(.mrcp)를 mmap 뷰로 연결: 복사 없이 행을 바로 읽는다.
+    // 편집(add/removeRow/append) 시점에 한 번 m_data 로 풀어낸 뒤 뷰를 놓는다.
+    bool attachBinary(const QString& path, QString* err = nullptr);
+    bool isViewAttached() const { return m_view != nullptr; }
+
+    // 링 버퍼 모드 (비전 모드 이력용): capacity>0 이면 최근 capacity 행만 유지.
+    // add/append 는 대기열에 쌓였다가 프레임(16ms)마다 한 번에 반영되고,
+    // 넘친 만큼 앞쪽(가장 오래된) 행을 밀어낸다. 0 이면 기존처럼 무제한/즉시 반영.
+    void setCapacity(int capacity);
+    int capacity() const { return m_capacity; }
+    quint64 evictedCount() const { return m_evicted; }   // 밀려난 누적 행 수
+    void flushPending();                                  // 대기 중인 행을 즉시 반영
 
     Pose6D getRow(int r) const;
 
     void setActiveRow(int r); // 선택 행 강조 표시)
 
+signals:
+    void evictedChanged(quint64 total);
+
 private:
     int m_activeRow{-1};
 
 private:
+    static constexpr int kFlushIntervalMs = 16;
+
+    bool ringMode() const { return m_capacity > 0; }
+    int size() const;
+    Pose6D poseAt(int r) const;
+    Pose6D& ringAt(int r) { return m_ring[(m_head + r) % m_capacity]; }
+    QVector<Pose6D> rows() const;              // 현재 행을 순서대로 복사
+    void storeRows(const QVector<Pose6D>& list); // 모델 시그널 없이 저장 (링이면 뒤쪽 capacity 행)
+    void queueRows(const Pose6D* p, int n);
+    void notifyEvicted();
+    void detachView();
+
     QVector<Pose6D> m_data;
+    std::shared_ptr<PoseBinView> m_view;   // 설정되면 m_data 대신 사용
+
+    // 링 버퍼 모드
+    int m_capacity = 0;
+    QVector<Pose6D> m_ring;     // 크기 = m_capacity
+    int m_head = 0;             // 가장 오래된 행 위치
+    int m_count = 0;
+    QVector<Pose6D> m_pending;  // 다음 프레임에 반영할 행
+    QTimer m_flushTimer;
+    quint64 m_evicted = 0;
+    quint64 m_evictedNotified = 0;
 };
 
 #endif // PICKLISTMODEL_H
@@ -0,0 +1,145 @@
+#include "PoseBinary.h"
+
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
+namespace PoseBinary {
+
+bool isBinaryFile(const QString& path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    char magic[4];
+    return f.read(magic, 4) == 4 && std::memcmp(magic, kMagic, 4) == 0;
+}
+
+bool write(const QString& path, const QVector<Pose6D>& poses,
+           const QVector<Meta>* meta, bool float64, QString* err)
+{
+    if (meta && meta->size() != poses.size()) {
+        if (err) *err = "meta size mismatch";
+        return false;
+    }
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, 4);
+    h.version    = qToLittleEndian(kVersion);
+    const quint16 flags = quint16((float64 ? Float64 : 0) | (meta ? HasMeta : 0));
+    h.flags      = qToLittleEndian(flags);
+    h.headerSize = qToLittleEndian(kHeaderSize);
+    h.recordSize = qToLittleEndian(recordSize(flags));
+    h.count      = qToLittleEndian(quint64(poses.size()));
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        if (err) *err = QString("open failed: %1").arg(path);
+        return false;
+    }
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    QByteArray rec(int(recordSize(flags)), '\0');
+    for (int i = 0; i < poses.size(); ++i) {
+        const Pose6D& p = poses[i];
+        const double v[6] = {p.x, p.y, p.z, p.rx, p.ry, p.rz};
+        char* out = rec.data();
+        for (double d : v) {
+            if (float64) { qToLittleEndian(d, out);        out += 8; }
+            else         { qToLittleEndian(float(d), out); out += 4; }
+        }
+        if (meta) {
+            const Meta& m = meta->at(i);
+            *out++ = char(m.kind);
+            *out++ = char(m.tool);
+            qToLittleEndian(m.speedPct, out);
+            qToLittleEndian(m.reserved, out + 2);
+        }
+        f.write(rec);
+    }
+    if (!f.commit()) {
+        if (err) *err = QString("write failed: %1").arg(f.errorString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace PoseBinary
+
+bool PoseBinView::open(const QString& path, QString* err)
+{
+    using namespace PoseBinary;
+    close();
+
+    auto fail = [&](const QString& why) {
+        if (err) *err = QString("%1: %2").arg(path, why);
+        close();
+        return false;
+    };
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return fail("open failed");
+
+    const qint64 size = m_file.size();
+    if (size < qint64(kHeaderSize)) return fail("too short");
+
+    uchar* base = m_file.map(0, size);
+    if (!base) return fail("mmap failed");
+    m_base = base;
+
+    Header h;
+    std::memcpy(&h, m_base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, 4) != 0) return fail("bad magic");
+    if (qFromLittleEndian(h.version) != kVersion) return fail("unsupported version");
+
+    m_flags = qFromLittleEndian(h.flags);
+    m_recordSize = qFromLittleEndian(h.recordSize);
+    const quint32 headerSize = qFromLittleEndian(h.headerSize);
+    const quint64 count = qFromLittleEndian(h.count);
+
+    if (m_recordSize != recordSize(m_flags)) return fail("bad record size");
+    if (headerSize < kHeaderSize) return fail("bad header size");
+    if (count > quint64(std::numeric_limits<int>::max())) return fail("too many poses");
+    if (quint64(size) < headerSize + count * m_recordSize) return fail("truncated");
+
+    m_records = m_base + headerSize;
+    m_count = int(count);
+    return true;
+}
+
+void PoseBinView::close()
+{
+    if (m_base) m_file.unmap(const_cast<uchar*>(m_base));
+    if (m_file.isOpen()) m_file.close();
+    m_base = nullptr;
+    m_records = nullptr;
+    m_count = 0;
+    m_flags = 0;
+    m_recordSize = 0;
+}
+
+Pose6D PoseBinView::pose(int i) const
+{
+    if (i < 0 || i >= m_count) return Pose6D{0,0,0,0,0,0};
+    const uchar* r = m_records + qint64(i) * m_recordSize;
+    double v[6];
+    if (isFloat64()) {
+        for (int k = 0; k < 6; ++k) v[k] = qFromLittleEndian<double>(r + 8 * k);
+    } else {
+        for (int k = 0; k < 6; ++k) v[k] = qFromLittleEndian<float>(r + 4 * k);
+    }
+    return Pose6D{v[0], v[1], v[2], v[3], v[4], v[5]};
+}
+
+PoseBinary::Meta PoseBinView::meta(int i) const
+{
+    PoseBinary::Meta m;
+    if (!hasMeta() || i < 0 || i >= m_count) return m;
+    const uchar* r = m_records + qint64(i) * m_recordSize + (isFloat64() ? 48 : 24);
+    m.kind     = r[0];
+    m.tool     = r[1];
+    m.speedPct = qFromLittleEndian<quint16>(r + 2);
+    m.reserved = qFromLittleEndian<quint32>(r + 4);
+    return m;
+}
@@ -0,0 +1,102 @@
+#ifndef POSEBINARY_H
+#define POSEBINARY_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "Pose6D.h"
+
+// ─────────────────────────────────────────────────────────────
+// 바이너리 좌표 레시피 (.mrcp) — little-endian
+//
+//  header (64B)
+//    char    magic[4]   "MRCP"
+//    quint16 version    1
+//    quint16 flags      bit0: float64 (아니면 float32), bit1: 포즈별 메타 포함
+//    quint32 headerSize 64
+//    quint32 recordSize 24 | 32 (f32) / 48 | 56 (f64)
+//    quint64 count
+//    (나머지 0)
+//  record × count
+//    x, y, z, rx, ry, rz  (float32 또는 float64)
+//    [meta 8B]  quint8 kind, quint8 tool, quint16 speedPct, quint32 reserved
+//
+// PoseBinView 는 파일을 mmap 한 채로 행을 바로 읽는다 (복사/힙 할당 없음).
+// 변환: mrc_pose_csv_to_bin (tools/pose_csv_to_bin) 또는 PoseBinary::write()
+// ─────────────────────────────────────────────────────────────
+namespace PoseBinary {
+
+constexpr char    kMagic[4]   = {'M', 'R', 'C', 'P'};
+constexpr quint16 kVersion    = 1;
+constexpr quint32 kHeaderSize = 64;
+
+enum Flags : quint16 {
+    Float64 = 1u << 0,
+    HasMeta = 1u << 1,
+};
+
+struct Header {
+    char    magic[4];
+    quint16 version;
+    quint16 flags;
+    quint32 headerSize;
+    quint32 recordSize;
+    quint64 count;
+    quint8  reserved[40];
+};
+static_assert(sizeof(Header) == kHeaderSize, "PoseBinary header must be 64 bytes");
+
+struct Meta {
+    quint8  kind = 0;       // 0: 미지정 (예: 1 pick, 2 place ...)
+    quint8  tool = 0;
+    quint16 speedPct = 0;   // 0: 기본 속도
+    quint32 reserved = 0;
+};
+static_assert(sizeof(Meta) == 8, "PoseBinary meta must be 8 bytes");
+
+inline quint32 recordSize(quint16 flags)
+{
+    return ((flags & Float64) ? 48u : 24u) + ((flags & HasMeta) ? quint32(sizeof(Meta)) : 0u);
+}
+
+// 파일 앞 4바이트로 판별 (CSV 와 구분용)
+bool isBinaryFile(const QString& path);
+
+// QSaveFile 로 원자적 저장. meta 가 있으면 poses 와 길이가 같아야 한다.
+bool write(const QString& path, const QVector<Pose6D>& poses,
+           const QVector<Meta>* meta = nullptr, bool float64 = false, QString* err = nullptr);
+
+} // namespace PoseBinary
+
+class PoseBinView
+{
+public:
+    PoseBinView() = default;
+    ~PoseBinView() { close(); }
+    PoseBinView(const PoseBinView&) = delete;
+    PoseBinView& operator=(const PoseBinView&) = delete;
+
+    bool open(const QString& path, QString* err = nullptr);
+    void close();
+
+    bool isOpen() const { return m_base != nullptr; }
+    int count() const { return m_count; }
+    bool hasMeta() const { return m_flags & PoseBinary::HasMeta; }
+    bool isFloat64() const { return m_flags & PoseBinary::Float64; }
+    QString path() const { return m_file.fileName(); }
+
+    Pose6D pose(int i) const;
+    PoseBinary::Meta meta(int i) const;   // 메타 없으면 기본값
+
+private:
+    QFile m_file;
+    const uchar* m_base = nullptr;   // mmap (헤더 포함)
+    const uchar* m_records = nullptr;
+    quint32 m_recordSize = 0;
+    quint16 m_flags = 0;
+    int m_count = 0;
+};
+
+#endif // POSEBINARY_H
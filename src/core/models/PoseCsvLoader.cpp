@@ -0,0 +1,288 @@
+#include "PoseCsvLoader.h"
+
+#include <QFile>
+#include <QMetaObject>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr qint64 kMinChunkBytes = 256 * 1024;      // 이보다 작으면 쪼개지 않음
+constexpr qint64 kMaxChunkBytes = 4 * 1024 * 1024; // 스트리밍 단위 (대략 10만 행)
+
+enum class LineKind { Pose, Skip, Bad };
+
+inline bool isWs(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+// QString::trimmed().toDouble() 과 같은 결과: 앞뒤 공백 허용, '+' 부호 허용, 전체 소비
+inline bool parseField(const char* b, const char* e, double& v)
+{
+    while (b < e && isWs(*b)) ++b;
+    while (e > b && isWs(e[-1])) --e;
+    if (b == e) return false;
+    if (*b == '+') {
+        ++b;
+        if (b == e || *b == '-' || *b == '+') return false;
+    }
+    const auto r = std::from_chars(b, e, v);
+    return r.ec == std::errc() && r.ptr == e;
+}
+
+// meta 가 있으면 6개 뒤 필드 7..9 를 kind, speedPct, tool 로 읽는다 (숫자 아니면 0, 소수는 버림)
+LineKind parseLine(const char* b, const char* e, Pose6D& out, PoseBinary::Meta* meta = nullptr)
+{
+    while (b < e && isWs(*b)) ++b;
+    while (e > b && isWs(e[-1])) --e;
+    if (b == e || *b == '#') return LineKind::Skip;
+
+    const char sep = std::memchr(b, '\t', size_t(e - b)) ? '\t' : ',';
+    double v[6];
+    int n = 0;
+    const char* p = b;
+    const char* tail = e;                  // 6번째 필드 끝 (메타 시작점)
+    while (n < 6) {
+        const char* q = static_cast<const char*>(std::memchr(p, sep, size_t(e - p)));
+        if (!q) q = e;
+        if (q > p) {                       // 빈 필드는 건너뜀 (SkipEmptyParts)
+            if (!parseField(p, q, v[n])) return LineKind::Bad;
+            if (++n == 6) tail = q;
+        }
+        if (q == e) break;
+        p = q + 1;
+    }
+    if (n < 6) return LineKind::Bad;
+    out = Pose6D{v[0], v[1], v[2], v[3], v[4], v[5]};
+
+    if (meta) {
+        *meta = PoseBinary::Meta{};
+        qint64 m[3] = {0, 0, 0};
+        int k = 0;
+        for (p = tail; p < e && k < 3; ) {
+            ++p;                           // 구분자 다음
+            const char* q = static_cast<const char*>(std::memchr(p, sep, size_t(e - p)));
+            if (!q) q = e;
+            if (q > p) {
+                double d = 0.0;
+                m[k++] = parseField(p, q, d) ? qint64(qBound(-1e9, d, 1e9)) : 0;
+            }
+            p = q;
+        }
+        meta->kind     = quint8(m[0]);
+        meta->speedPct = quint16(m[1]);
+        meta->tool     = quint8(m[2]);
+    }
+    return LineKind::Pose;
+}
+
+struct Chunk {
+    const char* b = nullptr;
+    const char* e = nullptr;
+    QVector<Pose6D> poses;
+    QVector<PoseBinary::Meta> meta;     // withMeta 일 때만 (poses 와 같은 길이)
+    int lines = 0;
+    int skipped = 0;
+    int firstBad = 0;   // 청크 내 줄 번호
+};
+
+void parseChunk(Chunk& c, bool fileStart, bool withMeta, const std::atomic<bool>* cancel)
+{
+    c.poses.reserve(int((c.e - c.b) / 40));   // 한 줄 대략 40바이트
+    if (withMeta) c.meta.reserve(c.poses.capacity());
+    const char* p = c.b;
+    int line = 0;
+    while (p < c.e) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', size_t(c.e - p)));
+        const char* le = nl ? nl : c.e;
+        ++line;
+
+        Pose6D pose;
+        PoseBinary::Meta meta;
+        switch (parseLine(p, le, pose, withMeta ? &meta : nullptr)) {
+        case LineKind::Pose:
+            c.poses.push_back(pose);
+            if (withMeta) c.meta.push_back(meta);
+            break;
+        case LineKind::Skip:
+            break;
+        case LineKind::Bad:
+            if (fileStart && line == 1) break;   // 헤더
+            ++c.skipped;
+            if (!c.firstBad) c.firstBad = line;
+            break;
+        }
+        p = nl ? nl + 1 : c.e;
+
+        if ((line & 0x3FFF) == 0 && cancel && cancel->load(std::memory_order_relaxed))
+            break;
+    }
+    c.lines = line;
+}
+
+// 줄 경계로 청크를 나누고 threads 개씩 병렬 파싱, 파일 순서대로 onChunk 에 넘긴다.
+// withMeta 면 청크의 메타 열을 r.meta 에 이어 붙인다.
+template <typename OnChunk>
+void runChunks(const char* data, qint64 size, int threads, bool withMeta,
+               const std::atomic<bool>* cancel, PoseCsvLoader::Result& r, OnChunk&& onChunk)
+{
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) { data += 3; size -= 3; } // UTF-8 BOM
+
+    if (threads <= 0) threads = int(std::max(1u, std::thread::hardware_concurrency()));
+    if (size < 2 * kMinChunkBytes) threads = 1;
+
+    const qint64 want = std::max<qint64>(threads, (size + kMaxChunkBytes - 1) / kMaxChunkBytes);
+    const qint64 target = std::max<qint64>(kMinChunkBytes, size / std::max<qint64>(1, want));
+
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    const char* p = data;
+    while (p < end) {
+        Chunk c;
+        c.b = p;
+        const char* cut = p + std::min<qint64>(target, end - p);
+        if (cut < end) {
+            const char* nl = static_cast<const char*>(std::memchr(cut, '\n', size_t(end - cut)));
+            cut = nl ? nl + 1 : end;
+        }
+        c.e = cut;
+        chunks.push_back(std::move(c));
+        p = cut;
+    }
+
+    int lineBase = 0;
+    for (size_t wave = 0; wave < chunks.size(); wave += size_t(threads)) {
+        const size_t last = std::min(chunks.size(), wave + size_t(threads));
+
+        std::vector<std::thread> pool;
+        for (size_t i = wave + 1; i < last; ++i)
+            pool.emplace_back(parseChunk, std::ref(chunks[i]), false, withMeta, cancel);
+        parseChunk(chunks[wave], wave == 0, withMeta, cancel);   // 한 청크는 호출 스레드에서
+        for (auto& t : pool) t.join();
+
+        for (size_t i = wave; i < last; ++i) {
+            Chunk& c = chunks[i];
+            if (c.firstBad && !r.firstBadLine) r.firstBadLine = lineBase + c.firstBad;
+            r.skipped += c.skipped;
+            lineBase  += c.lines;
+            if (withMeta) r.meta += c.meta;
+            if (!c.poses.isEmpty()) onChunk(std::move(c.poses));
+            c.poses = QVector<Pose6D>();
+            c.meta = QVector<PoseBinary::Meta>();
+        }
+        if (cancel && cancel->load()) return;
+    }
+    r.lines = lineBase;
+}
+
+// 매핑 실패(리소스 파일 등) 시 readAll 로 대체
+bool openBytes(QFile& f, QByteArray& fallback, const char** data, qint64* size, QString* err)
+{
+    if (!f.open(QIODevice::ReadOnly)) {
+        *err = QString("open failed: %1").arg(f.fileName());
+        return false;
+    }
+    *size = f.size();
+    if (*size == 0) { *data = ""; return true; }
+    if (uchar* m = f.map(0, *size)) {
+        *data = reinterpret_cast<const char*>(m);
+        return true;
+    }
+    fallback = f.readAll();
+    *data = fallback.constData();
+    *size = fallback.size();
+    return true;
+}
+
+} // namespace
+
+PoseCsvLoader::Result PoseCsvLoader::parse(const char* data, qint64 size, int threads, bool withMeta)
+{
+    Result r;
+    runChunks(data, size, threads, withMeta, nullptr, r, [&r](QVector<Pose6D>&& poses){
+        if (r.poses.isEmpty()) r.poses = std::move(poses);
+        else                   r.poses += poses;
+    });
+    if (r.poses.isEmpty()) r.error = "no valid rows";
+    return r;
+}
+
+PoseCsvLoader::Result PoseCsvLoader::parseFile(const QString& path, int threads, bool withMeta)
+{
+    QFile f(path);
+    QByteArray fallback;
+    const char* data = nullptr;
+    qint64 size = 0;
+    QString err;
+    if (!openBytes(f, fallback, &data, &size, &err)) {
+        Result r;
+        r.error = err;
+        return r;
+    }
+    return parse(data, size, threads, withMeta);
+}
+
+PoseCsvLoader::PoseCsvLoader(QObject* parent) : QObject(parent) {}
+
+PoseCsvLoader::~PoseCsvLoader()
+{
+    m_cancel = true;
+    join();
+}
+
+void PoseCsvLoader::join()
+{
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void PoseCsvLoader::cancel()
+{
+    m_cancel = true;
+}
+
+bool PoseCsvLoader::start(const QString& path, int threads)
+{
+    if (m_running) return false;
+    join();
+    m_cancel = false;
+    m_running = true;
+
+    m_worker = std::thread([this, path, threads]{
+        Result r;
+        int rows = 0;
+        QFile f(path);
+        QByteArray fallback;
+        const char* data = nullptr;
+        qint64 size = 0;
+        if (openBytes(f, fallback, &data, &size, &r.error)) {
+            runChunks(data, size, threads, false, &m_cancel, r, [this, &rows](QVector<Pose6D>&& poses){
+                rows += poses.size();
+                const QVector<Pose6D> batch = std::move(poses);
+                // 수신 측(UI 스레드)에서 청크 단위로 모델에 추가
+                QMetaObject::invokeMethod(this, [this, batch]{
+                    if (!m_cancel) emit batchReady(batch);
+                }, Qt::QueuedConnection);
+            });
+        }
+
+        QString msg;
+        bool ok = r.error.isEmpty();
+        if (ok && m_cancel)  { ok = false; msg = "cancelled"; }
+        else if (ok && rows == 0) { ok = false; msg = "no valid rows"; }
+        else if (!ok)        msg = r.error;
+        else if (r.skipped)  msg = QString("%1 rows, %2 lines skipped (first: line %3)")
+                                      .arg(rows).arg(r.skipped).arg(r.firstBadLine);
+        else                 msg = QString("%1 rows").arg(rows);
+
+        QMetaObject::invokeMethod(this, [this, ok, rows, msg]{
+            join();
+            m_running = false;
+            emit finished(ok, rows, msg);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef POSECSVLOADER_H
+#define POSECSVLOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <thread>
+
+#include "Pose6D.h"
+#include "PoseBinary.h"
+
+// ─────────────────────────────────────────────────────────────
+// 좌표 CSV/TSV 로더
+// - 파일은 QFile::map 으로 매핑 (리소스 등 매핑 불가 시 readAll)
+// - 줄 경계로 나눈 청크를 std::thread 로 병렬 파싱, 숫자는 std::from_chars
+// - 줄 규칙은 기존 loadCsvToModel 과 동일:
+//   앞뒤 공백 제거, 빈 줄/'#' 주석 무시, 탭이 있으면 탭 구분 아니면 콤마,
+//   빈 필드는 건너뛰고 앞의 6개 필드를 사용. 6개 미만/숫자 아님 → 건너뜀.
+// - 건너뛴 줄은 개수와 첫 번째 줄 번호(1부터)를 보고한다. 1행은 헤더로 보고 제외.
+// - withMeta: 7..9번째 필드를 kind, speedPct, tool 로 읽어 meta 에 담는다 (.mrcp 변환용)
+// ─────────────────────────────────────────────────────────────
+class PoseCsvLoader : public QObject
+{
+    Q_OBJECT
+public:
+    struct Result {
+        QVector<Pose6D> poses;
+        QVector<PoseBinary::Meta> meta;   // withMeta 일 때만, poses 와 같은 길이
+        int lines = 0;          // 전체 줄 수
+        int skipped = 0;        // 파싱 실패로 건너뛴 줄 (빈 줄/주석/헤더 제외)
+        int firstBadLine = 0;   // 첫 실패 줄 번호 (0: 없음)
+        QString error;          // I/O 오류 또는 "no valid rows"
+
+        bool ok() const { return error.isEmpty(); }
+    };
+
+    // 동기 파싱. threads<=0 이면 하드웨어 스레드 수 (작은 입력은 단일 스레드)
+    static Result parse(const char* data, qint64 size, int threads = 0, bool withMeta = false);
+    static Result parseFile(const QString& path, int threads = 0, bool withMeta = false);
+
+    explicit PoseCsvLoader(QObject* parent = nullptr);
+    ~PoseCsvLoader() override;
+
+    // 비동기 로드: 청크가 끝나는 순서대로 batchReady 를 (UI 스레드에서) 발행한다.
+    // 이미 실행 중이면 false.
+    bool start(const QString& path, int threads = 0);
+    void cancel();
+    bool isRunning() const { return m_running; }
+
+signals:
+    void batchReady(const QVector<Pose6D>& poses);
+    void finished(bool ok, int rows, const QString& message);
+
+private:
+    void join();
+
+    std::thread m_worker;
+    std::atomic<bool> m_cancel{false};
+    bool m_running = false;
+};
+
+#endif // POSECSVLOADER_H
@@ -0,0 +1,98 @@
+#include "LineFramer.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr int kMinCapacity = 4096;
+
+inline bool isWs(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+} // namespace
+
+LineFramer::Line LineFramer::Line::trimmed() const
+{
+    const char* b = data;
+    const char* e = data + size;
+    while (b < e && isWs(*b)) ++b;
+    while (e > b && isWs(e[-1])) --e;
+    return Line{b, int(e - b), binary};
+}
+
+// 꼬리에 n 바이트 공간 확보. 소비된 앞부분이 있으면 그때 한 번만 당긴다.
+void LineFramer::reserveTail(int n)
+{
+    if (m_buf.size() - m_wr >= n) return;
+
+    if (m_rd > 0) {
+        const int live = m_wr - m_rd;
+        if (live > 0) std::memmove(m_buf.data(), m_buf.constData() + m_rd, size_t(live));
+        m_scan -= m_rd;
+        m_wr = live;
+        m_rd = 0;
+        if (m_buf.size() - m_wr >= n) return;
+    }
+    int cap = qMax(kMinCapacity, int(m_buf.size()));
+    while (cap - m_wr < n) cap *= 2;
+    m_buf.resize(cap);
+}
+
+qint64 LineFramer::readFrom(QIODevice* dev)
+{
+    if (!dev) return -1;
+    const qint64 avail = dev->bytesAvailable();
+    if (avail <= 0) return 0;
+
+    reserveTail(int(avail));
+    const qint64 n = dev->read(m_buf.data() + m_wr, avail);
+    if (n > 0) m_wr += int(n);
+    return n;
+}
+
+void LineFramer::append(const char* data, int size)
+{
+    if (size <= 0) return;
+    reserveTail(size);
+    std::memcpy(m_buf.data() + m_wr, data, size_t(size));
+    m_wr += size;
+}
+
+bool LineFramer::next(Line& out)
+{
+    const char* base = m_buf.constData();
+    if (m_rd < m_wr && uchar(base[m_rd]) == kBinaryMarker) {
+        if (m_wr - m_rd < kBinaryHeader) return false;
+        const uchar* h = reinterpret_cast<const uchar*>(base + m_rd);
+        const int len = int(h[1]) | (int(h[2]) << 8) | (int(h[3]) << 16);
+        if (m_wr - m_rd - kBinaryHeader < len) return false;   // 아직 덜 옴 (overflow() 로 상한 확인)
+        out.data = base + m_rd + kBinaryHeader;
+        out.size = len;
+        out.binary = true;
+        m_rd = m_scan = m_rd + kBinaryHeader + len;
+        return true;
+    }
+
+    if (m_scan < m_rd) m_scan = m_rd;
+    const void* nl = std::memchr(base + m_scan, '\n', size_t(m_wr - m_scan));
+    if (!nl) {
+        m_scan = m_wr;          // 다음 데이터가 오면 여기부터 탐색
+        if (m_rd == m_wr) m_rd = m_wr = m_scan = 0;   // 다 소비했으면 커서만 되돌림
+        return false;
+    }
+    const int idx = int(static_cast<const char*>(nl) - base);
+    int len = idx - m_rd;
+    if (len > 0 && base[m_rd + len - 1] == '\r') --len;
+    out.data = base + m_rd;
+    out.size = len;
+    out.binary = false;
+    m_rd = m_scan = idx + 1;
+    return true;
+}
+
+void LineFramer::clear()
+{
+    m_rd = m_wr = m_scan = 0;
+}
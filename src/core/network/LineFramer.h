@@ -0,0 +1,60 @@
+#ifndef LINEFRAMER_H
+#define LINEFRAMER_H
+
+#include <QByteArray>
+#include <QIODevice>
+
+// ─────────────────────────────────────────────────────────────
+// '\n' 라인 프레이밍 버퍼 (읽기 커서 방식)
+// - 소켓 데이터를 버퍼 끝에 바로 read() 하고, 줄은 읽기 커서만 옮기며 꺼낸다.
+//   줄마다 remove(0, n) 으로 남은 버퍼를 당기지 않는다 (버스트 시 O(n²) 방지).
+// - 앞쪽 소비 영역은 다음 readFrom 에서 공간이 모자랄 때만 한 번에 당긴다.
+// - next() 가 돌려주는 뷰는 버퍼를 가리키는 비소유 포인터:
+//   다음 readFrom()/append()/clear() 전까지만 유효하다. 보관하려면 복사할 것.
+// - 프레임 시작 바이트가 0xB1 이면 바이너리 프레임 [0xB1][u24 LE 길이][payload]
+//   (WireFormat cbor1). 0xB1 은 UTF-8 연속 바이트라 텍스트 줄의 첫 바이트가 될 수 없다.
+// ─────────────────────────────────────────────────────────────
+class LineFramer
+{
+public:
+    static constexpr uchar kBinaryMarker = 0xB1;
+    static constexpr int kBinaryHeader = 4;
+    static constexpr int kMaxBinaryPayload = 0xFFFFFF;
+
+    struct Line {
+        const char* data = nullptr;
+        int size = 0;
+        bool binary = false;    // 바이너리 프레임 payload (줄 아님)
+
+        bool isEmpty() const { return size == 0; }
+        // 복사 없는 QByteArray (수명은 위와 동일)
+        QByteArray view() const { return QByteArray::fromRawData(data, size); }
+        QByteArray copy() const { return QByteArray(data, size); }
+        Line trimmed() const;   // 앞뒤 공백(\r 포함) 제거
+    };
+
+    explicit LineFramer(int maxLine = 1 << 20) : m_maxLine(maxLine) {}
+
+    // 장치의 읽을 수 있는 바이트를 버퍼 끝에 직접 읽는다. 읽은 바이트 수 (오류 시 -1)
+    qint64 readFrom(QIODevice* dev);
+    void append(const char* data, int size);
+
+    // 완성된 줄(또는 바이너리 프레임) 하나를 꺼낸다 ('\n' 제외, 끝의 '\r' 제거). 없으면 false
+    bool next(Line& out);
+
+    // next() 로 줄을 다 꺼낸 뒤: '\n' 없는 꼬리가 maxLine 을 넘었는지 (DoS 가드)
+    bool overflow() const { return (m_wr - m_rd) > m_maxLine; }
+    int pending() const { return m_wr - m_rd; }
+    void clear();
+
+private:
+    void reserveTail(int n);
+
+    QByteArray m_buf;
+    int m_rd = 0;     // 읽기 커서
+    int m_wr = 0;     // 유효 데이터 끝
+    int m_scan = 0;   // '\n' 탐색을 이어갈 위치 (이미 본 바이트는 다시 보지 않음)
+    int m_maxLine;
+};
+
+#endif // LINEFRAMER_H
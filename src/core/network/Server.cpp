@@ -1,5 +1,7 @@
 #include "Server.h"
+#include "LogCategories.h"
 #include <QNetworkInterface>
+#include <QTimer>
 #include <QDebug>
 
 Server::Server(QObject* parent) : QTcpServer(parent)
@@ -9,7 +11,7 @@ Server::Server(QObject* parent) : QTcpServer(parent)
 
 bool Server::start(const QHostAddress& bindAddr, quint16 port)
 {
-    qDebug()<<"[Server] Starting server on"<<bindAddr.toString()<<":"<<port;
+    qCDebug(lcVision)<<"[Server] Starting server on"<<bindAddr.toString()<<":"<<port;
     if (isListening()) stop();
     if (!listen(bindAddr, port)) {
         emit log(QString("[ERR] listen failed: %1").arg(errorString()));
@@ -23,14 +25,15 @@ bool Server::start(const QHostAddress& bindAddr, quint16 port)
 
 void Server::stop()
 {
-    for (auto s : std::as_const(m_clients)) {
+    for (auto s : std::as_const(m_order)) {
         if (!s) continue;
         s->disconnect(this);
         s->close();
         s->deleteLater();
     }
-    m_clients.clear();
-    m_inbuf.clear();
+    m_peers.clear();
+    m_byId.clear();
+    m_order.clear();
 
     if (isListening()) close();
     emit stopped();
@@ -40,107 +43,216 @@ void Server::onNewConnection()
 {
     while (hasPendingConnections()) {
         QTcpSocket* s = nextPendingConnection();
-        m_clients.insert(s);
-        emit peerCountChanged(m_clients.size());
+        s->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+        Peer& p = m_peers[s];
+        p.sock = s;
+        p.id = QString("%1:%2").arg(s->peerAddress().toString()).arg(s->peerPort());
+        m_byId.insert(p.id, s);
+        m_order.push_back(s);
+        emit peerCountChanged(m_order.size());
 
         connect(s, &QTcpSocket::readyRead,      this, &Server::onReadyRead);
+        connect(s, &QTcpSocket::bytesWritten,   this, &Server::onBytesWritten);
         connect(s, &QTcpSocket::disconnected,   this, &Server::onDisconnected);
         connect(s, &QTcpSocket::errorOccurred,  this, &Server::onErrorOccurred);
 
-        emit log(QString("[NET] +conn %1:%2 (count=%3)")
-                     .arg(s->peerAddress().toString()).arg(s->peerPort()).arg(m_clients.size()));
-
-        qDebug()<<"[Server] New client connected:"<<s->peerAddress().toString()<<":"<<s->peerPort();
+        emit log(QString("[NET] +conn %1 (count=%2)").arg(p.id).arg(m_order.size()));
 
         emit clientConnected(s);  // ★ 추가: 여기서 즉시 알림
     }
 }
 
+void Server::forget(QTcpSocket* s)
+{
+    const auto it = m_peers.find(s);
+    if (it == m_peers.end()) return;
+    const auto idIt = m_byId.find(it->id);
+    if (idIt != m_byId.end() && idIt.value() == s)
+        m_byId.erase(idIt);
+    m_peers.erase(it);
+    m_order.removeOne(s);
+}
+
 void Server::onDisconnected()
 {
     auto* s = qobject_cast<QTcpSocket*>(sender());
     if (!s) return;
-    m_clients.remove(s);
-    m_inbuf.remove(s);
+    const QString id = clientId(s);
+    forget(s);
     s->deleteLater();
-    emit peerCountChanged(m_clients.size());
-    emit log(QString("[NET] -conn %1:%2 (count=%3)")
-                 .arg(s->peerAddress().toString()).arg(s->peerPort()).arg(m_clients.size()));
+    emit peerCountChanged(m_order.size());
+    emit log(QString("[NET] -conn %1 (count=%2)").arg(id).arg(m_order.size()));
 }
 
 void Server::onErrorOccurred(QAbstractSocket::SocketError)
 {
     auto* s = qobject_cast<QTcpSocket*>(sender());
     if (!s) return;
-    emit log(QString("[NET] error %1:%2 -> %3")
-                 .arg(s->peerAddress().toString()).arg(s->peerPort()).arg(s->errorString()));
+    emit log(QString("[NET] error %1 -> %2").arg(clientId(s), s->errorString()));
 }
 
 void Server::onReadyRead()
 {
     auto* s = qobject_cast<QTcpSocket*>(sender());
     if (!s) return;
+    const auto it = m_peers.find(s);
+    if (it == m_peers.end()) return;
 
-    QByteArray& buf = m_inbuf[s];
-    buf.append(s->readAll());
-
-    // 라인 프레이밍
-    while (true) {
-        int idx = buf.indexOf('\n');
-        if (idx < 0) break;
-        QByteArray line = buf.left(idx);
-        buf.remove(0, idx + 1);
-
-        if (line.size() > 0)
-        {
-            emit lineReceived(s, line);
-//            qDebug()<<"[Server] Data received from"<<s->peerAddress().toString()<<":"<<s->peerPort()<<line;
-        }
+    LineFramer& buf = it->in;
+    buf.readFrom(s);
 
+    // 라인 프레이밍: 커서만 옮기고, 내보내는 줄만 복사한다 (수신 측이 보관할 수 있도록)
+    LineFramer::Line line;
+    while (buf.next(line)) {
+        if (line.binary)
+            emit binaryReceived(s, line.copy());
+        else if (line.size > 0)
+            emit lineReceived(s, line.copy());
+        if (!m_peers.contains(s)) return;   // 수신 측이 이 연결을 닫음 (buf 는 이미 해제)
     }
 
     // DoS 가드
-    if (buf.size() > kMaxLine) {
-        emit log(QString("[WARN] line too long from %1:%2, closing")
-                     .arg(s->peerAddress().toString()).arg(s->peerPort()));
+    if (buf.pending() > kMaxLine) {
+        emit log(QString("[WARN] line too long from %1, closing").arg(it->id));
         s->disconnect(this);
         s->close();
+        forget(s);
+        s->deleteLater();
+        emit peerCountChanged(m_order.size());
     }
+}
 
+void Server::onBytesWritten()
+{
+    auto* s = qobject_cast<QTcpSocket*>(sender());
+    const auto it = m_peers.find(s);
+    if (it != m_peers.end() && !it->out.isEmpty())
+        pump(*it);
 }
 
-int Server::broadcast(const QByteArray& bytes)
+// 소켓 버퍼에 여유가 있는 만큼 큐에서 내려보냄
+void Server::pump(Peer& p)
 {
-    int sent = 0;
-    for (auto* s : std::as_const(m_clients)) {
-        if (s && s->state() == QAbstractSocket::ConnectedState) {
-            qint64 w = s->write(bytes);
-            if (w >= 0) ++sent;
+    while (!p.out.isEmpty() && p.sock->bytesToWrite() < kSocketHighWater) {
+        const Pending m = p.out.dequeue();
+        p.queued -= m.bytes.size();
+        if (m.state) --p.queuedState;
+        if (p.sock->write(m.bytes) < 0) break;
+    }
+}
+
+bool Server::enqueue(Peer& p, const QByteArray& bytes, Stream stream)
+{
+    QTcpSocket* s = p.sock;
+    if (!s || s->state() != QAbstractSocket::ConnectedState || bytes.isEmpty()) return false;
+
+    // 대부분의 경우: 밀린 것이 없으면 바로 소켓으로
+    if (p.out.isEmpty() && s->bytesToWrite() < kSocketHighWater)
+        return s->write(bytes) >= 0;
+
+    const bool state = (stream == Stream::State);
+    auto overLimit = [&](int factor) {
+        return p.out.size() >= m_maxQueueMsgs * factor
+            || p.queued + bytes.size() > m_maxQueueBytes * factor;
+    };
+
+    // 한도 초과: 오래된 State 부터 버림
+    while (overLimit(1) && p.queuedState > 0) {
+        for (int i = 0; i < p.out.size(); ++i) {
+            if (!p.out.at(i).state) continue;
+            p.queued -= p.out.at(i).bytes.size();
+            p.out.removeAt(i);
+            --p.queuedState;
+            break;
         }
+        ++p.dropped; ++m_droppedTotal;
+    }
+    if (overLimit(1)) {
+        if (state) {                // 큐가 명령으로 가득 참 → 새 상태값을 버림
+            ++p.dropped; ++m_droppedTotal;
+            return false;
+        }
+        if (overLimit(kHardLimitFactor)) {
+            dropClient(p, QString("send queue overflow (%1 msgs, %2 bytes)").arg(p.out.size()).arg(p.queued));
+            return false;
+        }
+    }
+
+    p.out.enqueue(Pending{bytes, state});
+    p.queued += bytes.size();
+    if (state) ++p.queuedState;
+    return true;
+}
+
+// 브로드캐스트 순회 중에 불릴 수 있으므로 끊기는 이벤트 루프로 미룬다
+void Server::dropClient(Peer& p, const QString& why)
+{
+    emit log(QString("[WARN] %1: %2, disconnecting").arg(p.id, why));
+    p.out.clear();
+    p.queued = 0;
+    p.queuedState = 0;
+    QTcpSocket* s = p.sock;
+    QTimer::singleShot(0, s, [s]{ s->abort(); });
+}
+
+int Server::broadcast(const QByteArray& bytes, Stream stream)
+{
+    int sent = 0;
+    const auto list = m_order;      // 순회 중 해제에 안전 (암시적 공유, 복사 없음)
+    for (auto* s : list) {
+        const auto it = m_peers.find(s);
+        if (it != m_peers.end() && enqueue(*it, bytes, stream))
+            ++sent;
     }
     return sent;
 }
 
-bool Server::writeTo(QTcpSocket* s, const QByteArray& bytes)
+bool Server::writeTo(QTcpSocket* s, const QByteArray& bytes, Stream stream)
 {
-    if (!s || s->state() != QAbstractSocket::ConnectedState) return false;
-    return s->write(bytes) >= 0;
+    const auto it = m_peers.find(s);
+    return it != m_peers.end() && enqueue(*it, bytes, stream);
 }
 
 QString Server::clientId(QTcpSocket* s) const
 {
-    if (!s) return {};
-    return QString("%1:%2").arg(s->peerAddress().toString()).arg(s->peerPort());
+    const auto it = m_peers.constFind(s);
+    return it != m_peers.cend() ? it->id : QString();
 }
 
-bool Server::writeToId(const QString& id, const QByteArray& bytes)
+QTcpSocket* Server::clientById(const QString& id) const
 {
-    for (QTcpSocket* s : std::as_const(m_clients)) {
-        if (!s) continue;
-        const QString cid = clientId(s);
-        if (cid == id && s->state() == QAbstractSocket::ConnectedState) {
-            return s->write(bytes) >= 0;
-        }
-    }
-    return false; // 해당 ID 클라이언트 없음
+    return m_byId.value(id, nullptr);
+}
+
+bool Server::writeToId(const QString& id, const QByteArray& bytes, Stream stream)
+{
+    QTcpSocket* s = clientById(id);
+    return s && writeTo(s, bytes, stream);   // 해당 ID 클라이언트 없으면 false
+}
+
+void Server::setSendLimits(int maxMessages, qint64 maxBytes)
+{
+    m_maxQueueMsgs = qMax(1, maxMessages);
+    m_maxQueueBytes = qMax<qint64>(1024, maxBytes);
+}
+
+quint64 Server::droppedFor(QTcpSocket* s) const
+{
+    const auto it = m_peers.constFind(s);
+    return it != m_peers.cend() ? it->dropped : 0;
+}
+
+bool Server::writable(QTcpSocket* s) const
+{
+    const auto it = m_peers.constFind(s);
+    return it != m_peers.cend() && it->out.isEmpty()
+        && s->state() == QAbstractSocket::ConnectedState
+        && s->bytesToWrite() < kSocketHighWater;
+}
+
+qint64 Server::queuedBytes(QTcpSocket* s) const
+{
+    const auto it = m_peers.constFind(s);
+    return it != m_peers.cend() ? it->queued : 0;
 }
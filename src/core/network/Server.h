@@ -5,11 +5,27 @@
 #include <QSet>
 #include <QHash>
 #include <QHostAddress>
+#include <QQueue>
 
+#include "LineFramer.h"
+
+// ─────────────────────────────────────────────────────────────
+// 다중 클라이언트 TCP 허브
+//  - 클라이언트별 상태(Peer)는 소켓 키 해시 하나, "ip:port" → 소켓 인덱스 해시 하나.
+//    id 문자열은 접속 시 한 번만 만든다.
+//  - 송신은 클라이언트별 큐를 거친다. 브로드캐스트 payload 는 QByteArray 하나를
+//    모든 큐가 공유(암시적 공유)하고, 소켓 버퍼가 kSocketHighWater 아래일 때만 내려보낸다.
+//  - 큐 한도(메시지 수/바이트) 초과 시:
+//      Stream::State   — 같은 큐의 가장 오래된 State 메시지부터 버림 (최신값만 의미 있음)
+//      Stream::Command — 버리지 않음. 한도의 kHardLimitFactor 배를 넘기면 느린 클라이언트로 보고 끊음
+//  - 줄 단위 수신 경로에는 로그가 없다 (접속/해제/오류만 log).
+// ─────────────────────────────────────────────────────────────
 class Server : public QTcpServer
 {
     Q_OBJECT
 public:
+    enum class Stream { Command, State };
+
     explicit Server(QObject* parent=nullptr);
 
     // listen 제어
@@ -18,15 +34,24 @@ public:
     void stop();
 
     quint16 port() const { return serverPort(); }
-    QSet<QTcpSocket*> clients() const { return m_clients; }
+    const QList<QTcpSocket*>& clients() const { return m_order; }
+    int clientCount() const { return m_order.size(); }
 
-    // 송신 API
-    int  broadcast(const QByteArray& bytes);
-    bool writeTo(QTcpSocket* s, const QByteArray& bytes);
+    // 송신 API (성공: 큐에 들어갔거나 바로 씀)
+    int  broadcast(const QByteArray& bytes, Stream stream = Stream::Command);
+    bool writeTo(QTcpSocket* s, const QByteArray& bytes, Stream stream = Stream::Command);
 
-    // 새로 추가
     QString clientId(QTcpSocket* s) const;               // "ip:port" 문자열 반환
-    bool writeToId(const QString& id, const QByteArray& bytes); // ID로 전송
+    QTcpSocket* clientById(const QString& id) const;     // 없으면 nullptr
+    bool writeToId(const QString& id, const QByteArray& bytes, Stream stream = Stream::Command); // ID로 전송
+
+    // 클라이언트별 송신 큐 한도 (기본 1024건 / 4MB)
+    void setSendLimits(int maxMessages, qint64 maxBytes);
+    quint64 droppedTotal() const { return m_droppedTotal; }
+    quint64 droppedFor(QTcpSocket* s) const;
+    qint64 queuedBytes(QTcpSocket* s) const;
+    // 큐가 비어 있고 소켓 버퍼도 여유 → 지금 쓰면 바로 나감 (최신값만 보내는 발행자용)
+    bool writable(QTcpSocket* s) const;
 
 signals:
     void log(const QString& line);
@@ -34,11 +59,13 @@ signals:
     void stopped();
     void peerCountChanged(int count);
     void lineReceived(QTcpSocket* from, const QByteArray& line);
+    void binaryReceived(QTcpSocket* from, const QByteArray& payload);   // LineFramer 바이너리 프레임
     void clientConnected(QTcpSocket* s);
 
 private slots:
     void onNewConnection();
     void onReadyRead();
+    void onBytesWritten();
     void onDisconnected();
     void onErrorOccurred(QAbstractSocket::SocketError);
 
@@ -48,8 +75,35 @@ protected:
 
 private:
     static constexpr int kMaxLine = 1<<20; // 1MB 가드
-    QSet<QTcpSocket*> m_clients;
-    QHash<QTcpSocket*, QByteArray> m_inbuf; // 라인 프레이밍 버퍼
+    static constexpr qint64 kSocketHighWater = 256 * 1024;   // 소켓 미전송 바이트가 이 이상이면 큐에 보관
+    static constexpr int kHardLimitFactor = 4;
+
+    struct Pending {
+        QByteArray bytes;           // 브로드캐스트면 모든 클라이언트가 같은 데이터를 공유
+        bool state = false;         // Stream::State (버릴 수 있음)
+    };
+    struct Peer {
+        QTcpSocket* sock = nullptr;
+        QString id;                 // "ip:port"
+        LineFramer in;              // 라인 프레이밍 버퍼 (읽기 커서)
+        QQueue<Pending> out;
+        qint64 queued = 0;          // out 바이트 합
+        int queuedState = 0;        // out 안의 State 메시지 수
+        quint64 dropped = 0;
+    };
+
+    bool enqueue(Peer& p, const QByteArray& bytes, Stream stream);
+    void pump(Peer& p);
+    void dropClient(Peer& p, const QString& why);
+    void forget(QTcpSocket* s);
+
+    QHash<QTcpSocket*, Peer> m_peers;
+    QHash<QString, QTcpSocket*> m_byId;
+    QList<QTcpSocket*> m_order;     // 접속 순서 (브로드캐스트 순회용)
+
+    int m_maxQueueMsgs = 1024;
+    qint64 m_maxQueueBytes = 4 * 1024 * 1024;
+    quint64 m_droppedTotal = 0;
 };
 
 #endif // SERVER_H
@@ -0,0 +1,149 @@
+#include "WireFormat.h"
+#include "LineFramer.h"
+
+#include <QCborMap>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <cmath>
+
+namespace {
+
+void writeValue(QCborStreamWriter& w, const QJsonValue& v);
+
+void writeObject(QCborStreamWriter& w, const QJsonObject& o)
+{
+    w.startMap(quint64(o.size()));
+    for (auto it = o.constBegin(); it != o.constEnd(); ++it) {
+        w.append(it.key());
+        writeValue(w, it.value());
+    }
+    w.endMap();
+}
+
+void writeValue(QCborStreamWriter& w, const QJsonValue& v)
+{
+    switch (v.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        w.appendNull();
+        break;
+    case QJsonValue::Bool:
+        w.append(v.toBool());
+        break;
+    case QJsonValue::Double: {
+        const double d = v.toDouble();
+        if (std::floor(d) == d && std::fabs(d) < 9.0e15)
+            w.append(qint64(d));               // 정수 → 1~9 바이트
+        else if (double(float(d)) == d)
+            w.append(float(d));                // float32 로 손실 없음 → 5 바이트
+        else
+            w.append(d);
+        break;
+    }
+    case QJsonValue::String:
+        w.append(v.toString());
+        break;
+    case QJsonValue::Array: {
+        const QJsonArray a = v.toArray();
+        w.startArray(quint64(a.size()));
+        for (const auto& e : a) writeValue(w, e);
+        w.endArray();
+        break;
+    }
+    case QJsonValue::Object:
+        writeObject(w, v.toObject());
+        break;
+    }
+}
+
+} // namespace
+
+namespace WireFormat {
+
+const char* protoName(Proto p)
+{
+    return p == Proto::Cbor ? "cbor1" : "json";
+}
+
+Proto protoFromName(const QString& name)
+{
+    return name == QLatin1String("cbor1") ? Proto::Cbor : Proto::Json;
+}
+
+QByteArray encode(const QJsonObject& o, Proto p)
+{
+    if (p == Proto::Json)
+        return QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
+
+    QByteArray out;
+    beginBinary(out);
+    {
+        QCborStreamWriter w(&out);
+        writeObject(w, o);
+    }
+    if (!finishBinary(out))   // 헤더에 못 담음 → JSON 으로
+        return QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
+    return out;
+}
+
+void beginBinary(QByteArray& out)
+{
+    out.resize(0);                                   // reserve 해 둔 용량은 유지
+    out.append(LineFramer::kBinaryHeader, '\0');   // 헤더 자리, 본문은 뒤에 덧붙음
+}
+
+bool finishBinary(QByteArray& out)
+{
+    const int len = out.size() - LineFramer::kBinaryHeader;
+    if (len > LineFramer::kMaxBinaryPayload)
+        return false;
+    out[0] = char(LineFramer::kBinaryMarker);
+    out[1] = char(len & 0xFF);
+    out[2] = char((len >> 8) & 0xFF);
+    out[3] = char((len >> 16) & 0xFF);
+    return true;
+}
+
+bool decodeBinary(const char* payload, int size, QJsonObject& out)
+{
+    QCborParserError err{};
+    const QCborValue v = QCborValue::fromCbor(QByteArray::fromRawData(payload, size), &err);
+    if (err.error != QCborError::NoError || !v.isMap())
+        return false;
+    out = v.toMap().toJsonObject();
+    return true;
+}
+
+QJsonObject helloRequest(bool offerBinary)
+{
+    QJsonArray protos;
+    if (offerBinary) protos.append(protoName(Proto::Cbor));
+    protos.append(protoName(Proto::Json));
+    return QJsonObject{
+        {"type", "hello"},
+        {"proto", protos},
+        {"dir", 11}
+    };
+}
+
+Proto chooseProto(const QJsonObject& hello)
+{
+    const QJsonArray offered = hello.value("proto").toArray();
+    for (const auto& v : offered)
+        if (v.toString() == QLatin1String(protoName(Proto::Cbor)))
+            return Proto::Cbor;
+    return Proto::Json;
+}
+
+QJsonObject helloReply(Proto p)
+{
+    return QJsonObject{
+        {"type", "hello"},
+        {"proto", protoName(p)}
+    };
+}
+
+} // namespace WireFormat
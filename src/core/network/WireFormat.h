@@ -0,0 +1,48 @@
+#ifndef WIREFORMAT_H
+#define WIREFORMAT_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+// ─────────────────────────────────────────────────────────────
+// 비전 프로토콜 인코딩
+//  json  : 한 줄 JSON + '\n' (기존, 기본값)
+//  cbor1 : [0xB1][u24 LE 길이][CBOR map]  — 키/값 구조는 JSON 과 동일
+//          숫자는 정수/float32 로 손실 없이 표현되면 그 크기로 쓴다.
+//
+// 협상 (hello):
+//  클라이언트 → {"type":"hello","proto":["cbor1","json"],"dir":11}   (항상 JSON)
+//  서버       → {"type":"hello","proto":"cbor1"}                     (항상 JSON)
+//  응답을 받은 쪽부터 해당 형식으로 송신한다. 응답이 없으면(구버전 피어) 계속 JSON.
+//  수신 측 LineFramer 는 두 형식을 모두 받으므로 전환 시점의 경합이 없다.
+// ─────────────────────────────────────────────────────────────
+namespace WireFormat {
+
+enum class Proto { Json, Cbor };
+
+const char* protoName(Proto p);
+
+// 메시지 한 건을 송신 바이트로 (JSON 은 '\n' 포함, CBOR 는 헤더 포함)
+QByteArray encode(const QJsonObject& o, Proto p);
+
+// CBOR 본문을 직접 써서 cbor1 프레임을 만들 때 (JsonTemplate::renderCbor 등):
+//   beginBinary(buf) → 본문 덧붙이기 → finishBinary(buf)
+// finishBinary 는 본문이 헤더 길이 한도를 넘으면 false (buf 는 쓸 수 없음)
+void beginBinary(QByteArray& out);
+bool finishBinary(QByteArray& out);
+
+// LineFramer 가 넘긴 바이너리 프레임 페이로드 → JSON 객체. map 이 아니면 false
+bool decodeBinary(const char* payload, int size, QJsonObject& out);
+
+// hello 요청 (offerBinary=false 면 json 만 제시)
+QJsonObject helloRequest(bool offerBinary);
+// 서버: 요청의 proto 목록에서 지원하는 형식 선택 / 응답 생성
+Proto chooseProto(const QJsonObject& hello);
+QJsonObject helloReply(Proto p);
+// 클라이언트: 응답의 proto 문자열 해석 (모르면 Json)
+Proto protoFromName(const QString& name);
+
+} // namespace WireFormat
+
+#endif // WIREFORMAT_H
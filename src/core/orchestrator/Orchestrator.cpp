@@ -1,9 +1,13 @@
 #include "Orchestrator.h"
 #include "ModbusClient.h"
 #include "PickListModel.h"
+#include "LogCategories.h"
+#include "MonoClock.h"
 
 #include <QTimer>
 #include <QDebug>
+#include <QRegularExpression>
+#include <algorithm>
 #include <cstring>   // for memcpy
 
 #include "tf/EulerAngleConverter.h"
@@ -84,7 +88,7 @@ EulerZYX toolRotate(float rx, float ry, float rz, float target_yaw)
     double roll_degrees = static_cast<double>(rx);
     double pitch_degrees = static_cast<double>(ry);
     double yaw_degrees = static_cast<double>(rz);
-    qDebug()<<"Input Euler Angles (ZYX) in degrees:"
+    qCDebug(lcTf)<<"Input Euler Angles (ZYX) in degrees:"
              <<roll_degrees
              <<pitch_degrees
              <<yaw_degrees;
@@ -117,13 +121,13 @@ EulerZYX toolRotate(float rx, float ry, float rz, float target_yaw)
     double normalized_pitch_degrees = EulerAngleConverter::ConvertRadiansToDegrees(normalized_pitch);
     double normalized_roll_degrees = EulerAngleConverter::ConvertRadiansToDegrees(normalized_roll);
 
-    qDebug() << "Updated Euler Angles (ZYX) in degrees:"
+    qCDebug(lcTf) << "Updated Euler Angles (ZYX) in degrees:"
              << normalized_yaw_degrees
              << normalized_pitch_degrees
              << normalized_roll_degrees;
 
     EulerZYX normalized = normalizeEulerZYX({normalized_roll_degrees, normalized_pitch_degrees, normalized_yaw_degrees});
-    qDebug() << "Normalized Euler Angles (ZYX) in degrees:"
+    qCDebug(lcTf) << "Normalized Euler Angles (ZYX) in degrees:"
              << normalized.roll
              << normalized.pitch
              << normalized.yaw;
@@ -150,6 +154,8 @@ Orchestrator::Orchestrator(ModbusClient* bus, PickListModel* model, QObject* par
     : QObject(parent), m_bus(bus), m_model(model), m_cycleTimer(new QTimer(this))
 {
     m_cycleTimer->setInterval(25);
+    for (const auto& p : AddressMapGen::A::kPulses)
+        m_pulses.push_back({p.idx, p.addr, false});
     connect(m_cycleTimer, &QTimer::timeout, this, &Orchestrator::cycle);
 
     // READY/DONE/BUSY 읽기 및 에지 처리
@@ -167,109 +173,28 @@ Orchestrator::Orchestrator(ModbusClient* bus, PickListModel* model, QObject* par
         get(A_ROBOT_BUSY,  busy);
         get(A_PICK_DONE,   done);
 
-        // DO3/DO4/DO5 펄스 감지
-        bool do1=m_lastDO1;
-        bool do3=m_lastDO3, do4=m_lastDO4,   do5=m_lastDO5;
-        bool do6=m_lastDO6, do7=m_lastDO7,   do8=m_lastDO8;
-        bool do9=m_lastDO9, do10=m_lastDO10, do11=m_lastDO11;
-        bool do12=m_lastDO12, do13=m_lastDO13, do14=m_lastDO14;
-
-        get(A_DO1_PULSE , do1);
-        get(A_DO3_PULSE , do3);
-        get(A_DO4_PULSE , do4);
-        get(A_DO5_PULSE , do5);
-        get(A_DO6_PULSE , do6);
-        get(A_DO7_PULSE , do7);
-        get(A_DO8_PULSE , do8);
-        get(A_DO9_PULSE , do9);
-        get(A_DO10_PULSE , do10);
-        get(A_DO11_PULSE , do11);
-        get(A_DO12_PULSE , do12);
-        get(A_DO13_PULSE , do13);
-        get(A_DO14_PULSE , do14);
-
-#if true
-        // === 상승에지 → 공정 인덱스 배출 ===
-        if (!m_lastDO1 && do1) {
-            emit processPulse(m_robotId, 1);//, 0);
-        }
-        else if (m_lastDO1 && !do1) {
-            emit processPulse(m_robotId, 2);//, 0);
-        }
-        if (!m_lastDO3 && do3) {
-            emit processPulse(m_robotId, 3);//, 0);
-        }
-        if (!m_lastDO4 && do4) {
-            emit processPulse(m_robotId, 4);//, 1);
-        }
-        if (!m_lastDO5 && do5) {
-            emit processPulse(m_robotId, 5);//, 2);
-        }
-        if (!m_lastDO6 && do6) {
-            emit processPulse(m_robotId, 6);//, 3);
-        }
-        if (!m_lastDO7 && do7) {
-            emit processPulse(m_robotId, 7);//, 4);
-        }
-        if (!m_lastDO8 && do8) {
-            emit processPulse(m_robotId, 8);//, 5);
-        }
-        if (!m_lastDO9 && do9) {
-            emit processPulse(m_robotId, 9);//, 6);
+        if (busy != m_lastBusy) {
+            m_lastBusy = busy;
+            emit busyChanged(m_robotId, busy);
         }
-        if (!m_lastDO10 && do10) {
-            emit processPulse(m_robotId, 10);//, 7);
-        }
-        if (!m_lastDO11 && do11) {
-            emit processPulse(m_robotId, 11);//, 8);
-        }
-        if (!m_lastDO12 && do12) {
-            emit processPulse(m_robotId, 12);//, 9);
-        }
-        if (!m_lastDO13 && do13) {
-            emit processPulse(m_robotId, 13);//, 10);
-        }
-        if (!m_lastDO14 && do14) {
-            emit processPulse(m_robotId, 14);//, 11);
-        }
-#else
-        // === 하강에지 → 공정 인덱스 배출 ===
-        if (m_lastDO3 && !do3) {
-            emit processPulse(m_robotId, 0);
-        }
-        if (m_lastDO4 && !do4) {
+
+        // DO1: PICK_DONE 입력 공유 — 상승 → 1, 하강 → 2
+        bool do1 = m_lastDO1;
+        get(A_PICK_DONE, do1);
+        if (!m_lastDO1 && do1)
             emit processPulse(m_robotId, 1);
-        }
-        if (m_lastDO5 && !do5) {
+        else if (m_lastDO1 && !do1)
             emit processPulse(m_robotId, 2);
-        }
-        if (m_lastDO6 && !do6) {
-            emit processPulse(m_robotId, 3);
-        }
-        if (m_lastDO7 && !do7) {
-            emit processPulse(m_robotId, 4);
-        }
-        if (m_lastDO8 && !do8) {
-            emit processPulse(m_robotId, 5);
-        }
-        if (m_lastDO9 && !do9) {
-            emit processPulse(m_robotId, 6);
-        }
-        if (m_lastDO10 && !do10) {
-            emit processPulse(m_robotId, 7);
-        }
-        if (m_lastDO11 && !do11) {
-            emit processPulse(m_robotId, 8);
-        }
-        if (m_lastDO12 && !do12) {
-            emit processPulse(m_robotId, 9);
-        }
-#endif
         m_lastDO1 = do1;
-        m_lastDO3 = do3;    m_lastDO4 = do4;    m_lastDO5 = do5;
-        m_lastDO6 = do6;    m_lastDO7 = do7;    m_lastDO8 = do8;
-        m_lastDO9 = do9;    m_lastDO10 = do10;  m_lastDO11 = do11;
-        m_lastDO12 = do12;  m_lastDO13 = do13;   m_lastDO14 = do14;
+
+        // DOn 상승에지 → 공정 인덱스 n (펄스 표 순서 = n 오름차순)
+        for (PulseInput& p : m_pulses) {
+            bool v = p.last;
+            get(p.addr, v);
+            if (!p.last && v)
+                emit processPulse(m_robotId, p.idx);
+            p.last = v;
+        }
     });
 
     connect(m_bus, &ModbusClient::inputRead, this, [this](int start, const QVector<quint16>& data){
@@ -277,23 +202,38 @@ Orchestrator::Orchestrator(ModbusClient* bus, PickListModel* model, QObject* par
         if (data.isEmpty()) return;
 
         if(start==310 && data.size()>=13) {
-            st_.enabled          = (data[0] == 1);
-            st_.mode             = data[1];
-            st_.runningState     = data[2];
-            st_.toolNumber       = data[3];
-            st_.workpieceNumber  = data[4];
-            st_.emergencyStop    = (data[5] == 1);
-            st_.softLimitExceeded= (data[6] == 1);
-            st_.mainError        = static_cast<int>(data[7]);
-            st_.subError         = static_cast<int>(data[8]);
-            st_.collision        = (data[9] == 1);
-            st_.motionArrive     = (data[10] == 1);
-            st_.safetyStopSI0    = (data[11] == 1);
-            st_.safetyStopSI1    = (data[12] == 1);
-
-            emit stateFeedback(st_);
+            // 압축 워드 XOR 비교: 바뀐 게 없으면 디코딩/발행 모두 생략
+            const RobotStateWord cur = RobotStateWord::fromRegisters(data);
+            const quint32 changed = RobotStateWord::changedFields(m_stateWord, cur);
+            if (changed != 0 || !m_stateSeen) {
+                RobotStateChange ch;
+                ch.before  = m_stateWord;
+                ch.after   = cur;
+                ch.changed = changed;
+                ch.edges   = RobotStateWord::errorEdges(m_stateWord, cur);
+                ch.tsMs    = MonoClock::nowMs();
+                m_stateWord = cur;
+                m_stateSeen = true;
+
+                st_.enabled          = (data[0] == 1);
+                st_.mode             = data[1];
+                st_.runningState     = data[2];
+                st_.toolNumber       = data[3];
+                st_.workpieceNumber  = data[4];
+                st_.emergencyStop    = (data[5] == 1);
+                st_.softLimitExceeded= (data[6] == 1);
+                st_.mainError        = static_cast<int>(data[7]);
+                st_.subError         = static_cast<int>(data[8]);
+                st_.collision        = (data[9] == 1);
+                st_.motionArrive     = (data[10] == 1);
+                st_.safetyStopSI0    = (data[11] == 1);
+                st_.safetyStopSI1    = (data[12] == 1);
+
+                emit stateChange(ch);
+                emit stateFeedback(st_);
+            }
 /*
-            qDebug()<<"[RobotStateFeedback]"
+            qCDebug(lcOrch)<<"[RobotStateFeedback]"
                     <<"enabled:"<<st_.enabled
                     <<"mode:"<<st_.mode
                     <<"runningState:"<<st_.runningState
@@ -330,7 +270,7 @@ Orchestrator::Orchestrator(ModbusClient* bus, PickListModel* model, QObject* par
         }
 
         if (m_kinState.hasTcp && m_kinState.hasJoints) {
-            m_kinState.tsMs = QDateTime::currentMSecsSinceEpoch();
+            m_kinState.tsMs = MonoClock::nowMs();
             emit kinematicsUpdated(m_robotId, m_kinState);
             // 계속 최신값 유지 (플래그 유지)
         }
@@ -347,7 +287,6 @@ void Orchestrator::start()
     emit log("[RUN] Orchestrator started", Common::LogLevel::Info);
     setState(State::WaitRobotReady);
     m_cycleTimer->start();
-    m_stateTick.restart();
 
     QVector<quint16> init;
     init.resize(15);
@@ -390,15 +329,20 @@ void Orchestrator::applyAddressMap(const QVariantMap& m)
     getAddr(di, "ROBOT_READY", A_ROBOT_READY);
     getAddr(di, "ROBOT_BUSY", A_ROBOT_BUSY);
     getAddr(di, "PICK_DONE", A_PICK_DONE);
-    getAddr(di, "DO3_PULSE", A_DO3_PULSE);
-    getAddr(di, "DO4_PULSE", A_DO4_PULSE);
-    getAddr(di, "DO5_PULSE", A_DO5_PULSE);
-    getAddr(di, "DO6_PULSE", A_DO6_PULSE);
-    getAddr(di, "DO7_PULSE", A_DO7_PULSE);
-    getAddr(di, "DO8_PULSE", A_DO8_PULSE);
-    getAddr(di, "DO9_PULSE", A_DO9_PULSE);
-    getAddr(di, "DO10_PULSE", A_DO10_PULSE);
-    getAddr(di, "DO11_PULSE", A_DO11_PULSE);
+
+    // 맵에 DOn_PULSE 가 있으면 그 맵의 펄스 표로 교체 (맵에 없는 번호는 읽지 않음)
+    static const QRegularExpression kPulseKey(QStringLiteral("^DO(\\d+)_PULSE$"));
+    QVector<PulseInput> pulses;
+    for (auto it = di.cbegin(); it != di.cend(); ++it) {
+        const auto mo = kPulseKey.match(it.key());
+        if (mo.hasMatch())
+            pulses.push_back({mo.captured(1).toInt(), it.value().toInt(), false});
+    }
+    if (!pulses.isEmpty()) {
+        std::sort(pulses.begin(), pulses.end(),
+                  [](const PulseInput& a, const PulseInput& b) { return a.idx < b.idx; });
+        m_pulses = pulses;
+    }
 
     getAddr(coils, "PUBLISH_PICK", A_PUBLISH_PICK);
     getAddr(coils, "PUBLISH_PLACE", A_PUBLISH_PLACE);
@@ -476,7 +420,7 @@ void Orchestrator::setState(Orchestrator::State s)
 
 void Orchestrator::publishPickPlacePoses(const QVector<double>& pick, const QVector<double>& place, int speedPct)
 {
-    qDebug() << "[ORCH] publishPickPlacePoses:"
+    qCDebug(lcOrch) << "[ORCH] publishPickPlacePoses:"
              << "pick=" <<pick
              << "place=" <<place
              << "speedPct=" <<speedPct;
@@ -649,7 +593,7 @@ void Orchestrator::publishAlignPlace(const QVector<double>& pose, int clampSeque
     quint16 hi, lo;
     floatToRegs(float(static_cast<float>(clampSequenceMode)), hi, lo);
     regs << hi << lo;
-    qDebug()<<"SX-2: recv clamp_mode"<<clampSequenceMode<<", " <<float(static_cast<float>(clampSequenceMode));
+    qCDebug(lcOrch)<<"SX-2: recv clamp_mode"<<clampSequenceMode<<", " <<float(static_cast<float>(clampSequenceMode));
 
     m_bus->writeHoldingBlock(base, regs);
 #if true
@@ -669,7 +613,7 @@ void Orchestrator::publishAlignPlace(const QVector<double>& pose, int clampSeque
 
 void Orchestrator::publishPoseWithKind(const QVector<double>& pose, int speedPct, const QString& kind)
 {
-    qDebug() <<"[ORCH] publishPoseWithKind:"
+    qCDebug(lcOrch) <<"[ORCH] publishPoseWithKind:"
              <<"pose="<<pose
              <<"speedPct="<<speedPct
              <<"kind="<<kind;
@@ -679,13 +623,13 @@ void Orchestrator::publishPoseWithKind(const QVector<double>& pose, int speedPct
     if (!kind.compare("place", Qt::CaseInsensitive) && A_TARGET_BASE_PLACE >= 0)
     {   // kind가 "place"이고 A_TARGET_BASE_PLACE >= 0이면 해당 주소 사용
         base = A_TARGET_BASE_PLACE;
-        qDebug()<<"[ORCH] Using TARGET_BASE_PLACE ="<<base;
+        qCDebug(lcOrch)<<"[ORCH] Using TARGET_BASE_PLACE ="<<base;
         yaw = 0;
     }
     else if (!kind.compare("pick", Qt::CaseInsensitive) && A_TARGET_BASE_PICK >= 0)
     {   // kind가 "pick"이고 A_TARGET_BASE_PICK >= 0이면 해당 주소 사용
         base = A_TARGET_BASE_PICK;
-        qDebug()<<"[ORCH] Using TARGET_BASE_PICK ="<<base;
+        qCDebug(lcOrch)<<"[ORCH] Using TARGET_BASE_PICK ="<<base;
         yaw = 0;
         // KJW 2025-12-02: 로봇 ID "A"의 픽 포즈의 YAW 제한값 적용
         // 툴의 기본자세는 (180,0,-90), rz가 90도 근처일때 +30/-30 오프셋 적용.
@@ -707,7 +651,7 @@ void Orchestrator::publishPoseWithKind(const QVector<double>& pose, int speedPct
     }
     else
     {   // 그 외에는 기본 A_TARGET_BASE 사용
-        qDebug()<<"[ORCH] Using default TARGET_BASE ="<<base;
+        qCDebug(lcOrch)<<"[ORCH] Using default TARGET_BASE ="<<base;
     }
 
     // 3) 포즈를 12워드(6float)로 인코딩해서 쓰기
@@ -765,7 +709,7 @@ void Orchestrator::publishPoseWithKind(const QVector<double>& pose, int speedPct
 void Orchestrator::publishBulkPoseWithKind(const QVector<double>& pose, const QString& kind)
 {
     if (pose.size() < 6) {
-        qWarning() << "[ORCH] pose needs 6 elements, got" << pose.size();
+        qCWarning(lcOrch) << "[ORCH] pose needs 6 elements, got" << pose.size();
 //        return false;
     }
     int base = A_TARGET_BASE;   // 기본 TARGET_BASE
@@ -779,7 +723,7 @@ void Orchestrator::publishBulkPoseWithKind(const QVector<double>& pose, const QS
     }
     else
     {   // 그 외에는 기본 A_TARGET_BASE 사용
-        qDebug()<<"[ORCH] Using default TARGET_BASE ="<<base;
+        qCDebug(lcOrch)<<"[ORCH] Using default TARGET_BASE ="<<base;
     }
 
     QVector<quint16> regs;
@@ -875,7 +819,7 @@ void Orchestrator::publishArrangePoses(const QVector<double>& pick, const QVecto
     int pick_base = A_TARGET_BASE_PICK;
     int place_base = A_TARGET_BASE_PLACE;
 
-    qDebug()<<"[ORCH] publishArrangePoses:"
+    qCDebug(lcOrch)<<"[ORCH] publishArrangePoses:"
             <<"pick="<<pick
             <<"place="<<place;
     // 포즈를 12워드(6float)로 인코딩해서 쓰기
@@ -948,3 +892,9 @@ QVector<quint16> Orchestrator::makeSortPickRegs(const QVector<double>& pose,
 
     return regs;
 }
+
+Pose6D Orchestrator::rotateToolYaw(const Pose6D& pose, float yaw)
+{
+    const EulerZYX rpy = toolRotate(pose.rx, pose.ry, pose.rz, yaw);
+    return Pose6D{ pose.x, pose.y, pose.z, rpy.roll, rpy.pitch, rpy.yaw };
+}
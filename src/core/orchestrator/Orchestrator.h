@@ -3,11 +3,11 @@
 
 #include <QObject>
 #include <QVariant>
-#include <QElapsedTimer>
-#include <QDateTime>
 
 #include "LogLevel.h"
 #include "Pose6D.h"
+#include "AddressMapGenerated.h"
+#include "RobotStateWord.h"
 
 class ModbusClient;
 class PickListModel;
@@ -40,7 +40,7 @@ public:
     struct RobotState {
         Pose6D tcp;            // X,Y,Z,Rx,Ry,Rz
         Pose6D joints;         // J1..J6 (deg)
-        qint64 tsMs = 0;       // timestamp
+        qint64 tsMs = 0;       // 수신 시각 (MonoClock ms)
         bool   hasTcp = false;
         bool   hasJoints = false;
     };
@@ -87,7 +87,9 @@ signals:
     void currentRowChanged(int row);
     void finishedCurrentCycle();
     void processPulse(const QString& robotId, int idx); // idx: 0→DO3, 1→DO4, 2→DO5
-    void stateFeedback(const RobotStateFeedback& st);
+    void busyChanged(const QString& robotId, bool busy); // ROBOT_BUSY 에지
+    void stateFeedback(const RobotStateFeedback& st);   // IR 상태가 바뀐 폴링에서만
+    void stateChange(const RobotStateChange& ch);       // 바뀐 필드/에러 에지 묶음 (같은 시점)
 
 private slots:
     void cycle();
@@ -112,47 +114,36 @@ private:
     int m_currentRow{-1};
 
     bool m_repeat{false};
-    QElapsedTimer m_stateTick;
-
-    // AddressMap.json 기반 주소
-    int A_PUBLISH_PICK  {100};      // coils
-    int A_PUBLISH_PLACE {101};      // coils
-    int A_DI2           {102};      // coils
-    int A_DI3           {103};      // coils
-    int A_DI4           {104};      // coils
-    int A_DI5           {105};      // coils
-    int A_DI6           {106};      // coils
-    int A_DI7           {107};      // coils
-    int A_DI8           {108};      // coils
-    int A_DI9           {109};      // coils
-    int A_DI10          {110};      // coils
-    int A_DI11          {111};      // coils
-
-    int A_ROBOT_READY   {100};      // discrete_inputs
-    int A_PICK_DONE     {101};      // discrete_inputs
-    int A_ROBOT_BUSY    {102};      // discrete_inputs
-    int A_DO1_PULSE     {101};
-    int A_DO2_PULSE     {102};
-    int A_DO3_PULSE     {103};
-    int A_DO4_PULSE     {104};
-    int A_DO5_PULSE     {105};
-    int A_DO6_PULSE     {106};
-    int A_DO7_PULSE     {107};
-    int A_DO8_PULSE     {108};
-    int A_DO9_PULSE     {109};
-    int A_DO10_PULSE    {110};
-    int A_DO11_PULSE    {111};
-    int A_DO12_PULSE    {112};
-    int A_DO13_PULSE    {113};
-    int A_DO14_PULSE    {114};
-
-    int A_TARGET_BASE   {132};      // holding: TARGET_POSE_STAGING_BASE (132..143)
-    int A_TARGET_BASE_PICK   {132}; // holding: TARGET_POSE_STAGING_BASE (132..143)
-    int A_TARGET_BASE_PLACE  {144}; // holding: TARGET_POSE_STAGING_BASE (144..155)
-
-    int IR_JOINT_BASE   {340};        // input_registers: JOINT_BASE (340..351)
-    int IR_TCP_BASE     {388};        // input_registers: TCP_BASE (388..399)
-    int IR_WORD_PER_POSE   {12};         // 6개 실수값 × 2워드
+
+    // AddressMap.json 기반 주소 (기본값: 빌드 시 생성된 AddressMap_A 상수, applyAddressMap 으로 덮어씀)
+    int A_PUBLISH_PICK  {AddressMapGen::A::coils::PUBLISH_PICK};      // coils
+    int A_PUBLISH_PLACE {AddressMapGen::A::coils::PUBLISH_PLACE};      // coils
+    int A_DI2           {AddressMapGen::A::coils::DI2};      // coils
+    int A_DI3           {AddressMapGen::A::coils::DI3};      // coils
+    int A_DI4           {AddressMapGen::A::coils::DI4};      // coils
+    int A_DI5           {AddressMapGen::A::coils::DI5};      // coils
+    int A_DI6           {AddressMapGen::A::coils::DI6};      // coils
+    int A_DI7           {AddressMapGen::A::coils::DI7};      // coils
+    int A_DI8           {AddressMapGen::A::coils::DI8};      // coils
+    int A_DI9           {AddressMapGen::A::coils::DI9};      // coils
+    int A_DI10          {AddressMapGen::A::coils::DI10};      // coils
+    int A_DI11          {AddressMapGen::A::coils::DI11};      // coils
+
+    int A_ROBOT_READY   {AddressMapGen::A::discrete_inputs::ROBOT_READY};      // discrete_inputs
+    int A_PICK_DONE     {AddressMapGen::A::discrete_inputs::PICK_DONE};      // discrete_inputs
+    int A_ROBOT_BUSY    {AddressMapGen::A::discrete_inputs::ROBOT_BUSY};      // discrete_inputs
+    // DOn_PULSE 입력 → processPulse(n). 기본은 생성된 A 펄스 표, applyAddressMap 에 DOn_PULSE 가 있으면 그 맵으로 다시 만든다.
+    // (DO1 은 별도 입력 없이 PICK_DONE 을 같이 쓴다: 상승 → 1, 하강 → 2)
+    struct PulseInput { int idx; int addr; bool last; };
+    QVector<PulseInput> m_pulses;
+
+    int A_TARGET_BASE   {AddressMapGen::A::holding::TARGET_POSE_BASE};      // holding: TARGET_POSE_STAGING_BASE (132..143)
+    int A_TARGET_BASE_PICK   {AddressMapGen::A::holding::TARGET_POSE_PICK}; // holding: TARGET_POSE_STAGING_BASE (132..143)
+    int A_TARGET_BASE_PLACE  {AddressMapGen::A::holding::TARGET_POSE_PLACE}; // holding: TARGET_POSE_STAGING_BASE (144..155)
+
+    int IR_JOINT_BASE   {AddressMapGen::A::input_registers::CUR_JOINT_BASE};  // input_registers: JOINT_BASE (340..351)
+    int IR_TCP_BASE     {AddressMapGen::A::input_registers::CUR_TCP_BASE};    // input_registers: TCP_BASE (388..399)
+    int IR_WORD_PER_POSE   {AddressMapGen::A::meta::pose_words};         // 6개 실수값 × 2워드
 
     QString IR_WORD_ORDER {"HI_LO"}; // "HI_LO" 또는 "LO_HI"
 /*
@@ -169,11 +160,7 @@ private:
     bool m_lastDone{false};
 
     bool m_lastDI2{false}, m_lastDI3{false},  m_lastDI4{false};
-    bool m_lastDO1{false}, m_lastDO2{false};
-    bool m_lastDO3{false}, m_lastDO4{false},  m_lastDO5{false};
-    bool m_lastDO6{false}, m_lastDO7{false},  m_lastDO8{false};
-    bool m_lastDO9{false}, m_lastDO10{false}, m_lastDO11{false};
-    bool m_lastDO12{false}, m_lastDO13{false}, m_lastDO14{false};
+    bool m_lastDO1{false};
 
     quint16 m_seq{0};
     float m_yawOffset{0.0f};
@@ -181,6 +168,8 @@ private:
 private:
     bool flag_state {false};
     RobotStateFeedback st_;
+    RobotStateWord m_stateWord;     // 직전 IR 310.. 상태 (압축)
+    bool m_stateSeen{false};        // 첫 수신은 변화 없어도 1회 발행
 
 private:
     // 상태 전용 헬퍼: 여기서만 상태를 바꾸고, 시그널/로그를 함께 처리
@@ -201,6 +190,8 @@ public:
                                              int yawOffset,
                                              int thick);
 
+    // 툴 프레임 기준 yaw 추가 회전 후 정규화된 자세 (레시피 인자용)
+    static Pose6D rotateToolYaw(const Pose6D& pose, float yaw);
 };
 
 #endif // ORCHESTRATOR_H
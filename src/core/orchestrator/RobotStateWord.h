@@ -0,0 +1,121 @@
+#ifndef ROBOTSTATEWORD_H
+#define ROBOTSTATEWORD_H
+
+#include <QtGlobal>
+#include <QVector>
+
+// ─────────────────────────────────────────────────────────────
+// IR 310..322 (RobotStateFeedback 13워드) 를 quint64 두 개에 압축한 상태 워드.
+// 이전 워드와 XOR 한 번으로 바뀐 필드 전체를 구하고,
+// 바뀐 것이 없으면 아무것도 하지 않는다 (폴링 20Hz 무변화 시 비용 0).
+//
+// w[0]: bit0..6  enabled, emergency, softLimit, collision, motionArrive, SI0, SI1
+//       bit8..23 mode, bit24..39 runningState, bit40..55 toolNumber
+// w[1]: bit0..15 mainError, bit16..31 subError, bit32..47 workpieceNumber
+// ─────────────────────────────────────────────────────────────
+struct RobotStateWord
+{
+    enum Field : int {
+        Enabled, EmergencyStop, SoftLimit, Collision, MotionArrive, SafetySI0, SafetySI1,
+        Mode, RunningState, ToolNumber,
+        MainError, SubError, WorkpieceNumber,
+        FieldCount
+    };
+
+    // 동시에 여러 개가 켜질 수 있는 에러 에지 (비트마스크)
+    enum ErrorEdge : quint32 {
+        EdgeLimit       = 1u << 0,  // softLimit ↑
+        EdgeCollision   = 1u << 1,  // collision ↑
+        EdgeMainError   = 1u << 2,  // mainError 0 → !0
+        EdgeSubError    = 1u << 3,  // subError 0 → !0
+        EdgeUnreachable = 1u << 4,  // runningState 2 → 1
+    };
+
+    quint64 w[2]{0, 0};
+
+    struct Spec { quint8 word; quint8 shift; quint8 bits; };
+    static constexpr Spec kSpec[FieldCount] = {
+        {0, 0, 1}, {0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {0, 4, 1}, {0, 5, 1}, {0, 6, 1},
+        {0, 8, 16}, {0, 24, 16}, {0, 40, 16},
+        {1, 0, 16}, {1, 16, 16}, {1, 32, 16},
+    };
+
+    static constexpr quint64 mask(Field f)
+    {
+        return ((quint64(1) << kSpec[f].bits) - 1) << kSpec[f].shift;
+    }
+
+    int get(Field f) const
+    {
+        return int((w[kSpec[f].word] & mask(f)) >> kSpec[f].shift);
+    }
+    bool flag(Field f) const { return get(f) != 0; }
+
+    void set(Field f, quint16 v)
+    {
+        quint64& x = w[kSpec[f].word];
+        x = (x & ~mask(f)) | ((quint64(v) << kSpec[f].shift) & mask(f));
+    }
+
+    bool operator==(const RobotStateWord& o) const { return w[0] == o.w[0] && w[1] == o.w[1]; }
+    bool operator!=(const RobotStateWord& o) const { return !(*this == o); }
+
+    // IR 310.. 13워드 → 상태 워드 (불리언 필드는 ==1 만 참, 기존 디코딩과 동일)
+    static RobotStateWord fromRegisters(const QVector<quint16>& d)
+    {
+        RobotStateWord s;
+        s.set(Enabled,         d[0] == 1);
+        s.set(Mode,            d[1]);
+        s.set(RunningState,    d[2]);
+        s.set(ToolNumber,      d[3]);
+        s.set(WorkpieceNumber, d[4]);
+        s.set(EmergencyStop,   d[5] == 1);
+        s.set(SoftLimit,       d[6] == 1);
+        s.set(MainError,       d[7]);
+        s.set(SubError,        d[8]);
+        s.set(Collision,       d[9] == 1);
+        s.set(MotionArrive,    d[10] == 1);
+        s.set(SafetySI0,       d[11] == 1);
+        s.set(SafetySI1,       d[12] == 1);
+        return s;
+    }
+
+    // 바뀐 필드 비트마스크 (bit i = Field i). 같으면 0.
+    static quint32 changedFields(const RobotStateWord& a, const RobotStateWord& b)
+    {
+        const quint64 d0 = a.w[0] ^ b.w[0];
+        const quint64 d1 = a.w[1] ^ b.w[1];
+        if ((d0 | d1) == 0) return 0;
+
+        quint32 out = 0;
+        for (int f = 0; f < FieldCount; ++f) {
+            const quint64 d = kSpec[f].word ? d1 : d0;
+            if (d & mask(Field(f))) out |= 1u << f;
+        }
+        return out;
+    }
+
+    // before → after 에서 생긴 에러 에지 전부 (동시 발생 포함)
+    static quint32 errorEdges(const RobotStateWord& before, const RobotStateWord& after)
+    {
+        quint32 e = 0;
+        if (!before.flag(SoftLimit) && after.flag(SoftLimit))   e |= EdgeLimit;
+        if (!before.flag(Collision) && after.flag(Collision))   e |= EdgeCollision;
+        if (before.get(MainError) == 0 && after.get(MainError)) e |= EdgeMainError;
+        if (before.get(SubError) == 0 && after.get(SubError))   e |= EdgeSubError;
+        if (before.get(RunningState) == 2 && after.get(RunningState) == 1) e |= EdgeUnreachable;
+        return e;
+    }
+};
+
+// 상태 변화 한 건 (바뀐 경우에만 발행)
+struct RobotStateChange
+{
+    RobotStateWord before;
+    RobotStateWord after;
+    quint32 changed = 0;    // RobotStateWord::changedFields
+    quint32 edges = 0;      // RobotStateWord::errorEdges
+    qint64 tsMs = 0;        // 수신 시각 (MonoClock ms)
+};
+
+#endif // ROBOTSTATEWORD_H
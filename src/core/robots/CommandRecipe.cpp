@@ -0,0 +1,232 @@
+#include "CommandRecipe.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+struct ArgName { const char* name; int source; };
+
+const ArgName kArgNames[] = {
+    { "pose",       CompiledRecipe::kPose },
+    { "pose2",      CompiledRecipe::kPose2 },
+    { "mode",       int(RecipeArg::Mode) },
+    { "flip",       int(RecipeArg::Flip) },
+    { "offset",     int(RecipeArg::Offset) },
+    { "yaw",        int(RecipeArg::Yaw) },
+    { "thick",      int(RecipeArg::Thick) },
+    { "clamp_mode", int(RecipeArg::ClampMode) },
+    { "open",       int(RecipeArg::Open) },
+};
+
+int argSource(const QString& name)
+{
+    for (const auto& a : kArgNames)
+        if (name == QLatin1String(a.name)) return a.source;
+    return -1;
+}
+
+void floatToRegs(float value, quint16& hi, quint16& lo)
+{
+    quint32 raw;
+    std::memcpy(&raw, &value, sizeof(raw));
+    hi = quint16(raw >> 16);
+    lo = quint16(raw & 0xFFFF);
+}
+
+double poseComponent(const Pose6D& p, int i)
+{
+    switch (i) {
+    case 0: return p.x;  case 1: return p.y;  case 2: return p.z;
+    case 3: return p.rx; case 4: return p.ry; default: return p.rz;
+    }
+}
+
+// 숫자 또는 주소맵 키 → 주소
+bool resolveAddr(const QJsonValue& v, const QVariantMap& space, int* out)
+{
+    if (v.isDouble()) { *out = v.toInt(-1); return *out >= 0; }
+    if (v.isString() && space.contains(v.toString())) {
+        *out = space.value(v.toString()).toInt();
+        return *out >= 0;
+    }
+    return false;
+}
+
+} // namespace
+
+QVector<MbOp> CompiledRecipe::instantiate(const RecipeArgs& args) const
+{
+    QVector<MbOp> out = ops;
+    for (const Patch& p : patches) {
+        double x = 0.0;
+        if (p.source == kPose)       x = poseComponent(args.pose,  p.component);
+        else if (p.source == kPose2) x = poseComponent(args.pose2, p.component);
+        else                         x = args.v[p.source];
+
+        MbOp& op = out[p.op];
+        if (op.kind == MbOp::Kind::WriteCoil) {
+            op.coilValue = (x != 0.0);
+        } else if (p.f32) {
+            quint16 hi, lo;
+            floatToRegs(float(x), hi, lo);
+            op.blockValues[p.word]     = hi;
+            op.blockValues[p.word + 1] = lo;
+        } else {
+            op.blockValues[p.word] = quint16(qRound(x));
+        }
+    }
+    return out;
+}
+
+bool RecipeBook::load(const QString& path, QString* err)
+{
+    QString file = path;
+    if (file.isEmpty()) {
+        const QString local = QDir(QCoreApplication::applicationDirPath()).filePath("recipes.json");
+        file = QFile::exists(local) ? local : QStringLiteral(":/config/recipes.json");
+    }
+
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (err) *err = QString("open failed: %1").arg(file);
+        return false;
+    }
+    QJsonParseError pe{};
+    const auto doc = QJsonDocument::fromJson(f.readAll(), &pe);
+    if (!doc.isObject()) {
+        if (err) *err = QString("%1: %2 (offset %3)").arg(file, pe.errorString()).arg(pe.offset);
+        return false;
+    }
+
+    QVector<Spec> specs;
+    const QJsonObject recipes = doc.object().value("recipes").toObject();
+    for (auto it = recipes.begin(); it != recipes.end(); ++it) {
+        Spec s;
+        s.name  = it.key();
+        s.json  = it.value().toObject();
+        s.robot = s.json.value("robot").toString();
+        specs.push_back(s);
+    }
+    m_specs = specs;
+    m_source = file;
+    return true;
+}
+
+bool RecipeBook::compile(const Spec& spec, const QVariantMap& addr,
+                         CompiledRecipe* out, QString* err)
+{
+    auto fail = [&](const QString& why) {
+        if (err) *err = QString("recipe %1: %2").arg(spec.name, why);
+        return false;
+    };
+
+    const QVariantMap holding = addr.value("holding").toMap();
+    const QVariantMap coils   = addr.value("coils").toMap();
+
+    CompiledRecipe r;
+    r.name  = spec.name;
+    r.robot = spec.robot;
+    r.completePulse = spec.json.value("complete_pulse").toInt(-1);
+
+    // 1) 쓰기
+    const QJsonArray writes = spec.json.value("writes").toArray();
+    for (const auto& wv : writes) {
+        const QJsonObject w = wv.toObject();
+        const bool isCoil = (w.value("space").toString() == "coil");
+        const bool f32    = (w.value("format").toString() == "f32");
+
+        MbOp op;
+        if (!resolveAddr(w.value("addr"), isCoil ? coils : holding, &op.start))
+            return fail(QString("unknown addr %1").arg(w.value("addr").toVariant().toString()));
+
+        const int opIdx = r.ops.size();
+        int word = 0;
+        const QJsonArray values = w.value("values").toArray();
+        for (const auto& v : values) {
+            if (v.isDouble()) {
+                if (f32) {
+                    quint16 hi, lo;
+                    floatToRegs(float(v.toDouble()), hi, lo);
+                    op.blockValues << hi << lo;
+                    word += 2;
+                } else {
+                    op.blockValues << quint16(v.toInt());
+                    word += 1;
+                }
+                continue;
+            }
+            const QString s = v.toString();
+            const int src = s.startsWith('$') ? argSource(s.mid(1)) : -1;
+            if (src < 0) return fail(QString("unknown value %1").arg(s));
+
+            const int n = (src >= CompiledRecipe::kPose) ? 6 : 1;
+            for (int c = 0; c < n; ++c) {
+                CompiledRecipe::Patch p;
+                p.op = opIdx;
+                p.word = word;
+                p.source = src;
+                p.component = c;
+                p.f32 = f32;
+                r.patches.push_back(p);
+                const int words = f32 ? 2 : 1;
+                for (int k = 0; k < words; ++k) op.blockValues << 0;
+                word += words;
+            }
+        }
+        if (op.blockValues.isEmpty()) return fail("empty write");
+
+        if (isCoil) {
+            if (op.blockValues.size() != 1 || f32) return fail("coil write takes one u16 value");
+            op.kind = MbOp::Kind::WriteCoil;
+            op.coilValue = op.blockValues.front() != 0;
+            op.blockValues.clear();
+        } else {
+            op.kind = MbOp::Kind::WriteHoldingBlock;
+        }
+        r.ops.push_back(op);
+    }
+
+    // 2) 펄스 타임라인 → ON/OFF + DelayMs
+    struct Edge { int t; int addr; bool on; };
+    QVector<Edge> edges;
+    const QJsonArray pulses = spec.json.value("pulses").toArray();
+    for (const auto& pv : pulses) {
+        const QJsonObject p = pv.toObject();
+        int coil = -1;
+        if (!resolveAddr(p.value("coil"), coils, &coil))
+            return fail(QString("unknown coil %1").arg(p.value("coil").toVariant().toString()));
+        const int at    = qMax(0, p.value("at_ms").toInt(0));
+        const int width = qMax(1, p.value("width_ms").toInt(500));
+        edges.push_back({at, coil, true});
+        edges.push_back({at + width, coil, false});
+    }
+    std::stable_sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b){
+        if (a.t != b.t) return a.t < b.t;
+        return !a.on && b.on;   // 같은 시각이면 OFF 먼저
+    });
+    int t = 0;
+    for (const Edge& e : edges) {
+        if (e.t > t) {
+            MbOp d;
+            d.kind = MbOp::Kind::DelayMs;
+            d.delayMs = e.t - t;
+            r.ops.push_back(d);
+            t = e.t;
+        }
+        MbOp c;
+        c.kind = MbOp::Kind::WriteCoil;
+        c.start = e.addr;
+        c.coilValue = e.on;
+        r.ops.push_back(c);
+    }
+
+    if (r.ops.isEmpty()) return fail("no ops");
+    *out = r;
+    return true;
+}
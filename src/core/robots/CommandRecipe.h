@@ -0,0 +1,103 @@
+#ifndef COMMANDRECIPE_H
+#define COMMANDRECIPE_H
+
+#include <QString>
+#include <QVector>
+#include <QPointer>
+#include <QVariantMap>
+#include <QJsonObject>
+
+#include "Pose6D.h"
+#include "ModbusClient.h"
+
+// ─────────────────────────────────────────────────────────────
+// 명령 레시피: recipes.json 에 기술된 명령(레지스터 채우기 + 코일 펄스)을
+// 로봇 주소맵에 맞춰 한 번 컴파일해 두고, 호출 시 인자만 채워
+// ModbusClient::enqueueGroup() 으로 하나의 원자 그룹으로 투입한다.
+//
+// recipes.json 형식
+// {
+//   "recipes": {
+//     "sorting.pick": {
+//       "robot": "A",
+//       "writes": [                                   // 먼저 쓰기 (순서대로)
+//         { "addr": "TARGET_POSE_PICK", "format": "f32",
+//           "values": ["$pose", "$flip", "$offset", "$yaw", "$thick"] },
+//         { "space": "coil", "addr": 110, "values": ["$open"] }
+//       ],
+//       "pulses": [                                   // 쓰기 후 타임라인
+//         { "coil": "DI5",          "at_ms": 0,  "width_ms": 500 },
+//         { "coil": "PUBLISH_PICK", "at_ms": 10, "width_ms": 490 }
+//       ],
+//       "complete_pulse": 5                           // 완료 시 기대하는 DO 인덱스
+//     }
+//   }
+// }
+// - addr / coil : 숫자 또는 주소맵 키 (holding / coils)
+// - format      : "u16"(기본) | "f32" (HI_LO 2워드)
+// - values      : 숫자 리터럴, "$<arg>" 스칼라, "$pose"/"$pose2" (6개 값으로 확장)
+// - complete_pulse : 코일 기록이 끝나면 RobotManager 가 이 DOn_PULSE 를 기다린다.
+//                    도착 순서로 명령 완료를 맞추고, 기다리지 않던 완료 펄스는 경고.
+// ─────────────────────────────────────────────────────────────
+
+enum class RecipeArg : int {
+    Mode, Flip, Offset, Yaw, Thick, ClampMode, Open,
+    Count
+};
+
+struct RecipeArgs {
+    Pose6D pose{};
+    Pose6D pose2{};
+    double v[int(RecipeArg::Count)]{};
+
+    RecipeArgs& set(RecipeArg a, double x) { v[int(a)] = x; return *this; }
+};
+
+struct CompiledRecipe {
+    // 실행 시 인자로 채울 위치
+    struct Patch {
+        int op = 0;         // ops 인덱스
+        int word = 0;       // blockValues 내 워드 위치 (코일 쓰기는 0)
+        int source = 0;     // RecipeArg 값 또는 kPose/kPose2 + 성분
+        int component = 0;  // pose 성분 0..5
+        bool f32 = false;
+    };
+    enum : int { kPose = 100, kPose2 = 101 };
+
+    QString name;
+    QString robot;
+    QPointer<ModbusClient> bus;   // 컴파일 시 바인딩된 로봇 버스
+    int robotIndex = -1;          // RobotManager 조밀 인덱스
+    QVector<MbOp> ops;        // 리터럴은 미리 채워진 템플릿
+    QVector<Patch> patches;
+    int completePulse = -1;       // 기대하는 완료 펄스 DO 인덱스 (-1: 없음)
+
+    bool isValid() const { return !ops.isEmpty(); }
+    QVector<MbOp> instantiate(const RecipeArgs& args) const;
+};
+
+class RecipeBook
+{
+public:
+    struct Spec {
+        QString name;
+        QString robot;
+        QJsonObject json;
+    };
+
+    // path 가 비어 있으면: 실행 파일 옆 recipes.json → :/config/recipes.json 순
+    bool load(const QString& path = QString(), QString* err = nullptr);
+
+    const QVector<Spec>& specs() const { return m_specs; }
+    QString source() const { return m_source; }
+
+    // addr: 대상 로봇의 AddressMap (RobotContext::addr_)
+    static bool compile(const Spec& spec, const QVariantMap& addr,
+                        CompiledRecipe* out, QString* err);
+
+private:
+    QVector<Spec> m_specs;
+    QString m_source;
+};
+
+#endif // COMMANDRECIPE_H
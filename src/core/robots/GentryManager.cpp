@@ -1,4 +1,5 @@
 #include "GentryManager.h"
+#include "LogCategories.h"
 #include <qdebug.h>
 #include <QModbusDevice>
 #include <QDateTime>
@@ -177,7 +178,7 @@ void GentryManager::setup_motorStateMonitoring()
     QObject::connect(m_gantryDriver_, &Leadshine::Eld2Gantry::readEncoder,this,[=](int id, int32_t pulse, float pos){
         //qDebug()<<QString("%1번 모터 엔코더: %2 pulse, %3 mm").arg(id).arg(pulse).arg(pos);
         m_currentPos[id] = pulse;
-        qDebug()<<QString("Gantry %1 current pos: %2, %3").arg(id).arg(pos).arg(pulse);
+        qCDebug(lcGantry)<<QString("Gantry %1 current pos: %2, %3").arg(id).arg(pos).arg(pulse);
         updatePositions(id);
     });
     QObject::connect(m_conveyorDriver_, &Leadshine::Eld2Conveyor::readEncoder,this,[=](int id, int32_t pulse, float pos){
@@ -257,13 +258,13 @@ void GentryManager::updatePositions(int axis)
             }
             else
             {
-                qDebug()<<"Gentry position unknown:"
+                qCWarning(lcGantry)<<"Gentry position unknown:"
                          <<QString("X:%1, Z:%2, P:%3, place_cmd: 74000, %4 , -25020")
                                 .arg(xPos).arg(zPos).arg(pickerAngle).arg(m_targetGentryZ);
                 currentPose = GantryPose::None;
             }
             /////////////////////////////////////////////////////////////////////
-            qDebug()<<QDateTime::currentDateTime()<<QString("Gentry currentPose=%1").arg(gantryPoseToString(currentPose));
+            qCDebug(lcGantry) <<QString("Gentry currentPose=%1").arg(gantryPoseToString(currentPose));
             emit gantryCommandFinished(false, currentPose);
         }
     }
@@ -364,13 +365,13 @@ void GentryManager::onAxisFinished(int axis, int seq, bool ok)
             }
             else
             {
-                qDebug()<<"Gentry position unknown:"
+                qCWarning(lcGantry)<<"Gentry position unknown:"
                        <<QString("X:%1, Z:%2, P:%3, place_cmd: 74000, %4 , -25020")
                                 .arg(xPos).arg(zPos).arg(pickerAngle).arg(m_targetGentryZ);
                 currentPose = GantryPose::None;
             }
 /////////////////////////////////////////////////////////////////////
-            qDebug()<<QDateTime::currentDateTime()<<QString("Gentry currentPose=%1").arg(gantryPoseToString(currentPose));
+            qCDebug(lcGantry) <<QString("Gentry currentPose=%1").arg(gantryPoseToString(currentPose));
             emit gantryCommandFinished(m_gantryOk, currentPose);
             m_gantryOk = true;
         }
@@ -512,7 +513,7 @@ void GentryManager::gentry_motion()
         break;
 
     case picker_90: //picker -90 degree rotate
-        qDebug()<<QString("picker_90");
+        qCDebug(lcGantry)<<QString("picker_90");
         m_gantryDriver_->reqWritePos(3, -25020); //picker rotate -90 degree
         motion_seq = gty_z_place_pos;
         //magnet Off msg to robot
@@ -520,7 +521,7 @@ void GentryManager::gentry_motion()
         break;
 
     case picker_0: //picker 0 degree rotate
-        qDebug()<<QString("picker_0");
+        qCDebug(lcGantry)<<QString("picker_0");
         m_gantryDriver_->reqWritePos(3, 0); //picker rotate 0 degree
         //QThread::sleep(1000);
         //msg send to robot for magnet On
@@ -531,7 +532,7 @@ void GentryManager::gentry_motion()
 
         if(m_conveyorDriver_->isMotionDone(4)){
             logMessage2("conveyor move done");
-            qDebug()<<QString("conveyor move done");
+            qCDebug(lcGantry)<<QString("conveyor move done");
         }
         else if(m_gantryDriver_->isMotionDone(1)){
             logMessage2("X move done\r\n");
@@ -546,7 +547,7 @@ void GentryManager::gentry_motion()
         break;
 
     case msg_rdy_1:
-        qDebug()<<QString("msg_rdy_1");
+        qCDebug(lcGantry)<<QString("msg_rdy_1");
         /*  if(receive from robot){ //magnet On Msg
                 motion_seq = gty_place_pos;
             }
@@ -557,7 +558,7 @@ void GentryManager::gentry_motion()
         break;
 
     case msg_rdy_2:
-        qDebug()<<QString("msg_rdy_2");
+        qCDebug(lcGantry)<<QString("msg_rdy_2");
         /*  if(receive from robot){ //magnet Off Msg
                 motion_seq = gty_x_home_pos;
             }
@@ -0,0 +1,143 @@
+#include "PulseDispatcher.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "MonoClock.h"
+
+namespace {
+
+bool parseAction(const QJsonObject& o, PulseDispatcher::Action* out)
+{
+    using Kind = PulseDispatcher::Action::Kind;
+    PulseDispatcher::Action a;
+    a.delayMs = qMax(0, o.value("delay_ms").toInt(0));
+
+    const QString send = o.value("send").toString();
+    const QString sig  = o.value("emit").toString();
+    if (send == "work_complete") {
+        a.kind = Kind::WorkComplete;
+        a.a = o.value("type").toString();
+        a.b = o.value("kind").toString();
+        a.flag = o.value("clamp").toBool(false);
+    } else if (send == "tool_complete") {
+        a.kind = Kind::ToolComplete;
+        a.flag = o.value("state").toBool(true);
+    } else if (send == "feedback_pose") {
+        a.kind = Kind::FeedbackPose;
+        a.a = o.value("from").toString();
+        a.b = o.value("to").toString();
+    } else if (sig == "sort_finished") {
+        a.kind = Kind::SortFinished;
+    } else if (sig == "gantry_place") {
+        a.kind = Kind::GantryPlace;
+    } else if (sig == "gantry_ready") {
+        a.kind = Kind::GantryReady;
+    } else {
+        return false;
+    }
+    *out = a;
+    return true;
+}
+
+} // namespace
+
+PulseDispatcher::PulseDispatcher() = default;
+
+int PulseDispatcher::slotOf(const QString& robotId)
+{
+    auto it = m_slotById.constFind(robotId);
+    if (it != m_slotById.constEnd()) return it.value();
+
+    const int slot = m_table.size();
+    m_slotById.insert(robotId, slot);
+    m_table.push_back(QVector<Entry>());
+    return slot;
+}
+
+bool PulseDispatcher::load(const QString& path, QString* err)
+{
+    QString file = path;
+    if (file.isEmpty()) {
+        const QString local = QDir(QCoreApplication::applicationDirPath()).filePath("pulse_actions.json");
+        file = QFile::exists(local) ? local : QStringLiteral(":/config/pulse_actions.json");
+    }
+
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (err) *err = QString("open failed: %1").arg(file);
+        return false;
+    }
+    QJsonParseError pe{};
+    const auto doc = QJsonDocument::fromJson(f.readAll(), &pe);
+    if (!doc.isObject()) {
+        if (err) *err = QString("%1: %2 (offset %3)").arg(file, pe.errorString()).arg(pe.offset);
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    const int defDebounce = root.value("debounce_ms").toInt(50);
+    const QJsonObject robots = root.value("robots").toObject();
+
+    // 전부 파싱에 성공해야 교체 (부분 반영 금지)
+    QHash<QString, QVector<Entry>> parsed;
+    for (auto r = robots.begin(); r != robots.end(); ++r) {
+        QVector<Entry> rows;
+        const QJsonObject pulses = r.value().toObject();
+        for (auto p = pulses.begin(); p != pulses.end(); ++p) {
+            bool okIdx = false;
+            const int idx = p.key().toInt(&okIdx);
+            if (!okIdx || idx < 0 || idx > 255) {
+                if (err) *err = QString("%1: robot %2 bad pulse idx '%3'").arg(file, r.key(), p.key());
+                return false;
+            }
+            const QJsonObject o = p.value().toObject();
+
+            Entry e;
+            e.debounceMs = qMax(0, o.value("debounce_ms").toInt(defDebounce));
+            e.log = o.value("log").toString();
+            const QJsonArray acts = o.value("actions").toArray();
+            for (const auto& av : acts) {
+                Action a;
+                if (!parseAction(av.toObject(), &a)) {
+                    if (err) *err = QString("%1: robot %2 idx %3 unknown action").arg(file, r.key()).arg(idx);
+                    return false;
+                }
+                e.actions.push_back(a);
+            }
+
+            if (rows.size() <= idx) rows.resize(idx + 1);
+            rows[idx] = e;
+        }
+        parsed.insert(r.key(), rows);
+    }
+
+    // 기존 slot 번호는 유지 (hookSignals 에서 캡처해 둔 값)
+    for (auto it = m_slotById.cbegin(); it != m_slotById.cend(); ++it)
+        m_table[it.value()] = parsed.value(it.key());
+    for (auto it = parsed.cbegin(); it != parsed.cend(); ++it)
+        m_table[slotOf(it.key())] = it.value();
+
+    m_source = file;
+    return true;
+}
+
+const PulseDispatcher::Entry* PulseDispatcher::take(int slot, int idx)
+{
+    if (slot < 0 || slot >= m_table.size()) return nullptr;
+    QVector<Entry>& rows = m_table[slot];
+    if (idx < 0 || idx >= rows.size()) return nullptr;
+
+    Entry& e = rows[idx];
+    if (!e.isMapped()) return nullptr;
+
+    const qint64 now = MonoClock::nowMs();
+    if (e.lastMs >= 0 && now - e.lastMs < e.debounceMs)
+        return nullptr; // 같은 펄스의 중복 에지
+    e.lastMs = now;
+    return &e;
+}
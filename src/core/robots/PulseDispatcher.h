@@ -0,0 +1,73 @@
+#ifndef PULSEDISPATCHER_H
+#define PULSEDISPATCHER_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// ─────────────────────────────────────────────────────────────
+// 로봇 완료 펄스(Orchestrator::processPulse) → 비전 보고 테이블
+//
+// pulse_actions.json 을 [로봇 slot][pulse idx] 표로 펼쳐 두고,
+// 이벤트마다 인덱스 두 번으로 항목을 찾는다 (문자열 키 생성 없음).
+// 디바운스는 항목별 마지막 발송 시각(단조 시계)과 비교한다.
+//
+// pulse_actions.json 형식
+// {
+//   "debounce_ms": 50,                       // 기본 디바운스
+//   "robots": {
+//     "A": {
+//       "7": { "log": "Sort Place Complete", "debounce_ms": 50,
+//              "actions": [
+//                { "send": "work_complete", "type": "sorting", "kind": "place" },
+//                { "send": "work_complete", "type": "sorting", "kind": "idle" },
+//                { "emit": "sort_finished" } ] }
+//     }
+//   }
+// }
+// - send : "work_complete"(type, kind, clamp) | "tool_complete"(state)
+//          | "feedback_pose"(from, to)
+// - emit : "sort_finished" | "gantry_place" | "gantry_ready"
+// - delay_ms : 해당 액션만 지연 (기본 0 = 즉시)
+// ─────────────────────────────────────────────────────────────
+class PulseDispatcher
+{
+public:
+    struct Action {
+        enum class Kind { WorkComplete, ToolComplete, FeedbackPose,
+                          SortFinished, GantryPlace, GantryReady };
+        Kind kind = Kind::WorkComplete;
+        QString a;          // work: type / feedback: from
+        QString b;          // work: kind / feedback: to
+        bool flag = false;  // work: clampState / tool: state
+        int delayMs = 0;
+    };
+
+    struct Entry {
+        QVector<Action> actions;
+        qint64 debounceMs = 0;
+        qint64 lastMs = -1;     // 마지막 발송 시각 (-1: 없음)
+        QString log;
+
+        bool isMapped() const { return !actions.isEmpty(); }
+    };
+
+    PulseDispatcher();
+
+    // path 가 비어 있으면: 실행 파일 옆 pulse_actions.json → :/config/pulse_actions.json 순
+    bool load(const QString& path = QString(), QString* err = nullptr);
+    QString source() const { return m_source; }
+
+    // 로봇 id → slot (없으면 빈 표로 생성). hookSignals 시점에 한 번 구해 둔다.
+    int slotOf(const QString& robotId);
+
+    // 디바운스 통과 시 실행할 항목, 매핑 없음/디바운스 중이면 nullptr
+    const Entry* take(int slot, int idx);
+
+private:
+    QHash<QString, int> m_slotById;
+    QVector<QVector<Entry>> m_table;   // [slot][idx]
+    QString m_source;
+};
+
+#endif // PULSEDISPATCHER_H
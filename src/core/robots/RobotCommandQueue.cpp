@@ -0,0 +1,272 @@
+#include "RobotCommandQueue.h"
+
+RobotCommandQueue::RobotCommandQueue(QObject* parent) : QObject(parent)
+{
+    m_timeout.setSingleShot(true);
+    m_timeout.setTimerType(Qt::PreciseTimer);
+    connect(&m_timeout, &QTimer::timeout, this, &RobotCommandQueue::onTimeout);
+}
+
+quint64 RobotCommandQueue::enqueue(const Sequence& steps, Finished onFinished, OnFail onFail)
+{
+    if (steps.isEmpty()) {
+        if (onFinished) onFinished(true, QString());
+        return 0;
+    }
+
+    Job job;
+    job.ticket = m_nextTicket++;
+    job.stack.push_back({ std::make_shared<const Sequence>(steps), 0 });
+    job.onFinished = std::move(onFinished);
+    job.onFail = onFail;
+    job.label = steps.first().label;
+    m_jobs.enqueue(job);
+
+    if (!m_running) runNext();
+    return job.ticket;
+}
+
+bool RobotCommandQueue::cancel(quint64 ticket)
+{
+    if (m_running && m_cur.ticket == ticket) {
+        finishJob(false, QStringLiteral("cancelled"), false);
+        return true;
+    }
+    for (int i = 0; i < m_jobs.size(); ++i) {
+        if (m_jobs[i].ticket != ticket) continue;
+        dropJob(m_jobs.takeAt(i), QStringLiteral("cancelled"));
+        return true;
+    }
+    return false;
+}
+
+void RobotCommandQueue::cancelAll(const QString& reason)
+{
+    QQueue<Job> pending;
+    pending.swap(m_jobs);
+    if (m_running) finishJob(false, reason, false);
+
+    for (const Job& job : pending)
+        dropJob(job, reason);
+}
+
+// 실행되지 못한 대기 시퀀스 정리: 무엇이 왜 빠졌는지 한 줄씩 남긴다
+void RobotCommandQueue::dropJob(const Job& job, const QString& reason)
+{
+    emit log(QString("[CMDQ] sequence %1 (%2) dropped: %3")
+                 .arg(job.ticket).arg(job.label.isEmpty() ? QStringLiteral("-") : job.label, reason),
+             Common::LogLevel::Warn);
+    if (job.onFinished) job.onFinished(false, reason);
+    emit sequenceFinished(job.ticket, false, reason);
+}
+
+void RobotCommandQueue::runNext()
+{
+    if (m_jobs.isEmpty()) { m_running = false; return; }
+    m_running = true;
+    m_cur = m_jobs.dequeue();
+    m_attempt = 0;
+    runStep();
+}
+
+const RobotCommandQueue::Step& RobotCommandQueue::currentStep() const
+{
+    const Frame& f = m_cur.stack.last();
+    return f.steps->at(f.idx);
+}
+
+void RobotCommandQueue::runStep()
+{
+    // nested 는 스택에 펼쳐서 실행: 부모 idx 는 미리 넘겨두고 하위가 끝나면 이어서 진행
+    while (!m_cur.stack.isEmpty()) {
+        Frame& f = m_cur.stack.last();
+        if (f.idx >= f.steps->size()) {
+            m_cur.stack.removeLast();
+            continue;
+        }
+        const Step& s = f.steps->at(f.idx);
+        if (s.children) {
+            const auto children = s.children;
+            ++f.idx;
+            if (!children->isEmpty())
+                m_cur.stack.push_back({ children, 0 });
+            continue;
+        }
+        m_attempt = 0;
+        startAttempt();
+        return;
+    }
+    finishJob(true, QString(), false);
+}
+
+void RobotCommandQueue::startAttempt()
+{
+    const Step s = currentStep(); // run() 이 동기로 done 을 불러 스택이 바뀌어도 안전하도록 복사
+    const quint64 gen = ++m_gen;
+
+    if (s.timeoutMs > 0) m_timeout.start(s.timeoutMs);
+    else                 m_timeout.stop();
+
+    if (!s.run) { onStepDone(gen, false, QStringLiteral("empty step")); return; }
+
+    QPointer<RobotCommandQueue> self(this);
+    s.run([self, gen](bool ok, const QString& err){
+        if (self) self->onStepDone(gen, ok, err);
+    });
+}
+
+void RobotCommandQueue::onStepDone(quint64 gen, bool ok, const QString& err)
+{
+    if (!m_running || gen != m_gen) return; // 타임아웃/취소 뒤 늦게 온 완료
+    m_timeout.stop();
+    ++m_gen;
+
+    if (!ok) { failAttempt(err); return; }
+
+    ++m_cur.stack.last().idx;
+    runStep();
+}
+
+void RobotCommandQueue::onTimeout()
+{
+    if (!m_running) return;
+    ++m_gen;
+    failAttempt(QStringLiteral("timeout"));
+}
+
+void RobotCommandQueue::failAttempt(const QString& err)
+{
+    const Step& s = currentStep();
+    if (m_attempt < s.retries) {
+        ++m_attempt;
+        emit log(QString("[CMDQ] %1 failed (%2), retry %3/%4")
+                     .arg(s.label, err).arg(m_attempt).arg(s.retries),
+                 Common::LogLevel::Warn);
+        startAttempt();
+        return;
+    }
+    const QString why = s.label.isEmpty() ? err : QString("%1: %2").arg(s.label, err);
+    finishJob(false, why, true);
+}
+
+void RobotCommandQueue::finishJob(bool ok, const QString& err, bool flushPending)
+{
+    m_timeout.stop();
+    ++m_gen;
+
+    Job job = std::move(m_cur);
+    m_cur = Job();
+    m_running = false;
+
+    // 실패한 시퀀스가 FlushPending 이면 뒤에 쌓인 시퀀스는 전제 조건이 깨졌으므로 모두 취소
+    QQueue<Job> dropped;
+    if (flushPending && job.onFail == OnFail::FlushPending) dropped.swap(m_jobs);
+
+    if (!ok) emit log(QString("[CMDQ] sequence %1 failed: %2").arg(job.ticket).arg(err),
+                      Common::LogLevel::Error);
+    if (job.onFinished) job.onFinished(ok, err);
+    emit sequenceFinished(job.ticket, ok, err);
+
+    for (const Job& d : dropped)
+        dropJob(d, droppedReason());
+
+    // 콜백 안에서 새 시퀀스가 투입되어 이미 시작됐을 수 있다
+    if (!m_running) runNext();
+}
+
+// ─────────────────────────────────────────────────────────────
+// 스텝 팩토리
+// ─────────────────────────────────────────────────────────────
+namespace {
+
+RobotCommandQueue::Step busStep(ModbusClient* bus, const MbOp& op, int timeoutMs, const QString& label)
+{
+    RobotCommandQueue::Step s;
+    s.timeoutMs = timeoutMs;
+    s.label = label;
+    QPointer<ModbusClient> busPtr(bus);
+    s.run = [busPtr, op](RobotCommandQueue::Done done){
+        if (!busPtr) { done(false, QStringLiteral("no bus")); return; }
+        if (busPtr->submit(op, done).isNull())
+            done(false, QStringLiteral("rejected"));
+    };
+    return s;
+}
+
+} // namespace
+
+RobotCommandQueue::Step RobotCommandQueue::writeCoil(ModbusClient* bus, int addr, bool value, int timeoutMs)
+{
+    MbOp op;
+    op.kind = MbOp::Kind::WriteCoil;
+    op.start = addr;
+    op.coilValue = value;
+    return busStep(bus, op, timeoutMs, QString("coil %1=%2").arg(addr).arg(value ? 1 : 0));
+}
+
+RobotCommandQueue::Step RobotCommandQueue::writeHoldingBlock(ModbusClient* bus, int start,
+                                                            const QVector<quint16>& vals, int timeoutMs)
+{
+    MbOp op;
+    op.kind = MbOp::Kind::WriteHoldingBlock;
+    op.start = start;
+    op.blockValues = vals;
+    return busStep(bus, op, timeoutMs, QString("holding %1[%2]").arg(start).arg(vals.size()));
+}
+
+RobotCommandQueue::Step RobotCommandQueue::pulseCoil(ModbusClient* bus, int addr, int pulseMs)
+{
+    QVector<MbOp> ops(3);
+    ops[0].kind = MbOp::Kind::WriteCoil;
+    ops[0].start = addr;
+    ops[0].coilValue = true;
+    ops[1].kind = MbOp::Kind::DelayMs;
+    ops[1].delayMs = pulseMs;
+    ops[2].kind = MbOp::Kind::WriteCoil;
+    ops[2].start = addr;
+    ops[2].coilValue = false;
+
+    Step s = group(bus, ops);
+    s.label = QString("pulse %1 %2ms").arg(addr).arg(pulseMs);
+    return s;
+}
+
+RobotCommandQueue::Step RobotCommandQueue::group(ModbusClient* bus, const QVector<MbOp>& ops, int timeoutMs)
+{
+    if (timeoutMs <= 0) {
+        int total = 0;
+        for (const MbOp& op : ops)
+            if (op.kind == MbOp::Kind::DelayMs) total += op.delayMs;
+        timeoutMs = total + 2000; // 쓰기 op 응답 여유
+    }
+
+    Step s;
+    s.timeoutMs = timeoutMs;
+    s.label = QString("group[%1]").arg(ops.size());
+    QPointer<ModbusClient> busPtr(bus);
+    s.run = [busPtr, ops](Done done){
+        if (!busPtr) { done(false, QStringLiteral("no bus")); return; }
+        if (busPtr->submitGroup(ops, done).isNull())
+            done(false, QStringLiteral("rejected"));
+    };
+    return s;
+}
+
+RobotCommandQueue::Step RobotCommandQueue::delay(int ms)
+{
+    Step s;
+    s.label = QString("delay %1ms").arg(ms);
+    s.run = [ms](Done done){
+        // 수신 객체 없이 걸어도 done 쪽이 QPointer/세대 토큰으로 보호된다
+        QTimer::singleShot(qMax(0, ms), Qt::PreciseTimer, [done]{ done(true, QString()); });
+    };
+    return s;
+}
+
+RobotCommandQueue::Step RobotCommandQueue::nested(const Sequence& steps, const QString& label)
+{
+    Step s;
+    s.label = label;
+    s.children = std::make_shared<const Sequence>(steps);
+    return s;
+}
@@ -2,44 +2,117 @@
 #define ROBOTCOMMANDQUEUE_H
 
 #include <functional>
+#include <memory>
 
 #include <QObject>
+#include <QPointer>
 #include <QQueue>
-#include <QList>
+#include <QTimer>
+#include <QVector>
 
+#include "ModbusClient.h"
+#include "LogLevel.h"
+
+// ─────────────────────────────────────────────────────────────
+// 로봇 명령 시퀀스 실행기 (continuation 방식)
+//
+// - Step::run(done) 은 완료 시 done(ok, err) 를 정확히 한 번 호출한다.
+//   (동기 호출도 허용)
+// - 버스 op 완료는 ModbusClient::submit() 콜백으로 op id 해시에서 바로 라우팅된다.
+//   opFinished 를 스텝마다 구독하지 않는다.
+// - 스텝별 timeoutMs / retries. 타임아웃·취소 후 늦게 도착한 완료는
+//   세대(generation) 토큰으로 무시된다.
+// - nested(): 하위 시퀀스가 끝나야 다음 스텝으로 넘어간다.
+//   (timeout/retry 는 leaf 스텝 단위로만 적용)
+// - 시퀀스가 실패해도 뒤에 대기 중인 시퀀스는 그대로 실행한다. 뒤 시퀀스가 이 시퀀스에
+//   의존하면 투입 시 OnFail::FlushPending 을 지정 (실패 시 대기 중인 것 모두 취소).
+//   취소·폐기된 시퀀스는 모두 log 로 남긴다.
+// - 취소는 이미 버스에 투입된 op 를 회수하지 않는다.
+//   (펄스 그룹은 OFF 까지 버스에서 끝까지 수행됨)
+// ─────────────────────────────────────────────────────────────
 class RobotCommandQueue : public QObject {
     Q_OBJECT
 public:
-    using Step = std::function<void(std::function<void(bool)> done)>;
+    using Done = std::function<void(bool ok, const QString& err)>;
+
+    struct Step;
+    using Sequence = QVector<Step>;
+
+    struct Step {
+        std::function<void(Done)> run;
+        int timeoutMs = 0;      // 0: 무제한
+        int retries = 0;        // 실패/타임아웃 시 추가 시도 횟수
+        QString label;
+        std::shared_ptr<const Sequence> children; // nested 시퀀스 (run 대신)
+    };
+
+    using Finished = std::function<void(bool ok, const QString& err)>;
+
+    // 이 시퀀스가 실패했을 때 뒤에 대기 중인 시퀀스 처리
+    enum class OnFail { Continue, FlushPending };
+
+    // FlushPending 으로 폐기된 시퀀스의 완료 사유
+    static QString droppedReason() { return QStringLiteral("previous sequence failed"); }
+
+    explicit RobotCommandQueue(QObject* parent=nullptr);
 
-    explicit RobotCommandQueue(QObject* parent=nullptr) : QObject(parent) {}
+    // 시퀀스 투입. 반환값은 cancel()용 ticket (빈 시퀀스면 0, 즉시 성공 처리)
+    quint64 enqueue(const Sequence& steps, Finished onFinished = Finished(),
+                    OnFail onFail = OnFail::Continue);
 
-    void enqueue(const QList<Step>& steps) {
-        m_q.enqueue(steps);
-        if (!m_running) runNext();
-    }
+    bool cancel(quint64 ticket);               // 대기/실행 중인 시퀀스 취소
+    void cancelAll(const QString& reason = QStringLiteral("cancelled"));
+
+    bool isBusy() const { return m_running; }
+    int pending() const { return m_jobs.size(); }
+
+    // ── 스텝 팩토리 ──
+    static Step writeCoil(ModbusClient* bus, int addr, bool value, int timeoutMs = 2000);
+    static Step writeHoldingBlock(ModbusClient* bus, int start,
+                                  const QVector<quint16>& vals, int timeoutMs = 2000);
+    // ON → pulseMs → OFF 를 하나의 버스 그룹으로 투입 (타이밍은 버스 쪽 PreciseTimer)
+    // 완료는 OFF 쓰기까지 끝난 시점
+    static Step pulseCoil(ModbusClient* bus, int addr, int pulseMs);
+    // 임의 op 그룹 (레시피 등). timeoutMs<=0 이면 그룹 내 DelayMs 합 + 여유
+    static Step group(ModbusClient* bus, const QVector<MbOp>& ops, int timeoutMs = 0);
+    static Step delay(int ms);
+    static Step nested(const Sequence& steps, const QString& label = QString());
+
+signals:
+    void sequenceFinished(quint64 ticket, bool ok, const QString& err);
+    void log(const QString& line, Common::LogLevel level = Common::LogLevel::Info);
 
 private:
-    void runNext() {
-        if (m_q.isEmpty()) { m_running=false; return; }
-        m_running=true;
-        m_steps = m_q.dequeue();
-        m_idx = 0;
-        runStep();
-    }
-    void runStep() {
-        if (m_idx >= m_steps.size()) { runNext(); return; }
-        auto step = m_steps[m_idx++];
-        step([this](bool ok){
-            if (!ok) { m_q.clear(); m_running=false; return; }
-            runStep();
-        });
-    }
-
-    QQueue<QList<Step>> m_q;
-    QList<Step> m_steps;
-    int m_idx = 0;
+    struct Frame {
+        std::shared_ptr<const Sequence> steps;
+        int idx = 0;
+    };
+    struct Job {
+        quint64 ticket = 0;
+        QVector<Frame> stack;
+        Finished onFinished;
+        OnFail onFail = OnFail::Continue;
+        QString label;      // 로그용 (첫 스텝 label)
+    };
+
+    void runNext();
+    void runStep();
+    void startAttempt();
+    void onStepDone(quint64 gen, bool ok, const QString& err);
+    void onTimeout();
+    void failAttempt(const QString& err);
+    void finishJob(bool ok, const QString& err, bool flushPending);
+    void dropJob(const Job& job, const QString& reason);
+    const Step& currentStep() const;
+
+    QQueue<Job> m_jobs;
+    Job m_cur;
     bool m_running = false;
+
+    quint64 m_nextTicket = 1;
+    quint64 m_gen = 0;      // 현재 시도 토큰. 타임아웃/취소/완료 시 증가
+    int m_attempt = 0;
+    QTimer m_timeout;
 };
 
 #endif // ROBOTCOMMANDQUEUE_H
@@ -0,0 +1,228 @@
+#include "RobotCommandRouter.h"
+
+#include <QTimer>
+
+#include "RobotManager.h"
+#include "vision/VisionClient.h"
+
+namespace {
+
+QString poseText(const Pose6D& p)
+{
+    return QString("[%1,%2,%3] [%4,%5,%6]")
+        .arg(p.x).arg(p.y).arg(p.z).arg(p.rx).arg(p.ry).arg(p.rz);
+}
+
+} // namespace
+
+RobotCommandRouter::RobotCommandRouter(RobotManager* mgr, VisionClient* client, QObject* parent)
+    : QObject(parent)
+    , m_mgr(mgr)
+    , m_client(client)
+{
+}
+
+RobotCommandRouter::Result RobotCommandRouter::route(const RobotCommand& cmd)
+{
+    if (cmd.dir != 1 || !m_mgr || !m_client)
+        return Result::Ignored;
+
+    switch (cmd.robot) {
+    case RobotId::A: return routeA(cmd);
+    case RobotId::B: return routeB(cmd);
+    case RobotId::Unknown:
+        emit log("Unknown robot command");
+        return Result::Ignored;
+    default: {
+        // C..H: 셀 처리기가 없음 → 조용히 버리지 않고 실패로 응답 (진행 표에서도 failed 로 마감)
+        const QString robot(QChar('a' + robotIndex(cmd.robot)));
+        emit log(QString("[CMD] robot %1: no command handler, rejected seq=%2").arg(robot.toUpper()).arg(cmd.seq),
+                 Common::LogLevel::Warn);
+        m_client->sendAck(cmd.seq, "error", QString("robot %1 not handled").arg(robot));
+        m_client->sendError(robot, "unsupported_robot", 0, 0);
+        return Result::Rejected;
+    }
+    }
+}
+
+void RobotCommandRouter::ack(const RobotCommand& cmd, const char* msg)
+{
+    m_client->sendAck(cmd.seq, QStringLiteral("ok"), QString::fromLatin1(msg));
+}
+
+RobotCommandRouter::Result RobotCommandRouter::routeA(const RobotCommand& cmd)
+{
+    if (cmd.type == CmdType::Tool) {
+        const QString& tool = cmd.toolCmd.toolName;
+        if (cmd.kind == CmdKind::Tool_Mount) {
+            if (tool == "bulk") {
+                emit log("로봇 A 벌크 툴 마운트 처리 필요");
+                ack(cmd, "Tool Mount Bulk command received");
+                m_mgr->cmdBulk_AttachTool();
+                return Result::Routed;
+            }
+            if (tool == "sorting") {
+                emit log("로봇 A 소팅 툴 마운트 처리 필요");
+                ack(cmd, "Tool Mount Sorting command received");
+                m_mgr->cmdSort_AttachTool();
+                return Result::Routed;
+            }
+        } else if (cmd.kind == CmdKind::Tool_UnMount) {
+            if (tool == "bulk") {
+                emit log("로봇 A 벌크 툴 언마운트 처리 필요");
+                ack(cmd, "Tool UnMount Bulk command received");
+                m_mgr->cmdBulk_DettachTool();
+                return Result::Routed;
+            }
+            if (tool == "sorting") {
+                emit log("로봇 A 소팅 툴 언마운트 처리 필요");
+                ack(cmd, "Tool UnMount Sorting command received");
+                m_mgr->cmdSort_DettachTool();
+                return Result::Routed;
+            }
+        } else if (cmd.kind == CmdKind::Tool_Change) {
+            if (cmd.toolCmd.toolFrom == "bulk" && cmd.toolCmd.toolTo == "sorting") {
+                emit log("로봇 A 벌크→소팅 툴 체인지 처리 필요");
+                ack(cmd, "Tool Change Bulk to Sorting command received");
+                QTimer::singleShot(100, this, [this] { if (m_mgr) m_mgr->cmdBulk_ChangeTool(); });
+                return Result::Routed;
+            }
+            if (cmd.toolCmd.toolFrom == "sorting" && cmd.toolCmd.toolTo == "bulk") {
+                emit log("로봇 A 소팅→벌크 툴 체인지 처리 필요");
+                ack(cmd, "Tool Change Sorting to Bulk command received");
+                QTimer::singleShot(100, this, [this] { if (m_mgr) m_mgr->cmdSort_ChangeTool(); });
+                return Result::Routed;
+            }
+        }
+        return Result::Ignored;
+    }
+
+    if (cmd.type == CmdType::Bulk) {
+        const int mode = (cmd.mode == "single") ? 2 : 0;
+        if (cmd.kind == CmdKind::Pick && cmd.hasPick) {
+            emit log("Robot A 벌크 픽 처리 필요, pose:" + poseText(cmd.pick));
+            ack(cmd, "bulk Pick command received");
+            m_mgr->cmdBulk_DoPickup(cmd.pick, mode);
+            return Result::Routed;
+        }
+        if (cmd.kind == CmdKind::Place && cmd.hasPlace) {
+            emit log("Robot A 벌크 플레이스 처리 필요, pose:" + poseText(cmd.place));
+            ack(cmd, "bulk Place command received");
+            m_mgr->cmdBulk_DoPlace(cmd.place, mode);
+            return Result::Routed;
+        }
+        return Result::Ignored;
+    }
+
+    if (cmd.type == CmdType::Sorting) {
+        switch (cmd.kind) {
+        case CmdKind::Ready:
+            emit log("로봇 A 소팅 레디 처리 필요");
+            ack(cmd, "sorting Ready command received");
+            m_mgr->cmdSort_MoveToPickupReady();
+            return Result::Routed;
+        case CmdKind::Pick:
+            if (!cmd.hasPick || !cmd.isOffset)
+                return Result::Ignored;
+            emit log("로봇 A 소팅 픽 처리 필요, pose: " + poseText(cmd.pick));
+            if (m_gantry.sortPick)
+                m_gantry.sortPick(cmd);
+            ack(cmd, "sorting Pick command received");
+            m_mgr->cmdSort_DoPickup(cmd.pick, cmd.flip, cmd.sortOffset.height, cmd.sortOffset.thickness);
+            return Result::Routed;
+        case CmdKind::Place:
+            if (cmd.flip) {
+                emit log("로봇 A 소팅 플립 처리 필요");
+                ack(cmd, "sorting Place Flip command received");
+            } else {
+                emit log(QString("로봇 A 소팅 논플립 처리 필요, offset: %1").arg(cmd.offset));
+                ack(cmd, "sorting Place Non-Flip command received");
+            }
+            if (m_gantry.sortPlace) {
+                m_gantry.sortPlace(cmd);        // 갠트리 위치에 맞춰 cmdSort_DoPlace 는 훅 쪽에서
+                return Result::Routed;
+            }
+            if (cmd.flip)
+                return Result::GantryOnly;
+            // 갠트리가 이미 대기 위치라고 보고 바로 로봇 플레이스
+            m_mgr->cmdSort_DoPlace(false, cmd.sortOffset.height, cmd.sortOffset.thickness);
+            return Result::Routed;
+        case CmdKind::Arrange:
+            if (!cmd.isArrange)
+                return Result::Ignored;
+            m_mgr->cmdSort_Arrange(cmd.arrangeCmd.poseOrig, cmd.arrangeCmd.poseDest);
+            return Result::Routed;
+        default:
+            return Result::Ignored;
+        }
+    }
+
+    if (cmd.type == CmdType::Conveyor && cmd.kind == CmdKind::Forward) {
+        emit log("로봇 A 컨베이어 포워드 처리 필요");
+        ack(cmd, "conveyor Forward command received");
+        if (!m_gantry.conveyorForward)
+            return Result::GantryOnly;
+        m_gantry.conveyorForward();
+        return Result::Routed;
+    }
+    return Result::Ignored;
+}
+
+RobotCommandRouter::Result RobotCommandRouter::routeB(const RobotCommand& cmd)
+{
+    if (cmd.type != CmdType::Align)
+        return Result::Ignored;
+
+    switch (cmd.kind) {
+    case CmdKind::Init:
+        emit log("로봇 B 얼라인 이닛 처리 필요");
+        ack(cmd, "align Init command received");
+        m_mgr->cmdAlign_Initialize();
+        return Result::Routed;
+    case CmdKind::Assy:
+        emit log("로봇 B 얼라인 어셈블리 처리 필요");
+        ack(cmd, "align Assy command received");
+        m_mgr->cmdAlign_MoveToAssyReady();
+        return Result::Routed;
+    case CmdKind::Ready:
+        emit log("로봇 B 얼라인 레디 처리 필요");
+        ack(cmd, "align Ready command received");
+        m_mgr->cmdAlign_MoveToPickupReady();
+        return Result::Routed;
+    case CmdKind::Pick:
+        if (!cmd.hasPick)
+            return Result::Ignored;
+        emit log("로봇 B 얼라인 픽 처리 필요, pose: " + poseText(cmd.pick));
+        ack(cmd, "align Pick command received");
+        m_mgr->cmdAlign_DoPickup(cmd.pick);
+        return Result::Routed;
+    case CmdKind::Place:
+        if (!cmd.hasPlace)
+            return Result::Ignored;
+        emit log("로봇 B 얼라인 플레이스 처리 필요, pose: " + poseText(cmd.place));
+        ack(cmd, "align Place command received");
+        m_mgr->cmdAlign_DoPlace(cmd.place, cmd.clampSequenceMode);
+        return Result::Routed;
+    case CmdKind::Clamp:
+        if (cmd.clamp == "open") {
+            emit log("로봇 B 클램프 오픈 처리 필요");
+            ack(cmd, "align Clamp Open command received");
+            m_mgr->cmdAlign_Clamp(false);
+            return Result::Routed;
+        }
+        if (cmd.clamp == "close") {
+            emit log("로봇 B 클램프 클로즈 처리 필요");
+            ack(cmd, "align Clamp Close command received");
+            m_mgr->cmdAlign_Clamp(true);
+            return Result::Routed;
+        }
+        return Result::Ignored;
+    case CmdKind::Scrap:
+        emit log("로봇 B 스크랩 처리 필요");
+        ack(cmd, "align Scrap command received");
+        m_mgr->cmdAlign_Scrap();
+        return Result::Routed;
+    default:
+        return Result::Ignored;
+    }
+}
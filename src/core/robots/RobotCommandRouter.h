@@ -0,0 +1,64 @@
+#ifndef ROBOTCOMMANDROUTER_H
+#define ROBOTCOMMANDROUTER_H
+
+#include <QObject>
+#include <QPointer>
+
+#include <functional>
+
+#include "LogLevel.h"
+#include "RobotCommand.h"
+
+class RobotManager;
+class VisionClient;
+
+// ─────────────────────────────────────────────────────────────
+// 비전 명령(RobotCommand, dir:1) → ack + RobotManager 명령
+//
+// 앱(MainWindow)과 trace 재생 도구가 같은 규칙/같은 ack 문자열을 쓰도록 한 곳에 둔다.
+// 갠트리(RS-485)가 끼는 단계는 훅으로 주입한다:
+//  - sortPick      : 소팅 픽 직전 갠트리 준비 (없으면 생략)
+//  - sortPlace     : 소팅 플레이스 전체 (갠트리 위치를 보고 cmdSort_DoPlace 를 부르는 쪽이 맡는다)
+//                    없으면 논플립은 갠트리가 이미 대기 위치라고 보고 바로 로봇 플레이스,
+//                    플립은 갠트리 전용 → GantryOnly
+//  - conveyorForward : 컨베이어 한 칸 (없으면 GantryOnly)
+// C..H 는 셀 처리기가 없으므로 error ack + sendError 로 거절한다.
+// ─────────────────────────────────────────────────────────────
+class RobotCommandRouter : public QObject
+{
+    Q_OBJECT
+public:
+    struct GantryHooks {
+        std::function<void(const RobotCommand&)> sortPick;
+        std::function<void(const RobotCommand&)> sortPlace;
+        std::function<void()> conveyorForward;
+    };
+
+    enum class Result {
+        Ignored,        // dir != 1, 또는 처리할 종류가 아님
+        Routed,         // RobotManager 로 넘김 (또는 갠트리 훅이 맡음)
+        GantryOnly,     // ack 만 보냄: 갠트리 훅이 없어 실행하지 않음
+        Rejected        // 로봇 미지원 (error ack)
+    };
+
+    RobotCommandRouter(RobotManager* mgr, VisionClient* client, QObject* parent = nullptr);
+
+    void setGantryHooks(const GantryHooks& hooks) { m_gantry = hooks; }
+
+    Result route(const RobotCommand& cmd);
+
+signals:
+    void log(const QString& line,
+             Common::LogLevel level = Common::LogLevel::Info);
+
+private:
+    Result routeA(const RobotCommand& cmd);
+    Result routeB(const RobotCommand& cmd);
+    void ack(const RobotCommand& cmd, const char* msg);
+
+    QPointer<RobotManager> m_mgr;
+    QPointer<VisionClient> m_client;
+    GantryHooks m_gantry;
+};
+
+#endif // ROBOTCOMMANDROUTER_H
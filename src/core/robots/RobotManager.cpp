@@ -1,334 +1,328 @@
 #include "RobotManager.h"
 #include "PickListModel.h"
+#include "PoseCsvLoader.h"
+#include "PoseBinary.h"
 #include "ModbusClient.h"
 #include "Orchestrator.h"
+#include "LogCategories.h"
+#include "EventTrace.h"
+#include "FlightRecorder.h"
+#include "MonoClock.h"
 #include "vision/VisionClient.h"
+#include "vision/RobotStatePublisher.h"
 
 #include <QTimer>
 #include <QFile>
 #include <QTextStream>
 #include <QVector>
+#include <algorithm>
+#include <iterator>
 
-namespace {
-    using Step = RobotCommandQueue::Step;
+RobotManager::RobotManager(QObject* parent) : QObject(parent)
+    , m_statePub(new RobotStatePublisher(this))
+{
+    std::fill(std::begin(m_cmdRecipe), std::end(m_cmdRecipe), -1);
+}
 
-    Step stepWriteCoil(QObject* owner, ModbusClient* bus, int addr, bool value)
-    {
-        return [=](std::function<void(bool)> done){
-            MbOp op;
-            op.kind = MbOp::Kind::WriteCoil;
-            op.start = addr;
-            op.coilValue = value;
-            op.id = QUuid::createUuid();
-
-            QMetaObject::Connection c;
-            c = QObject::connect(bus, &ModbusClient::opFinished, owner,
-                                 [=, &c](QUuid id, bool ok, const QString&){
-                                     if (id != op.id) return;
-                                     QObject::disconnect(c);
-                                     done(ok);
-                                 });
-
-            bus->enqueue(op);
-        };
-    }
+void RobotManager::setVisionClient(VisionClient* srv)
+{
+    m_vsrv = srv;
+    if (srv) srv->setStatePublisher(m_statePub);
+}
 
-    Step stepDelay(QObject* owner, int ms)
-    {
-        return [=](std::function<void(bool)> done){
-            QTimer::singleShot(ms, owner, [=]{ done(true); });
-        };
-    }
+RobotContext* RobotManager::ctx(const QString& id)
+{
+    const int i = m_robotIndex.value(id, -1);
+    return i < 0 ? nullptr : &m_robots[i];
+}
 
-    // ON → (pulseMs 후) OFF
-    Step stepPulseCoil(QObject* owner, ModbusClient* bus, int addr, int pulseMs)
-    {
-        return [=](std::function<void(bool)> done){
-            QList<Step> seq;
-            seq << stepWriteCoil(owner, bus, addr, true);
-            seq << stepDelay(owner, pulseMs);
-            seq << stepWriteCoil(owner, bus, addr, false);
-
-            // seq를 즉석에서 실행
-            auto* runner = new RobotCommandQueue(owner);
-            runner->enqueue(seq);
-            QObject::connect(runner, &QObject::destroyed, owner, []{});
-            // 마지막 step이 끝나면 done을 호출하게 하려면 runner를 조금 확장하는 게 정석인데,
-            // 간단히 pulse는 마지막 write 완료 시 done 되게 아래처럼 구현하는 방식이 더 깔끔함(아래 3번에서)
-            done(true);
-        };
-    }
+const RobotContext* RobotManager::ctx(const QString& id) const
+{
+    const int i = m_robotIndex.value(id, -1);
+    return i < 0 ? nullptr : &m_robots[i];
+}
 
-    Step stepWriteHoldingBlock(QObject* owner,
-                               ModbusClient* bus,
-                               int start,
-                               const QVector<quint16>& vals)
-    {
-        return [=](std::function<void(bool)> done){
-            MbOp op;
-            op.kind = MbOp::Kind::WriteHoldingBlock;
-            op.start = start;
-            op.blockValues = vals;
-            op.id = QUuid::createUuid();
-
-            QMetaObject::Connection c;
-            c = QObject::connect(bus, &ModbusClient::opFinished, owner,
-                                 [=, &c](QUuid id, bool ok, const QString&){
-                                     if (id != op.id) return;
-                                     QObject::disconnect(c);
-                                     done(ok);
-                                 });
-
-            bus->enqueue(op);
-        };
+// id → 조밀 인덱스 (처음 보는 id 면 새 슬롯). 인덱스는 프로세스 동안 바뀌지 않는다.
+RobotContext& RobotManager::ensureContext(const QString& id, QObject* owner)
+{
+    int i = m_robotIndex.value(id, -1);
+    if (i < 0) {
+        i = m_robots.size();
+        RobotContext c;
+        c.id    = id;
+        c.index = i;
+        m_robots.push_back(c);
+        m_robotIndex.insert(id, i);
     }
+    RobotContext& c = m_robots[i];
+    if (!c.model) c.model = new PickListModel(owner ? owner : this); // 모델은 항상 보유
+    return c;
 }
 
-RobotManager::RobotManager(QObject* parent) : QObject(parent)
+int RobotManager::robotIndex(const QString& id) const
 {
+    return m_robotIndex.value(id, -1);
+}
 
+QString RobotManager::robotIdAt(int index) const
+{
+    return (index >= 0 && index < m_robots.size()) ? m_robots[index].id : QString();
 }
 
 void RobotManager::enqueuePose(const QString& id, const Pose6D &p) {
-    if (m_ctx.contains(id))
-        m_ctx[id].model->add(p);
+    if (auto* c = ctx(id))
+        c->model->add(p);
 }
 
 void RobotManager::applyExtras(const QString& id, const QVariantMap& extras) {
-    if (!m_ctx.contains(id)) return;
-    auto& c = m_ctx[id];
+    auto* c = ctx(id);
+    if (!c) return;
     if (extras.contains("speed_pct")) {
-        int addrSpeed = c.addr_.value("holding").toMap().value("SPEED_PCT").toInt();
+        int addrSpeed = c->addr_.value("holding").toMap().value("SPEED_PCT", -1).toInt();
         if (addrSpeed >= 0) {
             quint16 v = quint16(extras.value("speed_pct").toInt());
-            c.bus->writeHolding(addrSpeed, v);
+            c->bus->writeHolding(addrSpeed, v);
         }
     }
 }
 
 void RobotManager::start(const QString& id) {
-    if (m_ctx.contains(id)) m_ctx[id].orch->start();
+    if (auto* c = ctx(id)) if (c->orch) c->orch->start();
 }
 
 void RobotManager::stop(const QString& id) {
-    if (m_ctx.contains(id)) m_ctx[id].orch->stop();
+    if (auto* c = ctx(id)) if (c->orch) c->orch->stop();
 }
 
 void RobotManager::startAll() {
-    for (auto& c : m_ctx) c.orch->start();
+    for (auto& c : m_robots) if (c.orch) c.orch->start();
 }
 
 void RobotManager::stopAll() {
-    for (auto& c : m_ctx) c.orch->stop();
+    for (auto& c : m_robots) if (c.orch) c.orch->stop();
 }
 
 QAbstractItemModel* RobotManager::model(const QString& id) const {
-    return m_ctx.contains(id) ? m_ctx[id].model : nullptr;
+    const auto* c = ctx(id);
+    return c ? c->model : nullptr;
 }
 
 PickListModel* RobotManager::pickModel(const QString& id) const {
-    return m_ctx.contains(id) ? m_ctx.value(id).model : nullptr;
+    const auto* c = ctx(id);
+    return c ? c->model : nullptr;
 }
 
 void RobotManager::connectTo(const QString& id, const QString& host, int port)
 {
-    if(!m_ctx.contains(id))
-        return;
-    if(m_ctx[id].bus) {
-        m_ctx[id].bus->connectTo(host, port);
-    }
+    auto* c = ctx(id);
+    if (c && c->bus)
+        c->bus->connectTo(host, port);
 }
 
 void RobotManager::disconnect(const QString& id)
 {
-    if(!m_ctx.contains(id))
-        return;
-
-    if(m_ctx[id].bus) {
-        m_ctx[id].bus->disconnectFrom();
-    }
+    auto* c = ctx(id);
+    if (c && c->bus)
+        c->bus->disconnectFrom();
 }
 
 void RobotManager::setRepeat(const QString&id, bool on)
 {
-    if(!m_ctx.contains(id))
-        return;
-
-    if(m_ctx[id].orch) {
-        m_ctx[id].orch->setRepeat(on);
-    }
+    auto* c = ctx(id);
+    if (c && c->orch)
+        c->orch->setRepeat(on);
 }
 
 bool RobotManager::hasRobot(const QString& id) const
 {
-    return m_ctx.contains(id);
+    return m_robotIndex.contains(id);
 }
 
 void RobotManager::addOrConnect(const QString& id, const QString& host, int port,
                                 const QVariantMap& addr, QObject* owner)
 {
-    if (!m_ctx.contains(id)) {
-        RobotContext ctx;
-        ctx.id    = id;
-        ctx.model = new PickListModel(owner ? owner : this); // 모델은 항상 보유
-        if (!ctx.cmdq) ctx.cmdq = new RobotCommandQueue(owner ? owner : this);
-        m_ctx.insert(id, ctx);
+    RobotContext& c = ensureContext(id, owner);
+    const int index = c.index;
+    if (!c.cmdq) {
+        c.cmdq = new RobotCommandQueue(owner ? owner : this);
+        connect(c.cmdq, &RobotCommandQueue::log, this, [this, id](const QString& line, Common::LogLevel lv){
+            emit logByRobot(id, line, lv);
+        });
+        // 시퀀스 실패(스텝 타임아웃 포함) → 직전 버스/DI 기록을 남긴다.
+        // 앞 실패로 폐기된 시퀀스는 큐가 한 줄씩 로그로 남기고, 덤프는 원인 시퀀스에서 한 번만.
+        connect(c.cmdq, &RobotCommandQueue::sequenceFinished, this, [this, id](quint64, bool ok, const QString& err){
+            if (ok || err == RobotCommandQueue::droppedReason()) return;
+            if (EventTrace::enabled()) EventTrace::fault(::robotIndex(id), err);
+            dumpFlightRecorder(id, err.contains(QLatin1String("timeout")) ? "timeout" : "cmdq", false);
+        });
     }
-    auto& c = m_ctx[id];
     c.addr_ = addr;
     if (!c.bus)  c.bus  = new ModbusClient(owner ? owner : this);
     if (!c.orch) c.orch = new Orchestrator(c.bus, c.model, owner ? owner : this);
     c.orch->applyAddressMap(addr);
 
     if (!c.orch->isAddressMapValid()) {
-        qWarning() << "[RM] invalid addr_map" << id;
+        qCWarning(lcOrch) << "[RM] invalid addr_map" << id;
         return;
     }
 
     c.orch->setRobotId(id);
+    compileRecipes(index);
     // 시그널은 한 번만
-    static QSet<Orchestrator*> hooked;
-    if (!hooked.contains(c.orch)) {
-        hookSignals(id, c.bus, c.orch);
-        hooked.insert(c.orch);
+    if (!c.hooked) {
+        hookSignals(index, c.bus, c.orch);
+        m_robots[index].hooked = true;
     }
 
     // 연결은 다음 틱에 (즉시 시그널로 인한 UAF/레이스 방지)
-    QTimer::singleShot(0, this, [this, id, host, port]{
-        if (!m_ctx.contains(id) || !m_ctx[id].bus) return;
-        m_ctx[id].bus->connectTo(host, port);
+    QTimer::singleShot(0, this, [this, index, host, port]{
+        auto& r = m_robots[index];
+        if (r.bus) r.bus->connectTo(host, port);
     });
 }
 
 void RobotManager::reconnect(const QString& id, const QString& host, int port)
 {
-    if (!m_ctx.contains(id) || !m_ctx[id].bus) return;
-    QTimer::singleShot(0, this, [this, id, host, port]{
-        m_ctx[id].bus->connectTo(host, port);
+    const int index = robotIndex(id);
+    if (index < 0 || !m_robots[index].bus) return;
+    QTimer::singleShot(0, this, [this, index, host, port]{
+        auto& r = m_robots[index];
+        if (r.bus) r.bus->connectTo(host, port);
     });
 }
 
 bool RobotManager::isConnected(const QString& id) const
 {
-    if (!m_ctx.contains(id) || !m_ctx[id].bus) return false;
-    return m_ctx[id].bus->isConnected();  // 아래 ModbusClient 보강 참고
+    const auto* c = ctx(id);
+    if (!c || !c->bus) return false;
+    return c->bus->isConnected();  // 아래 ModbusClient 보강 참고
 }
 
 void RobotManager::setPoseList(const QString& id, const QVector<Pose6D>& list)
 {
-    if (!m_ctx.contains(id) || !m_ctx[id].model) return;
-    m_ctx[id].model->setAll(list);
+    auto* c = ctx(id);
+    if (!c || !c->model) return;
+    c->model->setAll(list);
 }
 
 void RobotManager::clearPoseList(const QString& id)
 {
-    if (!m_ctx.contains(id) || !m_ctx[id].model) return;
-    m_ctx[id].model->clear();
+    auto* c = ctx(id);
+    if (!c || !c->model) return;
+    c->model->clear();
 }
 
-static bool parseLineToPose(const QString& line, Pose6D& out)
+bool RobotManager::loadCsvToModel(const QString& id, const QString& filePath, QString* errMsg, QObject* owner)
 {
-    QString s = line.trimmed();
-    if (s.isEmpty() || s.startsWith('#')) return false;
-    // 콤마/탭 모두 허용
-    const QChar sep = s.contains('\t') ? '\t' : ',';
-    const auto parts = s.split(sep, Qt::SkipEmptyParts);
-    if (parts.size() < 6) return false;
-    bool ok[6]{};
-    double vals[6]{};
-    for (int i=0;i<6;i++) {
-        vals[i] = parts[i].trimmed().toDouble(&ok[i]);
-        if (!ok[i]) return false;
+    // 컨텍스트가 없으면 '모델만' 갖춘 컨텍스트를 먼저 만든다
+    const int index = ensureContext(id, owner).index;
+
+    const PoseCsvLoader::Result r = PoseCsvLoader::parseFile(filePath);
+    if (!r.ok()) {
+        if (errMsg) *errMsg = r.error;
+        return false;
     }
-    out = Pose6D{vals[0],vals[1],vals[2],vals[3],vals[4],vals[5]};
+    if (r.skipped)
+        emit log(QString("[WARN] %1: %2 lines skipped (first: line %3)")
+                     .arg(filePath).arg(r.skipped).arg(r.firstBadLine), Common::LogLevel::Warn);
+    m_robots[index].model->setAll(r.poses);
+    emit log(QString("[OK] Loaded %1 poses into %2").arg(r.poses.size()).arg(id));
     return true;
 }
 
-bool RobotManager::loadCsvToModel(const QString& id, const QString& filePath, QString* errMsg, QObject* owner)
+bool RobotManager::loadCsvToModelAsync(const QString& id, const QString& filePath, QObject* owner)
 {
-    // 컨텍스트가 없으면 '모델만' 갖춘 컨텍스트를 먼저 만든다
-    if (!m_ctx.contains(id)) {
-        RobotContext ctx;
-        ctx.id    = id;
-        ctx.model = new PickListModel(owner ? owner : this);
-        m_ctx.insert(id, ctx);
-    } else if (!m_ctx[id].model) {
-        m_ctx[id].model = new PickListModel(owner ? owner : this);
+    RobotContext& c = ensureContext(id, owner);
+    const int index = c.index;
+    if (!c.csv) {
+        c.csv = new PoseCsvLoader(this);
+        connect(c.csv, &PoseCsvLoader::batchReady, this, [this, index](const QVector<Pose6D>& poses){
+            if (auto* m = m_robots[index].model.data()) m->append(poses);
+        });
+        connect(c.csv, &PoseCsvLoader::finished, this, [this, id](bool ok, int rows, const QString& msg){
+            emit log(QString(ok ? "[OK] Loaded %1 into %2" : "[ERR] CSV load failed for %2: %1").arg(msg, id),
+                     ok ? Common::LogLevel::Info : Common::LogLevel::Error);
+            emit csvLoaded(id, ok, rows, msg);
+        });
     }
-
-    QFile f(filePath);
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        if (errMsg) *errMsg = QString("open failed: %1").arg(filePath);
+    if (c.csv->isRunning()) {
+        emit log(QString("[RM] CSV load already running for %1").arg(id), Common::LogLevel::Warn);
         return false;
     }
-    QTextStream ts(&f);
-    QVector<Pose6D> list;
-    int lineNo = 0, okCnt = 0;
-    while (!ts.atEnd()) {
-        const QString line = ts.readLine();
-        ++lineNo;
-        Pose6D p;
-        if (parseLineToPose(line, p)) {
-            list.push_back(p);
-            ++okCnt;
-        } else {
-            // 첫 줄이 헤더일 수도 있으니 조용히 스킵
-        }
-    }
-    if (okCnt == 0) {
-        if (errMsg) *errMsg = "no valid rows";
+    c.model->clear();
+    return c.csv->start(filePath);
+}
+
+bool RobotManager::loadPoseFile(const QString& id, const QString& filePath, QObject* owner)
+{
+    if (!PoseBinary::isBinaryFile(filePath))
+        return loadCsvToModelAsync(id, filePath, owner);
+
+    RobotContext& c = ensureContext(id, owner);
+    if (c.csv && c.csv->isRunning()) {
+        emit log(QString("[RM] CSV load already running for %1").arg(id), Common::LogLevel::Warn);
         return false;
     }
-    m_ctx[id].model->setAll(list);
-    emit log(QString("[OK] Loaded %1 poses into %2").arg(okCnt).arg(id));
+    QString err;
+    if (!c.model->attachBinary(filePath, &err)) {
+        emit log(QString("[ERR] Binary pose load failed for %1: %2").arg(id, err), Common::LogLevel::Error);
+        emit csvLoaded(id, false, 0, err);
+        return true;   // 요청 자체는 처리됨 (결과는 csvLoaded)
+    }
+    const int rows = c.model->rowCount();
+    emit log(QString("[OK] Mapped %1 poses into %2 (%3)").arg(rows).arg(id).arg(filePath));
+    emit csvLoaded(id, true, rows, QString("%1 rows (binary)").arg(rows));
     return true;
 }
 
 void RobotManager::onBusHeartbeat(bool ok)
 {
     auto* bus = qobject_cast<QObject*>(sender());
-    const QString id = m_busToId.value(bus);
-    if (!id.isEmpty()) emit heartbeat(id, ok);
+    const int i = m_busToIndex.value(bus, -1);
+    if (i >= 0) emit heartbeat(m_robots[i].id, ok);
 }
 
 void RobotManager::onBusConnected()
 {
     auto* bus = qobject_cast<QObject*>(sender());
-    const QString id = m_busToId.value(bus);
-    if (!id.isEmpty())
-        emit connectionChanged(id, true);
+    const int i = m_busToIndex.value(bus, -1);
+    if (i >= 0)
+        emit connectionChanged(m_robots[i].id, true);
 }
 
 void RobotManager::onBusDisconnected()
 {
     auto* bus = qobject_cast<QObject*>(sender());
-    const QString id = m_busToId.value(bus);
-    if (!id.isEmpty())
-        emit connectionChanged(id, false);
+    const int i = m_busToIndex.value(bus, -1);
+    if (i >= 0)
+        emit connectionChanged(m_robots[i].id, false);
 }
 
-void RobotManager::hookSignals(const QString& id, ModbusClient* bus, Orchestrator* orch)
+void RobotManager::hookSignals(int index, ModbusClient* bus, Orchestrator* orch)
 {
     if (!bus || !orch) return;
+    const QString id = m_robots[index].id;
     // 역참조용 맵에 등록
-    m_busToId.insert(bus, id);
+    m_busToIndex.insert(bus, index);
+    // 트레이스는 프로토콜 로봇 인덱스(a=0..)로 기록 → 비전 명령과 같은 번호
+    const int traceRobot = ::robotIndex(id);
+    bus->setTraceRobot(traceRobot);
     // ModbusClient 시그널
     connect(bus, &ModbusClient::heartbeat,   this, &RobotManager::onBusHeartbeat);
     connect(bus, &ModbusClient::connected,   this, &RobotManager::onBusConnected);
     connect(bus, &ModbusClient::disconnected,this, &RobotManager::onBusDisconnected);
     connect(bus, &ModbusClient::log, this,[this, id](const QString& line, Common::LogLevel lv) {
-        emit logByRobot(id, line, lv);   // ★ 패널용
-        emit log(QString("%1 (%2)").arg(line,id), lv);              // ★ 전체용
+        emit logByRobot(id, line, lv);   // 전체 로그창도 출처(로봇)별로 받는다 → 중복 emit 없음
     });
     // Orchestrator 시그널
-/*
-    connect(orch, &Orchestrator::kinematicsUpdated, m_vsrv,
+    // 관절/TCP 읽기마다 최신값만 갱신, 송신은 구독자별 주기로 발행자가 한다
+    connect(orch, &Orchestrator::kinematicsUpdated, this,
             [this](const QString& rid, const Orchestrator::RobotState& state){
-//                m_vsrv->updateRobotState(rid, state.tcp, state.joints, state.tsMs);
+                m_statePub->update(rid, state.tcp, state.joints);
     });
-*/
     connect(orch, &Orchestrator::stateChanged, this,
-            [this, id](int state, const QString& name){
+            [this, id, traceRobot](int state, const QString& name){
+                if (EventTrace::enabled()) EventTrace::fsmState(traceRobot, state);
                 emit stateChanged(id, state, name);
     });
     connect(orch, &Orchestrator::currentRowChanged, this,
@@ -337,435 +331,111 @@ void RobotManager::hookSignals(const QString& id, ModbusClient* bus, Orchestrato
 //
     });    
     connect(orch, &Orchestrator::log, this, [this, id](const QString& line, Common::LogLevel lv) {
-        emit logByRobot(id, line, lv);   // ★ 패널용
-        emit log(QString("%1 (%2)").arg(line,id), lv);              // ★ 전체용
+        emit logByRobot(id, line, lv);   // 전체 로그창도 출처(로봇)별로 받는다 → 중복 emit 없음
     });
 
-    connect(orch, &Orchestrator::stateFeedback, this, [this, id](const RobotStateFeedback& st) {
-/*
-        bool enabled = st.enabled;
-        int mode = st.mode;
-
-        int tool = st.toolNumber;
-*/
-        int run = st.runningState;
-
-        //int st.workpieceNumber  ;
-//        bool emg = st.emergencyStop;
-        bool limit = st.softLimitExceeded;
-        int mainError = st.mainError;
-        int subError = st.subError;
-        bool collision = st.collision;
-        //st.motionArrive     ;
-//        bool SI0 = st.safetyStopSI0;
-//        bool SI1 = st.safetyStopSI1;
-
-        int index=0;
-        if (id.toLower()=="a") index=0;
-        else if (id.toLower()=="b") index=1;
-
-        if(!old_Limit_[index] && limit)
-        {
-            m_vsrv->sendError(id,"limit", mainError, subError);
-        }
-        else if(!old_Collision_[index] && collision)
-        {
-            m_vsrv->sendError(id,"collision", mainError, subError);
-        }
-        else if((old_MainError_[index]==0)&& (mainError!=0))
-        {
-            if(mainError==1 && subError==22) // 긴급정지
-                m_vsrv->sendError(id,"limit", mainError, subError);
-            else
-                m_vsrv->sendError(id,QString::number(mainError),mainError, subError);
-        }
-        else if((old_SubError_[index]==0)&& (subError!=0))
-        {
-            m_vsrv->sendError(id,QString::number(subError), mainError, subError);
-        }
-        else if( (old_Run_[index]==2)&&(run==1) )
-        {
-            m_vsrv->sendError(id,"unreachable", mainError, subError);
+    // 상태 워드가 바뀐 폴링에서만 호출된다. 동시에 생긴 에러 에지는 모두 보고하되,
+    // 같은 사유는 한 번만 보낸다 (긴급정지 = 메인 1/서브 22 는 "limit" 하나로, 서브 에러 따로 안 보냄).
+    // 에러마다 Fault 레코드를 남기고, 한 폴링의 에러들은 플라이트 레코더 덤프 한 번으로 묶는다.
+    connect(orch, &Orchestrator::stateChange, this, [this, id, traceRobot](const RobotStateChange& ch) {
+        if (!ch.edges) return;
+        using W = RobotStateWord;
+        const int mainError = ch.after.get(W::MainError);
+        const int subError  = ch.after.get(W::SubError);
+
+        QStringList reasons;
+        auto report = [&](const QString& error) {
+            if (reasons.contains(error)) return;
+            if (EventTrace::enabled()) EventTrace::fault(traceRobot, error, mainError, subError);
+            reasons << error;
+            if (m_vsrv) m_vsrv->sendError(id, error, mainError, subError);
+        };
+
+        if (ch.edges & W::EdgeLimit)
+            report("limit");
+        if (ch.edges & W::EdgeCollision)
+            report("collision");
+        bool estop = false;
+        if (ch.edges & W::EdgeMainError) {
+            estop = (mainError==1 && subError==22); // 긴급정지
+            report(estop ? QStringLiteral("limit") : QString::number(mainError));
         }
+        if ((ch.edges & W::EdgeSubError) && !estop)
+            report(QString::number(subError));
+        if (ch.edges & W::EdgeUnreachable)
+            report("unreachable");
+
+        dumpFlightRecorder(id, reasons.join('+'), false);
+    });
 
-        old_Run_[index] = run;
-        old_Limit_[index] = limit;
-        old_Collision_[index] = collision;
-        old_MainError_[index] = mainError;
-        old_SubError_[index] = subError;
+    connect(orch, &Orchestrator::busyChanged, this, [this, id](const QString&, bool busy) {
+        if (busy && m_vsrv) m_vsrv->traceStage(id, CommandTracker::Busy);
     });
 
-    connect(orch, &Orchestrator::processPulse, this, [this, id](const QString& rid, int idx){
+    // 완료 펄스 → 비전 보고: slot 은 여기서 한 번만 구해 두고 이벤트마다 [slot][idx] 조회
+    const int pulseSlot = m_pulses.slotOf(id);
+    connect(orch, &Orchestrator::processPulse, this, [this, index, id, pulseSlot, traceRobot](const QString& rid, int idx){
+        if (EventTrace::enabled()) EventTrace::diEdge(traceRobot, idx);
+        emit pulseReceived(id, idx);
+        const bool expected = takeExpectedPulse(index, idx);
         if (!m_vsrv) return;
         emit logByRobot(id, QString("[RM] processPulse from %1 idx=%2").arg(rid).arg(idx), Common::LogLevel::Info);
-        if (rid == "A") {
-            switch(idx)
-            {
-            case 0: // 프로그램 시작
-                break;
-
-            case 1: // 동작 수행
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"command Start";
-                break;
-
-            case 2: // none
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"command Complete";
-                break;
-
-            case 3: // 툴 교체 완료
-            {
-                QString key = QString("%1_tool").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendToolComplete(id, 0, true);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Tool Complete";
-            }   break;
-            case 4: // 대기자세 완료
-            {
-                QString key = QString("%1_ready").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "standby", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Standby Complete";
-            }   break;
-            case 5: // none
-            {
-                QString key = QString("%1_pick_nonFlip").arg(rid);
-                qInfo()<<"RobotManager::processPulse PICK nonflip key="<<key;
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "pick", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                    qDebug()<<"RobotManager::processPulse PICK complete key="<<key;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Sort Pick_non-Flip Complete";
-
-            }   break;
-            case 6: // 소팅 PICK
-            {
-                QString key = QString("%1_pick").arg(rid);
-                qDebug()<<"RobotManager::processPulse PICK key="<<key;
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "pick", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                    qDebug()<<"RobotManager::processPulse PICK complete key="<<key;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Sort Pick_Flip Complete";
-            }   break;
-            case 7: // 소팅 PLACE
-            {
-                QString key = QString("%1_place").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "place", 0);
-                });
-                QTimer::singleShot(20, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "idle", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Sort Place Complete";
-                emit sortProcessFinished(id);
-            }   break;
-            case 8: // 갠트리 툴
-            {
-//                m_vsrv->sendWorkComplete(id, "sorting", "place", 0);
-//                emit sortProcessFinished(id);
-//                emit reqGentryReady();
-            }   break;
-            case 9: // 벌크 픽
-            {
-                QString key = QString("%1_bulk_pick").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(rid, "bulk", "pick", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Bulk Pick Complete";
-            }   break;
-            case 10:    // 벌크 플레이스
-            {
-                QString key = QString("%1_bulk_place").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "bulk", "place", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Bulk Place Complete";
-            }   break;
-            case 11:    // arrange
-            {
-                QString key = QString("%1_arrange").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "arrange", 0);
-                });
-                QTimer::singleShot(50, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"Arrange Complete";
-            }   break;
-
-            case 12:    // IDLE: 소팅 완료 후 대기 상태
-            {
-                QString key = QString("%1_idle").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "sorting", "idle", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"IDLE  Complete";
-            }   break;
-            case 13:    // 툴 체인지 중 촬상가능위치: Bulk to Sorting
-            {
-                QString key = QString("%1_capture_1").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(500, this, [=]() {
-                    m_vsrv->sendFeedbackPose(id,"bulk","sorting",0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"CAPTURE 1 Complete";
-            }   break;
-            case 14:    // 툴 체인지 중 촬상가능위치: Sorting to Bulk
-            {
-                QString key = QString("%1_capture_2").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(500, this, [=]() {
-                    m_vsrv->sendFeedbackPose(id,"sorting","bulk", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-                qInfo()<<QDateTime::currentDateTime()<<": "<<"CAPTURE 2 Complete";
-            }   break;
-            }
-        }
-        else if (rid == "B") {
-            switch(idx)
-            {
-            case 0:  // 프로그램 시작
-            case 1:  // 동작
-                break;
-            case 2: // INIT
-            {
-                QString key = QString("%1_init").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "init", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 3:  // none
-                break;
-            case 4: // READY
-            {
-                QString key = QString("%1_ready").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "standby", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 5: //ASSY
-            {
-                QString key = QString("%1_assy").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "assy", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 6: // PICK
-            {
-                QString key = QString("%1_pick").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "pick", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 7: // PLACE
-            {
-                QString key = QString("%1_pick").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "place", 0);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 8: // CLAMP close
-            {
-                QString key = QString("%1_clamp_1").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "clamp", 0, true);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 9: // CLAMP open
-            {
-                QString key = QString("%1_clamp_2").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "clamp", 0, false);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 10:  // none
-                break;
-            case 11: // scrap
-            {
-                QString key = QString("%1_scrap").arg(rid);
-                if (m_workCompleteSent.value(key, false)) {// 이미 전송된 상태 → 무시
-                    return;
-                }
-                m_workCompleteSent[key] = true;
-                QTimer::singleShot(10, this, [=]() {
-                    m_vsrv->sendWorkComplete(id, "align", "scrap", 0, false);
-                });
-                QTimer::singleShot(100, this, [=]() {
-                    m_workCompleteSent[key] = false;
-                });
-            }   break;
-            case 12:  //
-                break;
-            }
-        }
+        if (expected) m_vsrv->traceStage(id, CommandTracker::Pulse);
+        if (const PulseDispatcher::Entry* e = m_pulses.take(pulseSlot, idx))
+            runPulseActions(id, *e);
     });
 }
 
 // 2025-10-21
 void RobotManager::setVisionMode(const QString& id, bool on) {
-    m_visionMode[id] = on;
+    if (auto* c = ctx(id)) {
+        c->visionMode = on;
+        // 비전 모드: 이력이 끝없이 쌓이지 않도록 링 버퍼 + 프레임 단위 일괄 반영
+        if (c->model)
+            c->model->setCapacity(on ? (c->visionHistory > 0 ? c->visionHistory : kDefaultVisionHistory) : 0);
+    }
     emit log(QString("[RM] VisionMode(%1)=%2").arg(id).arg(on), Common::LogLevel::Info);
 }
 
+void RobotManager::setVisionHistory(const QString& id, int rows) {
+    RobotContext& c = ensureContext(id, nullptr);
+    c.visionHistory = qMax(0, rows);
+    if (c.visionMode && c.model)
+        c.model->setCapacity(c.visionHistory > 0 ? c.visionHistory : kDefaultVisionHistory);
+}
+
+QString RobotManager::dumpFlightRecorder(const QString& id, const QString& reason, bool force) {
+    if (!FlightRecorder::enabled()) return QString();
+    QString err;
+    const QString path = FlightRecorder::dump(::robotIndex(id), reason, force, &err);
+    if (!path.isEmpty())
+        emit logByRobot(id, QString("[RM] flight recorder dumped (%1): %2").arg(reason, path), Common::LogLevel::Warn);
+    else if (force || err != QLatin1String("holdoff"))
+        emit logByRobot(id, QString("[RM] flight recorder dump failed (%1): %2").arg(reason, err), Common::LogLevel::Error);
+    return path;
+}
+
 bool RobotManager::visionMode(const QString& id) const {
-    return m_visionMode.value(id, false);
+    const auto* c = ctx(id);
+    return c && c->visionMode;
 }
 
 void RobotManager::triggerByKey(const QString& id, const QString& coilKey, int pulseMs)
 {
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
+    auto* it = ctx(id);
+    if (!it || !it->bus) {
 
         emit log(QString("[RM] trigger: no bus for %1").arg(id));
         return;
     }
 
-    const auto coils   = it.value().addr_.value("coils").toMap();
+    const auto coils   = it->addr_.value("coils").toMap();
     int addr = coils.value(coilKey).toInt();
     if (addr <= 0) {
         emit log(QString("[RM] trigger: invalid key %1 for %2").arg(coilKey, id));
         return;
     }
-/*
-    auto* bus = it->bus.data();
-    auto* owner = this;
-
-    QList<RobotCommandQueue::Step> steps;
-    steps << stepWriteCoil(owner, bus, addr, true);
-    steps << stepDelay(owner, pulseMs);
-    steps << stepWriteCoil(owner, bus, addr, false);
-    it->cmdq->enqueue(steps);
-
-*/
-    QPointer<ModbusClient> busPtr = it->bus;
-    busPtr->writeCoil(addr, true);
-    QTimer::singleShot(pulseMs, this, [busPtr, addr]{
-        if (!busPtr) return;
-        busPtr->writeCoil(addr, false);
-    });
+    it->cmdq->enqueue({ RobotCommandQueue::pulseCoil(it->bus, addr, pulseMs) });
 
     emit log(QString("[RM] trigger %1(%2) pulsed %3ms for %4").arg(coilKey).arg(addr).arg(pulseMs).arg(id));
 }
@@ -776,192 +446,81 @@ void RobotManager::triggerByKey(const QString& id, const QString& coilKey, int p
 /* Bulk */
 void RobotManager::cmdBulk_AttachTool()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    QVector<quint16> regs;// AI0:1, AI1:1
-    regs.reserve(2);
-    regs << 1 << 1;
-    it->orch->publishToolComnad(regs);
-
-    triggerByKey(id, "DI2", 500);
-    emit logByRobot(id, QString("[RM] cmdBulk_AttachTool triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::BulkAttachTool, RecipeArgs(), "cmdBulk_AttachTool");
 }
 
 void RobotManager::cmdBulk_DettachTool()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    QVector<quint16> regs;// AI0:2, AI1:1
-    regs.reserve(2);
-    regs << 2 << 1;
-    it->orch->publishToolComnad(regs);
-
-    triggerByKey(id, "DI2", 500);
-    emit logByRobot(id, QString("[RM] cmdBulk_DettachTool triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::BulkDetachTool, RecipeArgs(), "cmdBulk_DettachTool");
 }
 
 void RobotManager::cmdBulk_ChangeTool()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    QVector<quint16> regs;  // AI0:3, AI1:1
-    regs.reserve(2);
-    regs << 3 << 1;
-    it->orch->publishToolComnad(regs);
-    // Bulk to Sorting
-    QTimer::singleShot(100, this, [this, id]() {
-        triggerByKey(id, "DI2", 500);
-    });
-
-    emit logByRobot(id, QString("[RM] cmdBulk_ChangeTool triggered for %1").arg(id), Common::LogLevel::Info);
+    // Bulk to Sorting (DI2 는 레시피에서 100ms 뒤)
+    runCmd(Cmd::BulkChangeTool, RecipeArgs(), "cmdBulk_ChangeTool");
 }
 
 /* Bulk */
 void RobotManager::cmdBulk_DoPickup(const Pose6D& pose, const int& mode)
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    qDebug()<<"[RM] cmdBulk_DoPickup pose:"<<pose.x<<pose.y<<pose.z<<pose.rx<<pose.ry<<pose.rz;
-    const QVector<double> v{ pose.x,pose.y,pose.z,pose.rx,pose.ry,pose.rz };
+    const CompiledRecipe* r = cmdRecipe(Cmd::BulkPick);
+    if (!r) return;
     /////////////////////////////////////////////////////////////////////
     // ✔ 테스트 체크박스(비전 모드)가 있다면: 켜짐=즉시 발행, 꺼짐=큐 적재 (선택)
-    if (visionMode(id)) {        // ← 이미 있는 함수면 그대로 사용
-        it->orch->publishBulkMode(mode);
-        it->orch->publishBulkPoseWithKind(v, "pick");
-        triggerByKey(id, "DI8", 500);
-        emit logByRobot(id, QString("[RM] cmdBulk_DoPickup triggered for %1").arg(id), Common::LogLevel::Info);
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
-    } else {
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
+    if (m_robots[r->robotIndex].visionMode) {
+        RecipeArgs a;
+        a.pose = pose;
+        a.set(RecipeArg::Mode, mode);
+        runCmd(Cmd::BulkPick, a, "cmdBulk_DoPickup");
     }
-    /// ///////////////////////////////////////////////////////////////////
+    m_robots[r->robotIndex].model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
 }
 
 void RobotManager::cmdBulk_DoPlace(const Pose6D& pose, const int &mode)
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    qDebug()<<"[RM] cmdBulk_DoPlace pose:"<<pose.x<<pose.y<<pose.z<<pose.rx<<pose.ry<<pose.rz;
-    const QVector<double> v{ pose.x,pose.y,pose.z,pose.rx,pose.ry,pose.rz };
-    /////////////////////////////////////////////////////////////////////
-    // ✔ 테스트 체크박스(비전 모드)가 있다면: 켜짐=즉시 발행, 꺼짐=큐 적재 (선택)
-    if (visionMode(id)) {        // ← 이미 있는 함수면 그대로 사용
-        it->orch->publishBulkMode(mode);
-        it->orch->publishBulkPoseWithKind(v, "place");
-        triggerByKey(id, "DI9", 500);
-        emit logByRobot(id, QString("[RM] cmdBulk_DoPlace triggered for %1").arg(id), Common::LogLevel::Info);
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
-    } else {
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
+    const CompiledRecipe* r = cmdRecipe(Cmd::BulkPlace);
+    if (!r) return;
+    if (m_robots[r->robotIndex].visionMode) {
+        RecipeArgs a;
+        a.pose = pose;
+        a.set(RecipeArg::Mode, mode);
+        runCmd(Cmd::BulkPlace, a, "cmdBulk_DoPlace");
     }
-    /// ///////////////////////////////////////////////////////////////////
-
+    m_robots[r->robotIndex].model->add(pose);
 }
 
 /* Sorting */
 // 1. 소팅 툴 장착
 void RobotManager::cmdSort_AttachTool()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    QVector<quint16> regs;  // AI0:1, AI1:2
-    regs.reserve(2);
-    regs << 1 << 2;
-    it->orch->publishToolComnad(regs);
-
-    triggerByKey(id, "DI2", 500);
-    emit logByRobot(id, QString("[RM] cmdSort_AttachTool triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::SortAttachTool, RecipeArgs(), "cmdSort_AttachTool");
 }
 void RobotManager::cmdSort_DettachTool()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    QVector<quint16> regs;  // AI0:2, AI1:2
-    regs.reserve(2);
-    regs << 2 << 2;
-    it->orch->publishToolComnad(regs);
-    QTimer::singleShot(100, this, [this, id]() {
-        triggerByKey(id, "DI2", 500);
-    });
-
-    emit logByRobot(id, QString("[RM] cmdSort_DettachTool triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::SortDetachTool, RecipeArgs(), "cmdSort_DettachTool");
 }
 
 void RobotManager::cmdSort_ChangeTool()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    QVector<quint16> regs;  // AI0:3, AI1:2
-    regs.reserve(2);
-    regs << 3 << 2;
-    it->orch->publishToolComnad(regs);
-    QTimer::singleShot(100, this, [this, id]() {
-        triggerByKey(id, "DI2", 500);
-    });
-
-    emit logByRobot(id, QString("[RM] cmdSort_ChangeTool triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::SortChangeTool, RecipeArgs(), "cmdSort_ChangeTool");
 }
 // 2. 피킹 촬상위치로 이동
 void RobotManager::cmdSort_MoveToPickupReady()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    triggerByKey(id, "DI4", 500);
-    emit logByRobot(id, QString("[RM] cmdSort_MoveToPickupReady triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::SortMovePickupReady, RecipeArgs(), "cmdSort_MoveToPickupReady");
 }
 // 3. 피킹 동작 수행
 void RobotManager::cmdSort_DoPickup(const Pose6D& pose, bool flip, int offset, int thick)
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
+    const CompiledRecipe* r = cmdRecipe(Cmd::SortPick);
+    if (!r) return;
     /////////////////////////////////////////////////////////////////////
-    const QVector<double> v{ pose.x,pose.y,pose.z,pose.rx,pose.ry,pose.rz };
-
-    if( 30 < v[5] && v[5]<= 90 )
+    // KJW 2025-12-02: 툴 기본자세 (180,0,-90), rz가 90도 근처일 때 ±60 오프셋
+    if( 30 < pose.rz && pose.rz <= 90 )
     {
         m_yawOffset=+60;
     }
-else if(90 <= v[5] && v[5] <150)
+    else if(90 <= pose.rz && pose.rz < 150)
     {
         m_yawOffset=-60;
     }
@@ -970,317 +529,391 @@ else if(90 <= v[5] && v[5] <150)
         m_yawOffset=0;
     }
     /////////////////////////////////////////////////////////////////////
-    // ✔ 테스트 체크박스(비전 모드)가 있다면: 켜짐=즉시 발행, 꺼짐=큐 적재 (선택)
-    if (!visionMode(id)) {
-        if (it->model) it->model->add(pose);
-        return;
+    if (m_robots[r->robotIndex].visionMode) {
+        RecipeArgs a;
+        a.pose = Orchestrator::rotateToolYaw(pose, m_yawOffset);
+        a.set(RecipeArg::Flip,   flip ? 1.0 : 0.0)
+         .set(RecipeArg::Offset, offset)
+         .set(RecipeArg::Yaw,    m_yawOffset)
+         .set(RecipeArg::Thick,  thick);
+        runCmd(Cmd::SortPick, a, "cmdSort_DoPickup");
     }
-/*
-    // ✅ 1) 레지스터 생성 (통신 없음)
-    const QVector<quint16> regs =
-        Orchestrator::makeSortPickRegs(v, flip, offset, m_yawOffset, thick);
-    // ✅ 2) 주소 resolve (addr_.json 기준)
-    const auto holding = it->addr_.value("holding").toMap();
-    const auto coils   = it->addr_.value("coils").toMap();
-
-    const int basePick = holding.value("TARGET_POSE_PICK").toInt();
-    const int coilPick = coils.value("DI5").toInt();   // 기존 PICK 트리거
-    if (basePick <= 0 || coilPick <= 0) {
-        emit log("[RM] cmdSort_DoPickup: invalid addr", Common::LogLevel::Error);
-        return;
-    }
-    // ✅ 3) cmdq에 “write → pulse”를 하나의 시퀀스로
-    QList<RobotCommandQueue::Step> steps;
-    steps << stepWriteHoldingBlock(this, it->bus, basePick, regs);
-    steps << stepWriteCoil(this, it->bus, coilPick, true);
-    steps << stepDelay(this, 80);   // 80~150ms 권장
-    steps << stepWriteCoil(this, it->bus, coilPick, false);
-
-    it->cmdq->enqueue(steps);
-
-    emit logByRobot(id,
-                    QString("[RM] cmdSort_DoPickup queued (base=%1, coil=%2)")
-                        .arg(basePick).arg(coilPick),
-                    Common::LogLevel::Info);
-*/
-    triggerByKey(id, "DI5", 500);
-    it->orch->publishSortPick(v,flip, offset, m_yawOffset, thick);
-
-    emit logByRobot(id, QString("[RM] cmdSort_DoPickup triggered for %1").arg(id), Common::LogLevel::Info);
-    if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
-
-    /// ///////////////////////////////////////////////////////////////////
+    m_robots[r->robotIndex].model->add(pose);
 }
 // 4. 컨베이어 이동
 void RobotManager::cmdSort_MoveToConveyor()
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
+    // 전용 레시피 없음 → 소팅 피킹 레시피가 배정된 로봇
+    const CompiledRecipe* r = cmdRecipe(Cmd::SortPick);
+    if (!r) return;
+    if (!r->bus) {
+        emit log(QString("[RM] trigger: no bus for %1").arg(r->robot));
         return;
     }
-    emit logByRobot(id, QString("[RM] cmdSort_MoveToConveyor triggered for %1").arg(id), Common::LogLevel::Info);
+    emit logByRobot(r->robot, QString("[RM] cmdSort_MoveToConveyor triggered for %1").arg(r->robot), Common::LogLevel::Info);
 }
 // 5. 플레이스 수행
 void RobotManager::cmdSort_DoPlace(bool flip, int offset, int thick)
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
     if (flip) {
-        // flip 처리
+        // flip: 오프셋 레지스터 갱신 없이 트리거만
+        runCmd(Cmd::SortPlaceFlip, RecipeArgs(), "cmdSort_DoPlace");
     } else {
-        // non-flip 처리
-        it->orch->publishFlip_Offset(false, offset, m_yawOffset, thick);
+        RecipeArgs a;
+        a.set(RecipeArg::Flip,   0.0)
+         .set(RecipeArg::Offset, offset)
+         .set(RecipeArg::Yaw,    m_yawOffset)
+         .set(RecipeArg::Thick,  thick);
+        runCmd(Cmd::SortPlace, a, "cmdSort_DoPlace");
     }
     m_yawOffset = 0;
-    triggerByKey(id, "DI6", 500);
-    emit logByRobot(id, QString("[RM] cmdSort_DoPlace triggered for %1").arg(id), Common::LogLevel::Info);
 }
 
 void RobotManager::cmdSort_GentryTool(bool toggle)
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-
-    QPointer<ModbusClient> busPtr = it->bus;
-    if (!busPtr) return;
-#if true
-    QTimer::singleShot(10, this, [busPtr]{
-        if (!busPtr) return;
-        busPtr->writeCoil(303, false);  // Tool true
-    });
-
-    QTimer::singleShot(50, this, [busPtr]{
-        if (!busPtr) return;
-        busPtr->writeCoil(303, true);   // Tool false
-    });
-
-    QTimer::singleShot(500, this, [busPtr]{
-        if (!busPtr) return;
-        busPtr->writeCoil(303, false);  // Tool true
-    });
-#else
-    MbOp op1; op1.kind = MbOp::Kind::DelayMs; op1.delayMs = 10;
-    MbOp op2; op2.kind = MbOp::Kind::WriteCoil; op2.start = 303; op2.coilValue = false;
-    MbOp op3; op3.kind = MbOp::Kind::DelayMs; op3.delayMs = 40;
-    MbOp op4; op4.kind = MbOp::Kind::WriteCoil; op4.start = 303; op4.coilValue = true;
-    MbOp op5; op5.kind = MbOp::Kind::DelayMs; op5.delayMs = 450;
-    MbOp op6; op6.kind = MbOp::Kind::WriteCoil; op6.start = 303; op6.coilValue = false;
-
-    busPtr->enqueue(op1);
-    busPtr->enqueue(op2);
-    busPtr->enqueue(op3);
-    busPtr->enqueue(op4);
-    busPtr->enqueue(op5);
-    busPtr->enqueue(op6);
-#endif
+    Q_UNUSED(toggle);
+    runCmd(Cmd::SortGantryTool, RecipeArgs(), "cmdSort_GentryTool");
 }
 
 void RobotManager::cmdSort_Arrange(const Pose6D &origin, const Pose6D &dest)
 {
-    QString id("A");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-
-    qDebug()<<"[RM] cmdSort_Arrange origin:"<<origin.x<<origin.y<<origin.z<<origin.rx<<origin.ry<<origin.rz;
-    qDebug()<<"[RM] cmdSort_Arrange dest:"<<dest.x<<dest.y<<dest.z<<dest.rx<<dest.ry<<dest.rz;
-
-
-    const QVector<double> v_1{ origin.x,origin.y,origin.z,origin.rx,origin.ry,origin.rz };
-    const QVector<double> v_2{ dest.x,dest.y,dest.z,dest.rx,dest.ry,dest.rz };
-    /////////////////////////////////////////////////////////////////////
-    // ✔ 테스트 체크박스(비전 모드)가 있다면: 켜짐=즉시 발행, 꺼짐=큐 적재 (선택)
-    if (visionMode(id)) {        // ← 이미 있는 함수면 그대로 사용
-        triggerByKey(id, "DI11", 500);
-        it->orch->publishArrangePoses(v_1,v_2);
-
-        if (it->model) it->model->add(origin); // 필요 시 큐에 쌓고 나중에 실행
-        if (it->model) it->model->add(dest); // 필요 시 큐에 쌓고 나중에 실행
-    } else {
-        if (it->model) it->model->add(origin); // 필요 시 큐에 쌓고 나중에 실행
-        if (it->model) it->model->add(dest); // 필요 시 큐에 쌓고 나중에 실행
+    const CompiledRecipe* r = cmdRecipe(Cmd::SortArrange);
+    if (!r) return;
+    if (m_robots[r->robotIndex].visionMode) {
+        RecipeArgs a;
+        a.pose  = origin;
+        a.pose2 = dest;
+        runCmd(Cmd::SortArrange, a, "cmdSort_Arrange");
     }
-    /// ///////////////////////////////////////////////////////////////////
-
+    m_robots[r->robotIndex].model->add(origin);
+    m_robots[r->robotIndex].model->add(dest);
 }
 
 /* Aligin */
 // 6. 얼라인 초기화
 void RobotManager::cmdAlign_Initialize()
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    triggerByKey(id, "DI3", 500);
-    emit logByRobot(id, QString("[RM] cmdAlign_Initialize triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::AlignInitialize, RecipeArgs(), "cmdAlign_Initialize");
 }
 // 7. ASSY 촬상위치로 이동
 void RobotManager::cmdAlign_MoveToAssyReady()
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    triggerByKey(id, "DI5", 500);
-    emit logByRobot(id, QString("[RM] cmdAlign_MoveToAssyReady triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::AlignMoveAssyReady, RecipeArgs(), "cmdAlign_MoveToAssyReady");
 }
 // 8. 피킹 촬상위치로 이동
 void RobotManager::cmdAlign_MoveToPickupReady()
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    triggerByKey(id, "DI4", 500);
-    emit logByRobot(id, QString("[RM] cmdAlign_MoveToPickupReady triggered for %1").arg(id), Common::LogLevel::Info);
+    runCmd(Cmd::AlignMovePickupReady, RecipeArgs(), "cmdAlign_MoveToPickupReady");
 }
 // 9. 피킹 동작 수행
 void RobotManager::cmdAlign_DoPickup(const Pose6D& pose)
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
-    }
-    /////////////////////////////////////////////////////////////////////
-    const QVector<double> v{ pose.x,pose.y,pose.z,pose.rx,pose.ry,pose.rz };
-    // ✔ 테스트 체크박스(비전 모드)가 있다면: 켜짐=즉시 발행, 꺼짐=큐 적재 (선택)
-    if (visionMode(id)) {        // ← 이미 있는 함수면 그대로 사용
-//        it->orch->publishPoseWithKind(v, 50, "pick");
-        triggerByKey(id, "DI6", 500);
-        it->orch->publishAlignPick(v);
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
-
-        emit logByRobot(id, QString("[RM] cmdAlign_DoPickup triggered for %1").arg(id), Common::LogLevel::Info);
-    } else {
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
+    const CompiledRecipe* r = cmdRecipe(Cmd::AlignPick);
+    if (!r) return;
+    if (m_robots[r->robotIndex].visionMode) {
+        RecipeArgs a;
+        a.pose = Orchestrator::rotateToolYaw(pose, 0.0f);
+        runCmd(Cmd::AlignPick, a, "cmdAlign_DoPickup");
     }
-    /// ///////////////////////////////////////////////////////////////////
+    m_robots[r->robotIndex].model->add(pose);
 }
 // 10. 플레이스 동작 수행
 void RobotManager::cmdAlign_DoPlace(const Pose6D& pose, int clampSequenceMode)
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
+    const CompiledRecipe* r = cmdRecipe(Cmd::AlignPlace);
+    if (!r) return;
+    if (m_robots[r->robotIndex].visionMode) {
+        RecipeArgs a;
+        a.pose = Orchestrator::rotateToolYaw(pose, 0.0f);
+        a.set(RecipeArg::ClampMode, clampSequenceMode);
+        runCmd(Cmd::AlignPlace, a, "cmdAlign_DoPlace");
     }
-    /////////////////////////////////////////////////////////////////////
-    const QVector<double> v{ pose.x,pose.y,pose.z,pose.rx,pose.ry,pose.rz };
-    // ✔ 테스트 체크박스(비전 모드)가 있다면: 켜짐=즉시 발행, 꺼짐=큐 적재 (선택)
-    if (visionMode(id)) {        // ← 이미 있는 함수면 그대로 사용
-//        it->orch->publishPoseWithKind(v, 50, "place");
-        triggerByKey(id, "DI7", 500);
-        it->orch->publishAlignPlace(v, clampSequenceMode);
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
+    m_robots[r->robotIndex].model->add(pose);
+}
+// 11. 클램프 동작 수행
+void RobotManager::cmdAlign_Clamp(bool open)
+{
+    RecipeArgs a;
+    a.set(RecipeArg::Open, open ? 1.0 : 0.0);
+    runCmd(Cmd::AlignClamp, a, open ? "Clamp Open" : "Clamp Close");
+}
 
-        emit logByRobot(id, QString("[RM] cmdAlign_DoPlace triggered for %1").arg(id), Common::LogLevel::Info);
-    } else {
-        if (it->model) it->model->add(pose); // 필요 시 큐에 쌓고 나중에 실행
+void RobotManager::cmdAlign_Scrap()
+{
+    runCmd(Cmd::AlignScrap, RecipeArgs(), "cmdAlign_Scrap");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// 명령 레시피 (recipes.json → CompiledRecipe → ModbusClient::enqueueGroup)
+/// /////////////////////////////////////////////////////////////////////////////////////
+const char* RobotManager::cmdRecipeName(Cmd c)
+{
+    switch (c) {
+    case Cmd::BulkAttachTool:       return "bulk.attach_tool";
+    case Cmd::BulkDetachTool:       return "bulk.detach_tool";
+    case Cmd::BulkChangeTool:       return "bulk.change_tool";
+    case Cmd::BulkPick:             return "bulk.pick";
+    case Cmd::BulkPlace:            return "bulk.place";
+    case Cmd::SortAttachTool:       return "sorting.attach_tool";
+    case Cmd::SortDetachTool:       return "sorting.detach_tool";
+    case Cmd::SortChangeTool:       return "sorting.change_tool";
+    case Cmd::SortMovePickupReady:  return "sorting.move_pickup_ready";
+    case Cmd::SortPick:             return "sorting.pick";
+    case Cmd::SortPlace:            return "sorting.place";
+    case Cmd::SortPlaceFlip:        return "sorting.place_flip";
+    case Cmd::SortGantryTool:       return "sorting.gantry_tool";
+    case Cmd::SortArrange:          return "sorting.arrange";
+    case Cmd::AlignInitialize:      return "align.initialize";
+    case Cmd::AlignMoveAssyReady:   return "align.move_assy_ready";
+    case Cmd::AlignMovePickupReady: return "align.move_pickup_ready";
+    case Cmd::AlignPick:            return "align.pick";
+    case Cmd::AlignPlace:           return "align.place";
+    case Cmd::AlignClamp:           return "align.clamp";
+    case Cmd::AlignScrap:           return "align.scrap";
+    case Cmd::Count:                break;
+    }
+    return "";
+}
+
+bool RobotManager::loadRecipes(const QString& path)
+{
+    QString err;
+    if (!m_recipeBook.load(path, &err)) {
+        emit log(QString("[RM] recipe load failed: %1").arg(err), Common::LogLevel::Error);
+        return false;
     }
-    /// ///////////////////////////////////////////////////////////////////
+    emit log(QString("[RM] %1 recipes loaded from %2")
+                 .arg(m_recipeBook.specs().size()).arg(m_recipeBook.source()), Common::LogLevel::Info);
 
+    for (int i = 0; i < m_robots.size(); ++i)
+        compileRecipes(i);
+    return true;
+}
 
+bool RobotManager::loadPulseActions(const QString& path)
+{
+    QString err;
+    if (!m_pulses.load(path, &err)) {
+        emit log(QString("[RM] pulse action load failed: %1").arg(err), Common::LogLevel::Error);
+        return false;
+    }
+    emit log(QString("[RM] pulse actions loaded from %1").arg(m_pulses.source()), Common::LogLevel::Info);
+    return true;
 }
-// 11. 클램프 동작 수행
-void RobotManager::cmdAlign_Clamp(bool open)
+
+// 디바운스를 통과한 완료 펄스의 액션을 순서대로 즉시 실행 (delay_ms 지정 액션만 지연)
+void RobotManager::runPulseActions(const QString& id, const PulseDispatcher::Entry& e)
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
+    using Kind = PulseDispatcher::Action::Kind;
+    for (const auto& a : e.actions) {
+        auto fire = [this, id, a]{
+            switch (a.kind) {
+            case Kind::WorkComplete:
+                if (m_vsrv) m_vsrv->sendWorkComplete(id, a.a, a.b, 0, a.flag);
+                break;
+            case Kind::ToolComplete:
+                if (m_vsrv) m_vsrv->sendToolComplete(id, 0, a.flag);
+                break;
+            case Kind::FeedbackPose:
+                if (m_vsrv) m_vsrv->sendFeedbackPose(id, a.a, a.b, 0);
+                break;
+            case Kind::SortFinished:
+                emit sortProcessFinished(id);
+                break;
+            case Kind::GantryPlace:
+                emit reqGentryPalce();
+                break;
+            case Kind::GantryReady:
+                emit reqGentryReady();
+                break;
+            }
+        };
+        if (a.delayMs > 0) QTimer::singleShot(a.delayMs, this, fire);
+        else               fire();
     }
-    it->bus->writeCoil(110, open); // 110번 코일을 여닫기);
-    triggerByKey(id, "DI8", 500);
-    emit logByRobot(id, QString("[RM] Clamp %1 command sent").arg(open?"Open":"Close"), Common::LogLevel::Info);
+    if (!e.log.isEmpty())
+        emit logByRobot(id, QString("[RM] %1").arg(e.log), Common::LogLevel::Info);
 }
 
-void RobotManager::cmdAlign_Scrap()
+// 로봇 주소맵이 바뀔 때(addOrConnect) 해당 로봇 레시피만 다시 컴파일
+void RobotManager::compileRecipes(int index)
 {
-    QString id("B");
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
-        emit log(QString("[RM] trigger: no bus for %1").arg(id));
-        return;
+    if (index < 0 || index >= m_robots.size()) return;
+    RobotContext& c = m_robots[index];
+    c.completePulseMask = 0;
+
+    for (const auto& spec : m_recipeBook.specs()) {
+        if (spec.robot != c.id) continue;
+
+        CompiledRecipe r;
+        QString err;
+        if (!RecipeBook::compile(spec, c.addr_, &r, &err)) {
+            emit log(QString("[RM] %1").arg(err), Common::LogLevel::Error);
+            continue;
+        }
+        r.bus = c.bus;
+        r.robotIndex = index;
+        if (r.completePulse >= 0 && r.completePulse < 64)
+            c.completePulseMask |= quint64(1) << r.completePulse;
+
+        const int idx = m_recipeIndex.value(spec.name, -1);
+        if (idx >= 0) {
+            m_recipes[idx] = r;
+        } else {
+            m_recipeIndex.insert(spec.name, m_recipes.size());
+            m_recipes.push_back(r);
+        }
+    }
+
+    for (int c = 0; c < int(Cmd::Count); ++c)
+        m_cmdRecipe[c] = m_recipeIndex.value(QString::fromLatin1(cmdRecipeName(Cmd(c))), -1);
+}
+
+const CompiledRecipe* RobotManager::cmdRecipe(Cmd c)
+{
+    const int idx = m_cmdRecipe[int(c)];
+    if (idx < 0) {
+        emit log(QString("[RM] recipe %1 not available").arg(cmdRecipeName(c)), Common::LogLevel::Warn);
+        return nullptr;
+    }
+    return &m_recipes[idx];
+}
+
+bool RobotManager::submitRecipe(const CompiledRecipe& r, const RecipeArgs& args)
+{
+    if (!r.bus || !r.bus->isConnected()) {
+        emit log(QString("[RM] trigger: no bus for %1").arg(r.robot));
+        return false;
+    }
+    if (r.robotIndex < 0 || !m_robots[r.robotIndex].cmdq) return false;
+
+    RobotCommandQueue::Step step = RobotCommandQueue::group(r.bus, r.instantiate(args));
+    step.label = r.name;
+    const QString robot = r.robot, name = r.name;
+    const int index = r.robotIndex;
+    // 완료 펄스는 그룹(트리거 OFF + 지연 포함)이 끝나기 전에 올 수 있으므로 투입 시점에 기다리기 시작
+    const quint64 token = r.completePulse >= 0 ? expectPulse(index, r.completePulse, name) : 0;
+    m_robots[index].cmdq->enqueue({ step }, [this, robot, name, index, token](bool ok, const QString& err){
+        if (!ok) {
+            if (token) cancelExpectedPulse(index, token);
+            emit logByRobot(robot, QString("[RM] recipe %1 failed: %2").arg(name, err), Common::LogLevel::Warn);
+            return;
+        }
+        if (m_vsrv) m_vsrv->traceStage(robot, CommandTracker::Trigger);   // 코일 기록 완료 시각
+    });
+    return true;
+}
+
+// 투입한 레시피의 완료 펄스를 기다린다. 오래 안 오는 것은 대기열 한도에서 밀려난다.
+quint64 RobotManager::expectPulse(int index, int pulse, const QString& recipe)
+{
+    RobotContext& c = m_robots[index];
+    if (c.expectPulses.size() >= kMaxExpectedPulses) {
+        const auto& old = c.expectPulses.front();
+        emit logByRobot(c.id, QString("[RM] %1: completion pulse DO%2 never arrived").arg(old.recipe).arg(old.idx),
+                        Common::LogLevel::Warn);
+        c.expectPulses.removeFirst();
+    }
+    const quint64 token = ++m_expectToken;
+    c.expectPulses.push_back({ pulse, recipe, MonoClock::nowMs(), token });
+    return token;
+}
+
+// 코일 기록이 실패한 레시피: 오지 않을 완료 펄스 대기를 지운다 (이미 도착해 정리됐으면 무시)
+void RobotManager::cancelExpectedPulse(int index, quint64 token)
+{
+    auto& list = m_robots[index].expectPulses;
+    for (int i = 0; i < list.size(); ++i) {
+        if (list[i].token == token) {
+            list.remove(i);
+            return;
+        }
+    }
+}
+
+// 완료 펄스를 대기열과 맞춘다. 레시피 완료 펄스가 아니면(FSM 등) 그대로 통과(true).
+// 기다리던 펄스면 그 앞의 대기(순서상 이미 끝났어야 할 명령)까지 정리하고 true,
+// 이 로봇 레시피의 완료 펄스인데 기다리던 명령이 없으면 false.
+bool RobotManager::takeExpectedPulse(int index, int idx)
+{
+    RobotContext& c = m_robots[index];
+    if (idx < 0 || idx >= 64 || !(c.completePulseMask & (quint64(1) << idx)))
+        return true;
+
+    for (int i = 0; i < c.expectPulses.size(); ++i) {
+        if (c.expectPulses[i].idx != idx) continue;
+        for (int k = 0; k < i; ++k)
+            emit logByRobot(c.id, QString("[RM] %1: completion pulse DO%2 skipped (DO%3 arrived)")
+                                      .arg(c.expectPulses[k].recipe).arg(c.expectPulses[k].idx).arg(idx),
+                            Common::LogLevel::Warn);
+        const auto done = c.expectPulses[i];
+        c.expectPulses.remove(0, i + 1);
+        emit logByRobot(c.id, QString("[RM] %1 complete (DO%2, %3 ms)")
+                                  .arg(done.recipe).arg(idx).arg(MonoClock::nowMs() - done.sinceMs),
+                        Common::LogLevel::Info);
+        return true;
+    }
+    emit logByRobot(c.id, QString("[RM] completion pulse DO%1 without a pending recipe").arg(idx),
+                    Common::LogLevel::Warn);
+    return false;
+}
+
+void RobotManager::runCmd(Cmd c, const RecipeArgs& args, const char* label)
+{
+    const CompiledRecipe* r = cmdRecipe(c);
+    if (!r || !submitRecipe(*r, args)) return;
+    emit logByRobot(r->robot, QString("[RM] %1 triggered for %2").arg(QLatin1String(label), r->robot), Common::LogLevel::Info);
+}
+
+bool RobotManager::runRecipe(const QString& name, const RecipeArgs& args)
+{
+    const int idx = m_recipeIndex.value(name, -1);
+    if (idx < 0) {
+        emit log(QString("[RM] recipe %1 not available").arg(name), Common::LogLevel::Warn);
+        return false;
     }
-    triggerByKey(id, "DI9", 500);
-    emit logByRobot(id, QString("[RM] Screap command sent"), Common::LogLevel::Info);
+    return submitRecipe(m_recipes[idx], args);
 }
 
 void RobotManager::setAutoMode(const QString& id, bool on)
 {
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
+    auto* it = ctx(id);
+    if (!it || !it->bus) {
         emit log(QString("[RM] trigger: no bus for %1").arg(id));
         return;
     }
-    QPointer<ModbusClient> busPtr = it->bus;
-    busPtr->writeCoil(505, true);
-    QTimer::singleShot(500, this, [busPtr]{
-        if (!busPtr) return;
-            busPtr->writeCoil(505, false);
-    });
+    it->cmdq->enqueue({ RobotCommandQueue::pulseCoil(it->bus, 505, 500) });
 }
 
 void RobotManager::startMainProgram(const QString& id)
 {
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
+    auto* it = ctx(id);
+    if (!it || !it->bus) {
         emit log(QString("[RM] trigger: no bus for %1").arg(id));
         return;
     }
-    QPointer<ModbusClient> busPtr = it->bus;
-    busPtr->writeCoil(506, false);
-    busPtr->writeCoil(506, true);
-    QTimer::singleShot(500, this, [busPtr]{
-        if (!busPtr) return;
-        busPtr->writeCoil(506, false);
-    });
+    // 엣지 보장: 먼저 OFF 후 펄스
+    it->cmdq->enqueue({ RobotCommandQueue::writeCoil(it->bus, 506, false),
+                        RobotCommandQueue::pulseCoil(it->bus, 506, 500) });
 }
 
 void RobotManager::stopMainProgram(const QString& id)
 {
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
+    auto* it = ctx(id);
+    if (!it || !it->bus) {
         emit log(QString("[RM] trigger: no bus for %1").arg(id));
         return;
     }
-    QPointer<ModbusClient> busPtr = it->bus;
-    busPtr->writeCoil(503, false);
-    busPtr->writeCoil(503, true);
-    QTimer::singleShot(500, this, [busPtr]{
-        if (!busPtr) return;
-        busPtr->writeCoil(503, false);
-    });
+    // 엣지 보장: 먼저 OFF 후 펄스
+    it->cmdq->enqueue({ RobotCommandQueue::writeCoil(it->bus, 503, false),
+                        RobotCommandQueue::pulseCoil(it->bus, 503, 500) });
 }
 
 void RobotManager::pauseMainProgram(const QString& id)
 {
     /*
-    auto it = m_ctx.find(id);
-    if (it == m_ctx.end() || !it->bus) {
+    auto* it = ctx(id);
+    if (!it || !it->bus) {
         emit log(QString("[RM] trigger: no bus for %1").arg(id));
         return;
     }
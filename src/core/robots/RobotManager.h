@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <QVector>
 #include <QPointer>
 #include <QVariantMap>
 
@@ -10,22 +11,38 @@
 #include "LogLevel.h"
 //#include "RobotCommand.h"
 #include "RobotCommandQueue.h"
+#include "CommandRecipe.h"
+#include "PulseDispatcher.h"
 
 class QAbstractItemModel;
 class PickListModel;
+class PoseCsvLoader;
 class ModbusClient;
 class Orchestrator;
 //class VisionServer; // for friend declaration
 class VisionClient;
+class RobotStatePublisher;
 
 struct RobotContext {
     QString id;
+    int index = -1;     // RobotManager 내 조밀 인덱스 (이벤트 경로는 이 값으로 접근)
     QPointer<PickListModel> model;
     QPointer<ModbusClient>  bus;
     QPointer<Orchestrator>  orch;
     QVariantMap addr_; // AddressMap
 
     QPointer<RobotCommandQueue> cmdq; // ✅ 추가
+    QPointer<PoseCsvLoader> csv;      // 비동기 CSV 로더 (필요 시 생성)
+
+    bool visionMode = false;  // ✅ 비전 모드
+    int  visionHistory = 0;   // 비전 모드 이력 행 수 (0: 기본값 사용)
+    bool hooked = false;      // hookSignals 완료
+
+    // 레시피 complete_pulse: 투입한 명령이 끝났다고 볼 완료 펄스 (투입 순서대로 대기).
+    // 투입 시점에 등록한다 (트리거 OFF 전에 오는 빠른 완료 펄스도 놓치지 않도록), 그룹 실패 시 token 으로 제거.
+    struct ExpectedPulse { int idx; QString recipe; qint64 sinceMs; quint64 token; };
+    QVector<ExpectedPulse> expectPulses;
+    quint64 completePulseMask = 0;  // 이 로봇 레시피들의 완료 펄스 (bit = DO 인덱스)
 };
 
 class RobotManager : public QObject {
@@ -33,7 +50,10 @@ class RobotManager : public QObject {
 public:
     explicit RobotManager(QObject* parent=nullptr);
 
-    void setVisionClient(VisionClient* srv)  { m_vsrv = srv; }
+    void setVisionClient(VisionClient* srv);
+
+    // 로봇 TCP/관절 상태 발행자 (모든 Orchestrator 의 kinematicsUpdated 가 여기로 모인다)
+    RobotStatePublisher* statePublisher() const { return m_statePub; }
 
     // 비전에서 온 포즈를 해당 로봇 큐로 적재
     void enqueuePose(const QString& id, const Pose6D& p);
@@ -56,6 +76,10 @@ public:
     void setRepeat(const QString&id, bool on);
 
     bool hasRobot(const QString& id) const;
+    // 로봇 id ↔ 조밀 인덱스 (0..robotCount()-1, 추가 순서). 없으면 -1 / 빈 문자열
+    int robotIndex(const QString& id) const;
+    int robotCount() const { return m_robots.size(); }
+    QString robotIdAt(int index) const;
     void addOrConnect(const QString& id, const QString& host, int port,
                       const QVariantMap& addr, QObject* owner); // 패널에서 호출
     // 선택: 이미 추가된 로봇의 호스트/포트만 바꿔 재연결
@@ -66,10 +90,21 @@ public:
     void setPoseList(const QString& id, const QVector<Pose6D>& list);
     void clearPoseList(const QString& id);
     bool loadCsvToModel(const QString& id, const QString& filePath, QString* errMsg=nullptr, QObject* owner=nullptr);
+    // 비동기: 모델을 비우고 청크가 파싱되는 대로 추가. 끝나면 csvLoaded
+    bool loadCsvToModelAsync(const QString& id, const QString& filePath, QObject* owner=nullptr);
+    // 파일 앞머리로 판별: .mrcp 바이너리는 mmap 뷰로 바로 연결(csvLoaded 즉시 발행), 그 외는 비동기 CSV
+    bool loadPoseFile(const QString& id, const QString& filePath, QObject* owner=nullptr);
 
     // ✅ 비전 모드 (true면 enqueue→즉시 전송→삭제)
     void setVisionMode(const QString& id, bool on);
     bool visionMode(const QString& id) const;
+    // 비전 모드에서 모델은 최근 N 행만 보관하는 링 버퍼로 동작 (robots.json "vision_history")
+    static constexpr int kDefaultVisionHistory = 2000;
+    void setVisionHistory(const QString& id, int rows);
+
+    // 플라이트 레코더: 이 로봇의 최근 기록(버스/DI/FSM/비전)을 파일로 덤프.
+    // force=false(자동 트리거)면 짧은 간격의 반복 덤프는 건너뛴다. 저장 경로 (없으면 빈 문자열)
+    QString dumpFlightRecorder(const QString& id, const QString& reason, bool force = true);
 
     // ✅ VisionServer → MainWindow 경유로 호출할 처리 API
 //    void processVisionPose(const QString& id, const QString& kind, const Pose6D& p, const QVariantMap& extras);
@@ -125,6 +160,13 @@ public:
 
     void cmdAlign_Scrap();
 
+    // 명령 레시피: path 가 비면 실행 파일 옆 recipes.json → :/config/recipes.json
+    bool loadRecipes(const QString& path = QString());
+    // 이름으로 레시피 실행 (재빌드 없이 추가한 명령용)
+    bool runRecipe(const QString& name, const RecipeArgs& args = RecipeArgs());
+    // 완료 펄스 → 비전 보고 표: path 가 비면 실행 파일 옆 pulse_actions.json → :/config/pulse_actions.json
+    bool loadPulseActions(const QString& path = QString());
+
     // Interface
     void setAutoMode(const QString& id, bool on);
     void startMainProgram(const QString& id);
@@ -136,6 +178,9 @@ signals:
     void connectionChanged(const QString& id, bool connected);
     void stateChanged(const QString& id, int state, const QString& name);
     void currentRowChanged(const QString& id, int row);
+    void csvLoaded(const QString& id, bool ok, int rows, const QString& message);
+    // 완료 펄스(DOn_PULSE 상승 에지) 수신. 디바운스 전, 액션 실행 전에 나간다
+    void pulseReceived(const QString& id, int idx);
 
 //    void bulkProcessStarted(const QString& id);
 //    void bulkProcessFinished(const QString& id);
@@ -157,23 +202,47 @@ private slots:
     void onBusDisconnected();
 
 private:
-    QMap<QString, RobotContext> m_ctx; // "A","B","C" → 컨텍스트
-    QHash<QObject*, QString> m_busToId; // ModbusClient* → id("A","B" 등)
+    QVector<RobotContext> m_robots;      // 조밀 인덱스 → 컨텍스트 (추가만, 삭제 없음)
+    QHash<QString, int> m_robotIndex;    // "A","B","C" → 인덱스 (API 진입 시 한 번)
+    QHash<QObject*, int> m_busToIndex;   // ModbusClient* → 인덱스
 
-    void hookSignals(const QString& id, ModbusClient* bus, Orchestrator* orch);
+    RobotContext* ctx(const QString& id);
+    const RobotContext* ctx(const QString& id) const;
+    RobotContext& ensureContext(const QString& id, QObject* owner);
+    void hookSignals(int index, ModbusClient* bus, Orchestrator* orch);
 
-    QHash<QString, bool> m_visionMode;  // ✅ 로봇별 비전 모드
 //    VisionServer* m_vsrv{nullptr};  // ✅ 보관용
     VisionClient* m_vsrv{nullptr};  // ✅ 보관용
+    RobotStatePublisher* m_statePub{nullptr};
     float m_yawOffset{0.0f}; // vision pose yaw offset
 
-    QMap<QString, bool> m_workCompleteSent;
-
-    int old_Run_[2]{0,0};
-    bool old_Limit_[2]{false,false};
-    bool old_Collision_[2]{false,false};
-    int old_MainError_[2]{0,0};
-    int old_SubError_[2]{0,0};
+    PulseDispatcher m_pulses;   // [robot slot][pulse idx] → 비전 보고 액션
+    void runPulseActions(const QString& id, const PulseDispatcher::Entry& e);
+
+    // ── 명령 레시피 ──
+    enum class Cmd : int {
+        BulkAttachTool, BulkDetachTool, BulkChangeTool, BulkPick, BulkPlace,
+        SortAttachTool, SortDetachTool, SortChangeTool, SortMovePickupReady,
+        SortPick, SortPlace, SortPlaceFlip, SortGantryTool, SortArrange,
+        AlignInitialize, AlignMoveAssyReady, AlignMovePickupReady,
+        AlignPick, AlignPlace, AlignClamp, AlignScrap,
+        Count
+    };
+    static const char* cmdRecipeName(Cmd c);
+    void compileRecipes(int index);
+    const CompiledRecipe* cmdRecipe(Cmd c);
+    bool submitRecipe(const CompiledRecipe& r, const RecipeArgs& args);
+    quint64 expectPulse(int index, int pulse, const QString& recipe);  // 등록 token
+    void cancelExpectedPulse(int index, quint64 token);
+    bool takeExpectedPulse(int index, int idx);
+    static constexpr int kMaxExpectedPulses = 8;
+    quint64 m_expectToken = 0;
+    void runCmd(Cmd c, const RecipeArgs& args, const char* label);
+
+    RecipeBook m_recipeBook;
+    QVector<CompiledRecipe> m_recipes;      // 컴파일된 프로그램 (로봇 주소맵 반영)
+    QHash<QString, int> m_recipeIndex;      // 이름 → m_recipes 인덱스
+    int m_cmdRecipe[int(Cmd::Count)];       // 내장 명령 → m_recipes 인덱스 (-1: 없음)
 };
 
 #endif // ROBOTMANAGER_H
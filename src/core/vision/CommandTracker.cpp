@@ -0,0 +1,199 @@
+#include "CommandTracker.h"
+#include "RobotCommandParser.h"
+
+#include <QJsonArray>
+
+const qint64 CommandTracker::kBounds[kBins - 1] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 60000
+};
+
+const char* CommandTracker::stageName(Stage s)
+{
+    switch (s) {
+    case Rx:      return "rx";
+    case Ack:     return "ack";
+    case Trigger: return "trigger";
+    case Busy:    return "busy";
+    case Pulse:   return "pulse";
+    case Done:    return "done";
+    case StageCount: break;
+    }
+    return "";
+}
+
+void CommandTracker::Histogram::add(qint64 ms)
+{
+    if (ms < 0) ms = 0;
+    int b = 0;
+    while (b < kBins - 1 && ms > kBounds[b]) ++b;
+    ++bins[b];
+    ++count;
+    sumMs += ms;
+    if (ms > maxMs) maxMs = ms;
+}
+
+// 버킷 상한으로 근사 (마지막 버킷은 최대값)
+qint64 CommandTracker::Histogram::percentile(double p) const
+{
+    if (count == 0) return 0;
+    const quint64 want = quint64(p * count + 0.999999);
+    quint64 acc = 0;
+    for (int b = 0; b < kBins; ++b) {
+        acc += bins[b];
+        if (acc >= want)
+            return b < kBins - 1 ? qMin(kBounds[b], maxMs) : maxMs;
+    }
+    return maxMs;
+}
+
+void CommandTracker::begin(const RobotCommand& cmd, qint64 nowMs)
+{
+    Entry e;
+    e.seq = cmd.seq;
+    e.robot = robotIndex(cmd.robot);
+    e.type = cmd.type;
+    e.kind = cmd.kind;
+    e.t[Rx] = nowMs;
+    e.order = ++m_order;
+    m_live.insert(cmd.seq, e);
+    if (e.robot >= 0) m_last[e.robot] = e;
+}
+
+bool CommandTracker::mark(quint32 seq, Stage s, qint64 nowMs)
+{
+    auto it = m_live.find(seq);
+    if (it == m_live.end()) return false;
+    if (it->t[s] < 0) it->t[s] = nowMs;     // 첫 기록만 유지
+    return true;
+}
+
+bool CommandTracker::markRobot(int robot, Stage s, qint64 nowMs, quint32* seq)
+{
+    Entry* best = nullptr;
+    for (auto it = m_live.begin(); it != m_live.end(); ++it) {
+        if (it->robot != robot || it->t[s] >= 0) continue;
+        if (!best || it->order < best->order) best = &it.value();
+    }
+    if (!best) return false;
+    best->t[s] = nowMs;
+    if (seq) *seq = best->seq;
+    return true;
+}
+
+const CommandTracker::Entry* CommandTracker::active(int robot, CmdType type, CmdKind kind) const
+{
+    const Entry* best = nullptr;
+    for (auto it = m_live.cbegin(); it != m_live.cend(); ++it) {
+        if (it->robot != robot) continue;
+        if (type != CmdType::Unknown && it->type != type) continue;
+        if (kind != CmdKind::Unknown && it->kind != kind) continue;
+        if (!best || it->order < best->order) best = &it.value();
+    }
+    return best;
+}
+
+const CommandTracker::Entry* CommandTracker::last(int robot) const
+{
+    if (robot < 0 || robot >= kMaxRobots || m_last[robot].order == 0) return nullptr;
+    return &m_last[robot];
+}
+
+bool CommandTracker::finish(quint32 seq, qint64 nowMs, bool ok, Entry* out)
+{
+    auto it = m_live.find(seq);
+    if (it == m_live.end()) return false;
+    Entry e = it.value();
+    m_live.erase(it);
+    e.t[Done] = nowMs;
+    if (ok) {
+        ++m_completed;
+        record(e);
+    } else {
+        ++m_failed;
+    }
+    if (out) *out = e;
+    return true;
+}
+
+int CommandTracker::expire(qint64 nowMs, QVector<Entry>* expired)
+{
+    if (m_timeoutMs <= 0) return 0;
+    int n = 0;
+    for (auto it = m_live.begin(); it != m_live.end(); ) {
+        if (nowMs - it->t[Rx] > m_timeoutMs) {
+            if (expired) expired->push_back(it.value());
+            it = m_live.erase(it);
+            ++n;
+        } else {
+            ++it;
+        }
+    }
+    m_timeouts += quint64(n);
+    return n;
+}
+
+// 구간: 직전에 찍힌 단계 → 이 단계 (빠진 단계는 건너뜀)
+void CommandTracker::record(const Entry& e)
+{
+    auto& h = m_hist[int(e.type)][int(e.kind)];
+    qint64 prev = e.t[Rx];
+    for (int s = Ack; s < StageCount; ++s) {
+        if (e.t[s] < 0) continue;
+        h[s].add(e.t[s] - prev);
+        prev = e.t[s];
+    }
+    h[Rx].add(e.t[Done] - e.t[Rx]);
+}
+
+QJsonObject CommandTracker::toJson() const
+{
+    QJsonArray bounds;
+    for (qint64 b : kBounds) bounds.append(double(b));
+
+    QJsonObject cmds;
+    for (int t = 0; t < kTypes; ++t) {
+        for (int k = 0; k < kKinds; ++k) {
+            const auto& h = m_hist[t][k];
+            if (h[Rx].count == 0) continue;
+
+            QJsonObject segs;
+            for (int s = 0; s < StageCount; ++s) {
+                const Histogram& x = h[s];
+                if (x.count == 0) continue;
+                QJsonArray bins;
+                for (quint32 c : x.bins) bins.append(double(c));
+                segs.insert(s == Rx ? QStringLiteral("total") : QString::fromLatin1(stageName(Stage(s))),
+                            QJsonObject{
+                                {"count",   double(x.count)},
+                                {"mean_ms", double(x.sumMs) / x.count},
+                                {"max_ms",  double(x.maxMs)},
+                                {"p50_ms",  double(x.percentile(0.50))},
+                                {"p95_ms",  double(x.percentile(0.95))},
+                                {"p99_ms",  double(x.percentile(0.99))},
+                                {"bins",    bins}
+                            });
+            }
+            const char* tn = RobotCommandParser::typeName(CmdType(t));
+            const char* kn = RobotCommandParser::kindName(CmdKind(k));
+            cmds.insert(QString("%1.%2").arg(*tn ? tn : "unknown", *kn ? kn : "unknown"), segs);
+        }
+    }
+
+    return QJsonObject{
+        {"bounds_ms", bounds},
+        {"completed", double(m_completed)},
+        {"failed",    double(m_failed)},
+        {"timeouts",  double(m_timeouts)},
+        {"in_flight", m_live.size()},
+        {"commands",  cmds}
+    };
+}
+
+void CommandTracker::resetStats()
+{
+    for (auto& byType : m_hist)
+        for (auto& byKind : byType)
+            for (auto& h : byKind)
+                h = Histogram{};
+    m_completed = m_failed = m_timeouts = 0;
+}
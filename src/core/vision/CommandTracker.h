@@ -0,0 +1,96 @@
+#ifndef COMMANDTRACKER_H
+#define COMMANDTRACKER_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QVector>
+
+#include "RobotCommand.h"
+
+// ─────────────────────────────────────────────────────────────
+// 비전 명령 진행 표 (seq 키) + 구간별 지연 히스토그램
+//
+// 명령 하나의 경로:
+//   Rx(수신) → Ack(응답) → Trigger(모드버스 코일 기록 완료) → Busy(BUSY↑)
+//   → Pulse(완료 펄스) → Done(work/tool complete 송신)
+//
+// - 각 단계 시각은 단조 시계(ms)로 기록, 찍히지 않은 단계는 -1.
+// - Trigger/Busy/Pulse 는 로봇 단위로만 알 수 있으므로, 해당 로봇에서
+//   그 단계를 아직 지나지 않은 가장 오래된 명령에 찍는다.
+// - 완료는 로봇 + type/kind 로 가장 오래된 명령을 찾으므로 순서가 뒤바뀐 완료도 맞는 seq 로 간다.
+// - 타임아웃(기본 60s)이 지나도록 완료되지 않은 명령은 expire() 에서 빠지고 따로 센다.
+// - 히스토그램은 [type][kind][구간] 별 고정 경계 버킷. 구간 = 직전 기록 단계 → 해당 단계, total = Rx → Done.
+// ─────────────────────────────────────────────────────────────
+class CommandTracker
+{
+public:
+    enum Stage : int { Rx, Ack, Trigger, Busy, Pulse, Done, StageCount };
+
+    struct Entry {
+        quint32 seq = 0;
+        int robot = -1;                 // robotIndex()
+        CmdType type = CmdType::Unknown;
+        CmdKind kind = CmdKind::Unknown;
+        qint64 t[StageCount] = {-1, -1, -1, -1, -1, -1};
+        quint64 order = 0;              // 수신 순서 (같은 로봇 안에서 가장 오래된 것 찾기)
+    };
+
+    static const char* stageName(Stage s);
+
+    void setTimeout(int ms) { m_timeoutMs = ms; }
+    int timeout() const { return m_timeoutMs; }
+
+    // 수신: 같은 seq 가 진행 중이면 새 명령으로 덮어쓴다 (재전송/seq 재사용)
+    void begin(const RobotCommand& cmd, qint64 nowMs);
+
+    // seq 로 단계 기록 (Ack). 없는 seq 면 false
+    bool mark(quint32 seq, Stage s, qint64 nowMs);
+    // 로봇 단위 단계 기록 (Trigger/Busy/Pulse). 찍힌 명령의 seq, 없으면 false
+    bool markRobot(int robot, Stage s, qint64 nowMs, quint32* seq = nullptr);
+
+    // 로봇의 진행 중 명령 중 가장 오래된 것 (type/kind 가 Unknown 이면 조건 없음)
+    const Entry* active(int robot, CmdType type = CmdType::Unknown, CmdKind kind = CmdKind::Unknown) const;
+    // 로봇에 마지막으로 들어온 명령 (완료 후에도 남음, 에러 보고용)
+    const Entry* last(int robot) const;
+    bool busy(int robot) const { return active(robot) != nullptr; }
+    int inFlight() const { return m_live.size(); }
+
+    // 완료(ok) 또는 실패: 표에서 빼고 히스토그램에 반영. out 으로 최종 기록 반환
+    bool finish(quint32 seq, qint64 nowMs, bool ok, Entry* out = nullptr);
+    // timeout 이 지난 명령 제거 (히스토그램에는 넣지 않음)
+    int expire(qint64 nowMs, QVector<Entry>* expired = nullptr);
+
+    // {"bounds_ms":[..], "completed":n, "failed":n, "timeouts":n, "in_flight":n,
+    //  "commands":{"bulk.pick":{"total":{"count","mean_ms","max_ms","p50_ms","p95_ms","p99_ms","bins":[..]}, "ack":{..}, ..}}}
+    QJsonObject toJson() const;
+    void resetStats();
+
+private:
+    static constexpr int kBins = 16;
+    static constexpr int kTypes = int(CmdType::Unknown) + 1;
+    static constexpr int kKinds = int(CmdKind::Unknown) + 1;
+    static const qint64 kBounds[kBins - 1];     // 버킷 상한 (ms), 마지막 버킷은 그 이상
+
+    struct Histogram {
+        quint32 bins[kBins] = {};
+        quint32 count = 0;
+        qint64 sumMs = 0;
+        qint64 maxMs = 0;
+        void add(qint64 ms);
+        qint64 percentile(double p) const;
+    };
+    // [type][kind][Stage] : Rx 칸은 total(Rx → Done) 용
+    Histogram m_hist[kTypes][kKinds][StageCount];
+
+    void record(const Entry& e);
+
+    QHash<quint32, Entry> m_live;
+    Entry m_last[kMaxRobots];
+    quint64 m_order = 0;
+    int m_timeoutMs = 60000;
+    quint64 m_completed = 0;
+    quint64 m_failed = 0;
+    quint64 m_timeouts = 0;
+};
+
+#endif // COMMANDTRACKER_H
@@ -0,0 +1,260 @@
+#include "RobotStatePublisher.h"
+#include "JsonTemplate.h"
+#include "MonoClock.h"
+
+#include <QJsonArray>
+#include <cmath>
+
+namespace {
+
+// 프레임 키는 QJsonObject 와 같은 사전순으로 쓴다
+const char* const kFieldKey[RobotStatePublisher::FieldCount] = {
+    "\"x\":", "\"y\":", "\"z\":", "\"rx\":", "\"ry\":", "\"rz\":",
+    "\"j1\":", "\"j2\":", "\"j3\":", "\"j4\":", "\"j5\":", "\"j6\":"
+};
+const char* const kFieldName[RobotStatePublisher::FieldCount] = {
+    "x", "y", "z", "rx", "ry", "rz", "j1", "j2", "j3", "j4", "j5", "j6"
+};
+constexpr int kFixedKeys = 5;   // key, robot, seq, t, type
+
+constexpr int kFrameReserve = 320;
+
+} // namespace
+
+RobotStatePublisher::RobotStatePublisher(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &RobotStatePublisher::onTick);
+}
+
+RobotStatePublisher::Options RobotStatePublisher::parseOptions(const QJsonObject& o)
+{
+    Options opt;
+    opt.hz = qBound(1, o.value("hz").toInt(opt.hz), kMaxHz);
+    opt.keyframeMs = qMax(0, o.value("keyframe_ms").toInt(opt.keyframeMs));
+
+    const QJsonObject db = o.value("deadband").toObject();
+    opt.deadband.pos   = qMax(0.0, db.value("pos").toDouble(opt.deadband.pos));
+    opt.deadband.rot   = qMax(0.0, db.value("rot").toDouble(opt.deadband.rot));
+    opt.deadband.joint = qMax(0.0, db.value("joint").toDouble(opt.deadband.joint));
+
+    const QJsonValue robots = o.value("robots");
+    if (robots.isArray()) {
+        for (const auto& v : robots.toArray())
+            if (v.isString()) opt.robots << v.toString().toLower();
+    } else if (robots.isString()) {
+        opt.robots << robots.toString().toLower();
+    }
+    return opt;
+}
+
+int RobotStatePublisher::subscribe(const Options& opt, Write write, Ready ready, Format format)
+{
+    if (!write) return 0;
+    Sub s;
+    s.id = m_nextId++;
+    s.opt = opt;
+    s.opt.hz = qBound(1, opt.hz, kMaxHz);
+    s.write = std::move(write);
+    s.ready = std::move(ready);
+    s.format = std::move(format);
+    s.periodMs = qMax<qint64>(kMinPeriodMs, 1000 / s.opt.hz);
+    s.nextMs = MonoClock::nowMs();
+    m_subs.push_back(std::move(s));
+    armTimer();
+    return m_subs.last().id;
+}
+
+void RobotStatePublisher::unsubscribe(int id)
+{
+    for (int i = 0; i < m_subs.size(); ++i) {
+        if (m_subs[i].id == id) {
+            m_subs.removeAt(i);
+            break;
+        }
+    }
+    armTimer();
+}
+
+void RobotStatePublisher::update(const QString& robot, const Pose6D& tcp, const Pose6D& joints)
+{
+    Sample& s = m_latest[robot.toLower()];
+    s.v[X]  = tcp.x;    s.v[Y]  = tcp.y;    s.v[Z]  = tcp.z;
+    s.v[Rx] = tcp.rx;   s.v[Ry] = tcp.ry;   s.v[Rz] = tcp.rz;
+    s.v[J1] = joints.x; s.v[J2] = joints.y; s.v[J3] = joints.z;
+    s.v[J4] = joints.rx; s.v[J5] = joints.ry; s.v[J6] = joints.rz;
+    s.tMs = MonoClock::nowMs();
+    ++s.n;
+    armTimer();
+}
+
+// 구독 대상 로봇 중 아직 평가하지 않은 샘플이 있는지
+bool RobotStatePublisher::hasFresh(const Sub& s) const
+{
+    for (auto it = m_latest.cbegin(); it != m_latest.cend(); ++it) {
+        if (!s.opt.robots.isEmpty() && !s.opt.robots.contains(it.key())) continue;
+        if (s.sent.value(it.key()).n != it->n) return true;
+    }
+    return false;
+}
+
+// 새 샘플이 있는 구독자 중 가장 이른 nextMs 에 단발로 맞춘다. 이미 더 이르게 맞춰 있으면 그대로
+void RobotStatePublisher::armTimer()
+{
+    qint64 due = -1;
+    for (const Sub& s : m_subs)
+        if ((due < 0 || s.nextMs < due) && hasFresh(s))
+            due = s.nextMs;
+
+    if (due < 0) {
+        m_timer.stop();
+        m_armedMs = -1;
+        return;
+    }
+    if (m_timer.isActive() && m_armedMs <= due)
+        return;
+    m_armedMs = due;
+    m_timer.start(int(qBound<qint64>(0, due - MonoClock::nowMs(), 1000)));
+}
+
+void RobotStatePublisher::onTick()
+{
+    const qint64 now = MonoClock::nowMs();
+
+    for (int i = 0; i < m_subs.size(); ++i) {
+        Sub& s = m_subs[i];
+        if (now < s.nextMs || !hasFresh(s)) continue;
+
+        // 송신 측이 밀려 있으면 이번 회차는 건너뜀 → kRetryMs 뒤 그때의 최신값 (쌓지 않음)
+        if (s.ready && !s.ready()) {
+            ++s.conflated;
+            s.nextMs = now + kRetryMs;
+            continue;
+        }
+
+        for (auto it = m_latest.cbegin(); it != m_latest.cend(); ++it) {
+            if (!s.opt.robots.isEmpty() && !s.opt.robots.contains(it.key())) continue;
+            if (s.sent.value(it.key()).n != it->n)
+                publish(s, it.key(), *it, now);
+        }
+        s.nextMs += s.periodMs;
+        if (s.nextMs <= now) s.nextMs = now + s.periodMs;
+    }
+
+    // 새 샘플이 없으면 update() 까지 깨어나지 않는다
+    armTimer();
+}
+
+bool RobotStatePublisher::publish(Sub& s, const QString& robot, const Sample& smp, qint64 now)
+{
+    Sent& st = s.sent[robot];
+    st.n = smp.n;
+
+    const bool key = st.keyMs < 0 || (s.opt.keyframeMs > 0 && now - st.keyMs >= s.opt.keyframeMs);
+    bool send[FieldCount];
+    bool any = false;
+    for (int f = 0; f < FieldCount; ++f) {
+        const double db = f < Rx ? s.opt.deadband.pos
+                        : f < J1 ? s.opt.deadband.rot
+                                 : s.opt.deadband.joint;
+        send[f] = key || std::fabs(smp.v[f] - st.v[f]) > db;
+        any |= send[f];
+    }
+    if (!any) {
+        ++s.suppressed;
+        return false;
+    }
+
+    const WireFormat::Proto proto = s.format ? s.format() : WireFormat::Proto::Json;
+    QByteArray frame;
+    frame.reserve(kFrameReserve);
+    if (proto == WireFormat::Proto::Cbor) {
+        if (!writeCbor(frame, robot, smp, send, key, s.seq + 1))
+            return false;
+    } else {
+        writeJson(frame, robot, smp, send, key, s.seq + 1);
+    }
+    ++s.seq;
+    for (int f = 0; f < FieldCount; ++f)
+        if (send[f]) st.v[f] = smp.v[f];     // 델타 기준은 실제로 보낸 값
+
+    if (key) st.keyMs = now;
+    ++s.frames;
+    s.write(frame, proto);
+    return true;
+}
+
+// 키는 QJsonObject 와 같은 사전순: j1..j6, key, robot, rx..rz, seq, t, type, x..z
+void RobotStatePublisher::writeJson(QByteArray& line, const QString& robot, const Sample& smp,
+                                    const bool* send, bool key, quint64 seq)
+{
+    line.append('{');
+    auto field = [&](int f) {
+        if (!send[f]) return;
+        line.append(kFieldKey[f]);
+        JsonText::appendDouble(line, smp.v[f]);
+        line.append(',');
+    };
+    for (int f = J1; f <= J6; ++f) field(f);
+    line.append("\"key\":");
+    JsonText::appendBool(line, key);
+    line.append(",\"robot\":");
+    JsonText::appendString(line, robot);
+    line.append(',');
+    field(Rx); field(Ry); field(Rz);
+    line.append("\"seq\":");
+    JsonText::appendInt(line, qint64(seq));
+    line.append(",\"t\":");
+    JsonText::appendInt(line, smp.tMs);
+    line.append(",\"type\":\"state\",");
+    field(X); field(Y); field(Z);
+    line[line.size() - 1] = '}';
+    line.append('\n');
+}
+
+// 같은 키 순서의 CBOR map (WireFormat::encode 로 만든 것과 같은 바이트)
+bool RobotStatePublisher::writeCbor(QByteArray& frame, const QString& robot, const Sample& smp,
+                                    const bool* send, bool key, quint64 seq)
+{
+    int pairs = kFixedKeys;
+    for (int f = 0; f < FieldCount; ++f) pairs += send[f];
+
+    WireFormat::beginBinary(frame);
+    CborText::appendMap(frame, pairs);
+    auto field = [&](int f) {
+        if (!send[f]) return;
+        CborText::appendLatin1(frame, kFieldName[f]);
+        CborText::appendDouble(frame, smp.v[f]);
+    };
+    for (int f = J1; f <= J6; ++f) field(f);
+    CborText::appendLatin1(frame, "key");
+    CborText::appendBool(frame, key);
+    CborText::appendLatin1(frame, "robot");
+    CborText::appendString(frame, robot);
+    field(Rx); field(Ry); field(Rz);
+    CborText::appendLatin1(frame, "seq");
+    CborText::appendInt(frame, qint64(seq));
+    CborText::appendLatin1(frame, "t");
+    CborText::appendInt(frame, smp.tMs);
+    CborText::appendLatin1(frame, "type");
+    CborText::appendLatin1(frame, "state");
+    field(X); field(Y); field(Z);
+    return WireFormat::finishBinary(frame);
+}
+
+QJsonObject RobotStatePublisher::stats() const
+{
+    QJsonArray subs;
+    for (const Sub& s : m_subs) {
+        subs.append(QJsonObject{
+            {"id", s.id},
+            {"hz", s.opt.hz},
+            {"frames", double(s.frames)},
+            {"suppressed", double(s.suppressed)},
+            {"conflated", double(s.conflated)},
+        });
+    }
+    return QJsonObject{{"robots", m_latest.size()}, {"subscribers", subs}};
+}
@@ -0,0 +1,121 @@
+#ifndef ROBOTSTATEPUBLISHER_H
+#define ROBOTSTATEPUBLISHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+
+#include "Pose6D.h"
+#include "WireFormat.h"
+
+// ─────────────────────────────────────────────────────────────
+// 로봇 TCP/관절 상태 발행 (구독자별 주기 + 데드밴드 + 최신값 병합)
+//
+//  - update(): Orchestrator::kinematicsUpdated 마다 로봇별 최신 샘플만 덮어쓴다 (송신 없음).
+//  - 구독자마다 주기(1..200 Hz)를 고르고, 주기가 돌아오면 새 샘플이 있을 때만 한 프레임을 만든다.
+//  - 마지막으로 보낸 값 대비 데드밴드 안에서 움직인 필드는 빼고 보낸다. 바뀐 필드가 없으면 프레임 없음.
+//    keyframeMs 마다(와 구독 직후) 전체 필드를 보낸다 (key:true).
+//  - 프레임은 구독자의 format() 형식으로 바로 만든다 (json 한 줄 / cbor1 프레임 — JSON 텍스트를 되읽지 않음).
+//  - 타이머는 새 샘플이 있는 구독자 중 가장 이른 nextMs 에 한 번만 울린다 (고정 주기 틱 없음, 보낼 게 없으면 정지).
+//  - 구독자의 ready() 가 false(송신 버퍼가 밀림)면 그 회차는 건너뛰고 kRetryMs 뒤에 그때의 최신값을 보낸다.
+//    밀린 프레임을 쌓지 않으므로 델타 기준(마지막 송신 값)이 어긋나지 않는다.
+//
+// 프레임 (키 사전순, 바뀐 필드만):
+//   {"j1"..,"key":false,"robot":"a","rx"..,"seq":n,"t":mono_ms,"type":"state","x"..}
+//   seq = 구독자별 프레임 번호, t = 샘플 시각 (단조 시계 ms, 부팅 기준)
+//
+// 구독 요청 (parseOptions):
+//   {"type":"subscribe","stream":"state","hz":50,"robots":["a"],
+//    "deadband":{"pos":0.05,"rot":0.05,"joint":0.05},"keyframe_ms":1000}
+// ─────────────────────────────────────────────────────────────
+class RobotStatePublisher : public QObject
+{
+    Q_OBJECT
+public:
+    enum Field { X, Y, Z, Rx, Ry, Rz, J1, J2, J3, J4, J5, J6, FieldCount };
+
+    struct Deadband {
+        double pos = 0.01;      // mm (x,y,z)
+        double rot = 0.01;      // deg (rx,ry,rz)
+        double joint = 0.01;    // deg (j1..j6)
+    };
+    struct Options {
+        int hz = 10;
+        Deadband deadband;
+        int keyframeMs = 1000;  // 0: 구독 직후 한 번만
+        QStringList robots;     // 소문자 id, 비어 있으면 전체
+    };
+
+    // 완성된 송신 프레임 (json: '\n' 포함 한 줄, cbor1: 헤더 포함)
+    using Write  = std::function<void(const QByteArray& frame, WireFormat::Proto proto)>;
+    using Ready  = std::function<bool()>;                  // 지금 보내도 밀리지 않는지
+    using Format = std::function<WireFormat::Proto()>;     // 지금 협상된 형식 (없으면 json)
+
+    explicit RobotStatePublisher(QObject* parent = nullptr);
+
+    // 구독 요청 JSON → Options (모르는 필드는 무시, 범위 밖 값은 잘라냄)
+    static Options parseOptions(const QJsonObject& o);
+
+    int  subscribe(const Options& opt, Write write, Ready ready = Ready(), Format format = Format());
+    void unsubscribe(int id);
+    int  subscriberCount() const { return m_subs.size(); }
+
+    void update(const QString& robot, const Pose6D& tcp, const Pose6D& joints);
+
+    // 구독자별 frames/suppressed/conflated 카운터
+    QJsonObject stats() const;
+
+private slots:
+    void onTick();
+
+private:
+    static constexpr int kMinPeriodMs = 5;
+    static constexpr int kMaxHz = 1000 / kMinPeriodMs;
+    static constexpr int kRetryMs = kMinPeriodMs;      // ready()=false 후 다시 볼 때까지
+
+    struct Sample {
+        double v[FieldCount] = {};
+        qint64 tMs = 0;
+        quint64 n = 0;          // 샘플 번호 (새 값 판별)
+    };
+    struct Sent {
+        double v[FieldCount] = {};
+        quint64 n = 0;          // 마지막으로 평가한 샘플 번호
+        qint64 keyMs = -1;      // 마지막 키프레임 시각 (-1: 아직 없음)
+    };
+    struct Sub {
+        int id = 0;
+        Options opt;
+        Write write;
+        Ready ready;
+        Format format;
+        qint64 periodMs = 100;
+        qint64 nextMs = 0;
+        quint64 seq = 0;
+        QHash<QString, Sent> sent;
+        quint64 frames = 0;
+        quint64 suppressed = 0;     // 데드밴드 안이라 보내지 않은 샘플
+        quint64 conflated = 0;      // ready()=false 로 건너뛴 회차
+    };
+
+    bool publish(Sub& s, const QString& robot, const Sample& smp, qint64 now);
+    static void writeJson(QByteArray& line, const QString& robot, const Sample& smp,
+                          const bool* send, bool key, quint64 seq);
+    static bool writeCbor(QByteArray& frame, const QString& robot, const Sample& smp,
+                          const bool* send, bool key, quint64 seq);
+    bool hasFresh(const Sub& s) const;
+    void armTimer();
+
+    QTimer m_timer;                     // 단발, 가장 이른 송신 시각에 맞춤
+    qint64 m_armedMs = -1;              // 타이머가 겨냥한 시각 (단조 ms)
+    QHash<QString, Sample> m_latest;    // 소문자 로봇 id → 최신 샘플
+    QVector<Sub> m_subs;
+    int m_nextId = 1;
+};
+
+#endif // ROBOTSTATEPUBLISHER_H
@@ -2,9 +2,58 @@
 
 #include <QJsonDocument>
 #include <QDateTime>
+#include <QFile>
 #include <QHostAddress>
+#include <QMetaMethod>
+#include <QRandomGenerator>
 
+#include <limits>
+
+#include "EventTrace.h"
+#include "MonoClock.h"
+#include "JsonTemplate.h"
+#include "LogCategories.h"
 #include "RobotCommandParser.h"
+#include "RobotStatePublisher.h"
+#include "WireFormat.h"
+
+// 송신 메시지 형태 (키는 QJsonObject 와 같은 사전순 → toJson(Compact) 와 같은 바이트)
+namespace {
+const JsonTemplate kFeedbackPose(
+    R"({"dir":11,"kind":"moving","robot":%s,"seq":%d,"tool":{"from":%s,"to":%s},"type":"tool"})");
+const JsonTemplate kWorkComplete(
+    R"({"dir":11,"error_code":0,"kind":%s,"robot":%s,"seq":%d,"success":true,"type":%s})");
+const JsonTemplate kWorkCompleteClamp(
+    R"({"clamp":%s,"dir":11,"error_code":0,"kind":%s,"robot":%s,"seq":%d,"success":true,"type":%s})");
+const JsonTemplate kToolComplete(
+    R"({"dir":11,"error_code":0,"kind":%s,"robot":%s,"seq":%d,"success":true,"tool":%r,"type":"tool"})");
+const JsonTemplate kToolName(R"({"name":%s})");
+const JsonTemplate kToolFromTo(R"({"from":%s,"to":%s})");
+const JsonTemplate kError(
+    R"({"dir":11,"error":{"error":%s,"main":%d,"sub":%d},"error_code":1,"kind":%s,"robot":%s,"seq":%d,"type":%s})");
+
+constexpr int kLineReserve = 192;   // 위 메시지 한 줄이 재할당 없이 들어가는 크기
+} // namespace
+
+// 템플릿 메시지 한 건을 협상된 형식으로 바로 만든다 (cbor1 은 renderCbor — JSON 텍스트를 거치지 않음)
+template <typename... Args>
+void VisionClient::enqueueTemplate(const JsonTemplate& t, const Args&... args)
+{
+    QByteArray frame;
+    frame.reserve(kLineReserve);
+    if (m_txProto == WireFormat::Proto::Json) {
+        t.render(frame, args...);
+        frame.append('\n');
+    } else {
+        WireFormat::beginBinary(frame);
+        t.renderCbor(frame, args...);
+        if (!WireFormat::finishBinary(frame)) {
+            emit log(QString("[WARN] VisionClient message too large for cbor1 (%1 bytes), dropped").arg(frame.size()));
+            return;
+        }
+    }
+    enqueueFrame(frame, m_txProto);
+}
 
 static QString cmdTypeToString(CmdType t)
 {
@@ -42,32 +91,119 @@ VisionClient::VisionClient(QObject* parent)
     connect(m_sock, &QTcpSocket::connected,    this, &VisionClient::onConnected);
     connect(m_sock, &QTcpSocket::disconnected, this, &VisionClient::onDisconnected);
     connect(m_sock, &QTcpSocket::readyRead,    this, &VisionClient::onReadyRead);
+    connect(m_sock, &QTcpSocket::errorOccurred, this, &VisionClient::onSocketError);
+    connect(m_sock, &QTcpSocket::bytesWritten, this, [this]{
+        if (!m_jsonQueue.isEmpty()) scheduleTx();
+    });
+
+    m_jsonTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_jsonTimer, &QTimer::timeout, this, &VisionClient::onTxJson);
+
+    m_connectTimer.setSingleShot(true);
+    connect(&m_connectTimer, &QTimer::timeout, this, [this]{
+        if (m_sock->state() == QAbstractSocket::ConnectedState) return;
+        m_sock->abort();
+        scheduleReconnect("connect timeout");
+    });
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &VisionClient::startConnect);
+    connect(&m_heartbeatTimer, &QTimer::timeout, this, &VisionClient::onHeartbeatTick);
+
+    m_traceTimer.setInterval(1000);
+    connect(&m_traceTimer, &QTimer::timeout, this, &VisionClient::onTraceTick);
 }
 
 VisionClient::~VisionClient()
 {
+    dropStateSubscription();    // 발행자가 이 객체를 가리키는 콜백을 들고 있지 않게
     disconnectFrom();
 }
 
 bool VisionClient::connectTo(const QString& host, quint16 port)
 {
-    if (m_sock->state() == QAbstractSocket::ConnectedState)
-        return true;
-
-    m_sock->connectToHost(host, port);
-    if (!m_sock->waitForConnected(2000)) {
-        emit log(QString("[ERR] Connect failed: %1").arg(m_sock->errorString()));
+    if (host.isEmpty() || port == 0) {
+        emit log("[ERR] VisionClient: invalid host or port");
         return false;
     }
+    if (m_sock->state() == QAbstractSocket::ConnectedState && host == m_host && port == m_port)
+        return true;
 
-    emit log(QString("[OK] Connected to VisionServer %1:%2").arg(host).arg(port));
+    m_host = host;
+    m_port = port;
+    m_autoReconnect = true;
+    m_backoffMs = kBackoffMinMs;
+    m_reconnectTimer.stop();
+    if (m_sock->state() != QAbstractSocket::UnconnectedState)
+        m_sock->abort();
+    startConnect();
     return true;
 }
 
+void VisionClient::startConnect()
+{
+    if (m_host.isEmpty() || m_sock->state() != QAbstractSocket::UnconnectedState)
+        return;
+    emit log(QString("[NET] Connecting to VisionServer %1:%2 ...").arg(m_host).arg(m_port));
+    m_sock->connectToHost(m_host, m_port);
+    m_connectTimer.start(kConnectTimeoutMs);
+}
+
+void VisionClient::scheduleReconnect(const QString& why)
+{
+    m_connectTimer.stop();
+    if (!m_autoReconnect || m_reconnectTimer.isActive())
+        return;
+    // 지터 ±20% 로 여러 클라이언트가 동시에 붙는 것을 피함
+    const int jitter = int(QRandomGenerator::global()->bounded(m_backoffMs / 5 + 1));
+    const int wait = m_backoffMs - m_backoffMs / 10 + jitter;
+    emit log(QString("[NET] VisionClient %1, retry in %2 ms").arg(why).arg(wait));
+    m_reconnectTimer.start(wait);
+    m_backoffMs = qMin(m_backoffMs * 2, kBackoffMaxMs);
+}
+
 void VisionClient::disconnectFrom()
 {
+    m_autoReconnect = false;
+    m_reconnectTimer.stop();
+    m_connectTimer.stop();
+    m_heartbeatTimer.stop();
     if (m_sock->state() == QAbstractSocket::ConnectedState)
         m_sock->disconnectFromHost();
+    else if (m_sock->state() != QAbstractSocket::UnconnectedState)
+        m_sock->abort();
+}
+
+void VisionClient::setHeartbeat(int intervalMs, int peerTimeoutMs)
+{
+    m_heartbeatMs = qMax(0, intervalMs);
+    m_peerTimeoutMs = qMax(0, peerTimeoutMs);
+    m_heartbeatTimer.stop();
+
+    int period = m_heartbeatMs;
+    if (m_peerTimeoutMs > 0 && (period == 0 || m_peerTimeoutMs < period))
+        period = m_peerTimeoutMs;
+    if (isConnected() && period > 0)
+        m_heartbeatTimer.start(qMax(100, period / 2));
+}
+
+void VisionClient::setOutboxLimits(int maxMessages, int ttlMs)
+{
+    m_outboxMax = qMax(1, maxMessages);
+    m_outboxTtlMs = qMax(0, ttlMs);
+}
+
+void VisionClient::onHeartbeatTick()
+{
+    if (!isConnected())
+        return;
+    const qint64 now = MonoClock::nowMs();
+    if (m_peerTimeoutMs > 0 && now - m_lastRxMs > m_peerTimeoutMs) {
+        emit log(QString("[WARN] VisionClient: no data for %1 ms, reconnecting").arg(now - m_lastRxMs));
+        m_sock->abort();   // → disconnected → 재연결
+        return;
+    }
+    if (m_heartbeatMs > 0 && now - m_lastTxMs >= m_heartbeatMs && m_jsonQueue.isEmpty())
+        enqueueMessage(QJsonObject{{"type", "heartbeat"}, {"dir", 11}});
 }
 
 void VisionClient::sendPose(const PickPose& p, const QString& kind, const int dir, const int id, quint32 seq, int speed_pct)
@@ -94,6 +230,7 @@ void VisionClient::sendAck(quint32 seq, const QString& status, const QString& ms
         {"status", status}
     };
     if (!msg.isEmpty()) o["message"] = msg;
+    m_tracker.mark(seq, CommandTracker::Ack, MonoClock::nowMs());
 
     const QByteArray json = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
 //    enqueueJson(json);
@@ -104,21 +241,8 @@ void VisionClient::sendFeedbackPose(const QString& robot, const QString& from, c
     if (robot.isEmpty())
         return;
 
-    QJsonObject o{
-        {"robot", robot.toLower()},
-        {"type", "tool"},
-        {"kind","moving"},
-        {"tool", QJsonObject {
-            {"from", from},
-            {"to", to}
-        }},
-        {"seq", static_cast<int>(seq)},
-        {"dir", 11}
-    };
-
-    const QByteArray json = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    qDebug()<<QDateTime::currentDateTime()<<QString("VisionClient::sendFeedbackPose json: %1").arg(QString::fromUtf8(json).trimmed());
-    enqueueJson(json);
+    qCDebug(lcVision) << "VisionClient::sendFeedbackPose" << robot << from << to << seq;
+    enqueueTemplate(kFeedbackPose, robot.toLower(), static_cast<int>(seq), from, to);
 }
 
 void VisionClient::sendWorkComplete(const QString& robot, const QString& type, const QString& kind, quint32 seq, bool clampState)
@@ -126,31 +250,29 @@ void VisionClient::sendWorkComplete(const QString& robot, const QString& type, c
     if (robot.isEmpty() || kind.isEmpty())
         return;
 
-    QJsonObject o{
-        {"robot", robot.toLower()},
-        {"type", type},
-        {"kind", kind},
-        {"success", true},
-        {"error_code", 0},
-        {"seq", static_cast<int>(seq)},
-        {"dir",  11}
-    };
-    if (robot.toLower()=="b" && type == "align"&& kind == "clamp") {
-        o["clamp"] = clampState ? "close" : "open";
-        qDebug()<<QDateTime::currentDateTime()<<QString("VisionClient::sendWorkComplete clamp state: %1").arg(clampState?"close":"open");
+    // seq 없이 오는 완료(펄스 경로)는 같은 로봇·type/kind 의 가장 오래된 진행 중 명령으로 귀속.
+    // 모르는 type/kind(예: "idle")는 어떤 명령도 완료시키지 않는다.
+    const int ri = robotIndex(robot);
+    if (seq == 0 && ri >= 0) {
+        const CmdType t = RobotCommandParser::typeFromName(type);
+        const CmdKind k = RobotCommandParser::kindFromName(kind);
+        if (t != CmdType::Unknown && k != CmdKind::Unknown)
+            if (const auto* e = m_tracker.active(ri, t, k))
+                seq = e->seq;
     }
-    const QByteArray json = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    qDebug()<<QDateTime::currentDateTime()<<QString("VisionClient::sendWorkComplete json: %1").arg(QString::fromUtf8(json).trimmed());
 
-    enqueueJson(json);
-    if(robot.toLower()=="a")
-    {
-        isMotion_[0]=false;
-    }
-    else if(robot.toLower()=="b")
-    {
-        isMotion_[1]=false;
+    if (type == "align" && kind == "clamp") {   // 얼라인 셀 로봇 (id 무관)
+        enqueueTemplate(kWorkCompleteClamp, clampState ? "close" : "open", kind, robot.toLower(), static_cast<int>(seq), type);
+        qCDebug(lcVision) <<QString("VisionClient::sendWorkComplete clamp state: %1").arg(clampState?"close":"open");
+    } else {
+        enqueueTemplate(kWorkComplete, kind, robot.toLower(), static_cast<int>(seq), type);
     }
+    qCInfo(lcVision) << "VisionClient::sendWorkComplete" << robot << type << kind << seq;
+
+    if (EventTrace::enabled())
+        EventTrace::visionTx(ri, seq, EventTrace::TxKind::WorkComplete,
+                             RobotCommandParser::typeFromName(type), RobotCommandParser::kindFromName(kind));
+    if (seq) finishTrace(seq);
 }
 
 void VisionClient::sendToolComplete(const QString& robot, quint32 seq, bool state)
@@ -161,44 +283,36 @@ void VisionClient::sendToolComplete(const QString& robot, quint32 seq, bool stat
     if (m_lastCmdKind == CmdKind::Unknown)
         return;
 
-    QString kind,name,from,to;
-    QJsonObject toolObj;
+    // "tool" 조각은 바깥 메시지와 같은 형식으로 만든다 (%r 자리에 그대로 들어감)
+    const bool cbor = m_txProto == WireFormat::Proto::Cbor;
+    QByteArray toolObj;
+    auto renderTool = [&](const JsonTemplate& t, const auto&... args) {
+        if (cbor) t.renderCbor(toolObj, args...);
+        else      t.render(toolObj, args...);
+    };
+    const char* kind = "";
     if (m_lastCmdKind == CmdKind::Tool_Mount){
         kind = "mount";
-        name = m_lastToolCmd.toolName;
-        toolObj["name"] = name;
+        renderTool(kToolName, m_lastToolCmd.toolName);
     }else if (m_lastCmdKind == CmdKind::Tool_UnMount){
         kind = "unmount";
-        name = m_lastToolCmd.toolName;
-        toolObj["name"] = name;
+        renderTool(kToolName, m_lastToolCmd.toolName);
     }else if (m_lastCmdKind == CmdKind::Tool_Change){
         kind = "change";
-        from = m_lastToolCmd.toolFrom;
-        to = m_lastToolCmd.toolTo;
-        toolObj["from"] = from;
-        toolObj["to"] = to;
+        renderTool(kToolFromTo, m_lastToolCmd.toolFrom, m_lastToolCmd.toolTo);
+    }else{
+        toolObj = cbor ? QByteArray(1, char(0xA0)) : QByteArray("{}");   // 빈 map
     }
 
-    QJsonObject o{
-        {"robot", robot.toLower()},
-        {"type", "tool"},
-        {"kind", kind},
-        {"tool", toolObj},
-        {"success", true},
-        {"error_code", 0},
-        {"seq", static_cast<int>(seq)},
-        {"dir",  11}
-    };
-    const QByteArray json = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    enqueueJson(json);
-    if(robot.toLower()=="a")
-    {
-        isMotion_[0]=false;
-    }
-    else if(robot.toLower()=="b")
-    {
-        isMotion_[1]=false;
-    }
+    const int ri = robotIndex(robot);
+    if (seq == 0 && ri >= 0)
+        if (const auto* e = m_tracker.active(ri, CmdType::Tool, m_lastCmdKind))
+            seq = e->seq;
+
+    enqueueTemplate(kToolComplete, kind, robot.toLower(), static_cast<int>(seq), JsonTemplate::Raw{toolObj});
+    if (EventTrace::enabled())
+        EventTrace::visionTx(ri, seq, EventTrace::TxKind::ToolComplete, CmdType::Tool, m_lastCmdKind);
+    if (seq) finishTrace(seq);
 }
 
 void VisionClient::sendError(const QString& robot, QString error, int code1, int code2)
@@ -208,170 +322,406 @@ void VisionClient::sendError(const QString& robot, QString error, int code1, int
 
     QString type, kind;
     quint32 seq{0};
+    CmdType cmdType = CmdType::Unknown;
+    CmdKind cmdKind = CmdKind::Unknown;
 
 
-    if(robot.toLower()=="a")
+    bool inFlight = false;   // 진행 중 명령에 귀속됐으면 실패로 마감
+    const int ri = robotIndex(robot);
+    if (ri >= 0)
     {
-        type = cmdTypeToString(lasCmd_[0].type);
-        kind = cmdKindToString(lasCmd_[0].kind);
-        seq = lasCmd_[0].seq;
-
-        if(error=="unreachable"&&!isMotion_[0])
-                return;
-    }
-    else if(robot.toLower()=="b")
-    {
-        type = cmdTypeToString(lasCmd_[1].type);
-        kind = cmdKindToString(lasCmd_[1].kind);
-        seq = lasCmd_[1].seq;
-
-        if(error=="unreachable"&&!isMotion_[1])
+        // 진행 중 명령(가장 오래된 것) → 없으면 마지막으로 받은 명령
+        const CommandTracker::Entry* e = m_tracker.active(ri);
+        if (error=="unreachable" && !e)
             return;
+        inFlight = e != nullptr;
+        if (!e) e = m_tracker.last(ri);
+        if (e) {
+            type = cmdTypeToString(e->type);
+            kind = cmdKindToString(e->kind);
+            seq = e->seq;
+            cmdType = e->type;
+            cmdKind = e->kind;
+        }
     }
-    QJsonObject o{
-        {"robot", robot.toLower()},
-        {"type", type},
-        {"kind", kind},
-        {"error_code", 1},
-        {"error", QJsonObject {
-            {"error", error},
-            {"main", code1},
-            {"sub", code2}
-        }},
-        {"seq", static_cast<int>(seq)},
-        {"dir",  11}
-    };
-    const QByteArray json = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    enqueueJson(json);
+    enqueueTemplate(kError, error, code1, code2, kind, robot.toLower(), static_cast<int>(seq), type);
+    if (EventTrace::enabled())
+        EventTrace::visionTx(ri, seq, EventTrace::TxKind::Error, cmdType, cmdKind);
+
+    // 실패한 명령을 진행 표에서 빼야 다음 완료가 새 seq 로 간다 (failed 로 집계)
+    if (inFlight && m_tracker.finish(seq, MonoClock::nowMs(), false))
+        emit log(QString("[TRACE] seq=%1 %2.%3 failed: %4").arg(seq).arg(type, kind, error));
 }
 
 void VisionClient::enqueueJson(const QByteArray& json)
 {
-    if (json.isEmpty())
+    enqueueFrame(json, WireFormat::Proto::Json);
+}
+
+void VisionClient::enqueueFrame(const QByteArray& data, WireFormat::Proto proto)
+{
+    if (data.isEmpty())
         return;
 
-    m_jsonQueue.enqueue(json);
+    if (m_jsonQueue.size() >= m_outboxMax) {
+        m_jsonQueue.dequeue();
+        if (m_outboxDropped++ % 100 == 0)
+            emit log(QString("[WARN] VisionClient outbox full (%1), dropping oldest (total dropped %2)")
+                         .arg(m_outboxMax).arg(m_outboxDropped));
+    }
+    const qint64 now = MonoClock::nowMs();
+    m_jsonQueue.enqueue(TxItem{data, m_outboxTtlMs > 0 ? now + m_outboxTtlMs
+                                                       : std::numeric_limits<qint64>::max(), proto});
+    if (isConnected())
+        scheduleTx();
+}
+
+// TTL 이 지난 메시지를 버린다 (끊긴 동안 쌓인 완료 보고 등)
+int VisionClient::dropExpired()
+{
+    const qint64 now = MonoClock::nowMs();
+    int n = 0;
+    for (auto it = m_jsonQueue.begin(); it != m_jsonQueue.end(); ) {
+        if (it->deadlineMs < now) { it = m_jsonQueue.erase(it); ++n; }
+        else ++it;
+    }
+    if (n > 0) {
+        m_outboxDropped += quint64(n);
+        emit log(QString("[WARN] VisionClient dropped %1 expired message(s) (TTL %2 ms)").arg(n).arg(m_outboxTtlMs));
+    }
+    return n;
+}
 
-    // 타이머가 안 돌고 있으면 시작
-    if (!m_jsonTimer.isActive()) {
-        m_jsonTimer.setTimerType(Qt::PreciseTimer);
+// 협상된 형식(json/cbor1)으로 인코딩해 outbox 에 넣는다
+void VisionClient::enqueueMessage(const QJsonObject& o)
+{
+    enqueueFrame(WireFormat::encode(o, m_txProto), m_txProto);
+}
 
-        connect(&m_jsonTimer, &QTimer::timeout, this, &VisionClient::onTxJson, Qt::UniqueConnection);
-        m_jsonTimer.start(m_jsonIntervalMs);
+// 새 연결은 hello 응답 전까지 JSON 이므로, 끊기기 전에 cbor1 로 인코딩해 둔 메시지를 JSON 으로 바꾼다.
+// 바꾼 건수 (되읽기 실패한 프레임은 버림)
+int VisionClient::reencodeOutboxAsJson()
+{
+    int n = 0;
+    for (auto it = m_jsonQueue.begin(); it != m_jsonQueue.end(); ) {
+        if (it->proto == WireFormat::Proto::Json) { ++it; continue; }
+        QJsonObject obj;
+        const QByteArray& f = it->data;
+        if (f.size() <= LineFramer::kBinaryHeader ||
+            !WireFormat::decodeBinary(f.constData() + LineFramer::kBinaryHeader,
+                                      f.size() - LineFramer::kBinaryHeader, obj)) {
+            it = m_jsonQueue.erase(it);
+            ++m_outboxDropped;
+            continue;
+        }
+        it->data = WireFormat::encode(obj, WireFormat::Proto::Json);
+        it->proto = WireFormat::Proto::Json;
+        ++it;
+        ++n;
+    }
+    return n;
+}
+
+void VisionClient::setBinaryProtocol(bool offer)
+{
+    m_offerBinary = offer;
+}
+
+void VisionClient::setTxPacing(int ms)
+{
+    m_jsonIntervalMs = qMax(0, ms);
+    m_jsonTimer.stop();
+    if (!m_jsonQueue.isEmpty())
+        scheduleTx();
+}
+
+// 같은 이벤트 루프 회차에 쌓인 메시지는 한 번에 보낸다 (유휴 시 타이머 없음)
+void VisionClient::scheduleTx()
+{
+    if (m_jsonIntervalMs > 0) {
+        if (!m_jsonTimer.isActive())
+            m_jsonTimer.start(m_jsonIntervalMs);
+        return;
     }
+    if (m_txScheduled)
+        return;
+    m_txScheduled = true;
+    QMetaObject::invokeMethod(this, &VisionClient::onTxJson, Qt::QueuedConnection);
 }
 
 void VisionClient::onTxJson()
 {
+    m_txScheduled = false;
+
     if (!m_sock || m_sock->state() != QAbstractSocket::ConnectedState)
     {
+        m_jsonTimer.stop();   // outbox 는 유지, 재연결 시 TTL 안의 것만 보냄
+        return;
+    }
+
+    dropExpired();
+    if (m_jsonQueue.isEmpty()) {
         m_jsonTimer.stop();
-        m_jsonQueue.clear();
+        return;
+    }
 
+    // 백프레셔: 커널로 못 넘긴 데이터가 많으면 bytesWritten 에서 다시 호출된다
+    if (m_sock->bytesToWrite() >= kTxHighWater)
+        return;
+
+    m_lastTxMs = MonoClock::nowMs();
+
+    if (m_jsonIntervalMs > 0) {
+        m_sock->write(m_jsonQueue.dequeue().data);
+        if (m_jsonQueue.isEmpty())
+            m_jsonTimer.stop();
         return;
     }
 
-    if (m_jsonQueue.isEmpty()) {
+    if (m_jsonQueue.size() == 1) {
+        m_sock->write(m_jsonQueue.dequeue().data);
         return;
     }
 
-    const QByteArray byte_json = m_jsonQueue.dequeue();
-    quint64 len =m_sock->write(byte_json);
-    qDebug()<<QDateTime::currentDateTime()<<QString("VisionClient::onTxJson sent %1 bytes: %2").arg(len).arg(QString::fromUtf8(byte_json).trimmed());
-//    m_sock->flush();
-/*
-    // 다 비면 타이머 정지
-    if (m_jsonQueue.isEmpty())
-        m_jsonTimer.stop();
-*/
+    QByteArray batch;
+    batch.reserve(kTxMaxBatch);
+    while (!m_jsonQueue.isEmpty() && batch.size() + m_jsonQueue.head().data.size() <= kTxMaxBatch)
+        batch += m_jsonQueue.dequeue().data;
+    if (batch.isEmpty())                      // 한 건이 kTxMaxBatch 보다 큼
+        batch = m_jsonQueue.dequeue().data;
+    m_sock->write(batch);
+
+    if (!m_jsonQueue.isEmpty())
+        scheduleTx();
 }
 
 void VisionClient::sendJson(const QJsonObject& obj)
 {
-    if (!m_sock || m_sock->state() != QAbstractSocket::ConnectedState) {
-        emit log("[ERR] Socket not connected");
-        return;
-    }
+    if (!isConnected())
+        emit log("[WARN] Socket not connected, queued");
 
-    const QByteArray json = QJsonDocument(obj).toJson(QJsonDocument::Compact) + '\n';
-    enqueueJson(json);
-    emit log(QString("[TX] %1").arg(QString::fromUtf8(json).trimmed()));
+    enqueueMessage(obj);
+    emit log(QString("[TX] %1").arg(QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact))));
 }
 
 void VisionClient::onConnected()
 {
+    m_connectTimer.stop();
+    m_backoffMs = kBackoffMinMs;
+    m_sock->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+    m_sock->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    m_lastRxMs = m_lastTxMs = MonoClock::nowMs();
+    setHeartbeat(m_heartbeatMs, m_peerTimeoutMs);   // 타이머 시작
+
+    // 새 연결은 JSON 으로 시작, hello 응답을 받으면 전환
+    m_txProto = WireFormat::Proto::Json;
+    if (const int n = reencodeOutboxAsJson())
+        emit log(QString("[NET] VisionClient: %1 queued cbor1 message(s) re-encoded as JSON").arg(n));
+    if (m_offerBinary)
+        m_jsonQueue.prepend(TxItem{WireFormat::encode(WireFormat::helloRequest(true), WireFormat::Proto::Json),
+                                   std::numeric_limits<qint64>::max()});
+
     emit connected();
-    emit log("[NET] VisionClient connected");
+    emit log(QString("[OK] Connected to VisionServer %1:%2").arg(m_host).arg(m_port));
+
+    if (!m_jsonQueue.isEmpty())
+        scheduleTx();   // 끊긴 동안 쌓인 것 (TTL 안의 것만)
 }
 
 void VisionClient::onDisconnected()
 {
+    m_framer.clear();
+    dropStateSubscription();
+    m_heartbeatTimer.stop();
     emit disconnected();
     emit log("[NET] VisionClient disconnected");
+    scheduleReconnect("disconnected");
+}
+
+void VisionClient::onSocketError(QAbstractSocket::SocketError)
+{
+    // 연결 중 실패(거부/호스트 없음)는 disconnected 가 오지 않으므로 여기서 재시도
+    if (m_sock->state() != QAbstractSocket::ConnectedState)
+        scheduleReconnect(QString("error: %1").arg(m_sock->errorString()));
 }
 
 void VisionClient::onReadyRead()
 {
-    m_inbuf.append(m_sock->readAll());
+    m_lastRxMs = MonoClock::nowMs();
+    m_framer.readFrom(m_sock);
 
-    int idx = -1;
-    while ((idx = m_inbuf.indexOf('\n')) >= 0) {
-        QByteArray line = m_inbuf.left(idx);
-        m_inbuf.remove(0, idx + 1);
+    // lineReceived 를 받는 쪽이 없으면 줄마다 QString 변환을 하지 않는다
+    const bool wantText = isSignalConnected(QMetaMethod::fromSignal(&VisionClient::lineReceived));
 
-        if (!line.isEmpty() && line.endsWith('\r'))
-            line.chop(1);
+    LineFramer::Line raw;
+    while (m_framer.next(raw)) {
+        RobotCommand cmd;
+        RobotCommandParser::Extras ex;
+        bool control = false;   // 스트림 구독 요청 (명령 아님)
+        QByteArray traceText;   // 트레이스용 원본 줄 (텍스트: 뷰, 바이너리: 켜져 있을 때만 직렬화)
+
+        // DOM 경로 (바이너리 프레임 / 빠른 디코더가 처리하지 못한 줄)
+        auto fromObject = [&](const QJsonObject& obj) {
+            const QString type = obj.value("type").toString();
+            if (type == "subscribe" || type == "unsubscribe") {
+                handleSubscribe(obj);
+                control = true;
+                return;
+            }
+            ex.isAck = type == "ack";
+            if (ex.isAck) {
+                ex.status  = obj.value("status").toString();
+                ex.message = obj.value("message").toString();
+            }
+            ex.isHello = type == "hello";
+            if (ex.isHello)
+                ex.proto = obj.value("proto").toString();
+            RobotCommandParser::parse(obj, cmd);
+        };
+
+        if (raw.binary) {
+            QJsonObject obj;
+            if (!WireFormat::decodeBinary(raw.data, raw.size, obj))
+                continue;
+            if (wantText || EventTrace::enabled())
+                traceText = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+            if (wantText)
+                emit lineReceived(QString::fromUtf8(traceText));
+            fromObject(obj);
+        } else {
+            const LineFramer::Line lv = raw.trimmed();
+            if (lv.isEmpty())
+                continue;
+            const QByteArray line = lv.view();   // 버퍼를 가리키는 뷰 (복사 없음)
+            traceText = line;
+
+            if (wantText)
+                emit lineReceived(QString::fromUtf8(line));
+
+            // ── JSON 파싱: 알려진 형태는 DOM 없이 바로 RobotCommand 로, 나머지는 QJsonDocument 경로
+            if (!RobotCommandParser::decode(line.constData(), line.size(), cmd, &ex)) {
+                QJsonParseError pe{};
+                const auto doc = QJsonDocument::fromJson(line, &pe);
+                if (pe.error != QJsonParseError::NoError || !doc.isObject())
+                    continue;
+                fromObject(doc.object());
+            }
+        }
 
-        line = line.trimmed();
-        if (line.isEmpty())
+        if (control)
             continue;
 
-        const QString s = QString::fromUtf8(line);
-        emit lineReceived(s);   // 원하면 유지
-
-        // ── JSON 파싱
-        QJsonParseError pe{};
-        const auto doc = QJsonDocument::fromJson(line, &pe);
-        if (pe.error != QJsonParseError::NoError || !doc.isObject())
+        if (ex.isHello) {
+            const WireFormat::Proto p = WireFormat::protoFromName(ex.proto);
+            if (p != m_txProto) {
+                m_txProto = p;
+                emit log(QString("[NET] VisionClient protocol: %1").arg(WireFormat::protoName(p)));
+            }
             continue;
+        }
 
-        const auto obj  = doc.object();
-        const auto type = obj.value("type").toString();
-        const auto dir = obj.value("dir").toInt(0);
+        if (ex.isAck)
+            emit ackReceived(cmd.seq, ex.status, ex.message);
+
+        if (cmd.dir != 1)
+            continue;   // DIR 1 아닌 CMD는 그냥 무시
 
-        if (type == "ack") {
-            const auto seq    = obj.value("seq").toInt(0);
-            const auto status = obj.value("status").toString();
-            const auto msg    = obj.value("message").toString();
-            emit ackReceived(seq, status, msg);
+        if (cmd.type == CmdType::Tool) {
+            m_lastCmdKind = cmd.kind;
+            m_lastToolCmd = cmd.toolCmd;
         }
+        m_tracker.begin(cmd, MonoClock::nowMs());
+        if (!m_traceTimer.isActive()) m_traceTimer.start();
+        if (EventTrace::enabled())
+            EventTrace::visionRx(cmd, traceText.constData(), traceText.size());
 
-        if (dir != 1)
-            continue;   // DIR 1 아닌 CMD는 그냥 무시
+        emit commandReceived(cmd);
+    }
 
-        qDebug()<<"parse";
-        RobotCommand cmd;
-        if (RobotCommandParser::parse(obj, cmd)) {
-            //const QByteArray compact = QJsonDocument(obj).toJson(QJsonDocument::Compact);
-            //qDebug()<<QDateTime::currentDateTime()<<type<<dir<< int(cmd.kind);
+    if (m_framer.overflow()) {
+        emit log(QString("[WARN] VisionClient: line too long (%1 bytes), dropped").arg(m_framer.pending()));
+        m_framer.clear();
+    }
+}
 
-            if (cmd.type == CmdType::Tool) {
-                m_lastCmdKind = cmd.kind;
-                m_lastToolCmd = cmd.toolCmd;
-            }
-            if(cmd.robot == RobotId::A)
-            {
-                isMotion_[0]=true;
-                lasCmd_[0] = cmd;
-            }
-            else if(cmd.robot == RobotId::B)
-            {
-                isMotion_[1]=true;
-                lasCmd_[1] = cmd;
-            }
+void VisionClient::setStatePublisher(RobotStatePublisher* pub)
+{
+    if (pub == m_statePub) return;
+    dropStateSubscription();
+    m_statePub = pub;
+}
 
+void VisionClient::handleSubscribe(const QJsonObject& obj)
+{
+    if (obj.value("stream").toString("state") != "state")
+        return;
+    dropStateSubscription();
+    if (obj.value("type").toString() != "subscribe")
+        return;
+    if (!m_statePub) {
+        emit log("[WARN] VisionClient: state subscribe ignored (no publisher)");
+        return;
+    }
 
-            emit commandReceived(cmd);
-        }
+    const auto opt = RobotStatePublisher::parseOptions(obj);
+    m_stateSubId = m_statePub->subscribe(opt,
+        [this](const QByteArray& frame, WireFormat::Proto proto) { enqueueFrame(frame, proto); },
+        // outbox 와 소켓 버퍼가 비어 있을 때만 → 밀리면 다음 틱에 최신값
+        [this] { return isConnected() && m_jsonQueue.isEmpty() && m_sock->bytesToWrite() < kTxHighWater; },
+        [this] { return m_txProto; });
+    emit log(QString("[NET] VisionClient: state stream %1 Hz (robots: %2)")
+                 .arg(opt.hz).arg(opt.robots.isEmpty() ? QString("all") : opt.robots.join(',')));
+}
+
+void VisionClient::dropStateSubscription()
+{
+    if (m_statePub && m_stateSubId)
+        m_statePub->unsubscribe(m_stateSubId);
+    m_stateSubId = 0;
+}
+
+void VisionClient::traceStage(const QString& robot, CommandTracker::Stage s)
+{
+    const int ri = robotIndex(robot);
+    if (ri >= 0) m_tracker.markRobot(ri, s, MonoClock::nowMs());
+}
+
+void VisionClient::finishTrace(quint32 seq)
+{
+    CommandTracker::Entry e;
+    if (!m_tracker.finish(seq, MonoClock::nowMs(), true, &e))
+        return;
+    // 구간별 지연 (찍히지 않은 단계는 -)
+    QString stages;
+    for (int i = CommandTracker::Ack; i < CommandTracker::StageCount; ++i) {
+        stages += QString(" %1=%2").arg(QLatin1String(CommandTracker::stageName(CommandTracker::Stage(i))),
+                                        e.t[i] < 0 ? QString("-") : QString::number(e.t[i] - e.t[CommandTracker::Rx]));
+    }
+    emit log(QString("[TRACE] seq=%1 %2.%3%4 ms")
+                 .arg(seq).arg(cmdTypeToString(e.type), cmdKindToString(e.kind), stages));
+}
+
+void VisionClient::onTraceTick()
+{
+    QVector<CommandTracker::Entry> expired;
+    m_tracker.expire(MonoClock::nowMs(), &expired);
+    for (const auto& e : expired) {
+        // 마지막으로 지난 단계 → 어디서 멈췄는지
+        int at = CommandTracker::Rx;
+        for (int i = CommandTracker::Ack; i < CommandTracker::StageCount; ++i)
+            if (e.t[i] >= 0) at = i;
+        emit log(QString("[WARN] command seq=%1 %2.%3 timed out after %4 (%5 ms)")
+                     .arg(e.seq).arg(cmdTypeToString(e.type), cmdKindToString(e.kind),
+                          QLatin1String(CommandTracker::stageName(CommandTracker::Stage(at))))
+                     .arg(m_tracker.timeout()));
     }
+    if (m_tracker.inFlight() == 0) m_traceTimer.stop();
+}
+
+bool VisionClient::saveCommandStats(const QString& path) const
+{
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return f.write(QJsonDocument(m_tracker.toJson()).toJson()) > 0;
 }
@@ -5,10 +5,18 @@
 #include <QTcpSocket>
 #include <QJsonObject>
 
+#include <QPointer>
 #include <QQueue>
 #include <QTimer>
+#include <QVector>
 
 #include "RobotCommand.h"
+#include "CommandTracker.h"
+#include "LineFramer.h"
+#include "WireFormat.h"
+
+class JsonTemplate;
+class RobotStatePublisher;
 
 class VisionClient : public QObject
 {
@@ -18,8 +26,25 @@ public:
 
     ~VisionClient();
 
+    // 비동기 연결: 즉시 반환하고 결과는 connected()/log 로 알린다.
+    // 연결이 끊기거나 실패하면 disconnectFrom() 전까지 백오프(0.5s → 최대 30s)로 재연결한다.
     bool connectTo(const QString& host, quint16 port);
     void disconnectFrom();
+    bool isConnected() const { return m_sock->state() == QAbstractSocket::ConnectedState; }
+
+    // 앱 레벨 하트비트: 송신이 intervalMs 동안 없으면 {"type":"heartbeat"} 전송 (0: 끔, 기본 끔).
+    // 서버가 모르는 메시지를 받으면 안 되므로 robots.json "vision" 설정으로만 켠다.
+    // peerTimeoutMs>0 이면 그 시간 동안 수신이 전혀 없을 때 연결을 끊고 재연결한다.
+    void setHeartbeat(int intervalMs, int peerTimeoutMs = 0);
+
+    // 송신 대기열(outbox): 끊긴 동안에도 maxMessages 건까지 보관, 넘치면 오래된 것부터 버림.
+    // 각 메시지는 ttlMs 안에 나가지 못하면 보내지 않고 버린다 (재연결 후 뒤늦은 완료 보고 방지).
+    void setOutboxLimits(int maxMessages, int ttlMs);
+
+    // 연결 시 hello 로 바이너리(cbor1) 프로토콜을 제안할지 (기본 false, robots.json 으로 켬).
+    // 서버가 응답하지 않으면 JSON 을 계속 쓴다.
+    void setBinaryProtocol(bool offer);
+    WireFormat::Proto txProtocol() const { return m_txProto; }
     // 단일 Pose 전송
     void sendPose(const PickPose& p, const QString& kind, const int dir, const int id, quint32 seq = 0, int speed_pct = 50);
     void sendAck(quint32 seq, const QString& status, const QString& msg = QString());
@@ -30,6 +55,20 @@ public:
     void sendError(const QString& robot, QString error, int code1=0, int code2=0);
     void enqueueJson(const QByteArray& json);
 
+    // 명령 진행 추적: 로봇 단위 단계(Trigger/Busy/Pulse)를 진행 중인 명령에 기록
+    void traceStage(const QString& robot, CommandTracker::Stage s);
+    const CommandTracker& commandTracker() const { return m_tracker; }
+    // 단계별 지연 히스토그램(JSON) 저장
+    bool saveCommandStats(const QString& path) const;
+
+    // 로봇 상태 스트림: 서버가 {"type":"subscribe","stream":"state",...} 을 보내면 이 발행자에 구독.
+    // 프레임은 outbox 가 비어 있을 때만 나간다 (밀리면 최신값으로 병합). 연결이 끊기면 구독 해제.
+    void setStatePublisher(RobotStatePublisher* pub);
+
+    // 송신 간격 (ms). 0(기본): 이벤트 구동, 쌓인 메시지를 한 번의 write 로 몰아 보냄.
+    // >0: 수신 측이 메시지 간 간격을 요구할 때만, 타이머로 틱마다 한 건씩 보냄.
+    void setTxPacing(int ms);
+
 signals:
     void connected();
     void disconnected();
@@ -42,27 +81,77 @@ private slots:
     void onConnected();
     void onDisconnected();
     void onReadyRead();
+    void onSocketError(QAbstractSocket::SocketError err);
+    void onHeartbeatTick();
+    void onTraceTick();
 
 private slots:
     void onTxJson();
 
 private:
     void sendJson(const QJsonObject& obj);
+    void enqueueMessage(const QJsonObject& o);
+    template <typename... Args>
+    void enqueueTemplate(const JsonTemplate& t, const Args&... args);
+    void enqueueFrame(const QByteArray& data, WireFormat::Proto proto);
+    int reencodeOutboxAsJson();
+    void finishTrace(quint32 seq);
+    void handleSubscribe(const QJsonObject& obj);
+    void dropStateSubscription();
 
 private:
     QTcpSocket* m_sock = nullptr;
-    QByteArray m_inbuf;
+    LineFramer m_framer;   // 수신 라인 프레이밍 (읽기 커서, 줄 단위 memmove 없음)
 
     CmdKind m_lastCmdKind {CmdKind::Unknown};
     ToolCommand m_lastToolCmd;
 
-    QQueue<QByteArray> m_jsonQueue;
-    QTimer m_jsonTimer;
-    int m_jsonIntervalMs{1};
+    void scheduleTx();
+    void scheduleReconnect(const QString& why);
+    void startConnect();
+    int dropExpired();
+
+    static constexpr qint64 kTxHighWater = 256 * 1024;   // 소켓 미전송 바이트가 이 이상이면 bytesWritten 까지 대기
+    static constexpr int kTxMaxBatch = 64 * 1024;        // 한 번에 모아 쓸 최대 바이트
+    static constexpr int kConnectTimeoutMs = 2000;
+    static constexpr int kBackoffMinMs = 500;
+    static constexpr int kBackoffMaxMs = 30000;
+
+    struct TxItem {
+        QByteArray data;
+        qint64 deadlineMs;          // MonoClock ms, 이 시각이 지나면 버림
+        WireFormat::Proto proto{WireFormat::Proto::Json};   // 인코딩된 형식 (재연결 시 cbor1 → JSON 재인코딩)
+    };
+    QQueue<TxItem> m_jsonQueue;     // outbox
+    int m_outboxMax{256};
+    int m_outboxTtlMs{5000};
+    quint64 m_outboxDropped{0};
+    QTimer m_jsonTimer;             // 페이싱 설정 시에만 사용
+    int m_jsonIntervalMs{0};
+    bool m_txScheduled{false};
+    WireFormat::Proto m_txProto{WireFormat::Proto::Json};
+    bool m_offerBinary{false};
+
+    // 연결 관리
+    QString m_host;
+    quint16 m_port{0};
+    bool m_autoReconnect{false};
+    int m_backoffMs{kBackoffMinMs};
+    QTimer m_connectTimer;          // 연결 시도 타임아웃
+    QTimer m_reconnectTimer;
+    QTimer m_heartbeatTimer;
+    int m_heartbeatMs{0};
+    int m_peerTimeoutMs{0};
+    qint64 m_lastTxMs{0};
+    qint64 m_lastRxMs{0};
 
 private:
-    RobotCommand lasCmd_[2];
-    bool isMotion_[2];
+    // seq 별 진행 중 명령 (완료/에러 보고의 seq 귀속, 구간 지연 측정)
+    CommandTracker m_tracker;
+    QTimer m_traceTimer;            // 진행 중 명령이 있을 때만 타임아웃 검사
+
+    QPointer<RobotStatePublisher> m_statePub;
+    int m_stateSubId{0};
 };
 
 #endif // VISIONCLIENT_H
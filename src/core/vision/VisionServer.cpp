@@ -1,18 +1,11 @@
 #include "VisionServer.h"
+#include "WireFormat.h"
+#include "LogCategories.h"
+#include "RobotStatePublisher.h"
+#include "MonoClock.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QDateTime>
-#include <QElapsedTimer>
-
-static inline qint64 nowMs() {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
-    return QElapsedTimer::clockType() == QElapsedTimer::MonotonicClock
-               ? QElapsedTimer().msecsSinceReference()
-               : QDateTime::currentMSecsSinceEpoch();
-#else
-    return QDateTime::currentMSecsSinceEpoch();
-#endif
-}
 
 VisionServer::VisionServer(QObject* parent)
     : QObject(parent)
@@ -24,11 +17,17 @@ VisionServer::VisionServer(QObject* parent)
     connect(m_srv, &Server::stopped,           this, &VisionServer::stopped);
     connect(m_srv, &Server::peerCountChanged,  this, &VisionServer::peerCountChanged);
     connect(m_srv, &Server::lineReceived,      this, &VisionServer::onLine);
+    connect(m_srv, &Server::binaryReceived,    this, &VisionServer::onBinary);
 
     // ★ 추가: 접속 즉시 화이트리스트 검사
     connect(m_srv, &Server::clientConnected,   this, &VisionServer::onClientConnected);
 }
 
+VisionServer::~VisionServer()
+{
+    setStatePublisher(nullptr);     // 발행자에 남은 콜백 정리
+}
+
 bool VisionServer::start(quint16 port)
 {
     return start(QHostAddress::Any, port);
@@ -36,6 +35,7 @@ bool VisionServer::start(quint16 port)
 
 bool VisionServer::start(const QHostAddress& a, quint16 p)
 {
+    m_srv->setSendLimits(m_opt.sendQueueMessages, m_opt.sendQueueBytes);
     return m_srv->start(a, p);
 }
 
@@ -60,7 +60,7 @@ bool VisionServer::passRateLimit(QTcpSocket* s)
 {
     if (!s) return false;
     auto& st = m_stats[s];
-    const qint64 t = nowMs();
+    const qint64 t = MonoClock::nowMs();
 
     // 초기화
     if (st.lastRefillMs == 0) {
@@ -95,7 +95,6 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
     auto& st = m_stats[from];
     ++st.linesTotal; ++m_global.linesTotal;
 
-    qDebug()<<"[VS] Line received from"<<peerIp(from)<<":"<<QString::fromUtf8(line);
 #if false
     // ── 화이트리스트 검사
     if (!allowedByWhitelist(from)) {
@@ -111,7 +110,7 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
         return;
     }
 
-    qDebug()<<"[VS] Whitelist passed for"<<peerIp(from);
+    qCDebug(lcVision)<<"[VS] Whitelist passed for"<<peerIp(from);
     // ── 레이트리밋
     if (!passRateLimit(from)) {
         ++st.rateLimitBlock; ++m_global.rateLimitBlock;
@@ -138,21 +137,65 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
     const auto doc = QJsonDocument::fromJson(line, &pe);
     if (pe.error != QJsonParseError::NoError || !doc.isObject()) {
         ++st.jsonErr; ++m_global.jsonErr;
-        emit log(QString("[ERR] Vision JSON parse failed: %1, line=%2")
-                     .arg(pe.errorString(), QString::fromUtf8(line)));
+        ++st.decodeErr; ++m_global.decodeErr;
+        quint64 skipped = 0;
+        if (errLogDue(st, skipped))
+            emit log(QString("[ERR] Vision JSON parse failed from %1: %2, line=%3%4 (%5 more since last report)")
+                         .arg(peerIp(from), pe.errorString(), QString::fromUtf8(line.left(kErrLogPreview)),
+                              line.size() > kErrLogPreview ? QStringLiteral("...") : QString())
+                         .arg(skipped));
         sendAck(from, 0, "error", "invalid_json");
         ++st.ackErr; ++m_global.ackErr;
         return;
     }
 
-    const auto obj   = doc.object();
+    handleObject(from, doc.object());
+}
+
+// 잘못된 메시지는 매번 세지만 로그는 피어당 kErrLogIntervalMs 에 한 줄 (그 사이 건수는 다음 줄에)
+bool VisionServer::errLogDue(ClientStat& st, quint64& skipped)
+{
+    const qint64 now = MonoClock::nowMs();
+    if (st.errLogMs >= 0 && now - st.errLogMs < kErrLogIntervalMs) {
+        ++st.errLogSkipped;
+        return false;
+    }
+    skipped = st.errLogSkipped;
+    st.errLogSkipped = 0;
+    st.errLogMs = now;
+    return true;
+}
+
+// cbor1 프레임: JSON 과 같은 구조의 map
+void VisionServer::onBinary(QTcpSocket* from, const QByteArray& payload)
+{
+    auto& st = m_stats[from];
+    ++st.linesTotal; ++m_global.linesTotal;
+
+    QJsonObject obj;
+    if (!WireFormat::decodeBinary(payload.constData(), payload.size(), obj)) {
+        ++st.jsonErr; ++m_global.jsonErr;
+        ++st.decodeErr; ++m_global.decodeErr;
+        quint64 skipped = 0;
+        if (errLogDue(st, skipped))
+            emit log(QString("[ERR] Vision CBOR decode failed (%1 bytes) from %2 (%3 more since last report)")
+                         .arg(payload.size()).arg(peerIp(from)).arg(skipped));
+        sendAck(from, 0, "error", "invalid_cbor");
+        ++st.ackErr; ++m_global.ackErr;
+        return;
+    }
+    handleObject(from, obj);
+}
+
+void VisionServer::handleObject(QTcpSocket* from, const QJsonObject& obj)
+{
+    auto& st = m_stats[from];
     const auto type  = obj.value("type").toString();
     const auto robot = obj.value("robot").toString("B"); // "A","B","C"... (없으면 빈 문자열)
     const auto kind = obj.value("kind").toString(""); // "pick", "place" 등 (없으면 빈 문자열)
     const quint32 seq = obj.value("seq").toInt(0);
     const auto dir = obj.value("dir").toInt(0);
 
-    qDebug()<<"[VS] Parsed JSON type="<<type<<"robot="<<robot<<"seq="<<seq;
 #if false
     // ── 인증 토큰
     if (!m_token.isEmpty()) {
@@ -166,6 +209,22 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
         }
     }
 #endif
+    // ── 프로토콜 협상: 응답은 항상 JSON, 이후 이 클라이언트로는 선택한 형식으로 보냄
+    if (type == "hello") {
+        const WireFormat::Proto p = WireFormat::chooseProto(obj);
+        m_srv->writeTo(from, WireFormat::encode(WireFormat::helloReply(p), WireFormat::Proto::Json));
+        if (p == WireFormat::Proto::Cbor) m_proto.insert(from, p);
+        else                              m_proto.remove(from);
+        emit log(QString("[NET] %1 protocol: %2").arg(peerIp(from), QString::fromLatin1(WireFormat::protoName(p))));
+        return;
+    }
+    if (type == "heartbeat")
+        return;
+    if (type == "subscribe" || type == "unsubscribe") {
+        handleSubscribe(from, obj);
+        return;
+    }
+
     const auto extras = collectExtras(obj);
 
     if (type == "pose") {
@@ -181,7 +240,7 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
             }
             else
             {
-                qDebug()<<"[VS] Pick Pose parsing failed";
+                qCWarning(lcVision)<<"[VS] Pick Pose parsing failed";
                 ++st.jsonErr; ++m_global.jsonErr;
                 sendAck(from, seq, "error", "missing_fields [pick]");
                 ++st.ackErr; ++m_global.ackErr;
@@ -195,7 +254,7 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
             }
             else
             {
-                qDebug()<<"[VS] PlacePose parsing failed";
+                qCWarning(lcVision)<<"[VS] PlacePose parsing failed";
                 ++st.jsonErr; ++m_global.jsonErr;
                 sendAck(from, seq, "error", "missing_fields [place]");
                 ++st.ackErr; ++m_global.ackErr;
@@ -216,14 +275,13 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
             {
                 parsePoseObj(obj["pick"].toObject(), pick);
                 //qDebug()<<"[VS] Pick Pose parsed:"<<pick.x<<pick.y<<pick.z<<pick.rx<<pick.ry<<pick.rz;
-                qDebug()<<pick.x<<pick.y<<pick.z<<pick.rx<<pick.ry<<pick.rz;
             }
         }
         else if(robot=="B")
         {
             Pose6D p{};
             if (!parsePoseObj(obj, p)) {
-                qDebug()<<"[VS] Pose parsing failed";
+                qCWarning(lcVision)<<"[VS] Pose parsing failed";
                 ++st.jsonErr; ++m_global.jsonErr;
                 sendAck(from, seq, "error", "missing_fields [pose]");
                 ++st.ackErr; ++m_global.ackErr;
@@ -234,7 +292,7 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
             if(kind.isEmpty())
             {
                 //TODO: kind 이 없으면 에러 처리
-                qDebug()<<"[VS] Pose kind missing";
+                qCWarning(lcVision)<<"[VS] Pose kind missing";
                 ++st.jsonErr; ++m_global.jsonErr;
                 sendAck(from, seq, "error", "missing_kind");
                 ++st.ackErr; ++m_global.ackErr;
@@ -252,7 +310,7 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
     {
         if(robot=="A" && kind=="bulk" && dir==1)
         {
-            qDebug() << "[VS] Bulk Stop command received for robot"<<robot;
+            qCDebug(lcVision) << "[VS] Bulk Stop command received for robot"<<robot;
             emit commandReceived(robot, kind, seq);
         }
     }
@@ -325,7 +383,10 @@ void VisionServer::onLine(QTcpSocket* from, const QByteArray& line)
     // 알 수 없는 타입
     ++st.jsonErr;
     ++m_global.jsonErr;
-    emit log(QString("[ERR] Vision unknown type: %1").arg(type));
+    quint64 skipped = 0;
+    if (errLogDue(st, skipped))
+        emit log(QString("[ERR] Vision unknown type from %1: %2 (%3 more since last report)")
+                     .arg(peerIp(from), type.left(kErrLogPreview)).arg(skipped));
     sendAck(from, seq, "error", "unknown_type");
     ++st.ackErr;
     ++m_global.ackErr;
@@ -399,9 +460,8 @@ void VisionServer::sendAck(QTcpSocket* to, quint32 seq, const QString& status, c
     };
     if (!message.isEmpty()) o["message"] = message;
 
-    const auto bytes = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
     if (status == "ok") { ++m_global.ackOk; } else { ++m_global.ackErr; }
-    m_srv->writeTo(to, bytes);
+    writeObject(to, o);
 }
 
 QVariantMap VisionServer::metrics() const
@@ -417,6 +477,7 @@ QVariantMap VisionServer::metrics() const
     m["auth_fail"]        = static_cast<qulonglong>(m_global.authFail);
     m["whitelist_block"]  = static_cast<qulonglong>(m_global.whitelistBlock);
     m["ratelimit_block"]  = static_cast<qulonglong>(m_global.rateLimitBlock);
+    m["decode_err"]       = static_cast<qulonglong>(m_global.decodeErr);
     return m;
 }
 
@@ -437,12 +498,19 @@ QVariantMap VisionServer::metricsFor(const QTcpSocket* s) const
     m["auth_fail"]       = static_cast<qulonglong>(st.authFail);
     m["whitelist_block"] = static_cast<qulonglong>(st.whitelistBlock);
     m["ratelimit_block"] = static_cast<qulonglong>(st.rateLimitBlock);
+    m["decode_err"]      = static_cast<qulonglong>(st.decodeErr);
     m["tokens"]          = st.tokens;
     return m;
 }
 
 void VisionServer::onClientConnected(QTcpSocket* s)
 {
+    if (s)
+        connect(s, &QObject::destroyed, this, [this, s]{
+            dropStateSubscription(s);
+            m_proto.remove(s);
+            m_stats.remove(s);
+        });
     if (!s || !m_ef.enforceWhitelist) return;
 
     const QString ip = peerIp(s);
@@ -486,10 +554,8 @@ void VisionServer::requestCaptureKind(const char* kind, quint32 seq, int speed_p
     };
     if (speed_pct >= 0) o["speed_pct"] = speed_pct;
 
-    const QByteArray line = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    qDebug()<<"[VS] Broadcasting request_pose:"<<QString::fromUtf8(line);
-
-    if (m_srv) m_srv->broadcast(line);
+    qCDebug(lcVision)<<"[VS] Broadcasting request_pose:"<<o;
+    broadcastObject(o);
 
     emit log(QString("[NET] request_pose(kind=%1, seq=%2, speed=%3) broadcast")
                  .arg(kind).arg(seq).arg(speed_pct));
@@ -506,9 +572,8 @@ void VisionServer::requestPoseBulk(const char* kind, quint32 seq)
         {"ts",   QDateTime::currentDateTimeUtc().toString(Qt::ISODate)}
     };
 
-    const QByteArray line = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    qDebug()<<"[VS] Broadcasting request_pose:"<<QString::fromUtf8(line);
-    if (m_srv) m_srv->broadcast(line);
+    qCDebug(lcVision)<<"[VS] Broadcasting request_pose:"<<o;
+    broadcastObject(o);
     emit log(QString("[NET] request_pose(kind=%1, seq=%2 broadcast")
                  .arg(kind).arg(seq));
 }
@@ -523,9 +588,8 @@ void VisionServer::requestPoseKind(const char* kind, quint32 seq, int speed_pct)
     };
     if (speed_pct >= 0) o["speed_pct"] = speed_pct;
 
-    const QByteArray line = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    qDebug()<<"[VS] Broadcasting request_pose:"<<QString::fromUtf8(line);
-    if (m_srv) m_srv->broadcast(line);
+    qCDebug(lcVision)<<"[VS] Broadcasting request_pose:"<<o;
+    broadcastObject(o);
     emit log(QString("[NET] request_pose(kind=%1, seq=%2, speed=%3) broadcast")
                  .arg(kind).arg(seq).arg(speed_pct));
 }
@@ -541,8 +605,7 @@ void VisionServer::requestPoseKindTo(const QString& targetId, const char* kind,
     };
     if (speed_pct >= 0) o["speed_pct"] = speed_pct;
 
-    const QByteArray line = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    if (m_srv) m_srv->writeToId(targetId, line);
+    writeObjectToId(targetId, o);
     emit log(QString("[NET] request_pose(kind=%1, seq=%2, speed=%3) -> %4")
                  .arg(kind).arg(seq).arg(speed_pct).arg(targetId));
 }
@@ -569,16 +632,43 @@ void VisionServer::sendStatus(const PickPose& p, const JointPose& j, const int i
                   {"j1", j.j1}, {"j2", j.j2}, {"j3", j.j3}, {"j4", j.j4}, {"j5", j.j5}, {"j6", j.j6},
 
                   };
-    sendJson(o);
+    broadcastObject(o, Server::Stream::State);   // 상태 스트림: 느린 클라이언트에겐 최신값만
 }
 
 void VisionServer::sendJson(const QJsonObject& obj)
 {
+    broadcastObject(obj);
+}
+
+// 클라이언트별 협상 형식으로 인코딩: 형식마다 한 번만 인코딩하고 그 payload 를 모든 큐가 공유
+int VisionServer::broadcastObject(const QJsonObject& o, Server::Stream stream)
+{
+    if (!m_srv) return 0;
+    if (m_proto.isEmpty())          // 아무도 cbor1 을 협상하지 않음 → JSON 하나로
+        return m_srv->broadcast(WireFormat::encode(o, WireFormat::Proto::Json), stream);
+
+    QByteArray enc[2];
+    int sent = 0;
+    const auto clients = m_srv->clients();
+    for (QTcpSocket* s : clients) {
+        const WireFormat::Proto p = m_proto.value(s, WireFormat::Proto::Json);
+        QByteArray& bytes = enc[p == WireFormat::Proto::Cbor ? 1 : 0];
+        if (bytes.isEmpty()) bytes = WireFormat::encode(o, p);
+        if (m_srv->writeTo(s, bytes, stream)) ++sent;
+    }
+    return sent;
+}
+
+bool VisionServer::writeObject(QTcpSocket* to, const QJsonObject& o, Server::Stream stream)
+{
+    if (!m_srv || !to) return false;
+    return m_srv->writeTo(to, WireFormat::encode(o, m_proto.value(to, WireFormat::Proto::Json)), stream);
+}
 
-    const QByteArray json = QJsonDocument(obj).toJson(QJsonDocument::Compact) + '\n';
-    //const QByteArray line = QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
-    qDebug()<<"[VS] Broadcasting JSON:"<<QString::fromUtf8(json);
-    m_srv->broadcast(json);
+bool VisionServer::writeObjectToId(const QString& targetId, const QJsonObject& o)
+{
+    if (!m_srv) return false;
+    return writeObject(m_srv->clientById(targetId), o);   // 해당 ID 클라이언트 없으면 false
 }
 
 void VisionServer::updateRobotState(const QString& id, const Pose6D& tcp, const Pose6D& joints, qint64 tsMs)
@@ -589,3 +679,38 @@ void VisionServer::updateRobotState(const QString& id, const Pose6D& tcp, const
     s.tsMs = tsMs;
     s.valid = true;
 }
+
+void VisionServer::setStatePublisher(RobotStatePublisher* pub)
+{
+    if (pub == m_statePub) return;
+    const auto subs = m_stateSubs.keys();
+    for (QTcpSocket* s : subs)
+        dropStateSubscription(s);
+    m_statePub = pub;
+}
+
+void VisionServer::handleSubscribe(QTcpSocket* from, const QJsonObject& obj)
+{
+    if (obj.value("stream").toString("state") != "state")
+        return;
+    dropStateSubscription(from);
+    if (obj.value("type").toString() != "subscribe" || !m_statePub)
+        return;
+
+    const auto opt = RobotStatePublisher::parseOptions(obj);
+    const int id = m_statePub->subscribe(opt,
+        [this, from](const QByteArray& frame, WireFormat::Proto) {
+            m_srv->writeTo(from, frame, Server::Stream::State);
+        },
+        [this, from] { return m_srv && m_srv->writable(from); },
+        [this, from] { return m_proto.value(from, WireFormat::Proto::Json); });
+    m_stateSubs.insert(from, id);
+    emit log(QString("[NET] %1 state stream %2 Hz").arg(peerIp(from)).arg(opt.hz));
+}
+
+void VisionServer::dropStateSubscription(QTcpSocket* s)
+{
+    const int id = m_stateSubs.take(s);
+    if (id && m_statePub)
+        m_statePub->unsubscribe(id);
+}
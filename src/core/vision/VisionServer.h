@@ -11,6 +11,9 @@
 
 #include "Server.h"        // core/network/Server.h
 #include "Pose6D.h"        // core/models/Pose6D.h
+#include "WireFormat.h"    // core/network/WireFormat.h
+
+class RobotStatePublisher;
 /*
 VisionServer* vs = new VisionServer(this);
 
@@ -30,7 +33,7 @@ vs->start(QHostAddress::Any, 50000);
 struct VisionRobotState {
     Pose6D tcp;
     Pose6D joints;
-    qint64 tsMs{0};
+    qint64 tsMs{0};         // MonoClock ms
     bool   valid{false};
 };
 
@@ -52,9 +55,14 @@ public:
 
         // ── 메트릭
         bool     metricsEnabled    = true;      // 카운터 수집/스냅샷 허용
+
+        // ── 클라이언트별 송신 큐 한도 (start() 시 적용). 넘치면 상태 메시지부터 버림
+        int      sendQueueMessages = 1024;
+        qint64   sendQueueBytes    = 4 * 1024 * 1024;
     };
 
     explicit VisionServer(QObject* parent=nullptr);
+    ~VisionServer() override;
 
     // Server 제어 프록시
     bool start(quint16 port);
@@ -78,6 +86,10 @@ public:
 // KJW: 2025-10-28
     void updateRobotState(const QString& id, const Pose6D& tcp, const Pose6D& joints, qint64 tsMs);
 
+    // 로봇 상태 스트림: 클라이언트가 {"type":"subscribe","stream":"state",...} 을 보내면
+    // 그 클라이언트 전용 구독을 만든다 (State 스트림, 소켓이 밀리면 최신값으로 병합)
+    void setStatePublisher(RobotStatePublisher* pub);
+
 signals:
     // 단건/다건 좌표 수신
     void poseReceived(const QString& robotId, const QString& kind, const Pose6D& pose,
@@ -100,6 +112,7 @@ signals:
 
 private slots:
     void onLine(QTcpSocket* from, const QByteArray& line);
+    void onBinary(QTcpSocket* from, const QByteArray& payload);
 
 private:
     // 내부 헬퍼
@@ -107,7 +120,15 @@ private:
     bool parsePickPoseObj(const QJsonObject& o, Pose6D& out) const;
     bool parsePlacePoseObj(const QJsonObject& o, Pose6D& out) const;
 
+    void handleObject(QTcpSocket* from, const QJsonObject& obj);
+    void handleSubscribe(QTcpSocket* from, const QJsonObject& obj);
+    void dropStateSubscription(QTcpSocket* s);
     QVariantMap collectExtras(const QJsonObject& o) const;
+
+    // 클라이언트별 협상 형식(json/cbor1)으로 송신
+    int  broadcastObject(const QJsonObject& o, Server::Stream stream = Server::Stream::Command);
+    bool writeObject(QTcpSocket* to, const QJsonObject& o, Server::Stream stream = Server::Stream::Command);
+    bool writeObjectToId(const QString& targetId, const QJsonObject& o);
     void sendAck(QTcpSocket* to, quint32 seq, const QString& status,
                  const QString& message = QString());
 
@@ -118,6 +139,7 @@ private:
 
 private:
     QPointer<Server> m_srv;    // 네트워크 레이어
+    QHash<QTcpSocket*, WireFormat::Proto> m_proto;  // cbor1 을 협상한 클라이언트만 (없으면 JSON)
     QString          m_token;  // 옵션 인증 토큰
     Options          m_opt;
 
@@ -137,9 +159,19 @@ private:
         quint64  authFail = 0;
         quint64  whitelistBlock = 0;
         quint64  rateLimitBlock = 0;
+        quint64  decodeErr = 0;        // JSON 파싱/CBOR 디코드 실패 (jsonErr 에도 포함)
+
+        // 잘못된 메시지 로그 제한 (피어당 kErrLogIntervalMs 에 한 줄)
+        qint64   errLogMs = -1;        // 마지막 로그 시각 (-1: 아직 없음)
+        quint64  errLogSkipped = 0;    // 그 뒤로 로그 없이 센 건수
     };
     QHash<QTcpSocket*, ClientStat> m_stats;
 
+    static constexpr qint64 kErrLogIntervalMs = 5000;
+    static constexpr int kErrLogPreview = 120;     // 로그에 싣는 잘못된 줄 앞부분 (바이트)
+    // 이 피어의 오류를 지금 로그해도 되는지. true 면 skipped = 직전 로그 뒤로 생략된 건수
+    static bool errLogDue(ClientStat& st, quint64& skipped);
+
     // 글로벌 카운터
     struct GlobalStat {
         quint64 linesTotal = 0;
@@ -151,6 +183,7 @@ private:
         quint64 authFail = 0;
         quint64 whitelistBlock = 0;
         quint64 rateLimitBlock = 0;
+        quint64 decodeErr = 0;
     } m_global;
 
 public:
@@ -189,5 +222,8 @@ private:
 
     QHash<QString, VisionRobotState> m_latest;  // robotId → 최신 상태 캐시
 
+    QPointer<RobotStatePublisher> m_statePub;
+    QHash<QTcpSocket*, int> m_stateSubs;        // 클라이언트 → 구독 id
+
 };
 #endif // VISIONSERVER_H
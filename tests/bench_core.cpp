@@ -0,0 +1,320 @@
+// ─────────────────────────────────────────────────────────────
+// mrc_bench — 코어 파서/프레이머 마이크로벤치마크 (QtTest QBENCHMARK)
+//
+//   mrc_bench                      # 전체
+//   mrc_bench csvLoader            # 슬롯 하나만
+//   mrc_bench -tickcounter ...     # QtTest 측정기 옵션 그대로 사용
+//
+// 각 벤치는 이전 구현(기준)과 현재 구현을 같은 입력으로 나란히 잰다.
+// 결과 비교 전에 두 구현의 출력이 같은지 먼저 확인한다.
+// ─────────────────────────────────────────────────────────────
+#include <QtTest>
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QVector>
+
+#include "JsonTemplate.h"
+#include "LineFramer.h"
+#include "Pose6D.h"
+#include "PoseCsvLoader.h"
+#include "RobotCommandParser.h"
+#include "RobotCommandSerializer.h"
+
+namespace {
+
+// ---- 기준 구현: 기존 RobotManager::loadCsvToModel (QTextStream/split/toDouble)
+bool refParseLine(const QString& line, Pose6D& out)
+{
+    QString s = line.trimmed();
+    if (s.isEmpty() || s.startsWith('#')) return false;
+    const QChar sep = s.contains('\t') ? '\t' : ',';
+    const auto parts = s.split(sep, Qt::SkipEmptyParts);
+    if (parts.size() < 6) return false;
+    bool ok[6]{};
+    double vals[6]{};
+    for (int i = 0; i < 6; i++) {
+        vals[i] = parts[i].trimmed().toDouble(&ok[i]);
+        if (!ok[i]) return false;
+    }
+    out = Pose6D{vals[0], vals[1], vals[2], vals[3], vals[4], vals[5]};
+    return true;
+}
+
+QVector<Pose6D> refParse(const QByteArray& csv)
+{
+    QTextStream ts(csv);
+    QVector<Pose6D> list;
+    while (!ts.atEnd()) {
+        Pose6D p;
+        if (refParseLine(ts.readLine(), p)) list.push_back(p);
+    }
+    return list;
+}
+
+// 헤더 + rows 줄 (가끔 주석/빈 줄 섞음)
+QByteArray makeCsv(int rows)
+{
+    QByteArray out = "x,y,z,rx,ry,rz\n";
+    out.reserve(rows * 48);
+    for (int i = 0; i < rows; ++i) {
+        if (i % 1000 == 999) out += "# block\n\n";
+        out += QByteArray::number(100.0 + i * 0.125, 'f', 3) + ','
+             + QByteArray::number(-250.5 + (i % 97), 'f', 3) + ','
+             + QByteArray::number(12.25, 'f', 3) + ','
+             + QByteArray::number(180.0 - (i % 7), 'f', 3) + ",0.000,"
+             + QByteArray::number((i % 360) - 180.0, 'f', 3) + '\n';
+    }
+    return out;
+}
+
+bool samePoses(const QVector<Pose6D>& a, const QVector<Pose6D>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        const Pose6D& p = a[i];
+        const Pose6D& q = b[i];
+        if (p.x != q.x || p.y != q.y || p.z != q.z || p.rx != q.rx || p.ry != q.ry || p.rz != q.rz)
+            return false;
+    }
+    return true;
+}
+
+// ---- 기준 구현: 기존 VisionClient/Server 의 indexOf/left/remove(0, n) 프레이밍
+int refFrameLines(QByteArray& buf, qint64* bytes)
+{
+    int lines = 0;
+    int idx = -1;
+    while ((idx = buf.indexOf('\n')) >= 0) {
+        QByteArray line = buf.left(idx);
+        buf.remove(0, idx + 1);
+        if (!line.isEmpty() && line.endsWith('\r'))
+            line.chop(1);
+        line = line.trimmed();
+        if (line.isEmpty()) continue;
+        ++lines;
+        *bytes += line.size();
+    }
+    return lines;
+}
+
+int framerLines(LineFramer& f, qint64* bytes)
+{
+    int lines = 0;
+    LineFramer::Line l;
+    while (f.next(l)) {
+        const LineFramer::Line t = l.trimmed();
+        if (t.isEmpty()) continue;
+        ++lines;
+        *bytes += t.size;
+    }
+    return lines;
+}
+
+// 비전 명령과 비슷한 길이(약 110B)의 줄 n 개, CRLF 섞음
+QByteArray makeBurst(int n)
+{
+    QByteArray out;
+    out.reserve(n * 120);
+    for (int i = 0; i < n; ++i) {
+        out += R"({"dir":10,"robot":"a","seq":)" + QByteArray::number(i)
+             + R"(,"cmd":"tool","pose":[412.5,-103.25,88.0,180.0,0.0,)"
+             + QByteArray::number(i % 360) + "]}";
+        out += (i % 3 == 0) ? "\r\n" : "\n";
+    }
+    return out;
+}
+
+} // namespace
+
+class BenchCore : public QObject
+{
+    Q_OBJECT
+private slots:
+    void csvLoader_data();
+    void csvLoader();
+    void lineFramerBurst_data();
+    void lineFramerBurst();
+    void commandDecode_data();
+    void commandDecode();
+    void jsonWrite_data();
+    void jsonWrite();
+};
+
+// ─────────────────────────────────────────────────────────────
+// PoseCsvLoader vs QTextStream (user-032)
+// ─────────────────────────────────────────────────────────────
+void BenchCore::csvLoader_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<int>("impl");      // 0: QTextStream 기준, 1: 로더 단일 스레드, 2: 로더 하드웨어 스레드
+    for (int rows : {10000, 200000}) {
+        QTest::newRow(qPrintable(QString("qtextstream/%1").arg(rows))) << rows << 0;
+        QTest::newRow(qPrintable(QString("loader-1t/%1").arg(rows)))   << rows << 1;
+        QTest::newRow(qPrintable(QString("loader-mt/%1").arg(rows)))   << rows << 2;
+    }
+}
+
+void BenchCore::csvLoader()
+{
+    QFETCH(int, rows);
+    QFETCH(int, impl);
+    const QByteArray csv = makeCsv(rows);
+
+    const QVector<Pose6D> expected = refParse(csv);
+    QCOMPARE(expected.size(), rows);
+    if (impl != 0) {
+        const PoseCsvLoader::Result r = PoseCsvLoader::parse(csv.constData(), csv.size(), impl == 1 ? 1 : 0);
+        QVERIFY(r.ok());
+        QVERIFY(samePoses(r.poses, expected));
+    }
+
+    if (impl == 0) {
+        QBENCHMARK { refParse(csv); }
+    } else {
+        const int threads = impl == 1 ? 1 : 0;
+        QBENCHMARK { PoseCsvLoader::parse(csv.constData(), csv.size(), threads); }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────
+// LineFramer vs indexOf/remove — 한 번에 도착한 10k 줄 버스트 (user-035)
+// ─────────────────────────────────────────────────────────────
+void BenchCore::lineFramerBurst_data()
+{
+    QTest::addColumn<int>("lines");
+    QTest::addColumn<bool>("framer");
+    for (int n : {1000, 10000}) {
+        QTest::newRow(qPrintable(QString("remove/%1").arg(n))) << n << false;
+        QTest::newRow(qPrintable(QString("framer/%1").arg(n))) << n << true;
+    }
+}
+
+void BenchCore::lineFramerBurst()
+{
+    QFETCH(int, lines);
+    QFETCH(bool, framer);
+    const QByteArray burst = makeBurst(lines);
+
+    qint64 refBytes = 0, newBytes = 0;
+    QByteArray ref = burst;
+    QCOMPARE(refFrameLines(ref, &refBytes), lines);
+    LineFramer check;
+    check.append(burst.constData(), burst.size());
+    QCOMPARE(framerLines(check, &newBytes), lines);
+    QCOMPARE(newBytes, refBytes);
+
+    qint64 sink = 0;
+    if (framer) {
+        LineFramer f;   // 재사용 (소켓 하나에 버스트가 이어지는 경우와 같음)
+        QBENCHMARK {
+            f.append(burst.constData(), burst.size());
+            framerLines(f, &sink);
+        }
+    } else {
+        QBENCHMARK {
+            QByteArray buf;
+            buf.append(burst);
+            refFrameLines(buf, &sink);
+        }
+    }
+    QVERIFY(sink > 0);
+}
+
+// ─────────────────────────────────────────────────────────────
+// RobotCommandParser::decode vs QJsonDocument + parse — 줄 하나당 비용 (user-036)
+// ─────────────────────────────────────────────────────────────
+void BenchCore::commandDecode_data()
+{
+    QTest::addColumn<QByteArray>("line");
+    QTest::addColumn<bool>("fast");
+    const QByteArray pick = R"({"dir":1,"robot":"a","type":"bulk","kind":"pick","seq":1017,)"
+                            R"("pose":{"x":412.5,"y":-103.25,"z":88.0,"rx":180.0,"ry":0.0,"rz":-45.5}})";
+    const QByteArray tool = R"({"dir":1,"robot":"b","type":"tool","kind":"change","seq":1018,)"
+                            R"("tool":{"from":"gripper","to":"vacuum"}})";
+    const QByteArray ack  = R"({"type":"ack","seq":1019,"status":"ok","message":"done"})";
+    for (const auto& c : {qMakePair("pick", pick), qMakePair("tool", tool), qMakePair("ack", ack)}) {
+        QTest::newRow(qPrintable(QString("dom/%1").arg(c.first)))    << c.second << false;
+        QTest::newRow(qPrintable(QString("decode/%1").arg(c.first))) << c.second << true;
+    }
+}
+
+void BenchCore::commandDecode()
+{
+    QFETCH(QByteArray, line);
+    QFETCH(bool, fast);
+
+    RobotCommand cmd;
+    QVERIFY(RobotCommandParser::decode(line.constData(), line.size(), cmd));
+
+    if (fast) {
+        QBENCHMARK {
+            RobotCommand c;
+            RobotCommandParser::Extras ex;
+            RobotCommandParser::decode(line.constData(), line.size(), c, &ex);
+        }
+    } else {
+        QBENCHMARK {
+            RobotCommand c;
+            RobotCommandParser::parse(QJsonDocument::fromJson(line).object(), c);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────
+// JsonTemplate / appendJson vs QJsonObject + toJson(Compact) (user-041)
+// ─────────────────────────────────────────────────────────────
+void BenchCore::jsonWrite_data()
+{
+    QTest::addColumn<int>("msg");       // 0: work complete, 1: RobotCommand 직렬화
+    QTest::addColumn<bool>("tmpl");
+    QTest::newRow("qjson/workComplete")    << 0 << false;
+    QTest::newRow("template/workComplete") << 0 << true;
+    QTest::newRow("qjson/command")         << 1 << false;
+    QTest::newRow("template/command")      << 1 << true;
+}
+
+void BenchCore::jsonWrite()
+{
+    QFETCH(int, msg);
+    QFETCH(bool, tmpl);
+
+    static const JsonTemplate kWorkComplete(
+        R"({"dir":11,"error_code":0,"kind":%s,"robot":%s,"seq":%d,"success":true,"type":%s})");
+    const QString kind = QStringLiteral("pick"), robot = QStringLiteral("a"), type = QStringLiteral("bulk");
+    const int seq = 1017;
+
+    RobotCommand cmd;
+    cmd.robot = RobotId::A;
+    cmd.type = CmdType::Bulk;
+    cmd.kind = CmdKind::Pick;
+    cmd.seq = 1017;
+    cmd.dir = 1;
+    cmd.hasPick = cmd.hasPlace = true;
+    cmd.pick = Pose6D{412.375, -118.25, 95.5, 179.98, -0.12, 91.004};
+    cmd.place = Pose6D{-20.5, 610.125, 40.0, 180.0, 0.0, -89.75};
+
+    auto viaQt = [&] {
+        if (msg == 0)
+            return QJsonDocument(QJsonObject{{"dir", 11}, {"error_code", 0}, {"kind", kind}, {"robot", robot},
+                                             {"seq", seq}, {"success", true}, {"type", type}})
+                .toJson(QJsonDocument::Compact);
+        return QJsonDocument(RobotCommandSerializer::toJson(cmd)).toJson(QJsonDocument::Compact);
+    };
+    auto viaTemplate = [&] {
+        QByteArray out;
+        out.reserve(256);
+        if (msg == 0) kWorkComplete.render(out, kind, robot, seq, type);
+        else          RobotCommandSerializer::appendJson(cmd, out);
+        return out;
+    };
+    QCOMPARE(viaTemplate(), viaQt());
+
+    if (tmpl) { QBENCHMARK { viaTemplate(); } }
+    else      { QBENCHMARK { viaQt(); } }
+}
+
+QTEST_GUILESS_MAIN(BenchCore)
+#include "bench_core.moc"
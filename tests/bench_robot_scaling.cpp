@@ -0,0 +1,195 @@
+// ─────────────────────────────────────────────────────────────
+// bench_robot_scaling — 로봇 N 대 확장성 벤치마크
+//
+//   bench_robot_scaling [--robots 1,2,4,8] [--seconds 5] [--period-ms 300]
+//                       [--width-ms 120] [--port 15020]
+//
+// 로봇마다 Modbus 에뮬레이터(루프백)를 띄우고 RobotManager 로 실제 경로
+// (ModbusClient 폴링 → Orchestrator 에지 검출 → processPulse 처리)를 그대로 돌린다.
+// 에뮬레이터가 로봇마다 period-ms 간격으로 DO3_PULSE 를 켜고(width-ms), 코어가
+// pulseReceived 를 낼 때까지의 지연과 프로세스 CPU 시간을 잰다.
+//
+// 선형 확장이면: 로봇당 CPU(ms/s) 가 N 과 무관하게 거의 일정하고, 지연 분포
+// (폴링 주기 50ms 가 지배)도 N 이 늘어도 변하지 않는다. 에뮬레이터도 같은
+// 프로세스에서 돌므로 CPU 에는 서버 쪽 비용이 함께 들어간다.
+// CPU 시간은 std::clock() (Linux: 프로세스 CPU 시간)
+// ─────────────────────────────────────────────────────────────
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <QVector>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+
+#include "AddressMapBuiltin.h"
+#include "AddressMapGenerated.h"
+#include "ModbusEmulator.h"
+#include "MonoClock.h"
+#include "RobotManager.h"
+
+namespace {
+
+struct Args {
+    QVector<int> robots{1, 2, 4, 8};
+    int seconds = 5;
+    int periodMs = 300;
+    int widthMs = 120;
+    int port = 15020;
+};
+
+bool parseArgs(const QStringList& a, Args& out)
+{
+    for (int i = 1; i + 1 < a.size(); i += 2) {
+        const QString& k = a[i];
+        const QString& v = a[i + 1];
+        if (k == "--robots") {
+            out.robots.clear();
+            for (const QString& n : v.split(',', Qt::SkipEmptyParts))
+                out.robots << qBound(1, n.toInt(), kMaxRobots);
+        }
+        else if (k == "--seconds")   out.seconds = qMax(1, v.toInt());
+        else if (k == "--period-ms") out.periodMs = qMax(10, v.toInt());
+        else if (k == "--width-ms")  out.widthMs = qMax(1, v.toInt());
+        else if (k == "--port")      out.port = v.toInt();
+        else return false;
+    }
+    return !out.robots.isEmpty();
+}
+
+void waitMs(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+double percentile(QVector<double> v, double q)
+{
+    if (v.isEmpty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[qMin(v.size() - 1, int(q * v.size()))];
+}
+
+struct Result {
+    int robots = 0;
+    int connected = 0;
+    quint64 sent = 0;
+    quint64 received = 0;
+    QVector<double> latencyMs;
+    double cpuMsPerSec = 0.0;
+};
+
+Result runRound(int n, const Args& a, const QVariantMap& addr)
+{
+    Result res;
+    res.robots = n;
+
+    // 람다가 참조하는 지역 변수는 mgr 보다 먼저 선언 (mgr 가 먼저 파괴되도록)
+    QVector<qint64> pulseAtNs(n, -1);
+    QVector<ModbusEmulator*> emu(n, nullptr);   // mgr 소유
+    auto mgr = std::make_unique<RobotManager>();
+    const int pulseAddr = AddressMapGen::A::discrete_inputs::DO3_PULSE;
+    const quint16 basePort = quint16(a.port + n * kMaxRobots);   // 라운드마다 다른 포트 (TIME_WAIT 회피)
+
+    for (int i = 0; i < n; ++i) {
+        emu[i] = new ModbusEmulator(mgr.get());
+        QString err;
+        if (!emu[i]->listen(quint16(basePort + i), QStringLiteral("127.0.0.1"), &err)) {
+            std::fprintf(stderr, "robot %d: cannot listen on %d: %s\n", i, basePort + i, qPrintable(err));
+            return res;
+        }
+    }
+
+    QObject::connect(mgr.get(), &RobotManager::connectionChanged, mgr.get(),
+                     [&](const QString& id, bool up) {
+        if (!up) return;
+        ++res.connected;
+        mgr->start(id);
+    });
+    QObject::connect(mgr.get(), &RobotManager::pulseReceived, mgr.get(),
+                     [&](const QString& id, int) {
+        const int i = id.at(0).unicode() - 'A';
+        if (i < 0 || i >= n || pulseAtNs[i] < 0) return;
+        res.latencyMs << (MonoClock::nowNs() - pulseAtNs[i]) / 1e6;
+        pulseAtNs[i] = -1;
+        ++res.received;
+    });
+
+    for (int i = 0; i < n; ++i)
+        mgr->addOrConnect(QString(QChar('A' + i)), QStringLiteral("127.0.0.1"), basePort + i, addr, nullptr);
+
+    for (int t = 0; t < 300 && res.connected < n; ++t)
+        waitMs(10);
+    if (res.connected < n) {
+        std::fprintf(stderr, "robots=%d: only %d connected\n", n, res.connected);
+        return res;
+    }
+    waitMs(200);    // 첫 폴링/상태 안정화
+
+    // 로봇마다 위상을 나눠 펄스 발생
+    QVector<QTimer*> drivers;
+    for (int i = 0; i < n; ++i) {
+        auto* t = new QTimer(mgr.get());
+        t->setTimerType(Qt::PreciseTimer);
+        t->setInterval(a.periodMs);
+        QObject::connect(t, &QTimer::timeout, mgr.get(), [&, i] {
+            pulseAtNs[i] = MonoClock::nowNs();
+            emu[i]->pulse(pulseAddr, a.widthMs);
+            ++res.sent;
+        });
+        QTimer::singleShot(i * a.periodMs / n, t, [t] { t->start(); });
+        drivers << t;
+    }
+
+    const std::clock_t c0 = std::clock();
+    QElapsedTimer wall;
+    wall.start();
+    waitMs(a.seconds * 1000);
+    const double cpuMs = double(std::clock() - c0) * 1000.0 / CLOCKS_PER_SEC;
+    res.cpuMsPerSec = cpuMs / (wall.elapsed() / 1000.0);
+
+    for (QTimer* t : drivers) t->stop();
+    mgr->stopAll();
+    waitMs(a.widthMs + 100);
+    return res;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    MonoClock::anchor();
+
+    Args a;
+    if (!parseArgs(app.arguments(), a)) {
+        std::fprintf(stderr, "usage: bench_robot_scaling [--robots 1,2,4,8] [--seconds 5] "
+                             "[--period-ms 300] [--width-ms 120] [--port 15020]\n");
+        return 1;
+    }
+
+    QVariantMap addr;
+    if (!AddressMapBuiltin::lookup(QStringLiteral(":/map/AddressMap_A.json"), &addr)) {
+        std::fprintf(stderr, "built-in address map A missing\n");
+        return 1;
+    }
+
+    std::printf("%-6s %8s %8s %9s %9s %9s %10s %12s\n",
+                "robots", "sent", "recv", "p50(ms)", "p99(ms)", "max(ms)", "cpu(ms/s)", "cpu/robot");
+    int rc = 0;
+    for (int n : a.robots) {
+        const Result r = runRound(n, a, addr);
+        if (r.connected < n) { rc = 2; continue; }
+        std::printf("%-6d %8llu %8llu %9.2f %9.2f %9.2f %10.2f %12.2f\n",
+                    n, (unsigned long long)r.sent, (unsigned long long)r.received,
+                    percentile(r.latencyMs, 0.50), percentile(r.latencyMs, 0.99),
+                    percentile(r.latencyMs, 1.0), r.cpuMsPerSec, r.cpuMsPerSec / n);
+        std::fflush(stdout);
+        if (r.received + n < r.sent) rc = 2;   // 라운드 끝에 걸린 펄스(로봇당 1개)는 허용
+    }
+    return rc;
+}
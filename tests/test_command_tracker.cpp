@@ -0,0 +1,109 @@
+// ─────────────────────────────────────────────────────────────
+// CommandTracker / VisionClient 명령 귀속 테스트
+//  - 실패 마감(finish ok=false)은 failed 로만 세고 히스토그램에는 넣지 않는다.
+//  - 에러 보고 뒤의 완료는 실패한 명령이 아니라 새 명령의 seq 로 간다 (루프백 소켓으로 실제 경로 확인).
+// ─────────────────────────────────────────────────────────────
+#include <QtTest>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "vision/CommandTracker.h"
+#include "vision/VisionClient.h"
+
+namespace {
+
+RobotCommand command(quint32 seq, RobotId robot = RobotId::A)
+{
+    RobotCommand c;
+    c.robot = robot;
+    c.type = CmdType::Bulk;
+    c.kind = CmdKind::Pick;
+    c.seq = seq;
+    c.dir = 1;
+    return c;
+}
+
+QByteArray commandLine(quint32 seq)
+{
+    return QByteArray(R"({"dir":1,"robot":"a","type":"bulk","kind":"pick","seq":)") + QByteArray::number(seq)
+         + R"(,"pose":{"x":1,"y":2,"z":3,"rx":0,"ry":0,"rz":0}})" + '\n';
+}
+
+} // namespace
+
+class TestCommandTracker : public QObject
+{
+    Q_OBJECT
+private slots:
+    void failedIsCountedNotRecorded();
+    void errorThenCompletionReportsNewSeq();
+};
+
+void TestCommandTracker::failedIsCountedNotRecorded()
+{
+    CommandTracker t;
+    t.begin(command(1), 0);
+    t.begin(command(2), 10);
+
+    CommandTracker::Entry e;
+    QVERIFY(t.finish(1, 50, false, &e));
+    QCOMPARE(e.t[CommandTracker::Done], qint64(50));
+    QVERIFY(!t.finish(1, 60, false));   // 이미 마감
+    QCOMPARE(t.active(0)->seq, quint32(2));
+
+    QVERIFY(t.finish(2, 80, true));
+    const QJsonObject j = t.toJson();
+    QCOMPARE(j.value("failed").toInt(), 1);
+    QCOMPARE(j.value("completed").toInt(), 1);
+    QCOMPARE(j.value("in_flight").toInt(), 0);
+    const QJsonObject total = j.value("commands").toObject().value("bulk.pick").toObject()
+                                  .value("total").toObject();
+    QCOMPARE(total.value("count").toInt(), 1);   // 실패한 명령은 지연 분포에 없음
+}
+
+void TestCommandTracker::errorThenCompletionReportsNewSeq()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost, 0));
+
+    VisionClient vc;
+    int received = 0;
+    connect(&vc, &VisionClient::commandReceived, this, [&](const RobotCommand&) { ++received; });
+    vc.connectTo(QStringLiteral("127.0.0.1"), server.serverPort());
+    QVERIFY(server.waitForNewConnection(3000));
+    QTcpSocket* peer = server.nextPendingConnection();
+    QVERIFY(peer);
+    QTRY_VERIFY(vc.isConnected());
+
+    peer->write(commandLine(101));
+    QTRY_COMPARE(received, 1);
+    QCOMPARE(vc.commandTracker().inFlight(), 1);
+
+    vc.sendError(QStringLiteral("A"), QStringLiteral("gripper fault"), 3, 1);
+    QCOMPARE(vc.commandTracker().inFlight(), 0);
+    QCOMPARE(vc.commandTracker().toJson().value("failed").toInt(), 1);
+
+    peer->write(commandLine(102));
+    QTRY_COMPARE(received, 2);
+    vc.sendWorkComplete(QStringLiteral("A"), QStringLiteral("bulk"), QStringLiteral("pick"), 0);
+
+    // 피어가 받은 줄: 에러(seq 101) → 완료(seq 102)
+    QVector<QJsonObject> out;
+    auto readLines = [&] {
+        while (peer->canReadLine())
+            out << QJsonDocument::fromJson(peer->readLine()).object();
+        return out.size() >= 2;
+    };
+    QTRY_VERIFY_WITH_TIMEOUT(readLines(), 3000);
+    QCOMPARE(out[0].value("error_code").toInt(), 1);
+    QCOMPARE(out[0].value("seq").toInt(), 101);
+    QCOMPARE(out[1].value("success").toBool(), true);
+    QCOMPARE(out[1].value("seq").toInt(), 102);
+    QCOMPARE(vc.commandTracker().toJson().value("completed").toInt(), 1);
+}
+
+QTEST_GUILESS_MAIN(TestCommandTracker)
+#include "test_command_tracker.moc"
@@ -0,0 +1,250 @@
+// ─────────────────────────────────────────────────────────────
+// JsonTemplate / JsonText 바이트 동일성 테스트
+//
+// JsonTemplate.h 의 약속: 출력이 QJsonDocument::toJson(Compact) 와 바이트 단위로 같다.
+// Qt 를 기준(oracle)으로 실수/문자열 변환, VisionClient 송신 템플릿 형태,
+// RobotCommandSerializer::appendJson 을 무작위 입력으로 비교한다.
+// renderCbor 는 WireFormat::encode(obj, Cbor) 본문과 비교한다.
+// ─────────────────────────────────────────────────────────────
+#include <QtTest>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "JsonTemplate.h"
+#include "LineFramer.h"
+#include "RobotCommandSerializer.h"
+#include "WireFormat.h"
+
+namespace {
+
+QByteArray compact(const QJsonObject& o)
+{
+    return QJsonDocument(o).toJson(QJsonDocument::Compact);
+}
+
+// cbor1 프레임에서 헤더를 뗀 CBOR 본문
+QByteArray cborBody(const QJsonObject& o)
+{
+    return WireFormat::encode(o, WireFormat::Proto::Cbor).mid(LineFramer::kBinaryHeader);
+}
+
+// Qt 가 쓰는 값 하나 ([x] 에서 괄호 제거)
+QByteArray qtValue(const QJsonValue& v)
+{
+    const QByteArray a = QJsonDocument(QJsonArray{v}).toJson(QJsonDocument::Compact);
+    return a.mid(1, a.size() - 2);
+}
+
+double randomDouble(QRandomGenerator& rng)
+{
+    switch (rng.bounded(4)) {
+    case 0: {   // 임의 비트 패턴 (NaN/Inf 제외)
+        double d;
+        do {
+            const quint64 bits = rng.generate64();
+            std::memcpy(&d, &bits, sizeof d);
+        } while (!std::isfinite(d));
+        return d;
+    }
+    case 1:  return (rng.generateDouble() - 0.5) * 4000.0;                       // 좌표 범위
+    case 2:  return std::round((rng.generateDouble() - 0.5) * 2e6) / 1000.0;      // 소수 셋째 자리
+    default: return double(qint64(rng.generate64() >> rng.bounded(64))) * (rng.bounded(2) ? 1 : -1);
+    }
+}
+
+QString randomString(QRandomGenerator& rng)
+{
+    static const char16_t kChars[] = u"abcXYZ 019\"\\/\b\f\n\r\t\x01\x1f\x7f가나é€";
+    QString s;
+    const int n = int(rng.bounded(12));
+    for (int i = 0; i < n; ++i)
+        s += QChar(kChars[rng.bounded(int(std::size(kChars)) - 1)]);
+    if (rng.bounded(8) == 0)
+        s += QString::fromUcs4(U"\U0001F600");   // 서로게이트 쌍
+    return s;
+}
+
+Pose6D randomPose(QRandomGenerator& rng)
+{
+    return Pose6D{randomDouble(rng), randomDouble(rng), randomDouble(rng),
+                  randomDouble(rng), randomDouble(rng), randomDouble(rng)};
+}
+
+} // namespace
+
+class TestJsonTemplate : public QObject
+{
+    Q_OBJECT
+private slots:
+    void doubles();
+    void doubleEdgeCases();
+    void strings();
+    void templates();
+    void cborTemplates();
+    void serializer();
+};
+
+void TestJsonTemplate::doubles()
+{
+    QRandomGenerator rng(0x4A53u);
+    for (int i = 0; i < 200000; ++i) {
+        const double d = randomDouble(rng);
+        QByteArray mine;
+        JsonText::appendDouble(mine, d);
+        const QByteArray qt = qtValue(d);
+        if (mine != qt)
+            QFAIL(qPrintable(QString("%1: mine=%2 qt=%3").arg(d, 0, 'g', 17)
+                                 .arg(QString::fromLatin1(mine), QString::fromLatin1(qt))));
+    }
+}
+
+void TestJsonTemplate::doubleEdgeCases()
+{
+    const double cases[] = {
+        0.0, -0.0, 1.0, -1.0, 0.1, 1e-7, 1e-6, 1e20, 1e21, 1e22, 123456789012345680.0,
+        9007199254740992.0, 9007199254740994.0, -9007199254740992.0, 1.5e300, 5e-324,
+        std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(), 412.375, -118.25, 0.30000000000000004,
+    };
+    for (double d : cases) {
+        QByteArray mine;
+        JsonText::appendDouble(mine, d);
+        QCOMPARE(mine, qtValue(d));
+    }
+}
+
+void TestJsonTemplate::strings()
+{
+    QRandomGenerator rng(0x5354u);
+    for (int i = 0; i < 20000; ++i) {
+        const QString s = randomString(rng);
+        QByteArray mine;
+        JsonText::appendString(mine, s);
+        QCOMPARE(mine, qtValue(s));
+    }
+    QByteArray lat;
+    JsonText::appendLatin1(lat, "open \"x\"\t\\");
+    QCOMPARE(lat, qtValue(QStringLiteral("open \"x\"\t\\")));
+}
+
+// VisionClient 송신 메시지와 같은 형태 (키는 사전순)
+void TestJsonTemplate::templates()
+{
+    static const JsonTemplate workComplete(
+        R"({"dir":11,"error_code":0,"kind":%s,"robot":%s,"seq":%d,"success":true,"type":%s})");
+    static const JsonTemplate error(
+        R"({"dir":11,"error":{"error":%s,"main":%d,"sub":%d},"error_code":1,"kind":%s,"robot":%s,"seq":%d,"type":%s})");
+    static const JsonTemplate pose(
+        R"({"dir":%d,"ok":%b,"pose":{"rx":%f,"ry":%f,"rz":%f,"x":%f,"y":%f,"z":%f},"robot":%s,"tag":%r})");
+
+    QRandomGenerator rng(0x544Du);
+    for (int i = 0; i < 5000; ++i) {
+        const QString kind = randomString(rng), robot = randomString(rng), type = randomString(rng);
+        const int seq = int(rng.generate());
+        const int main = int(rng.bounded(1000)) - 500, sub = int(rng.bounded(100));
+        QByteArray mine;
+
+        workComplete.render(mine, kind, robot, seq, type);
+        QCOMPARE(mine, compact(QJsonObject{{"dir", 11}, {"error_code", 0}, {"kind", kind}, {"robot", robot},
+                                           {"seq", seq}, {"success", true}, {"type", type}}));
+
+        mine.clear();
+        const QString msg = randomString(rng);
+        error.render(mine, msg, main, sub, kind, robot, seq, type);
+        QCOMPARE(mine, compact(QJsonObject{
+            {"dir", 11}, {"error", QJsonObject{{"error", msg}, {"main", main}, {"sub", sub}}}, {"error_code", 1},
+            {"kind", kind}, {"robot", robot}, {"seq", seq}, {"type", type}}));
+
+        mine.clear();
+        const Pose6D p = randomPose(rng);
+        const bool ok = rng.bounded(2);
+        const QByteArray tag = compact(QJsonObject{{"n", i}});
+        pose.render(mine, 1, ok, p.rx, p.ry, p.rz, p.x, p.y, p.z, robot, JsonTemplate::Raw{tag});
+        QCOMPARE(mine, compact(QJsonObject{
+            {"dir", 1}, {"ok", ok},
+            {"pose", QJsonObject{{"rx", p.rx}, {"ry", p.ry}, {"rz", p.rz}, {"x", p.x}, {"y", p.y}, {"z", p.z}}},
+            {"robot", robot}, {"tag", QJsonObject{{"n", i}}}}));
+    }
+}
+
+// 같은 템플릿의 CBOR 출력 (JSON 텍스트를 거치지 않음)
+void TestJsonTemplate::cborTemplates()
+{
+    static const JsonTemplate error(
+        R"({"dir":11,"error":{"error":%s,"main":%d,"sub":%d},"error_code":1,"kind":%s,"robot":%s,"seq":%d,"type":%s})");
+    static const JsonTemplate pose(
+        R"({"dir":%d,"ok":%b,"pose":{"rx":%f,"ry":%f,"rz":%f,"x":%f,"y":%f,"z":%f},"robot":%s,"tag":%r})");
+    static const JsonTemplate tag(R"({"n":%d})");
+    static const JsonTemplate fragment(R"("dir":%d,"flip":%b)");
+    QVERIFY(error.hasCbor());
+    QVERIFY(!fragment.hasCbor());
+
+    QRandomGenerator rng(0x4342u);
+    for (int i = 0; i < 5000; ++i) {
+        const QString kind = randomString(rng), robot = randomString(rng), type = randomString(rng);
+        const int seq = int(rng.generate());
+        const int main = int(rng.bounded(1000)) - 500, sub = int(rng.bounded(100));
+        QByteArray mine;
+
+        const QString msg = randomString(rng);
+        error.renderCbor(mine, msg, main, sub, kind, robot, seq, type);
+        QCOMPARE(mine, cborBody(QJsonObject{
+            {"dir", 11}, {"error", QJsonObject{{"error", msg}, {"main", main}, {"sub", sub}}}, {"error_code", 1},
+            {"kind", kind}, {"robot", robot}, {"seq", seq}, {"type", type}}));
+
+        mine.clear();
+        const Pose6D p = randomPose(rng);
+        const bool ok = rng.bounded(2);
+        QByteArray tagCbor;
+        tag.renderCbor(tagCbor, i);
+        pose.renderCbor(mine, 1, ok, p.rx, p.ry, p.rz, p.x, p.y, p.z, robot, JsonTemplate::Raw{tagCbor});
+        QCOMPARE(mine, cborBody(QJsonObject{
+            {"dir", 1}, {"ok", ok},
+            {"pose", QJsonObject{{"rx", p.rx}, {"ry", p.ry}, {"rz", p.rz}, {"x", p.x}, {"y", p.y}, {"z", p.z}}},
+            {"robot", robot}, {"tag", QJsonObject{{"n", i}}}}));
+    }
+}
+
+void TestJsonTemplate::serializer()
+{
+    QRandomGenerator rng(0x5345u);
+    for (int i = 0; i < 20000; ++i) {
+        RobotCommand c;
+        c.robot = RobotId(rng.bounded(int(RobotId::Unknown) + 1));
+        c.type = CmdType(rng.bounded(int(CmdType::Unknown) + 1));
+        c.kind = CmdKind(rng.bounded(int(CmdKind::Unknown) + 1));
+        c.seq = rng.generate();
+        c.dir = int(rng.bounded(12));
+        c.flip = rng.bounded(2);
+        c.offset = int(rng.bounded(200)) - 100;
+        c.isOffset = rng.bounded(2);
+        c.sortOffset = sortingOffset{int(rng.bounded(100)), int(rng.bounded(20)), int(rng.bounded(10))};
+        c.isArrange = rng.bounded(2);
+        c.arrangeCmd = arrangeCommnad{randomPose(rng), randomPose(rng)};
+        c.clamp = rng.bounded(2) ? QStringLiteral("open") : randomString(rng);
+        c.clampSequenceMode = int(rng.bounded(3));
+        c.hasPick = rng.bounded(2);
+        c.hasPlace = rng.bounded(2);
+        c.pick = randomPose(rng);
+        c.place = randomPose(rng);
+        c.isTool = rng.bounded(2);
+        c.toolCmd = ToolCommand{randomString(rng), randomString(rng), randomString(rng)};
+        c.mode = rng.bounded(2) ? QStringLiteral("dual") : randomString(rng);
+
+        QByteArray mine;
+        RobotCommandSerializer::appendJson(c, mine);
+        QCOMPARE(mine, compact(RobotCommandSerializer::toJson(c)));
+        QCOMPARE(RobotCommandSerializer::toJsonLine(c), mine);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestJsonTemplate)
+#include "test_json_template.moc"
@@ -0,0 +1,220 @@
+// ─────────────────────────────────────────────────────────────
+// RobotCommandParser::decode 차등 퍼즈 테스트
+//
+// decode() 의 약속: true 를 돌려준 줄은 QJsonDocument::fromJson 으로도 객체로 읽히고,
+// 결과 RobotCommand/Extras 가 DOM 경로(VisionClient 의 parse + ack/hello 처리)와 같다.
+// 시드 명령 줄을 무작위로 변형(바이트 치환/삭제/삽입/구간 복제/절단/숫자 치환/시드 접합)해
+// decode 가 받아들인 모든 입력을 DOM 결과와 필드 단위로 비교한다.
+//
+//   MRC_FUZZ_SEED=<n>  난수 시드 (기본 고정값, 실패 시 메시지에 출력)
+//   MRC_FUZZ_ITER=<n>  변형 입력 수 (기본 20000)
+// ─────────────────────────────────────────────────────────────
+#include <QtTest>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+
+#include <cstring>
+#include <iterator>
+
+#include "RobotCommandParser.h"
+
+namespace {
+
+const char* const kSeeds[] = {
+    R"({"dir":1,"robot":"a","type":"bulk","kind":"pick","seq":17,"pose":{"x":412.5,"y":-103.25,"z":88,"rx":180,"ry":0,"rz":-45.5}})",
+    R"({"dir":1,"robot":"b","type":"align","kind":"place","seq":18,"clamp_mode":2,"pose":{"x":1,"y":2,"z":3,"rx":4,"ry":5,"rz":6}})",
+    R"({"dir":1,"robot":"A","type":"sorting","kind":"place","seq":19,"offset":{"height":12,"thickness":3},"flip":true})",
+    R"({"dir":1,"robot":"b","type":"tool","kind":"change","seq":20,"tool":{"from":"gripper","to":"vacuum"}})",
+    R"({"dir":1,"robot":"b","type":"tool","kind":"mount","seq":21,"tool":{"name":"gripper"}})",
+    R"({"dir":1,"robot":"a","type":"bulk","kind":"arrange","seq":22,"arrange":{"start":{"x":1,"y":2,"z":3,"rx":0,"ry":0,"rz":0},"dest":{"x":4,"y":5,"z":6,"rx":0,"ry":0,"rz":90}}})",
+    R"({"dir":1,"robot":"a","type":"bulk","kind":"pick","seq":23,"mode":"single","pick":{"x":1e2,"y":-0.5,"z":0,"rx":1.5e-3,"ry":2,"rz":3},"place":{"x":1,"y":2,"z":3,"rx":4,"ry":5}})",
+    R"({"dir":1,"robot":"b","type":"conveyor","kind":"forward","seq":24,"clamp":"open","offset":7})",
+    R"({"type":"ack","seq":25,"status":"ok","message":"done"})",
+    R"({"type":"hello","proto":"cbor1"})",
+    R"({"dir":11,"robot":"c","type":"bulk","kind":"standby","seq":4294967295,"extra":[1,{"a":[true,false,null]},"s\"q"]})",
+    R"(  {"seq": 1.0, "dir": -0, "robot": "h", "kind": "init", "unknown": {"nested": {"x": 1}}}  )",
+};
+
+// 입력을 망가뜨리는 데 잘 먹히는 바이트 (문법 문자/숫자/비ASCII/제어 문자)
+const char kAlphabet[] = "{}[]:,\"\\ \t\r\n0123456789-+.eEtrufalsnxyzabh#\x01\x7f\xc3\xa9\xff";
+
+// "-0" 은 DOM 에서 정수 0 → +0.0, decode 에서는 -0.0 이라 == 로 비교
+bool samePose(const Pose6D& a, const Pose6D& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.rx == b.rx && a.ry == b.ry && a.rz == b.rz;
+}
+
+// 다른 필드 이름 (같으면 빈 문자열)
+QString diff(const RobotCommand& a, const RobotCommand& b)
+{
+    if (a.robot != b.robot)                 return "robot";
+    if (a.type != b.type)                   return "type";
+    if (a.kind != b.kind)                   return "kind";
+    if (a.seq != b.seq)                     return "seq";
+    if (a.dir != b.dir)                     return "dir";
+    if (a.flip != b.flip)                   return "flip";
+    if (a.offset != b.offset)               return "offset";
+    if (a.isOffset != b.isOffset)           return "isOffset";
+    if (a.isOffset && (a.sortOffset.height != b.sortOffset.height ||
+                       a.sortOffset.thickness != b.sortOffset.thickness))
+                                            return "sortOffset";
+    if (a.isArrange != b.isArrange)         return "isArrange";
+    if (a.isArrange && (!samePose(a.arrangeCmd.poseOrig, b.arrangeCmd.poseOrig) ||
+                        !samePose(a.arrangeCmd.poseDest, b.arrangeCmd.poseDest)))
+                                            return "arrangeCmd";
+    if (a.clamp != b.clamp)                 return "clamp";
+    if (a.clampSequenceMode != b.clampSequenceMode) return "clampSequenceMode";
+    if (a.hasPick != b.hasPick)             return "hasPick";
+    if (a.hasPlace != b.hasPlace)           return "hasPlace";
+    if (a.hasPick && !samePose(a.pick, b.pick))    return "pick";
+    if (a.hasPlace && !samePose(a.place, b.place)) return "place";
+    if (a.isTool != b.isTool)               return "isTool";
+    if (a.isTool && (a.toolCmd.toolName != b.toolCmd.toolName || a.toolCmd.toolFrom != b.toolCmd.toolFrom ||
+                     a.toolCmd.toolTo != b.toolCmd.toolTo))
+                                            return "toolCmd";
+    if (a.mode != b.mode)                   return "mode";
+    return QString();
+}
+
+QString diff(const RobotCommandParser::Extras& a, const RobotCommandParser::Extras& b)
+{
+    if (a.isAck != b.isAck)     return "isAck";
+    if (a.isAck && (a.status != b.status || a.message != b.message)) return "ack status/message";
+    if (a.isHello != b.isHello) return "isHello";
+    if (a.isHello && a.proto != b.proto) return "proto";
+    return QString();
+}
+
+// VisionClient 의 DOM 경로와 같은 처리
+void domDecode(const QJsonObject& obj, RobotCommand& cmd, RobotCommandParser::Extras& ex)
+{
+    const QString type = obj.value("type").toString();
+    ex.isAck = type == "ack";
+    if (ex.isAck) {
+        ex.status  = obj.value("status").toString();
+        ex.message = obj.value("message").toString();
+    }
+    ex.isHello = type == "hello";
+    if (ex.isHello)
+        ex.proto = obj.value("proto").toString();
+    RobotCommandParser::parse(obj, cmd);
+}
+
+class Mutator
+{
+public:
+    explicit Mutator(quint32 seed) : m_rng(seed) {}
+
+    QByteArray next()
+    {
+        QByteArray s = pickSeed();
+        const int rounds = 1 + bounded(4);
+        for (int r = 0; r < rounds && !s.isEmpty(); ++r) {
+            switch (bounded(7)) {
+            case 0: s[bounded(s.size())] = alpha(); break;
+            case 1: s.remove(bounded(s.size()), 1 + bounded(3)); break;
+            case 2: s.insert(bounded(s.size() + 1), alpha()); break;
+            case 3: {   // 구간 복제 (중복 키/깊은 중첩 유도)
+                const int at = bounded(s.size());
+                const int n = 1 + bounded(qMin(24, s.size() - at));
+                s.insert(bounded(s.size() + 1), s.mid(at, n));
+                break;
+            }
+            case 4: s.truncate(bounded(s.size())); break;
+            case 5: {   // 숫자 하나를 경계값으로
+                static const char* const kNums[] = {
+                    "0", "-0", "1.0", "2147483647", "2147483648", "-2147483649", "4294967296",
+                    "1e308", "1e-320", "9007199254740993", "0.1", "-1.5e3", "123456789012345678901234",
+                };
+                const int at = s.indexOf(QByteArray::number(bounded(10)));
+                if (at >= 0) s.replace(at, 1, kNums[bounded(int(std::size(kNums)))]);
+                break;
+            }
+            case 6: {   // 다른 시드의 뒷부분 접합
+                const QByteArray o = pickSeed();
+                s = s.left(bounded(s.size())) + o.mid(bounded(o.size()));
+                break;
+            }
+            }
+        }
+        return s;
+    }
+
+private:
+    int bounded(int n) { return n <= 0 ? 0 : int(m_rng.bounded(quint32(n))); }
+    char alpha() { return kAlphabet[bounded(int(sizeof(kAlphabet)) - 1)]; }
+    QByteArray pickSeed() { return QByteArray(kSeeds[bounded(int(std::size(kSeeds)))]); }
+
+    QRandomGenerator m_rng;
+};
+
+} // namespace
+
+class TestRobotCommandParser : public QObject
+{
+    Q_OBJECT
+private slots:
+    void seedsDecode();
+    void differentialFuzz();
+};
+
+// 시드는 모두 빠른 경로로 디코딩되고 DOM 과 같아야 한다
+void TestRobotCommandParser::seedsDecode()
+{
+    for (const char* line : kSeeds) {
+        RobotCommand fast, dom;
+        RobotCommandParser::Extras fastEx, domEx;
+        QVERIFY2(RobotCommandParser::decode(line, int(std::strlen(line)), fast, &fastEx), line);
+
+        QJsonParseError pe{};
+        const QJsonDocument doc = QJsonDocument::fromJson(QByteArray(line), &pe);
+        QVERIFY2(pe.error == QJsonParseError::NoError && doc.isObject(), line);
+        domDecode(doc.object(), dom, domEx);
+
+        QVERIFY2(diff(fast, dom).isEmpty(), qPrintable(diff(fast, dom) + ": " + line));
+        QVERIFY2(diff(fastEx, domEx).isEmpty(), qPrintable(diff(fastEx, domEx) + ": " + line));
+    }
+}
+
+void TestRobotCommandParser::differentialFuzz()
+{
+    const quint32 seed = qEnvironmentVariableIsSet("MRC_FUZZ_SEED")
+                             ? quint32(qEnvironmentVariableIntValue("MRC_FUZZ_SEED")) : 0x5EEDu;
+    const int iters = qEnvironmentVariableIsSet("MRC_FUZZ_ITER")
+                          ? qEnvironmentVariableIntValue("MRC_FUZZ_ITER") : 20000;
+
+    Mutator mut(seed);
+    int accepted = 0;
+    for (int i = 0; i < iters; ++i) {
+        const QByteArray line = mut.next();
+        const QString where = QString("seed=%1 iter=%2 input=%3")
+                                  .arg(seed).arg(i).arg(QString::fromLatin1(line.toPercentEncoding("{}[]:,\" ")));
+
+        RobotCommand fast;
+        RobotCommandParser::Extras fastEx;
+        if (!RobotCommandParser::decode(line.constData(), line.size(), fast, &fastEx))
+            continue;   // DOM 경로로 넘김 → 비교 대상 아님
+        ++accepted;
+
+        QJsonParseError pe{};
+        const QJsonDocument doc = QJsonDocument::fromJson(line, &pe);
+        QVERIFY2(pe.error == QJsonParseError::NoError && doc.isObject(),
+                 qPrintable("decode accepted what QJsonDocument rejects: " + pe.errorString() + " " + where));
+
+        RobotCommand dom;
+        RobotCommandParser::Extras domEx;
+        domDecode(doc.object(), dom, domEx);
+        const QString d = diff(fast, dom);
+        QVERIFY2(d.isEmpty(), qPrintable(d + " differs, " + where));
+        const QString dx = diff(fastEx, domEx);
+        QVERIFY2(dx.isEmpty(), qPrintable(dx + " differs, " + where));
+    }
+    // 변형이 너무 파괴적이면 비교가 무의미해진다
+    QVERIFY2(accepted > iters / 20, qPrintable(QString("only %1 of %2 mutated inputs took the fast path").arg(accepted).arg(iters)));
+    qInfo("fast path accepted %d of %d mutated inputs", accepted, iters);
+}
+
+QTEST_GUILESS_MAIN(TestRobotCommandParser)
+#include "test_robot_command_parser.moc"
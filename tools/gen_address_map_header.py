@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+AddressMap_*.json -> constexpr C++ header generator
+
+Build-time companion of validate_address_map_win.py. Reads one or more robot
+address maps and emits a single header with, per robot:
+- register constants   (namespace <ID>::coils / discrete_inputs / holding / input_registers)
+- entry tables         (name/address/words per space, used by AddressMapBuiltin)
+- pulse table          (DOn_PULSE discrete input -> processPulse index n, drives Orchestrator's DI edge loop)
+
+Used/reserved ranges and the DI poll block are only checked here, not emitted.
+
+Overlap rules (stricter than the validator, the build fails on any of them):
+- different ranges in the same space must not intersect
+  (identical ranges are treated as aliases, e.g. TARGET_POSE_BASE == TARGET_POSE_PICK)
+- reserved ranges must not intersect each other or any used range
+- documented exceptions are listed in ALLOWED_OVERLAPS
+
+Usage:
+  python gen_address_map_header.py -o AddressMapGenerated.h A=AddressMap_A.json B=AddressMap_B.json
+         [--resource-prefix :/map/] [--max-queue N]
+
+Exit codes:
+  0: header written
+  2: errors found (nothing written)
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+from typing import Dict, List, Tuple
+
+SPACES = ("coils", "discrete_inputs", "holding", "input_registers")
+# 값(주소가 아닌) 키: 테이블에는 싣지만 범위 검사에서는 제외
+VALUE_KEYS = ("TARGET_QUEUE_STRIDE",)
+# 문서화된 겹침 (space, 작은 범위 키, 큰 범위 키): 범위 검사에서 제외
+# SPEED_PCT(146) 는 TARGET_POSE_PLACE(144..155) 안에 있는 기존 배치 — 컨트롤러 쪽 맵이 이 주소를 쓴다.
+ALLOWED_OVERLAPS = {
+    ("holding", "SPEED_PCT", "TARGET_POSE_PLACE"),
+}
+PULSE_RE = re.compile(r"^DO(\d+)_PULSE$")
+IDENT_RE = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+
+errors: List[str] = []
+
+
+def error(msg: str) -> None:
+    errors.append(msg)
+
+
+def is_comment_key(k) -> bool:
+    return isinstance(k, str) and (k.startswith("_") or k.endswith("__comment"))
+
+
+def pose_words(meta: Dict) -> int:
+    return int(meta.get("pose_axes", 6)) * int(meta.get("float32_words_per_axis", 2))
+
+
+def words_for_key(key: str, meta: Dict) -> int:
+    if key.endswith("TICK_BASE"):
+        return 2
+    if key.endswith("_BASE") or key.startswith("TARGET_POSE_"):
+        return pose_words(meta)
+    return 1
+
+
+def load_map(robot: str, path: str, max_queue: int):
+    try:
+        with open(path, "r", encoding="utf-8") as f:
+            m = json.load(f)
+    except Exception as e:
+        error(f"{robot}: failed to load {path}: {e}")
+        return None
+
+    meta = m.get("meta", {})
+    out = {"id": robot, "path": path, "meta": meta, "entries": {}, "used": {}, "reserved": {}}
+
+    for s in SPACES:
+        mapping = m.get(s, {})
+        if not isinstance(mapping, dict):
+            error(f"{robot}: '{s}' must be an object")
+            mapping = {}
+        entries = []   # (name, addr, words)
+        used = []      # (start, end, name)
+        for k, v in mapping.items():
+            if is_comment_key(k):
+                continue
+            if not isinstance(v, int):
+                error(f"{robot}: {s}.{k} must be an integer (got {type(v).__name__})")
+                continue
+            if not IDENT_RE.match(k):
+                error(f"{robot}: {s}.{k} is not a valid C++ identifier")
+                continue
+            if k in VALUE_KEYS:
+                entries.append((k, v, 0))
+                continue
+            if k == "TARGET_QUEUE_BASE":
+                stride = mapping.get("TARGET_QUEUE_STRIDE", pose_words(meta))
+                words = stride * max_queue if max_queue > 0 else 1
+            else:
+                words = words_for_key(k, meta) if s in ("holding", "input_registers") else 1
+            entries.append((k, v, words))
+            used.append((v, v + words - 1, k))
+        out["entries"][s] = entries
+        out["used"][s] = used
+
+        resv = []
+        for item in m.get("reserved", {}).get(s, []):
+            a, b = item.get("start"), item.get("end")
+            if not isinstance(a, int) or not isinstance(b, int) or b < a:
+                error(f"{robot}: bad reserved.{s} item {item}")
+                continue
+            resv.append((a, b, str(item.get("purpose", ""))))
+        out["reserved"][s] = resv
+    return out
+
+
+def check_overlaps(rm) -> None:
+    robot = rm["id"]
+    for s in SPACES:
+        used = sorted(rm["used"][s])
+        for i, a in enumerate(used):
+            for b in used[i + 1:]:
+                if b[0] > a[1]:
+                    break
+                if (a[0], a[1]) == (b[0], b[1]):
+                    continue  # alias
+                if (s, a[2], b[2]) in ALLOWED_OVERLAPS or (s, b[2], a[2]) in ALLOWED_OVERLAPS:
+                    continue
+                error(f"{robot}: {s} overlap {a[2]} [{a[0]}..{a[1]}] <-> {b[2]} [{b[0]}..{b[1]}]")
+
+        resv = sorted(rm["reserved"][s])
+        for i, a in enumerate(resv):
+            for b in resv[i + 1:]:
+                if b[0] <= a[1]:
+                    error(f"{robot}: reserved {s} overlap [{a[0]}..{a[1]}] <-> [{b[0]}..{b[1]}]")
+        for u in used:
+            for r in resv:
+                if not (u[1] < r[0] or u[0] > r[1]):
+                    error(f"{robot}: {s} {u[2]} [{u[0]}..{u[1]}] overlaps reserved [{r[0]}..{r[1]}] ({r[2]})")
+
+
+def merge_blocks(ranges: List[Tuple[int, int]], max_gap: int) -> List[Tuple[int, int]]:
+    blocks: List[Tuple[int, int]] = []
+    for a, b in sorted(ranges):
+        if blocks and a <= blocks[-1][1] + 1 + max_gap:
+            blocks[-1] = (blocks[-1][0], max(blocks[-1][1], b))
+        else:
+            blocks.append((a, b))
+    return blocks
+
+
+def poll_plan(rm) -> List[Tuple[str, int, int]]:
+    plan = []
+    # 이산 입력: 전체를 한 블록으로 (사이클마다 한 번에 읽음)
+    di = [(a, b) for (a, b, _) in rm["used"]["discrete_inputs"]]
+    for a, b in merge_blocks(di, max_gap=16):
+        plan.append(("discrete_inputs", a, b - a + 1))
+    # 입력 레지스터: 현재 자세/관절 블록만 (로그성 레지스터는 제외)
+    ir = [(a, b) for (a, b, n) in rm["used"]["input_registers"]
+          if n.startswith("CUR_") or n.startswith("CURR_")]
+    for a, b in merge_blocks(ir, max_gap=0):
+        plan.append(("input_registers", a, b - a + 1))
+    return plan
+
+
+def pulse_table(rm, plan) -> List[Tuple[int, int, int]]:
+    di_base = next((s for (sp, s, _) in plan if sp == "discrete_inputs"), 0)
+    pulses = []
+    for (k, v, _) in rm["entries"]["discrete_inputs"]:
+        mo = PULSE_RE.match(k)
+        if mo:
+            pulses.append((int(mo.group(1)), v, v - di_base))
+    pulses.sort()
+    for (idx, addr, bit) in pulses:
+        if bit < 0 or bit >= 32:
+            error(f"{rm['id']}: DO{idx}_PULSE at {addr} is outside the 32-bit DI poll window")
+    return pulses
+
+
+def cstr(s: str) -> str:
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def emit_robot(rm, resource_prefix: str) -> List[str]:
+    rid = rm["id"]
+    meta = rm["meta"]
+    plan = poll_plan(rm)
+    pulses = pulse_table(rm, plan)
+    L = []
+    L.append(f"namespace {rid} {{")
+    L.append(f"constexpr const char kId[] = {cstr(rid)};")
+    L.append(f"constexpr const char kResource[] = {cstr(resource_prefix + os.path.basename(rm['path']))};")
+    L.append("")
+    for s in SPACES:
+        L.append(f"namespace {s} {{")
+        for (k, v, _) in rm["entries"][s]:
+            L.append(f"constexpr int {k} = {v};")
+        L.append(f"}} // namespace {s}")
+    L.append("")
+    L.append("namespace meta {")
+    L.append(f"constexpr int schema_version = {int(meta.get('schema_version', 0))};")
+    L.append(f"constexpr bool word_order_hi_lo = {'true' if meta.get('word_order', 'HI_LO') == 'HI_LO' else 'false'};")
+    L.append(f"constexpr int pose_axes = {int(meta.get('pose_axes', 6))};")
+    L.append(f"constexpr int float32_words_per_axis = {int(meta.get('float32_words_per_axis', 2))};")
+    L.append(f"constexpr int pose_words = {pose_words(meta)};")
+    L.append("} // namespace meta")
+    L.append("")
+
+    def table(name, rows, typ, fmt):
+        L.append(f"constexpr std::array<{typ}, {len(rows)}> {name}{{{{")
+        for r in rows:
+            L.append("    " + fmt(r) + ",")
+        L.append("}};")
+
+    for s in SPACES:
+        cname = "".join(p.capitalize() for p in s.split("_"))
+        table(f"k{cname}", rm["entries"][s], "Entry",
+              lambda r: f"Entry{{ {cstr(r[0])}, {r[1]}, {r[2]} }}")
+    table("kPulses", pulses, "Pulse",
+          lambda r: f"Pulse{{ {r[0]}, {r[1]} }}")
+    L.append(f"}} // namespace {rid}")
+    L.append("")
+    return L
+
+
+HEADER_PROLOGUE = """\
+// AddressMapGenerated.h
+// 자동 생성 파일 - 직접 수정하지 마세요.
+// generator: tools/gen_address_map_header.py
+// sources  : {sources}
+#ifndef ADDRESSMAPGENERATED_H
+#define ADDRESSMAPGENERATED_H
+
+#include <array>
+
+namespace AddressMapGen {{
+
+// words == 0 : 주소가 아닌 값 (예: TARGET_QUEUE_STRIDE)
+struct Entry     {{ const char* name; int addr; int words; }};
+// DOn_PULSE → processPulse(idx = n), idx 오름차순
+struct Pulse     {{ int idx; int addr; }};
+
+"""
+
+HEADER_EPILOGUE = """\
+}} // namespace AddressMapGen
+
+#endif // ADDRESSMAPGENERATED_H
+"""
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("maps", nargs="+", help="ID=path/to/AddressMap_ID.json")
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--resource-prefix", default=":/map/")
+    ap.add_argument("--max-queue", type=int, default=16,
+                    help="Expand TARGET_QUEUE_BASE for N targets when checking overlaps (default: 16)")
+    args = ap.parse_args()
+
+    robots = []
+    for spec in args.maps:
+        if "=" not in spec:
+            error(f"bad map spec '{spec}' (expected ID=path)")
+            continue
+        rid, path = spec.split("=", 1)
+        if not IDENT_RE.match(rid):
+            error(f"robot id '{rid}' is not a valid C++ identifier")
+            continue
+        rm = load_map(rid, path, args.max_queue)
+        if rm:
+            check_overlaps(rm)
+            robots.append(rm)
+
+    body = []
+    for rm in robots:
+        body += emit_robot(rm, args.resource_prefix)
+
+    if errors:
+        for e in errors:
+            print(f"[CONFLICT] {e}", file=sys.stderr)
+        print(f"[ERROR] {len(errors)} address map error(s); header not generated.", file=sys.stderr)
+        sys.exit(2)
+
+    text = HEADER_PROLOGUE.format(sources=", ".join(os.path.basename(r["path"]) for r in robots))
+    text += "\n".join(body) + "\n"
+    text += "struct Robot {\n"
+    text += "    const char* id;\n    const char* resource;\n"
+    for s in SPACES:
+        text += f"    const Entry* {s}; int {s}Count;\n"
+    text += "};\n\n"
+    text += f"constexpr std::array<Robot, {len(robots)}> kRobots{{{{\n"
+    for rm in robots:
+        rid = rm["id"]
+        fields = [f"{rid}::kId", f"{rid}::kResource"]
+        for s in SPACES:
+            cname = "".join(p.capitalize() for p in s.split("_"))
+            fields += [f"{rid}::k{cname}.data()", f"int({rid}::k{cname}.size())"]
+        text += "    Robot{ " + ", ".join(fields) + " },\n"
+    text += "}};\n\n"
+    text += HEADER_EPILOGUE.format()
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    print(f"[INFO] {args.output} generated ({len(robots)} robot map(s))")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,692 @@
+// ─────────────────────────────────────────────────────────────
+// mrc_log_analyzer — tmp/log_*.txt 오프라인 분석 (Qt 불필요)
+//
+//   mrc_log_analyzer [options] <file|dir>...
+//     dir 은 그 안의 log_*.txt 를 이름순으로 읽는다.
+//   --threads N     줄 스캔 스레드 수 (기본: 하드웨어 스레드 수)
+//   --streak N      연속 실패를 이상으로 보고할 최소 길이 (기본 2)
+//   --timeout S     명령 수신 후 S 초 안에 완료가 없으면 무응답으로 본다 (기본 600)
+//   --top N         느린 작업 상위 N 개 (기본 10)
+//   --by-file       파일(= 날짜/배포본)별 작업 p50 비교표만 출력
+//
+// 파일은 통째로 메모리 매핑하고 줄 경계에서 나눠 여러 스레드가 동시에 훑는다.
+// 각 스레드는 관심 있는 줄만 작은 이벤트로 뽑고, 짝 맞추기(수신→완료)는 합친 뒤 순서대로 한 번.
+//
+// 줄 형식 (AsyncFileLogger / 이전 LogToFile 공통):
+//   [Debug]2026-01-14 11:18:05.864: msg                                             ← ms 정밀도
+//   [Debug]2026-01-14 11:18:05: QDateTime(2026-01-14 11:18:05.864 GMT+9 ...) msg   ← ms 정밀도 (이전)
+//   [Debug]2026-01-14 11:18:05: msg                                                 ← 초 정밀도 (이전)
+//
+// 뽑는 이벤트:
+//   비전 수신  "line received" + dir:1        → robot/type/kind
+//   비전 송신  "onTxJson sent" / "sendWorkComplete" + dir:11 (같은 메시지 중복 기록은 한 번만)
+//   갠트리     "N번 모터 이동 완료", "Gentry position unknown", "gantry command finished: OK|FAIL"
+//   컨베이어   "Conveyor command finished: OK|FAIL" (conveyor.forward 완료, 비전 응답이 없는 명령)
+//   버스       "Modbus error", "Device is not connected"
+// 앱은 이 줄들을 info 이상으로 남긴다 (기본 로깅 규칙/MRC_NO_DEBUG_LOG 에서도 빠지지 않게).
+// ─────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// ── 읽기 전용 메모리 매핑 ────────────────────────────────────
+class MappedFile
+{
+public:
+    explicit MappedFile(const fs::path& p)
+    {
+#ifdef _WIN32
+        m_file = CreateFileW(p.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                             nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(m_file, &sz) || sz.QuadPart == 0) return;
+        m_map = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_map) return;
+        m_data = static_cast<const char*>(MapViewOfFile(m_map, FILE_MAP_READ, 0, 0, 0));
+        if (m_data) m_size = size_t(sz.QuadPart);
+#else
+        m_fd = ::open(p.c_str(), O_RDONLY);
+        if (m_fd < 0) return;
+        struct stat st;
+        if (fstat(m_fd, &st) != 0 || st.st_size == 0) return;
+        void* d = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (d == MAP_FAILED) return;
+        madvise(d, size_t(st.st_size), MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(d);
+        m_size = size_t(st.st_size);
+#endif
+    }
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_map) CloseHandle(m_map);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+        if (m_data) munmap(const_cast<char*>(m_data), m_size);
+        if (m_fd >= 0) ::close(m_fd);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_map = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+// ── 이벤트 ───────────────────────────────────────────────────
+enum class Ev : uint8_t {
+    VisionRx, VisionTx, GantryDone, GantryUnknown, GantryOk, GantryFail,
+    ConveyorDone, BusError, BusNotConnected
+};
+
+struct Event {
+    int64_t ms = 0;         // 로컬 시각 (epoch 기준처럼 계산, 시간대 보정 없음)
+    Ev type = Ev::VisionRx;
+    char robot = '-';
+    bool ok = true;         // VisionTx: error_code == 0, ConveyorDone: OK
+    int axis = 0;           // GantryDone
+    uint32_t seq = 0;
+    char cmdType[12] = {};
+    char cmdKind[12] = {};
+};
+
+// 문자열 뷰 안에서 JSON 키의 문자열/숫자 값 (로그에 \" 로 이스케이프되어 있어도 됨)
+std::string_view jsonField(std::string_view s, std::string_view key)
+{
+    size_t pos = 0, at;
+    while ((at = s.find(key, pos)) != std::string_view::npos) {
+        pos = at + 1;
+        // 키 앞이 따옴표가 아니면 다른 키의 일부 ("kind" vs "xkind")
+        if (at == 0 || s[at - 1] != '"') continue;
+        size_t i = at + key.size();
+        if (i < s.size() && s[i] == '\\') ++i;
+        if (i >= s.size() || s[i] != '"') continue;
+        ++i;
+        if (i >= s.size() || s[i] != ':') continue;
+        ++i;
+        if (i < s.size() && s[i] == '\\') ++i;
+        const bool quoted = i < s.size() && s[i] == '"';
+        if (quoted) ++i;
+        size_t end = i;
+        while (end < s.size()) {
+            const char c = s[end];
+            if (quoted ? (c == '"' || c == '\\') : (c == ',' || c == '}' || c == '\\' || c == '"')) break;
+            ++end;
+        }
+        return s.substr(i, end - i);
+    }
+    return {};
+}
+
+void copyField(char (&out)[12], std::string_view v)
+{
+    const size_t n = std::min(v.size(), sizeof(out) - 1);
+    std::memcpy(out, v.data(), n);
+    out[n] = '\0';
+}
+
+int toInt(std::string_view v)
+{
+    int sign = 1, r = 0;
+    size_t i = 0;
+    if (!v.empty() && v[0] == '-') { sign = -1; i = 1; }
+    for (; i < v.size() && v[i] >= '0' && v[i] <= '9'; ++i) r = r * 10 + (v[i] - '0');
+    return sign * r;
+}
+
+int64_t daysFromCivil(int y, int m, int d)
+{
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era * 400;
+    const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return int64_t(era) * 146097 + doe - 719468;
+}
+
+inline int dig(const char* p, int n)
+{
+    int r = 0;
+    for (int i = 0; i < n; ++i) {
+        if (p[i] < '0' || p[i] > '9') return -1;
+        r = r * 10 + (p[i] - '0');
+    }
+    return r;
+}
+
+// "YYYY-MM-DD hh:mm:ss" (19자) → ms. 형식이 아니면 -1
+int64_t parseStamp(const char* p, size_t n)
+{
+    if (n < 19 || p[4] != '-' || p[7] != '-' || p[10] != ' ' || p[13] != ':' || p[16] != ':') return -1;
+    const int y = dig(p, 4), mo = dig(p + 5, 2), d = dig(p + 8, 2);
+    const int h = dig(p + 11, 2), mi = dig(p + 14, 2), s = dig(p + 17, 2);
+    if (y < 0 || mo < 1 || d < 1 || h < 0 || mi < 0 || s < 0) return -1;
+    return ((daysFromCivil(y, mo, d) * 24 + h) * 60 + mi) * 60000LL + s * 1000LL;
+}
+
+// "번 모터 이동 완료" (UTF-8). MSVC 소스 인코딩 설정과 무관하도록 바이트로 둔다.
+constexpr std::string_view kMoveDone = "\xEB\xB2\x88 \xEB\xAA\xA8\xED\x84\xB0 \xEC\x9D\xB4\xEB\x8F\x99 \xEC\x99\x84\xEB\xA3\x8C";
+
+// 한 줄 → 이벤트 (관심 없는 줄이면 false)
+bool parseLine(std::string_view line, Event& ev)
+{
+    // [Type]YYYY-MM-DD hh:mm:ss: msg
+    if (line.size() < 24 || line[0] != '[') return false;
+    const size_t close = line.find(']');
+    if (close == std::string_view::npos || close > 12) return false;
+    const char* stamp = line.data() + close + 1;
+    int64_t ms = parseStamp(stamp, line.size() - close - 1);
+    if (ms < 0) return false;
+    size_t stampLen = 19;
+    if (line.size() > close + 1 + 23 && stamp[19] == '.') {   // AsyncFileLogger: .zzz
+        const int frac = dig(stamp + 20, 3);
+        if (frac >= 0) { ms += frac; stampLen = 23; }
+    }
+    std::string_view msg = line.substr(std::min(line.size(), close + 1 + stampLen + 2));
+
+    // 이전 형식: QDateTime(YYYY-MM-DD hh:mm:ss.zzz ...) 접두 → ms 정밀도
+    if (msg.substr(0, 10) == "QDateTime(") {
+        const int64_t precise = parseStamp(msg.data() + 10, msg.size() - 10);
+        if (precise >= 0 && msg.size() > 33 && msg[29] == '.') {
+            const int frac = dig(msg.data() + 30, 3);
+            if (frac >= 0) ms = precise + frac;
+        }
+        const size_t end = msg.find(") ");
+        if (end != std::string_view::npos) msg = msg.substr(end + 2);
+    }
+    ev.ms = ms;
+
+    auto has = [&](std::string_view k) { return msg.find(k) != std::string_view::npos; };
+
+    if (has("line received")) {
+        if (toInt(jsonField(msg, "dir")) != 1) return false;
+        ev.type = Ev::VisionRx;
+    } else if (has("onTxJson sent") || has("sendWorkComplete json") || has("VisionClient::sendWorkComplete \"")) {
+        if (toInt(jsonField(msg, "dir")) != 11) return false;
+        ev.type = Ev::VisionTx;
+        ev.ok = toInt(jsonField(msg, "error_code")) == 0;
+    } else if (has(kMoveDone)) {
+        ev.type = Ev::GantryDone;
+        size_t i = msg.find(kMoveDone);
+        size_t b = i;
+        while (b > 0 && msg[b - 1] >= '0' && msg[b - 1] <= '9') --b;
+        ev.axis = toInt(msg.substr(b, i - b));
+        return true;
+    } else if (has("Gentry position unknown")) {
+        ev.type = Ev::GantryUnknown;
+        return true;
+    } else if (has("antry command finished:")) {
+        ev.type = has("FAIL") ? Ev::GantryFail : Ev::GantryOk;
+        return true;
+    } else if (has("Conveyor command finished:")) {
+        ev.type = Ev::ConveyorDone;
+        ev.ok = !has("FAIL");
+        return true;
+    } else if (has("Modbus error")) {
+        ev.type = Ev::BusError;
+        return true;
+    } else if (has("Device is not connected")) {
+        ev.type = Ev::BusNotConnected;
+        return true;
+    } else {
+        return false;
+    }
+
+    const std::string_view robot = jsonField(msg, "robot");
+    ev.robot = robot.empty() ? '-' : char(std::tolower(static_cast<unsigned char>(robot[0])));
+    ev.seq = uint32_t(toInt(jsonField(msg, "seq")));
+    copyField(ev.cmdType, jsonField(msg, "type"));
+    copyField(ev.cmdKind, jsonField(msg, "kind"));
+    return std::strcmp(ev.cmdKind, "moving") != 0;    // 공구 이동 피드백은 완료가 아님
+}
+
+// 파일 하나를 줄 경계로 나눠 병렬 스캔. 결과는 파일 내 순서 그대로.
+struct ScanResult {
+    std::vector<Event> events;
+    uint64_t lines = 0;
+    uint64_t bytes = 0;
+};
+
+ScanResult scanFile(const fs::path& p, unsigned threads)
+{
+    ScanResult out;
+    MappedFile f(p);
+    if (!f.data()) {
+        std::fprintf(stderr, "cannot read %s\n", p.string().c_str());
+        return out;
+    }
+    out.bytes = f.size();
+
+    // 작은 파일은 나누지 않는다 (스레드 시작 비용이 더 큼)
+    constexpr size_t kMinChunk = 4 << 20;
+    const size_t n = std::max<size_t>(1, std::min<size_t>(threads, f.size() / kMinChunk + 1));
+
+    std::vector<size_t> cut(n + 1, f.size());
+    cut[0] = 0;
+    for (size_t i = 1; i < n; ++i) {
+        size_t c = std::max(cut[i - 1], f.size() * i / n);
+        const void* nl = std::memchr(f.data() + c, '\n', f.size() - c);
+        cut[i] = nl ? size_t(static_cast<const char*>(nl) - f.data()) + 1 : f.size();
+    }
+
+    std::vector<ScanResult> part(n);
+    auto work = [&](size_t k) {
+        const char* p0 = f.data() + cut[k];
+        const char* end = f.data() + cut[k + 1];
+        ScanResult& r = part[k];
+        while (p0 < end) {
+            const char* nl = static_cast<const char*>(std::memchr(p0, '\n', size_t(end - p0)));
+            const char* le = nl ? nl : end;
+            size_t len = size_t(le - p0);
+            if (len && p0[len - 1] == '\r') --len;
+            Event ev;
+            if (parseLine(std::string_view(p0, len), ev))
+                r.events.push_back(ev);
+            ++r.lines;
+            p0 = le + 1;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t k = 1; k < n; ++k) pool.emplace_back(work, k);
+    work(0);
+    for (auto& t : pool) t.join();
+
+    for (auto& r : part) {
+        out.lines += r.lines;
+        out.events.insert(out.events.end(), r.events.begin(), r.events.end());
+    }
+    return out;
+}
+
+// ── 집계 ─────────────────────────────────────────────────────
+struct Dist {
+    std::vector<double> v;      // 초
+    double at(double q) const { return v.empty() ? 0.0 : v[std::min(v.size() - 1, size_t(q * double(v.size())))]; }
+    void sort() { std::sort(v.begin(), v.end()); }
+    double mean() const
+    {
+        double s = 0;
+        for (double x : v) s += x;
+        return v.empty() ? 0.0 : s / double(v.size());
+    }
+};
+
+struct Hour {
+    int done = 0, picks = 0, places = 0, tools = 0, visionErrors = 0;
+    int gantryFail = 0, gantryUnknown = 0, busErrors = 0;
+};
+
+struct Streak {
+    int64_t startMs = 0;
+    int length = 0;
+    const char* what = "";
+};
+
+struct Slow {
+    double sec;
+    int64_t atMs;
+    std::string op;
+    char robot;
+};
+
+struct Report {
+    uint64_t lines = 0, bytes = 0;
+    std::map<std::string, Dist> ops;            // "bulk.pick", "tool.change", "standby" ...
+    std::map<int, Dist> gantry;                 // 축 → 직전 비전 명령부터 이동 완료까지
+    std::map<int64_t, Hour> hours;              // 시 단위 (ms / 3600000)
+    std::vector<Streak> streaks;
+    std::vector<Slow> slow;
+    int unanswered = 0, orphanTx = 0, visionErrors = 0;
+    int gantryUnknown = 0, gantryFail = 0, conveyorFail = 0, busErrors = 0, notConnected = 0;
+};
+
+std::string opName(const Event& e)
+{
+    const std::string kind = e.cmdKind;
+    const std::string type = e.cmdType;
+    if (kind == "standby") return "standby";
+    if (type == "tool") return "tool." + kind;
+    return (type.empty() ? std::string("?") : type) + "." + (kind.empty() ? std::string("?") : kind);
+}
+
+struct Options {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int streak = 2;
+    int64_t timeoutMs = 600000;
+    size_t top = 10;
+    bool byFile = false;
+};
+
+void analyze(const std::vector<Event>& evs, const Options& opt, Report& rep)
+{
+    std::map<std::string, std::deque<int64_t>> pending;     // robot|op → 수신 시각 (FIFO)
+    std::map<std::string, int64_t> lastTx;                  // 같은 송신의 중복 기록 제거
+    int64_t lastRxMs = -1, lastConveyorMs = -1;
+    Streak gantry{0, 0, "gantry FAIL"}, vision{0, 0, "vision error"};
+
+    auto closeStreak = [&](Streak& s) {
+        if (s.length >= opt.streak) rep.streaks.push_back(s);
+        s.length = 0;
+    };
+    auto bump = [](Streak& s, int64_t ms) {
+        if (s.length++ == 0) s.startMs = ms;
+    };
+    // 완료 → 같은 키의 가장 최근 수신과 짝. 그보다 앞선 수신은 재전송에 밀린 것(무응답)으로 센다.
+    auto complete = [&](std::deque<int64_t>& q, const Event& e, const std::string& op, Hour& h) {
+        while (!q.empty() && e.ms - q.front() > opt.timeoutMs) {
+            q.pop_front();
+            ++rep.unanswered;
+        }
+        if (q.empty()) return false;
+        const double sec = double(e.ms - q.back()) / 1000.0;
+        rep.unanswered += int(q.size()) - 1;
+        q.clear();
+        rep.ops[op].v.push_back(sec);
+        rep.slow.push_back({sec, e.ms, op, e.robot});
+        ++h.done;
+        return true;
+    };
+
+    for (const Event& e : evs) {
+        Hour& h = rep.hours[e.ms / 3600000];
+        switch (e.type) {
+        case Ev::VisionRx: {
+            pending[std::string(1, e.robot) + "|" + opName(e)].push_back(e.ms);
+            lastRxMs = e.ms;
+            break;
+        }
+        case Ev::VisionTx: {
+            const std::string op = opName(e);
+            const std::string key = std::string(1, e.robot) + "|" + op;
+            const std::string dup = key + "|" + std::to_string(e.seq) + (e.ok ? "" : "!");
+            auto d = lastTx.find(dup);
+            if (d != lastTx.end() && e.ms - d->second <= 50) break;     // sendWorkComplete + onTxJson
+            lastTx[dup] = e.ms;
+
+            if (!e.ok) {
+                ++rep.visionErrors;
+                ++h.visionErrors;
+                bump(vision, e.ms);
+                break;
+            }
+            closeStreak(vision);
+
+            if (!complete(pending[key], e, op, h)) {
+                if (std::strcmp(e.cmdKind, "idle") != 0) ++rep.orphanTx;    // idle 은 명령 없는 상태 보고
+                break;
+            }
+            if (std::strcmp(e.cmdKind, "pick") == 0) ++h.picks;
+            else if (std::strcmp(e.cmdKind, "place") == 0) ++h.places;
+            else if (std::strcmp(e.cmdType, "tool") == 0) ++h.tools;
+            break;
+        }
+        case Ev::ConveyorDone: {
+            if (e.ms - lastConveyorMs <= 50) break;     // 같은 완료가 두 번 기록됨
+            lastConveyorMs = e.ms;
+            if (!e.ok) {
+                ++rep.conveyorFail;
+                break;
+            }
+            // 로봇이 찍히지 않으므로 conveyor.forward 대기 중인 것 아무거나 (보통 하나)
+            for (auto& kv : pending) {
+                if (kv.first.size() > 2 && kv.first.compare(2, std::string::npos, "conveyor.forward") == 0 && !kv.second.empty()) {
+                    Event c = e;
+                    c.robot = kv.first[0];
+                    complete(kv.second, c, "conveyor.forward", h);
+                    break;
+                }
+            }
+            break;
+        }
+        case Ev::GantryDone:
+            if (lastRxMs >= 0 && e.ms - lastRxMs <= 60000)
+                rep.gantry[e.axis].v.push_back(double(e.ms - lastRxMs) / 1000.0);
+            break;
+        case Ev::GantryUnknown:
+            ++rep.gantryUnknown;
+            ++h.gantryUnknown;
+            break;
+        case Ev::GantryOk:
+            closeStreak(gantry);
+            break;
+        case Ev::GantryFail:
+            ++rep.gantryFail;
+            ++h.gantryFail;
+            bump(gantry, e.ms);
+            break;
+        case Ev::BusError:
+            ++rep.busErrors;
+            ++h.busErrors;
+            break;
+        case Ev::BusNotConnected:
+            ++rep.notConnected;
+            break;
+        }
+    }
+    closeStreak(gantry);
+    closeStreak(vision);
+    for (auto& kv : pending) rep.unanswered += int(kv.second.size());
+
+    for (auto& kv : rep.ops) kv.second.sort();
+    for (auto& kv : rep.gantry) kv.second.sort();
+    std::sort(rep.slow.begin(), rep.slow.end(), [](const Slow& a, const Slow& b) { return a.sec > b.sec; });
+    if (rep.slow.size() > opt.top) rep.slow.resize(opt.top);
+}
+
+std::string stamp(int64_t ms, bool withSec = true)
+{
+    int64_t days = ms / 86400000;
+    int64_t rem = ms % 86400000;
+    if (rem < 0) { rem += 86400000; --days; }
+    // civil from days
+    const int64_t z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const int64_t doe = z - era * 146097;
+    const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int64_t mp = (5 * doy + 2) / 153;
+    const int d = int(doy - (153 * mp + 2) / 5 + 1);
+    const int m = int(mp < 10 ? mp + 3 : mp - 9);
+    const int y = int(yoe + era * 400 + (m <= 2));
+    char buf[32];
+    if (withSec)
+        std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d", y, m, d,
+                      int(rem / 3600000), int(rem / 60000 % 60), int(rem / 1000 % 60));
+    else
+        std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:00", y, m, d, int(rem / 3600000));
+    return buf;
+}
+
+void printDist(const char* name, const Dist& d)
+{
+    std::printf("  %-18s %6zu  %8.2f %8.2f %8.2f %8.2f %8.2f\n", name, d.v.size(),
+                d.mean(), d.at(0.50), d.at(0.90), d.at(0.99), d.v.empty() ? 0.0 : d.v.back());
+}
+
+void printReport(const Report& rep, double seconds)
+{
+    std::printf("scanned %llu lines, %.1f MB in %.2f s\n\n",
+                (unsigned long long)rep.lines, double(rep.bytes) / 1e6, seconds);
+
+    std::printf("operation durations (s): vision command -> completion\n");
+    std::printf("  %-18s %6s  %8s %8s %8s %8s %8s\n", "op", "n", "mean", "p50", "p90", "p99", "max");
+    for (const auto& kv : rep.ops) printDist(kv.first.c_str(), kv.second);
+
+    if (!rep.gantry.empty()) {
+        std::printf("\ngantry move done (s): last vision command -> axis in position\n");
+        for (const auto& kv : rep.gantry) {
+            const std::string name = "axis " + std::to_string(kv.first);
+            printDist(name.c_str(), kv.second);
+        }
+    }
+
+    std::printf("\nthroughput per hour\n");
+    std::printf("  %-16s %6s %6s %6s %6s %6s %6s %6s %6s\n",
+                "hour", "done", "pick", "place", "tool", "v.err", "g.fail", "g.unk", "bus.err");
+    for (const auto& kv : rep.hours) {
+        const Hour& h = kv.second;
+        if (!h.done && !h.visionErrors && !h.gantryFail && !h.gantryUnknown && !h.busErrors) continue;
+        std::printf("  %-16s %6d %6d %6d %6d %6d %6d %6d %6d\n", stamp(kv.first * 3600000, false).c_str(),
+                    h.done, h.picks, h.places, h.tools, h.visionErrors, h.gantryFail, h.gantryUnknown, h.busErrors);
+    }
+
+    std::printf("\nanomalies\n");
+    std::printf("  Gentry position unknown   %d\n", rep.gantryUnknown);
+    std::printf("  gantry command FAIL       %d\n", rep.gantryFail);
+    std::printf("  conveyor command FAIL     %d\n", rep.conveyorFail);
+    std::printf("  vision error replies      %d\n", rep.visionErrors);
+    std::printf("  unanswered commands       %d\n", rep.unanswered);
+    std::printf("  completions w/o command   %d\n", rep.orphanTx);
+    std::printf("  modbus errors             %d\n", rep.busErrors);
+    std::printf("  device not connected      %d\n", rep.notConnected);
+    for (const Streak& s : rep.streaks)
+        std::printf("  streak: %-13s x%-4d from %s\n", s.what, s.length, stamp(s.startMs).c_str());
+
+    if (!rep.slow.empty()) {
+        std::printf("\nslowest operations\n");
+        for (const Slow& s : rep.slow)
+            std::printf("  %8.2f s  %-18s robot %c  done %s\n", s.sec, s.op.c_str(), s.robot, stamp(s.atMs).c_str());
+    }
+}
+
+// 파일별 p50 비교표 (배포본 간 회귀 확인용)
+void printByFile(const std::vector<std::pair<std::string, Report>>& reps)
+{
+    std::map<std::string, bool> ops;
+    for (const auto& r : reps)
+        for (const auto& kv : r.second.ops) ops[kv.first] = true;
+
+    std::printf("p50 seconds (n) per file\n%-18s", "op");
+    for (const auto& r : reps) std::printf(" %18s", r.first.c_str());
+    std::printf("\n");
+    for (const auto& o : ops) {
+        std::printf("%-18s", o.first.c_str());
+        for (const auto& r : reps) {
+            auto it = r.second.ops.find(o.first);
+            if (it == r.second.ops.end()) {
+                std::printf(" %18s", "-");
+            } else {
+                char cell[32];
+                std::snprintf(cell, sizeof(cell), "%.2f (%zu)", it->second.at(0.5), it->second.v.size());
+                std::printf(" %18s", cell);
+            }
+        }
+        std::printf("\n");
+    }
+    std::printf("%-18s", "g.unknown/fail");
+    for (const auto& r : reps) {
+        char cell[32];
+        std::snprintf(cell, sizeof(cell), "%d/%d", r.second.gantryUnknown, r.second.gantryFail);
+        std::printf(" %18s", cell);
+    }
+    std::printf("\n");
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+        "usage: mrc_log_analyzer [--threads N] [--streak N] [--timeout S] [--top N] [--by-file] <file|dir>...\n");
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    std::vector<fs::path> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        if (a == "--threads")      { const char* v = next(); if (!v) return usage(); opt.threads = unsigned(std::max(1, std::atoi(v))); }
+        else if (a == "--streak")  { const char* v = next(); if (!v) return usage(); opt.streak = std::max(1, std::atoi(v)); }
+        else if (a == "--timeout") { const char* v = next(); if (!v) return usage(); opt.timeoutMs = int64_t(std::atof(v) * 1000); }
+        else if (a == "--top")     { const char* v = next(); if (!v) return usage(); opt.top = size_t(std::max(0, std::atoi(v))); }
+        else if (a == "--by-file") opt.byFile = true;
+        else if (a.rfind("--", 0) == 0) return usage();
+        else {
+            std::error_code ec;
+            if (fs::is_directory(a, ec)) {
+                std::vector<fs::path> in;
+                for (const auto& de : fs::directory_iterator(a, ec)) {
+                    const std::string n = de.path().filename().string();
+                    if (n.rfind("log_", 0) == 0 && de.path().extension() == ".txt") in.push_back(de.path());
+                }
+                std::sort(in.begin(), in.end());
+                files.insert(files.end(), in.begin(), in.end());
+            } else {
+                files.emplace_back(a);
+            }
+        }
+    }
+    if (files.empty()) return usage();
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    if (opt.byFile) {
+        std::vector<std::pair<std::string, Report>> reps;
+        for (const auto& f : files) {
+            ScanResult s = scanFile(f, opt.threads);
+            Report rep;
+            rep.lines = s.lines;
+            rep.bytes = s.bytes;
+            analyze(s.events, opt, rep);
+            reps.emplace_back(f.stem().string(), std::move(rep));
+        }
+        printByFile(reps);
+        return 0;
+    }
+
+    std::vector<Event> all;
+    Report rep;
+    for (const auto& f : files) {
+        ScanResult s = scanFile(f, opt.threads);
+        rep.lines += s.lines;
+        rep.bytes += s.bytes;
+        all.insert(all.end(), s.events.begin(), s.events.end());
+    }
+    analyze(all, opt, rep);
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printReport(rep, sec);
+    return 0;
+}
@@ -0,0 +1,118 @@
+// ─────────────────────────────────────────────────────────────
+// mrc_pose_csv_to_bin — 좌표 CSV/TSV → 바이너리 레시피(.mrcp) 변환
+//
+//   mrc_pose_csv_to_bin <poses.csv> [-o poses.mrcp] [--f64] [--meta] [--threads N]
+//   mrc_pose_csv_to_bin --dump <poses.mrcp> [--limit 20]
+//
+// 파싱은 앱과 같은 PoseCsvLoader::parse, 저장은 PoseBinary::write 를 그대로 쓴다
+// (줄 규칙이 앱 로더와 어긋날 일이 없음). 형식은 src/core/models/PoseBinary.h 참고.
+//  --f64  : float64 로 저장 (기본 float32)
+//  --meta : 7..9번째 필드(kind, speed_pct, tool)를 포즈별 메타로 저장, 없으면 0
+//
+// 종료 코드: 0 정상, 1 입력 오류(읽기 실패/유효 행 없음/잘못된 .mrcp/인자 오류)
+// ─────────────────────────────────────────────────────────────
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <cstdio>
+
+#include "PoseBinary.h"
+#include "PoseCsvLoader.h"
+
+namespace {
+
+struct Args {
+    QString input;
+    QString output;
+    bool f64 = false;
+    bool meta = false;
+    bool dump = false;
+    int limit = 20;
+    int threads = 0;
+};
+
+int usage()
+{
+    std::fprintf(stderr,
+        "usage: mrc_pose_csv_to_bin <poses.csv> [-o out.mrcp] [--f64] [--meta] [--threads N]\n"
+        "       mrc_pose_csv_to_bin --dump <poses.mrcp> [--limit N]\n");
+    return 1;
+}
+
+bool parseArgs(const QStringList& a, Args& out)
+{
+    for (int i = 1; i < a.size(); ++i) {
+        const QString& k = a[i];
+        const bool hasValue = i + 1 < a.size();
+        if (k == "-o" || k == "--output") { if (!hasValue) return false; out.output = a[++i]; }
+        else if (k == "--limit")          { if (!hasValue) return false; out.limit = a[++i].toInt(); }
+        else if (k == "--threads")        { if (!hasValue) return false; out.threads = a[++i].toInt(); }
+        else if (k == "--f64")            out.f64 = true;
+        else if (k == "--meta")           out.meta = true;
+        else if (k == "--dump")           out.dump = true;
+        else if (k.startsWith('-'))       return false;
+        else if (out.input.isEmpty())     out.input = k;
+        else                              return false;
+    }
+    return !out.input.isEmpty();
+}
+
+int dump(const Args& a)
+{
+    PoseBinView v;
+    QString err;
+    if (!v.open(a.input, &err)) {
+        std::fprintf(stderr, "[ERR] %s: %s\n", qPrintable(a.input), qPrintable(err));
+        return 1;
+    }
+    std::printf("flags=%s%s count=%d\n", v.isFloat64() ? "f64" : "f32", v.hasMeta() ? "+meta" : "", v.count());
+    for (int i = 0; i < qMin(v.count(), a.limit); ++i) {
+        const Pose6D p = v.pose(i);
+        std::printf("%g, %g, %g, %g, %g, %g", p.x, p.y, p.z, p.rx, p.ry, p.rz);
+        if (v.hasMeta()) {
+            const PoseBinary::Meta m = v.meta(i);
+            std::printf("  (kind=%u tool=%u speed=%u)", unsigned(m.kind), unsigned(m.tool), unsigned(m.speedPct));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
+int convert(const Args& a)
+{
+    const PoseCsvLoader::Result r = PoseCsvLoader::parseFile(a.input, a.threads, a.meta);
+    if (!r.ok()) {
+        std::fprintf(stderr, "[ERR] %s: %s\n", qPrintable(a.input), qPrintable(r.error));
+        return 1;
+    }
+
+    QString out = a.output;
+    if (out.isEmpty()) {
+        const QFileInfo fi(a.input);
+        out = fi.path() + '/' + fi.completeBaseName() + ".mrcp";
+    }
+    QString err;
+    if (!PoseBinary::write(out, r.poses, a.meta ? &r.meta : nullptr, a.f64, &err)) {
+        std::fprintf(stderr, "[ERR] %s: %s\n", qPrintable(out), qPrintable(err));
+        return 1;
+    }
+
+    std::printf("[OK] %d poses -> %s", int(r.poses.size()), qPrintable(out));
+    if (r.skipped)
+        std::printf(" (%d lines skipped, first: line %d)", r.skipped, r.firstBadLine);
+    std::printf("\n");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    Args args;
+    if (!parseArgs(app.arguments(), args))
+        return usage();
+    return args.dump ? dump(args) : convert(args);
+}
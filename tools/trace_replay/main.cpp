@@ -0,0 +1,639 @@
+// ─────────────────────────────────────────────────────────────
+// mrc_trace_replay — EventTrace(.mrct) 파일 덤프/통계/재생
+//
+//   mrc_trace_replay dump   <trace> [--from N] [--count N]
+//   mrc_trace_replay stats  <trace>
+//   mrc_trace_replay replay <trace> [--speed 1|N|max] [--gap-ms 30] [--drain-ms 3000]
+//                           [--modbus-port 0] [--stats out.json] [--verbose]
+//   mrc_trace_replay replay <trace> --external [--vision-port 50000] [--modbus-port 0] ...
+//
+// replay: 기록된 타임라인을 그대로(1x), N배 빠르게, 또는 간격 없이(max, 이벤트 사이를 --gap-ms 로 자름)
+//         다시 흘려 보낸다.
+//  - 기본(프로세스 내): 이 도구 안에서 코어 라이브러리(RobotManager + VisionClient)를 그대로 띄운다.
+//          로봇마다 ModbusEmulator(127.0.0.1, --modbus-port 기본 15502 + 로봇 인덱스)를 두고 기록된
+//          읽기 응답 값을 같은 시각에 써 넣어, 폴링 → DI 에지 → 펄스 액션 → 완료 보고 경로를 다시 돌린다.
+//          비전 명령은 앱(MainWindow)과 같은 RobotCommandRouter 로 RobotManager 명령에 연결한다 (ack + cmdXxx).
+//          GUI 도 실제 장비도 필요 없으므로 같은 trace 를 반복 재생해 벤치마크로 쓸 수 있다.
+//          --stats 로 VisionClient 명령 단계별 지연 히스토그램(JSON)을 저장한다.
+//  - --external: 도구는 외부 서버 역할만 하고 대상 앱은 평소처럼 따로 실행한다.
+//          비전 서버(--vision-port 에서 listen)로 앱의 VisionClient 를 받고, --modbus-port > 0 이면
+//          로봇 인덱스 i 마다 Modbus TCP 에뮬레이터(port+i)를 띄운다.
+//  - 공통: 기록된 VisionRx 원본 줄을 같은 순서/간격으로 보내고, dir:11 완료/에러 응답을
+//          robot+seq 로 짝 지어 기록 당시 지연과 비교한다.
+//  - 갠트리(RS-485)는 에뮬레이트하지 않는다. 갠트리가 끼는 명령(소팅 플립 플레이스, 컨베이어)은
+//    프로세스 내 모드에서 ack 만 보내며, 통계에만 포함.
+//
+// 종료 코드: 0 정상, 1 파일 오류/인자 오류/접속 실패, 2 재생 중 응답 누락
+// ─────────────────────────────────────────────────────────────
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QVector>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "AddressMapBuiltin.h"
+#include "EventTrace.h"
+#include "ModbusEmulator.h"
+#include "MonoClock.h"
+#include "RobotCommandRouter.h"
+#include "RobotCommandSerializer.h"
+#include "RobotManager.h"
+#include "vision/VisionClient.h"
+
+using namespace EventTrace;
+
+namespace {
+
+struct Args {
+    QString mode;
+    QString file;
+    double speed = 1.0;             // 0: max
+    int gapMs = 30;
+    int visionPort = 50000;
+    int modbusPort = 0;
+    int drainMs = 3000;
+    qint64 from = 0;
+    qint64 count = -1;
+    bool external = false;          // 외부 앱 상대 (기본: 프로세스 내 코어 라이브러리)
+    bool verbose = false;
+    QString statsFile;
+};
+
+constexpr int kInProcessModbusBase = 15502;
+constexpr int kConnectTimeoutMs = 10000;
+
+int usage()
+{
+    std::fprintf(stderr,
+        "usage: mrc_trace_replay dump|stats|replay <trace.mrct> [options]\n"
+        "  dump:   --from N --count N\n"
+        "  replay: --speed 1|N|max --gap-ms 30 --drain-ms 3000 --modbus-port 0 --stats out.json --verbose\n"
+        "          --external [--vision-port 50000]   (replay against a separately running app)\n");
+    return 1;
+}
+
+bool parseArgs(const QStringList& a, Args& out)
+{
+    if (a.size() < 3) return false;
+    out.mode = a[1];
+    out.file = a[2];
+    for (int i = 3; i < a.size(); ++i) {
+        const QString& k = a[i];
+        if (k == "--external") { out.external = true; continue; }
+        if (k == "--verbose")  { out.verbose = true; continue; }
+        if (i + 1 >= a.size()) return false;
+        const QString& v = a[++i];
+        if (k == "--speed")            out.speed = v == "max" ? 0.0 : v.toDouble();
+        else if (k == "--gap-ms")      out.gapMs = v.toInt();
+        else if (k == "--vision-port") out.visionPort = v.toInt();
+        else if (k == "--modbus-port") out.modbusPort = v.toInt();
+        else if (k == "--drain-ms")    out.drainMs = v.toInt();
+        else if (k == "--from")        out.from = v.toLongLong();
+        else if (k == "--count")       out.count = v.toLongLong();
+        else if (k == "--stats")       out.statsFile = v;
+        else return false;
+    }
+    return out.speed >= 0.0;
+}
+
+template <typename T>
+T payloadAs(const Record& r)
+{
+    T p;
+    std::memcpy(&p, r.payload, sizeof(T));
+    return p;
+}
+
+char robotChar(int robot)
+{
+    return robot >= 0 && robot < kMaxRobots ? char('a' + robot) : '-';
+}
+
+quint64 replyKey(int robot, quint32 seq)
+{
+    return (quint64(quint8(robot)) << 32) | seq;
+}
+
+struct Percentiles {
+    QVector<double> v;
+    void add(double x) { v.push_back(x); }
+    QString summary()
+    {
+        if (v.isEmpty()) return QStringLiteral("n=0");
+        std::sort(v.begin(), v.end());
+        auto at = [&](double q) { return v[qMin(v.size() - 1, int(q * v.size()))]; };
+        double sum = 0;
+        for (double x : v) sum += x;
+        return QString("n=%1 avg=%2 p50=%3 p99=%4 max=%5")
+            .arg(v.size()).arg(sum / v.size(), 0, 'f', 2)
+            .arg(at(0.50), 0, 'f', 2).arg(at(0.99), 0, 'f', 2).arg(v.last(), 0, 'f', 2);
+    }
+};
+
+// ── dump ─────────────────────────────────────────────────────
+int dump(const Reader& rd, const Args& a)
+{
+    const qint64 end = a.count < 0 ? rd.size() : qMin(rd.size(), a.from + a.count);
+    for (qint64 i = qMax<qint64>(0, a.from); i < end; ++i) {
+        const Record& r = rd.at(i);
+        const Event e = Event(r.event);
+        std::printf("%8lld %12.3f %-11s %c seq=%-6u arg=%-5u",
+                    i, r.tNs / 1e6, eventName(e), robotChar(r.robot), r.seq, r.arg);
+        switch (e) {
+        case Event::BusRead:
+        case Event::BusWrite:
+        case Event::BusReply: {
+            const auto p = payloadAs<BusPayload>(r);
+            std::printf(" table=%u count=%u", p.table, p.count);
+            if (e == Event::BusReply) std::printf(" ok=%u rtt=%uus", p.ok, p.rttUs);
+            const int n = qMin<int>(p.count, kBusValues);
+            if (n > 0 && (e != Event::BusRead)) {
+                std::printf(" [");
+                for (int k = 0; k < n; ++k) std::printf(k ? " %u" : "%u", p.values[k]);
+                std::printf("]");
+            }
+            break;
+        }
+        case Event::VisionRx:
+            std::printf(" %s", rd.visionText(i).constData());
+            break;
+        case Event::VisionTx: {
+            const auto p = payloadAs<VisionPayload>(r);
+            std::printf(" type=%u kind=%u", p.type, p.kind);
+            break;
+        }
+        case Event::GantryMove:
+        case Event::GantryDone: {
+            const auto p = payloadAs<GantryPayload>(r);
+            std::printf(" target=%d%s", p.target, p.relative ? " (rel)" : "");
+            break;
+        }
+        case Event::Fault:
+            std::printf(" %.*s", int(qstrnlen(reinterpret_cast<const char*>(r.payload), kPayloadBytes)),
+                        reinterpret_cast<const char*>(r.payload));
+            break;
+        default:
+            break;
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
+// ── stats ────────────────────────────────────────────────────
+int stats(const Reader& rd)
+{
+    quint64 counts[int(Event::Count)] = {};
+    Percentiles busRtt[kMaxRobots];
+    Percentiles visionMs;
+    QHash<quint64, qint64> rxAt;
+    quint64 busErrors = 0;
+
+    for (qint64 i = 0; i < rd.size(); ++i) {
+        const Record& r = rd.at(i);
+        if (r.event < quint8(Event::Count)) ++counts[r.event];
+        switch (Event(r.event)) {
+        case Event::BusReply: {
+            const auto p = payloadAs<BusPayload>(r);
+            if (!p.ok) ++busErrors;
+            else if (r.robot >= 0 && r.robot < kMaxRobots) busRtt[r.robot].add(p.rttUs / 1000.0);
+            break;
+        }
+        case Event::VisionRx:
+            rxAt.insert(replyKey(r.robot, r.seq), r.tNs);
+            break;
+        case Event::VisionTx: {
+            const auto it = rxAt.find(replyKey(r.robot, r.seq));
+            if (it != rxAt.end()) {
+                visionMs.add((r.tNs - *it) / 1e6);
+                rxAt.erase(it);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    const FileHeader& h = rd.header();
+    const double spanMs = rd.size() > 0 ? rd.at(rd.size() - 1).tNs / 1e6 : 0.0;
+    std::printf("records   %lld (dropped %llu, %s)\n", rd.size(),
+                (unsigned long long)h.dropped, h.count ? "closed" : "not closed");
+    if (h.note[0])
+        std::printf("note      %.*s\n", int(qstrnlen(h.note, sizeof(h.note))), h.note);
+    std::printf("span      %.3f s\n", spanMs / 1000.0);
+    for (int e = 1; e < int(Event::Count); ++e)
+        if (counts[e]) std::printf("  %-12s %llu\n", eventName(Event(e)), (unsigned long long)counts[e]);
+    std::printf("bus errors %llu\n", (unsigned long long)busErrors);
+    for (int r = 0; r < kMaxRobots; ++r)
+        if (!busRtt[r].v.isEmpty())
+            std::printf("bus rtt %c (ms)      %s\n", robotChar(r), qPrintable(busRtt[r].summary()));
+    std::printf("vision rx->tx (ms)  %s\n", qPrintable(visionMs.summary()));
+    std::printf("vision unanswered   %d\n", rxAt.size());
+    return 0;
+}
+
+// ── replay ───────────────────────────────────────────────────
+class Replayer : public QObject
+{
+public:
+    Replayer(const Reader& rd, const Args& a) : m_rd(rd), m_args(a) {}
+
+    bool start()
+    {
+        m_timer.setSingleShot(true);
+        m_timer.setTimerType(Qt::PreciseTimer);
+        connect(&m_timer, &QTimer::timeout, this, &Replayer::step);
+        buildSchedule();
+
+        if (!m_args.external)
+            return startInProcess();
+
+        if (m_args.modbusPort > 0 && !startBus(QStringLiteral("0.0.0.0"), m_args.modbusPort))
+            return false;
+
+        if (m_visionCount > 0) {
+            connect(&m_vision, &QTcpServer::newConnection, this, &Replayer::onVisionConnected);
+            if (!m_vision.listen(QHostAddress::Any, quint16(m_args.visionPort))) {
+                std::fprintf(stderr, "vision: cannot listen on %d: %s\n", m_args.visionPort,
+                             qPrintable(m_vision.errorString()));
+                return false;
+            }
+            std::printf("vision listening on %d, waiting for the controller (%d commands)\n",
+                        m_args.visionPort, m_visionCount);
+        } else {
+            run();      // 비전 명령이 없으면 바로 시작
+        }
+        return true;
+    }
+
+    int exitCode() const { return m_exitCode; }
+
+private:
+    struct Step {
+        qint64 atNs;            // 재생 시작 기준 목표 시각
+        qint64 index;           // 레코드 번호
+    };
+
+    bool busEnabled() const { return !m_args.external || m_args.modbusPort > 0; }
+
+    // 사용된 로봇마다 Modbus 에뮬레이터 (basePort + 로봇 인덱스)
+    bool startBus(const QString& address, int basePort)
+    {
+        for (int r = 0; r < kMaxRobots; ++r) {
+            if (!m_busUsed[r]) continue;
+            auto* emu = new ModbusEmulator(this);
+            QString err;
+            if (!emu->listen(quint16(basePort + r), address, &err)) {
+                std::fprintf(stderr, "modbus %c: cannot listen on %d: %s\n", robotChar(r),
+                             basePort + r, qPrintable(err));
+                return false;
+            }
+            connect(emu, &ModbusEmulator::written, this, [this] { ++m_busWrites; });
+            m_bus[r] = emu;
+            std::printf("modbus %c listening on %d\n", robotChar(r), basePort + r);
+        }
+        return true;
+    }
+
+    // ── 프로세스 내 모드: RobotManager + VisionClient 를 이 프로세스에서 에뮬레이터에 붙인다
+    bool startInProcess()
+    {
+        const int basePort = m_args.modbusPort > 0 ? m_args.modbusPort : kInProcessModbusBase;
+
+        // 소멸 순서: mgr → client → 에뮬레이터 (자식은 만든 순서대로 지워진다)
+        m_mgr = new RobotManager(this);
+        m_client = new VisionClient(this);
+        m_mgr->setVisionClient(m_client);
+        if (m_args.verbose) {
+            connect(m_mgr, &RobotManager::log, this, [](const QString& line, Common::LogLevel) {
+                std::printf("[RM] %s\n", qPrintable(line));
+            });
+            connect(m_mgr, &RobotManager::logByRobot, this,
+                    [](const QString& id, const QString& line, Common::LogLevel) {
+                std::printf("[RM %s] %s\n", qPrintable(id), qPrintable(line));
+            });
+            connect(m_client, &VisionClient::log, this, [](const QString& line) {
+                std::printf("[VC] %s\n", qPrintable(line));
+            });
+        }
+        m_mgr->loadRecipes();
+        m_mgr->loadPulseActions();
+
+        // 주소맵이 있는 로봇만 버스를 띄운다 (출하 맵 A/B)
+        QVariantMap addr[kMaxRobots];
+        for (int r = 0; r < kMaxRobots; ++r) {
+            if (!m_busUsed[r]) continue;
+            const QString map = QString(":/map/AddressMap_%1.json").arg(QChar('A' + r));
+            if (!AddressMapBuiltin::lookup(map, &addr[r])) {
+                std::printf("robot %c: no built-in address map, bus not emulated\n", robotChar(r));
+                m_busUsed[r] = false;
+            }
+        }
+        if (!startBus(QStringLiteral("127.0.0.1"), basePort))
+            return false;
+
+        connect(m_mgr, &RobotManager::connectionChanged, this, [this](const QString& id, bool up) {
+            const int r = robotIndex(id);
+            if (!up || r < 0) return;
+            m_mgr->start(id);
+            if (!m_robotUp[r]) {        // 재연결은 다시 세지 않음
+                m_robotUp[r] = true;
+                ++m_robotsUp;
+            }
+            maybeRun();
+        });
+        m_router = new RobotCommandRouter(m_mgr, m_client, this);
+        if (m_args.verbose) {
+            connect(m_router, &RobotCommandRouter::log, this, [](const QString& line, Common::LogLevel) {
+                std::printf("[CMD] %s\n", qPrintable(line));
+            });
+        }
+        connect(m_client, &VisionClient::commandReceived, this, &Replayer::route);
+
+        connect(&m_vision, &QTcpServer::newConnection, this, &Replayer::onVisionConnected);
+        if (!m_vision.listen(QHostAddress::LocalHost, 0)) {
+            std::fprintf(stderr, "vision: cannot listen: %s\n", qPrintable(m_vision.errorString()));
+            return false;
+        }
+        m_client->connectTo(QStringLiteral("127.0.0.1"), m_vision.serverPort());
+
+        for (int r = 0; r < kMaxRobots; ++r) {
+            if (!m_bus[r]) continue;
+            ++m_robotsWanted;
+            m_mgr->addOrConnect(QString(QChar('A' + r)), QStringLiteral("127.0.0.1"), basePort + r,
+                                addr[r], nullptr);
+        }
+        std::printf("in-process: %d robot(s), %d vision commands\n", m_robotsWanted, m_visionCount);
+
+        QTimer::singleShot(kConnectTimeoutMs, this, [this] {
+            if (m_started) return;
+            std::fprintf(stderr, "in-process: not connected after %d ms (robots %d/%d, vision %s)\n",
+                         kConnectTimeoutMs, m_robotsUp, m_robotsWanted, m_sock ? "up" : "down");
+            m_exitCode = 1;
+            QCoreApplication::exit(1);
+        });
+        maybeRun();                     // 기다릴 것이 없으면 바로 시작
+        return true;
+    }
+
+    // 비전 명령 → RobotManager (앱과 같은 RobotCommandRouter, 갠트리 훅 없음)
+    void route(const RobotCommand& cmd)
+    {
+        if (cmd.dir != 1)
+            return;
+        ++m_routed;
+        if (m_router->route(cmd) == RobotCommandRouter::Result::GantryOnly)
+            ++m_gantryOnly;
+    }
+
+    // 재생할 레코드만 골라 목표 시각을 계산 (speed/gap 적용)
+    void buildSchedule()
+    {
+        const qint64 gapNs = qint64(m_args.gapMs) * 1000000;
+        qint64 prevT = -1, at = 0;
+        for (qint64 i = 0; i < m_rd.size(); ++i) {
+            const Record& r = m_rd.at(i);
+            const Event e = Event(r.event);
+            bool use = false;
+            if (e == Event::VisionRx) {
+                use = true;
+                ++m_visionCount;
+                if (!m_args.external && r.robot >= 0 && r.robot < kMaxRobots)
+                    m_busUsed[r.robot] = true;      // 명령 대상 로봇은 버스도 띄운다
+            } else if (e == Event::BusReply && r.robot >= 0 && r.robot < kMaxRobots) {
+                const auto p = payloadAs<BusPayload>(r);
+                const bool read = p.ok && p.count > 0;
+                use = read && busEnabled();
+                if (use) m_busUsed[r.robot] = true;
+            } else if (e == Event::VisionTx) {
+                // 기록 당시 지연 (비교용)
+                const auto it = m_recRx.find(replyKey(r.robot, r.seq));
+                if (it != m_recRx.end()) {
+                    m_recordedMs.add((r.tNs - *it) / 1e6);
+                    m_recRx.erase(it);
+                }
+            }
+            if (e == Event::VisionRx) m_recRx.insert(replyKey(r.robot, r.seq), r.tNs);
+            if (!use) continue;
+
+            if (prevT < 0) prevT = r.tNs;
+            const qint64 dt = r.tNs - prevT;
+            at += m_args.speed > 0.0 ? qint64(dt / m_args.speed) : qMin(dt, gapNs);
+            prevT = r.tNs;
+            m_steps.push_back({at, i});
+        }
+    }
+
+    void onVisionConnected()
+    {
+        QTcpSocket* s = m_vision.nextPendingConnection();
+        if (!s) return;
+        if (m_sock) {           // 하나만 받는다
+            s->disconnectFromHost();
+            s->deleteLater();
+            return;
+        }
+        m_sock = s;
+        connect(s, &QTcpSocket::readyRead, this, &Replayer::onVisionReadyRead);
+        connect(s, &QTcpSocket::disconnected, this, [this]() {
+            std::printf("vision: controller disconnected\n");
+            m_sock = nullptr;
+        });
+        std::printf("vision: controller connected from %s\n", qPrintable(s->peerAddress().toString()));
+        maybeRun();
+    }
+
+    void onVisionReadyRead()
+    {
+        while (m_sock && m_sock->canReadLine()) {
+            const QByteArray line = m_sock->readLine().trimmed();
+            const QJsonObject o = QJsonDocument::fromJson(line).object();
+            if (o.value("dir").toInt() != 11 || o.value("kind").toString() == "moving")
+                continue;
+            const QString robot = o.value("robot").toString();
+            const quint32 seq = quint32(o.value("seq").toInt());
+            const auto it = m_sentAt.find(replyKey(robotIndex(robot), seq));
+            if (it == m_sentAt.end()) continue;
+            m_replayMs.add((m_clock.nsecsElapsed() - *it) / 1e6);
+            m_sentAt.erase(it);
+            ++m_replies;
+        }
+    }
+
+    // 프로세스 내 모드는 로봇 버스와 비전 링크가 모두 붙은 뒤 시작
+    void maybeRun()
+    {
+        if (!m_args.external && m_robotsUp < m_robotsWanted) return;
+        if (m_visionCount > 0 && !m_sock) return;
+        run();
+    }
+
+    void run()
+    {
+        if (m_started) return;
+        m_started = true;
+        m_clock.start();
+        step();
+    }
+
+    void step()
+    {
+        const qint64 now = m_clock.nsecsElapsed();
+        while (m_next < m_steps.size() && m_steps[m_next].atNs <= now) {
+            fire(m_steps[m_next].index);
+            ++m_next;
+        }
+        if (m_next < m_steps.size()) {
+            const qint64 waitMs = (m_steps[m_next].atNs - m_clock.nsecsElapsed()) / 1000000;
+            m_timer.start(int(qMax<qint64>(0, waitMs)));
+            return;
+        }
+        // 다 보냈으면 남은 응답을 기다렸다 종료
+        QTimer::singleShot(m_args.drainMs, this, &Replayer::finish);
+    }
+
+    void fire(qint64 i)
+    {
+        const Record& r = m_rd.at(i);
+        if (Event(r.event) == Event::VisionRx) {
+            QByteArray line = m_rd.visionText(i);
+            if (line.isEmpty()) {
+                // 원본 줄이 없으면 기록된 필드로 다시 만든다 (위치/종류만)
+                const auto p = payloadAs<VisionPayload>(r);
+                RobotCommand cmd;
+                cmd.robot = r.robot >= 0 && r.robot < kMaxRobots ? RobotId(r.robot) : RobotId::Unknown;
+                cmd.type = CmdType(p.type);
+                cmd.kind = CmdKind(p.kind);
+                cmd.seq = r.seq;
+                cmd.dir = p.dir;
+                cmd.hasPick = p.flags & 1;
+                cmd.hasPlace = p.flags & 2;
+                cmd.flip = p.flags & 4;
+                cmd.pick = Pose6D{p.pick[0], p.pick[1], p.pick[2], p.pick[3], p.pick[4], p.pick[5]};
+                cmd.place = Pose6D{p.place[0], p.place[1], p.place[2], p.place[3], p.place[4], p.place[5]};
+                line = RobotCommandSerializer::toJsonLine(cmd);
+            }
+            if (!m_sock) {
+                ++m_unsent;
+                return;
+            }
+            line.append('\n');
+            m_sock->write(line);
+            m_sentAt.insert(replyKey(r.robot, r.seq), m_clock.nsecsElapsed());
+            ++m_sent;
+            return;
+        }
+
+        // BusReply: 기록된 읽기 값을 에뮬레이터 메모리에 반영
+        ModbusEmulator* emu = m_bus[r.robot];
+        if (!emu) return;
+        const auto p = payloadAs<BusPayload>(r);
+        const int n = qMin<int>(p.count, kBusValues);
+        ModbusEmulator::Table table = ModbusEmulator::Table::HoldingRegisters;
+        switch (Table(p.table)) {
+        case Table::Coils:            table = ModbusEmulator::Table::Coils; break;
+        case Table::DiscreteInputs:   table = ModbusEmulator::Table::DiscreteInputs; break;
+        case Table::InputRegisters:   table = ModbusEmulator::Table::InputRegisters; break;
+        case Table::HoldingRegisters: break;
+        }
+        emu->set(table, r.arg, QVector<quint16>(p.values, p.values + n));
+        ++m_busUpdates;
+    }
+
+    void finish()
+    {
+        std::printf("vision sent %d (not connected: %d), replies %d, missing %d\n",
+                    m_sent, m_unsent, m_replies, m_sentAt.size());
+        std::printf("vision rx->tx recorded (ms)  %s\n", qPrintable(m_recordedMs.summary()));
+        std::printf("vision rx->tx replay   (ms)  %s\n", qPrintable(m_replayMs.summary()));
+        if (busEnabled())
+            std::printf("modbus snapshots applied %d, controller writes %d\n", m_busUpdates, m_busWrites);
+        if (m_client) {
+            const QJsonObject t = m_client->commandTracker().toJson();
+            std::printf("in-process: routed %d (gantry only %d), tracker completed %d failed %d timeouts %d in-flight %d\n",
+                        m_routed, m_gantryOnly, t.value("completed").toInt(), t.value("failed").toInt(),
+                        t.value("timeouts").toInt(), t.value("in_flight").toInt());
+            if (!m_args.statsFile.isEmpty() && !m_client->saveCommandStats(m_args.statsFile))
+                std::fprintf(stderr, "cannot write %s\n", qPrintable(m_args.statsFile));
+            m_mgr->stopAll();
+            m_client->disconnectFrom();
+        }
+        std::printf("replay span %.3f s\n", m_clock.nsecsElapsed() / 1e9);
+        m_exitCode = m_sentAt.isEmpty() && m_unsent == 0 ? 0 : 2;
+        QCoreApplication::exit(m_exitCode);
+    }
+
+    const Reader& m_rd;
+    Args m_args;
+
+    QVector<Step> m_steps;
+    int m_next = 0;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    bool m_started = false;
+
+    QTcpServer m_vision;
+    QTcpSocket* m_sock = nullptr;
+    int m_visionCount = 0;
+    QHash<quint64, qint64> m_sentAt;        // robot+seq → 송신 시각 (재생 기준 ns)
+    QHash<quint64, qint64> m_recRx;         // 기록 당시 수신 시각 (짝 맞춤용)
+    Percentiles m_recordedMs;
+    Percentiles m_replayMs;
+    int m_sent = 0;
+    int m_unsent = 0;
+    int m_replies = 0;
+
+    ModbusEmulator* m_bus[kMaxRobots] = {};
+    bool m_busUsed[kMaxRobots] = {};
+    int m_busUpdates = 0;
+    int m_busWrites = 0;
+
+    // 프로세스 내 모드
+    RobotManager* m_mgr = nullptr;
+    VisionClient* m_client = nullptr;
+    RobotCommandRouter* m_router = nullptr;
+    bool m_robotUp[kMaxRobots] = {};
+    int m_robotsWanted = 0;
+    int m_robotsUp = 0;
+    int m_routed = 0;
+    int m_gantryOnly = 0;
+
+    int m_exitCode = 0;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    MonoClock::anchor();
+
+    Args args;
+    if (!parseArgs(app.arguments(), args))
+        return usage();
+
+    Reader rd;
+    QString err;
+    if (!rd.open(args.file, &err)) {
+        std::fprintf(stderr, "%s: %s\n", qPrintable(args.file), qPrintable(err));
+        return 1;
+    }
+
+    if (args.mode == "dump")  return dump(rd, args);
+    if (args.mode == "stats") return stats(rd);
+    if (args.mode != "replay") return usage();
+
+    Replayer rp(rd, args);
+    if (!rp.start())
+        return 1;
+    return app.exec();
+}
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+VisionServer load generator (loopback, many clients)
+
+Opens N TCP clients against a running VisionServer (the app, or the headless
+mrc_vision_server tool built from tools/vision_server) and, for each client:
+- sends {"type":"pose","robot":"B","kind":"pick",...,"seq":n,"dir":1} lines
+  at --rate lines/s and measures the ack round trip by seq
+- every --status-every lines sends {"type":"status","robot":"A"}; the server
+  broadcasts the status to every client (Server::Stream::State), which
+  exercises the shared broadcast payload and the per-client queues
+- --slow K: the first K clients never read, so their server-side queues fill
+  up; the server must drop their oldest state messages (or disconnect them
+  once commands pass the hard limit) without slowing the other clients
+
+Report: connect time, lines sent, acks, ack latency p50/p95/p99/max,
+broadcast messages received, disconnects.
+
+Usage:
+  mrc_vision_server --port 50000 --rate 100 --burst 200 --duration 30 &
+  python vision_load.py [--host 127.0.0.1] [--port 50000] [--clients 200]
+                        [--duration 10] [--rate 20] [--status-every 10]
+                        [--slow 0]
+
+Exit codes:
+  0: ok (every fast client connected and got acks)
+  1: connect failures, missing acks or unexpected disconnects
+"""
+
+import argparse
+import asyncio
+import json
+import sys
+import time
+
+
+class Stats:
+    def __init__(self):
+        self.connected = 0
+        self.connect_fail = 0
+        self.sent = 0
+        self.acks = 0
+        self.ack_err = 0
+        self.broadcasts = 0
+        self.disconnects = 0
+        self.lat_ms = []
+
+
+async def reader(r, pending, st, slow):
+    if slow:
+        await asyncio.Event().wait()    # never read
+    while True:
+        line = await r.readline()
+        if not line:
+            st.disconnects += 1
+            return
+        try:
+            msg = json.loads(line)
+        except ValueError:
+            continue
+        t = msg.get("type")
+        if t == "ack":
+            st.acks += 1
+            if msg.get("status") != "ok":
+                st.ack_err += 1
+            t0 = pending.pop(msg.get("seq"), None)
+            if t0 is not None:
+                st.lat_ms.append((time.perf_counter() - t0) * 1000.0)
+        elif t == "status":
+            st.broadcasts += 1
+
+
+async def client(idx, args, st, start_evt, clock):
+    t0 = time.perf_counter()
+    try:
+        r, w = await asyncio.wait_for(asyncio.open_connection(args.host, args.port), 5.0)
+    except (OSError, asyncio.TimeoutError):
+        st.connect_fail += 1
+        return None
+    st.connected += 1
+    connect_ms = (time.perf_counter() - t0) * 1000.0
+
+    pending = {}
+    slow = idx < args.slow
+    rd = asyncio.create_task(reader(r, pending, st, slow))
+    await start_evt.wait()
+    stop_at = clock["stop_at"]
+
+    period = 1.0 / args.rate if args.rate > 0 else 0.0
+    seq = idx * 1_000_000
+    n = 0
+    try:
+        while time.perf_counter() < stop_at:
+            seq += 1
+            n += 1
+            if args.status_every and n % args.status_every == 0:
+                obj = {"type": "status", "robot": "A", "seq": seq}
+            else:
+                obj = {"type": "pose", "robot": "B", "kind": "pick", "dir": 1, "seq": seq,
+                       "x": 100.0 + n, "y": -50.5, "z": 200.25, "rx": 180.0, "ry": 0.0, "rz": 90.0}
+                pending[seq] = time.perf_counter()
+            w.write((json.dumps(obj, separators=(",", ":")) + "\n").encode())
+            st.sent += 1
+            if n % 16 == 0:
+                await w.drain()
+            if period:
+                await asyncio.sleep(period)
+        await asyncio.sleep(0.5)            # last acks
+    except (ConnectionError, OSError):
+        pass
+    rd.cancel()
+    w.close()
+    return connect_ms
+
+
+def pct(sorted_vals, p):
+    if not sorted_vals:
+        return 0.0
+    k = min(len(sorted_vals) - 1, int(p * len(sorted_vals)))
+    return sorted_vals[k]
+
+
+async def run(args):
+    st = Stats()
+    start_evt = asyncio.Event()
+    clock = {"stop_at": 0.0}
+    tasks = [asyncio.create_task(client(i, args, st, start_evt, clock)) for i in range(args.clients)]
+    # 모두 접속할 때까지 대기 후 동시에 시작
+    t_conn = time.perf_counter()
+    while st.connected + st.connect_fail < args.clients:
+        await asyncio.sleep(0.01)
+        if time.perf_counter() - t_conn > 10:
+            break
+    conn_total = (time.perf_counter() - t_conn) * 1000.0
+    clock["stop_at"] = time.perf_counter() + args.duration
+    start_evt.set()
+    results = await asyncio.gather(*tasks)
+    return st, conn_total, [r for r in results if r is not None]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="VisionServer loopback load generator")
+    ap.add_argument("--host", default="127.0.0.1")
+    ap.add_argument("--port", type=int, default=50000)
+    ap.add_argument("--clients", type=int, default=200)
+    ap.add_argument("--duration", type=float, default=10.0, help="seconds of traffic")
+    ap.add_argument("--rate", type=float, default=20.0, help="lines/s per client (0 = as fast as possible)")
+    ap.add_argument("--status-every", type=int, default=10, help="every Nth line is a status request (0 = never)")
+    ap.add_argument("--slow", type=int, default=0, help="number of clients that never read")
+    args = ap.parse_args()
+
+    st, conn_ms, per_conn = asyncio.run(run(args))
+    lat = sorted(st.lat_ms)
+    fast = args.clients - args.slow
+    print(f"clients      : {st.connected}/{args.clients} connected in {conn_ms:.0f} ms "
+          f"(per-connect max {max(per_conn) if per_conn else 0:.1f} ms), {st.connect_fail} failed")
+    print(f"lines sent   : {st.sent}  ({st.sent / args.duration:.0f}/s)")
+    print(f"acks         : {st.acks} ({st.ack_err} error)")
+    print(f"ack latency  : p50 {pct(lat, .50):.2f}  p95 {pct(lat, .95):.2f}  "
+          f"p99 {pct(lat, .99):.2f}  max {lat[-1] if lat else 0:.2f} ms")
+    print(f"broadcasts   : {st.broadcasts} received by fast clients")
+    print(f"disconnects  : {st.disconnects}")
+
+    ok = st.connect_fail == 0 and st.acks > 0 and st.disconnects == 0 and len(lat) > 0
+    if fast <= 0:
+        ok = st.connect_fail == 0
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
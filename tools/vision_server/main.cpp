@@ -0,0 +1,138 @@
+// ─────────────────────────────────────────────────────────────
+// mrc_vision_server — UI 없는 VisionServer (부하/회귀 시험용)
+//
+//   mrc_vision_server [--port 50000] [--bind 127.0.0.1] [--rate 100] [--burst 200]
+//                     [--queue-msgs 1024] [--queue-bytes 4194304]
+//                     [--metrics-sec 5] [--duration 0] [--quiet]
+//
+// 앱과 같은 코어 라이브러리(VisionServer/Server)를 그대로 띄운다. tools/vision_load.py 로
+// 클라이언트 수백 개를 붙여 ack 지연/브로드캐스트/느린 클라이언트 처리를 확인할 때 쓴다.
+//  --rate/--burst  : 클라이언트별 토큰 버킷 (라인/초, 버킷 크기). 부하 측정 시 vision_load.py 의
+//                    --rate 보다 크게 둔다 (초과분은 서버가 ack 없이 버린다)
+//  --metrics-sec N : N 초마다 전체 카운터를 한 줄로 출력 (0: 끔)
+//  --duration N    : N 초 후 종료하며 최종 카운터 출력 (0: 종료하지 않음, Ctrl+C 로 끊으면 최종 출력 없음)
+//  --quiet         : 서버 로그(접속/거부 등) 출력 안 함
+//
+// 종료 코드: 0 정상, 1 인자 오류/listen 실패
+// ─────────────────────────────────────────────────────────────
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantMap>
+
+#include <cstdio>
+
+#include "MonoClock.h"
+#include "vision/VisionServer.h"
+
+namespace {
+
+struct Args {
+    quint16 port = 50000;
+    QString bind = QStringLiteral("127.0.0.1");
+    int rate = 100;
+    int burst = 200;
+    int queueMsgs = 1024;
+    qint64 queueBytes = 4 * 1024 * 1024;
+    int metricsSec = 5;
+    int durationSec = 0;
+    bool quiet = false;
+};
+
+int usage()
+{
+    std::fprintf(stderr,
+        "usage: mrc_vision_server [--port 50000] [--bind 127.0.0.1] [--rate 100] [--burst 200]\n"
+        "                         [--queue-msgs 1024] [--queue-bytes 4194304]\n"
+        "                         [--metrics-sec 5] [--duration 0] [--quiet]\n");
+    return 1;
+}
+
+bool parseArgs(const QStringList& a, Args& out)
+{
+    for (int i = 1; i < a.size(); ++i) {
+        const QString& k = a[i];
+        if (k == "--quiet") { out.quiet = true; continue; }
+        if (i + 1 >= a.size()) return false;
+        const QString& v = a[++i];
+        bool ok = true;
+        if      (k == "--port")        out.port = quint16(v.toUInt(&ok));
+        else if (k == "--bind")        out.bind = v;
+        else if (k == "--rate")        out.rate = v.toInt(&ok);
+        else if (k == "--burst")       out.burst = v.toInt(&ok);
+        else if (k == "--queue-msgs")  out.queueMsgs = v.toInt(&ok);
+        else if (k == "--queue-bytes") out.queueBytes = v.toLongLong(&ok);
+        else if (k == "--metrics-sec") out.metricsSec = v.toInt(&ok);
+        else if (k == "--duration")    out.durationSec = v.toInt(&ok);
+        else return false;
+        if (!ok) return false;
+    }
+    return out.rate > 0 && out.burst > 0 && out.queueMsgs > 0 && out.queueBytes > 0;
+}
+
+void printMetrics(const VisionServer& vs, const char* tag)
+{
+    const QVariantMap m = vs.metrics();
+    QString line;
+    for (auto it = m.cbegin(); it != m.cend(); ++it)
+        line += QString(" %1=%2").arg(it.key(), it.value().toString());
+    std::printf("%s [%s]%s\n", qPrintable(MonoClock::toString(MonoClock::nowMs())), tag, qPrintable(line));
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    MonoClock::anchor();
+
+    Args args;
+    if (!parseArgs(app.arguments(), args))
+        return usage();
+
+    VisionServer vs;
+    VisionServer::Options o = vs.options();
+    o.ratePerSec = args.rate;
+    o.rateBurst = args.burst;
+    o.sendQueueMessages = args.queueMsgs;
+    o.sendQueueBytes = args.queueBytes;
+    vs.setOptions(o);
+
+    if (!args.quiet)
+        QObject::connect(&vs, &VisionServer::log, &app, [](const QString& line) {
+            std::printf("%s\n", qPrintable(line));
+            std::fflush(stdout);
+        });
+    QObject::connect(&vs, &VisionServer::peerCountChanged, &app, [&args](int n) {
+        if (!args.quiet) std::printf("[VS] clients: %d\n", n);
+    });
+
+    const QHostAddress addr(args.bind);
+    if (addr.isNull()) {
+        std::fprintf(stderr, "bad --bind address: %s\n", qPrintable(args.bind));
+        return 1;
+    }
+    if (!vs.start(addr, args.port)) {
+        std::fprintf(stderr, "listen failed on %s:%u\n", qPrintable(args.bind), unsigned(args.port));
+        return 1;
+    }
+    std::printf("[VS] listening on %s:%u (rate %d/s, burst %d, queue %d msgs / %lld bytes)\n",
+                qPrintable(args.bind), unsigned(args.port), args.rate, args.burst,
+                args.queueMsgs, static_cast<long long>(args.queueBytes));
+    std::fflush(stdout);
+
+    QTimer metrics;
+    if (args.metricsSec > 0) {
+        QObject::connect(&metrics, &QTimer::timeout, &app, [&vs] { printMetrics(vs, "metrics"); });
+        metrics.start(args.metricsSec * 1000);
+    }
+    if (args.durationSec > 0)
+        QTimer::singleShot(args.durationSec * 1000, &app, &QCoreApplication::quit);
+
+    const int rc = app.exec();
+    printMetrics(vs, "final");
+    vs.stop();
+    return rc;
+}